@@ -26,6 +26,9 @@
 #include <kis_iterator_ng.h>
 #include <KisGlobalResourcesInterface.h>
 
+#include "kis_convolution_kernel.h"
+#include "kis_convolution_painter.h"
+
 void KisBlurBenchmark::initTestCase()
 {
     m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();    
@@ -76,6 +79,66 @@ void KisBlurBenchmark::benchmarkFilter()
     }
 }
 
+void KisBlurBenchmark::benchmarkSpatialKernel_data()
+{
+    QTest::addColumn<int>("kernelSize");
+
+    QTest::newRow("3x3") << 3;
+    QTest::newRow("5x5") << 5;
+    QTest::newRow("7x7") << 7;
+    QTest::newRow("9x9") << 9;
+}
+
+void KisBlurBenchmark::benchmarkSpatialKernel()
+{
+    QFETCH(int, kernelSize);
+
+    /**
+     * A sharpen-like kernel: the same shape as the edge detection
+     * and sharpen filters use, but of arbitrary size
+     */
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> matrix(kernelSize, kernelSize);
+    matrix.fill(-1.0);
+    matrix(kernelSize / 2, kernelSize / 2) = kernelSize * kernelSize;
+
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMatrix(matrix, 0, 1);
+
+    const QRect rc(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+    KisPaintDeviceSP dst = new KisPaintDevice(m_colorSpace);
+
+    QBENCHMARK{
+        KisConvolutionPainter painter(dst, KisConvolutionPainter::SPATIAL);
+        painter.applyMatrix(kernel, m_device, rc.topLeft(), rc.topLeft(), rc.size(), BORDER_REPEAT);
+    }
+}
 
+void KisBlurBenchmark::benchmarkUnsharpMask_data()
+{
+    QTest::addColumn<int>("halfSize");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("2") << 2;
+    QTest::newRow("4") << 4;
+}
+
+void KisBlurBenchmark::benchmarkUnsharpMask()
+{
+    QFETCH(int, halfSize);
+
+    KisFilterSP filter = KisFilterRegistry::instance()->value("unsharp");
+    KisFilterConfigurationSP kfc = filter->defaultConfiguration(KisGlobalResourcesInterface::instance());
+
+    // process all the channels with KoConvolutionOp
+    kfc->setProperty("halfSize", halfSize);
+    kfc->setProperty("threshold", 0);
+    kfc->setProperty("lightnessOnly", false);
+
+    const QRect rc(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+    KisPaintDeviceSP dev = new KisPaintDevice(*m_device);
+
+    QBENCHMARK{
+        filter->process(dev, rc, kfc);
+    }
+}
 
 SIMPLE_TEST_MAIN(KisBlurBenchmark)
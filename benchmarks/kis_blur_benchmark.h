@@ -27,6 +27,12 @@ private Q_SLOTS:
     void cleanupTestCase();
     
     void benchmarkFilter();
+
+    void benchmarkSpatialKernel_data();
+    void benchmarkSpatialKernel();
+
+    void benchmarkUnsharpMask_data();
+    void benchmarkUnsharpMask();
     
 };
 
@@ -10,6 +10,10 @@
 #include <simpletest.h>
 #include <kis_datamanager.h>
 
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
 // RGBA
 #define PIXEL_SIZE 4
 //#define CYCLES 100
@@ -186,5 +190,59 @@ void KisDatamanagerBenchmark::benchmarkMemCpy()
     delete[] dst;
 }
 
+void KisDatamanagerBenchmark::benchmarkTileAllocationScaling_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    const int maxThreads = QThread::idealThreadCount();
+
+    for (int numThreads = 1; numThreads < maxThreads; numThreads *= 2) {
+        QTest::newRow(QString("threads-%1").arg(numThreads).toLatin1()) << numThreads;
+    }
+
+    QTest::newRow(QString("threads-%1").arg(maxThreads).toLatin1()) << maxThreads;
+}
+
+void KisDatamanagerBenchmark::benchmarkTileAllocationScaling()
+{
+    QFETCH(int, numThreads);
+
+    // every thread allocates and frees 256 tiles per cycle
+    const int regionSize = 1024;
+    const int numCycles = 16;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(numThreads);
+
+    auto allocateTiles = [regionSize, numCycles] () {
+        quint8 defaultPixel[PIXEL_SIZE];
+        memset(defaultPixel, 0, PIXEL_SIZE);
+
+        QVector<quint8> bytes(PIXEL_SIZE * regionSize * regionSize, 128);
+
+        for (int i = 0; i < numCycles; i++) {
+            KisDataManager dm(PIXEL_SIZE, defaultPixel);
+            dm.writeBytes(bytes.data(), 0, 0, regionSize, regionSize);
+        }
+    };
+
+    auto runAllThreads = [&pool, numThreads, allocateTiles] () {
+        QVector<QFuture<void>> jobs;
+        for (int i = 0; i < numThreads; i++) {
+            jobs << QtConcurrent::run(&pool, allocateTiles);
+        }
+
+        Q_FOREACH (QFuture<void> job, jobs) {
+            job.waitForFinished();
+        }
+    };
+
+    // warm up the pool threads and their tile caches
+    runAllThreads();
+
+    QBENCHMARK {
+        runAllThreads();
+    }
+}
 
 SIMPLE_TEST_MAIN(KisDatamanagerBenchmark)
@@ -9,11 +9,15 @@
 #include "kis_benchmark_values.h"
 
 #include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoCompositeOpRegistry.h>
 
 #include <kis_group_layer.h>
+#include <kis_paint_layer.h>
 #include <kis_paint_device.h>
 #include <KisDocument.h>
 #include <kis_image.h>
+#include <kis_image_config.h>
 #include <KisPart.h>
 
 void KisProjectionBenchmark::initTestCase()
@@ -46,5 +50,63 @@ void KisProjectionBenchmark::benchmarkLoading()
     }
 }
 
+void KisProjectionBenchmark::benchmarkProjectionScaling_data()
+{
+    QTest::addColumn<int>("numThreads");
+    QTest::addColumn<bool>("useWorkStealing");
+
+    for (int numThreads = 1; numThreads <= 64; numThreads *= 2) {
+        QTest::addRow("%d-thread-pool", numThreads) << numThreads << false;
+        QTest::addRow("%d-work-stealing", numThreads) << numThreads << true;
+    }
+}
+
+void KisProjectionBenchmark::benchmarkProjectionScaling()
+{
+    QFETCH(int, numThreads);
+    QFETCH(bool, useWorkStealing);
+
+    const int numLayers = 8;
+    const QRect imageRect(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+
+    /**
+     * The scheduler reads the settings on construction of the image,
+     * so they should be written before the image is created
+     */
+    KisImageConfig config(false);
+    const int oldNumThreads = config.maxNumberOfThreads();
+    const bool oldUseWorkStealing = config.useWorkStealingScheduler();
+
+    config.setMaxNumberOfThreads(numThreads);
+    config.setUseWorkStealingScheduler(useWorkStealing);
+
+    {
+        const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+        KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "scaling test");
+
+        const QStringList compositeOps({COMPOSITE_OVER, COMPOSITE_MULT, COMPOSITE_SCREEN, COMPOSITE_OVERLAY});
+
+        for (int i = 0; i < numLayers; i++) {
+            KisPaintLayerSP layer = new KisPaintLayer(image, QString("layer %1").arg(i), OPACITY_OPAQUE_U8 * 3 / 4);
+            layer->setCompositeOpId(compositeOps[i % compositeOps.size()]);
+
+            const QColor color = QColor::fromHsv(i * 360 / numLayers, 200, 200, 180);
+            layer->paintDevice()->fill(imageRect.adjusted(i * 16, i * 16, -i * 16, -i * 16),
+                                       KoColor(color, cs));
+
+            image->addNode(layer, image->root());
+        }
+
+        image->initialRefreshGraph();
+
+        QBENCHMARK {
+            image->refreshGraphAsync();
+            image->waitForDone();
+        }
+    }
+
+    config.setMaxNumberOfThreads(oldNumThreads);
+    config.setUseWorkStealingScheduler(oldUseWorkStealing);
+}
 
 SIMPLE_TEST_MAIN(KisProjectionBenchmark)
@@ -0,0 +1,47 @@
+# Builds the benchmarks once per tile size and runs them one after another,
+# so that the results could be compared side by side. Is called by the
+# benchmark-tile-sizes target, see benchmarks/CMakeLists.txt
+
+# the lists are passed comma-separated to survive the custom command
+string(REPLACE "," ";" BENCHMARK_TILE_SIZES "${BENCHMARK_TILE_SIZES}")
+string(REPLACE "," ";" BENCHMARK_TARGETS "${BENCHMARK_TARGETS}")
+string(REPLACE "," ";" BENCHMARK_PREFIX_PATH "${BENCHMARK_PREFIX_PATH}")
+
+include(ProcessorCount)
+ProcessorCount(NUM_JOBS)
+if (NUM_JOBS EQUAL 0)
+    set(NUM_JOBS 1)
+endif()
+
+foreach(TILE_SIZE ${BENCHMARK_TILE_SIZES})
+    set(BUILD_DIR ${BENCHMARK_BINARY_DIR}/tile-size-${TILE_SIZE})
+
+    message(STATUS "=== Tile size ${TILE_SIZE}x${TILE_SIZE} ===")
+
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} -S ${KRITA_SOURCE_DIR} -B ${BUILD_DIR}
+            -DKRITA_TILE_SIZE=${TILE_SIZE}
+            -DBUILD_TESTING=ON
+            -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE}
+            "-DCMAKE_PREFIX_PATH=${BENCHMARK_PREFIX_PATH}"
+        RESULT_VARIABLE RESULT)
+    if (NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "Failed to configure the build for tile size ${TILE_SIZE}")
+    endif()
+
+    foreach(TARGET ${BENCHMARK_TARGETS})
+        execute_process(
+            COMMAND ${CMAKE_COMMAND} --build ${BUILD_DIR} --target ${TARGET} -- -j${NUM_JOBS}
+            RESULT_VARIABLE RESULT)
+        if (NOT RESULT EQUAL 0)
+            message(FATAL_ERROR "Failed to build ${TARGET} for tile size ${TILE_SIZE}")
+        endif()
+    endforeach()
+
+    foreach(TARGET ${BENCHMARK_TARGETS})
+        message(STATUS "--- ${TARGET}, tile size ${TILE_SIZE} ---")
+        execute_process(
+            COMMAND ${BUILD_DIR}/benchmarks/${TARGET}
+            WORKING_DIRECTORY ${BUILD_DIR}/benchmarks)
+    endforeach()
+endforeach()
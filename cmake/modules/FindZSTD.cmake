@@ -0,0 +1,26 @@
+# - Try to find the Zstandard Library
+# Once done this will define
+#
+#  ZSTD_FOUND - system has zstd
+#  ZSTD_INCLUDE_DIRS - the zstd include directories
+#  ZSTD_LIBRARIES - the libraries needed to use zstd
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+include(LibFindMacros)
+libfind_pkg_check_modules(ZSTD_PKGCONF libzstd)
+
+find_path(ZSTD_INCLUDE_DIR
+    NAMES zstd.h
+    HINTS ${ZSTD_PKGCONF_INCLUDE_DIRS} ${ZSTD_PKGCONF_INCLUDEDIR}
+)
+
+find_library(ZSTD_LIBRARY
+    NAMES zstd libzstd zstd_static
+    HINTS ${ZSTD_PKGCONF_LIBRARY_DIRS} ${ZSTD_PKGCONF_LIBDIR}
+)
+
+set(ZSTD_PROCESS_LIBS ZSTD_LIBRARY)
+set(ZSTD_PROCESS_INCLUDES ZSTD_INCLUDE_DIR)
+libfind_process(ZSTD)
@@ -0,0 +1,238 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisBelowStackCache.h"
+
+#include <atomic>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegion>
+#include <QSet>
+#include <QGlobalStatic>
+
+#include "kis_group_layer.h"
+#include "kis_paint_device.h"
+#include "kis_painter.h"
+
+namespace {
+std::atomic<bool> s_cacheEnabled {false};
+
+/**
+ * All the existing caches, so that they could be freed when the
+ * cache is disabled
+ */
+struct CacheRegistry
+{
+    QMutex lock;
+    QSet<KisBelowStackCache*> caches;
+};
+
+Q_GLOBAL_STATIC(CacheRegistry, s_registry)
+}
+
+struct KisBelowStackCache::Private
+{
+    mutable QMutex lock;
+
+    /**
+     * The node is used as a key only, it is never dereferenced,
+     * so it is safe to keep a pointer to a removed node here
+     */
+    const KisNode *activeNode = 0;
+    int graphSequenceNumber = -1;
+
+    /**
+     * Incremented on every invalidation. The merger reads the value
+     * before compositing the layers and the result is not stored if
+     * something has changed in the meantime.
+     */
+    quint64 generation = 0;
+
+    KisPaintDeviceSP device;
+    QRegion validRegion;
+
+    void invalidate() {
+        generation++;
+        activeNode = 0;
+        graphSequenceNumber = -1;
+        device = 0;
+        validRegion = QRegion();
+    }
+};
+
+KisBelowStackCache::KisBelowStackCache()
+    : m_d(new Private)
+{
+    QMutexLocker l(&s_registry->lock);
+    s_registry->caches.insert(this);
+}
+
+KisBelowStackCache::~KisBelowStackCache()
+{
+    if (s_registry.isDestroyed()) return;
+
+    QMutexLocker l(&s_registry->lock);
+    s_registry->caches.remove(this);
+}
+
+void KisBelowStackCache::setEnabled(bool value)
+{
+    const bool wasEnabled = s_cacheEnabled.exchange(value);
+
+    if (wasEnabled && !value) {
+        QMutexLocker l(&s_registry->lock);
+
+        Q_FOREACH (KisBelowStackCache *cache, s_registry->caches) {
+            cache->invalidate();
+        }
+    }
+}
+
+bool KisBelowStackCache::isEnabled()
+{
+    return s_cacheEnabled;
+}
+
+bool KisBelowStackCache::fetch(const KisNode *activeNode, const QRect &rect,
+                               KisPaintDeviceSP dst, int graphSequenceNumber,
+                               quint64 *generation)
+{
+    KisPaintDeviceSP cachedDevice;
+
+    {
+        QMutexLocker l(&m_d->lock);
+
+        *generation = m_d->generation;
+
+        if (!m_d->device ||
+            m_d->activeNode != activeNode ||
+            m_d->graphSequenceNumber != graphSequenceNumber ||
+            !(QRegion(rect) - m_d->validRegion).isEmpty()) {
+
+            return false;
+        }
+
+        cachedDevice = m_d->device;
+    }
+
+    /**
+     * The invalidation resets the device pointer instead of clearing
+     * the device, so our copy of the pointer stays valid even if the
+     * cache is invalidated right now
+     */
+    KisPainter::copyAreaOptimized(rect.topLeft(), cachedDevice, dst, rect);
+
+    return true;
+}
+
+void KisBelowStackCache::store(const KisNode *activeNode, const QRect &rect,
+                               KisPaintDeviceSP src, int graphSequenceNumber,
+                               quint64 generation)
+{
+    KisPaintDeviceSP cachedDevice;
+
+    {
+        QMutexLocker l(&m_d->lock);
+
+        if (m_d->generation != generation) return;
+
+        if (!m_d->device ||
+            m_d->activeNode != activeNode ||
+            m_d->graphSequenceNumber != graphSequenceNumber) {
+
+            m_d->activeNode = activeNode;
+            m_d->graphSequenceNumber = graphSequenceNumber;
+            m_d->validRegion = QRegion();
+
+            m_d->device = new KisPaintDevice(src->colorSpace());
+            m_d->device->prepareClone(src);
+        }
+
+        cachedDevice = m_d->device;
+    }
+
+    KisPainter::copyAreaOptimized(rect.topLeft(), src, cachedDevice, rect);
+
+    QMutexLocker l(&m_d->lock);
+
+    if (m_d->generation == generation && m_d->device == cachedDevice) {
+        m_d->validRegion += rect;
+    }
+}
+
+void KisBelowStackCache::invalidate()
+{
+    QMutexLocker l(&m_d->lock);
+    m_d->invalidate();
+}
+
+void KisBelowStackCache::invalidateIfBelowActive(const KisNode *changedChild)
+{
+    QMutexLocker l(&m_d->lock);
+
+    if (!m_d->activeNode || changedChild == m_d->activeNode) return;
+
+    for (KisNodeSP node = changedChild->nextSibling(); node; node = node->nextSibling()) {
+        if (node.data() == m_d->activeNode) {
+            m_d->invalidate();
+            break;
+        }
+    }
+}
+
+bool KisBelowStackCache::contains(const KisNode *activeNode, const QRect &rect) const
+{
+    QMutexLocker l(&m_d->lock);
+
+    return m_d->device &&
+        m_d->activeNode == activeNode &&
+        (QRegion(rect) - m_d->validRegion).isEmpty();
+}
+
+KisPaintDeviceSP KisBelowStackCache::device() const
+{
+    QMutexLocker l(&m_d->lock);
+    return m_d->device;
+}
+
+void KisBelowStackCache::notifyNodeDirty(KisNode *node)
+{
+    const KisNode *child = node;
+    KisNodeSP parent = node->parent();
+
+    while (parent) {
+        KisGroupLayer *group = qobject_cast<KisGroupLayer*>(parent.data());
+        if (group) {
+            group->belowStackCache()->invalidateIfBelowActive(child);
+        }
+
+        child = parent.data();
+        parent = parent->parent();
+    }
+}
+
+namespace {
+
+void invalidateCachesRecursive(KisNode *node)
+{
+    KisGroupLayer *group = qobject_cast<KisGroupLayer*>(node);
+    if (group) {
+        group->belowStackCache()->invalidate();
+    }
+
+    for (KisNodeSP child = node->firstChild(); child; child = child->nextSibling()) {
+        invalidateCachesRecursive(child.data());
+    }
+}
+
+}
+
+void KisBelowStackCache::notifySubtreeRefreshed(KisNode *root)
+{
+    invalidateCachesRecursive(root);
+    notifyNodeDirty(root);
+}
@@ -0,0 +1,115 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISBELOWSTACKCACHE_H
+#define KISBELOWSTACKCACHE_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+#include <QScopedPointer>
+
+class QRect;
+
+/**
+ * Keeps the composition of the layers placed below the "active"
+ * child of a group, i.e. the child that receives the updates right
+ * now. Every KisGroupLayer owns one cache.
+ *
+ * When painting on a layer placed high in a big stack, KisAsyncMerger
+ * would recomposite all the layers below it on every update, even
+ * though nothing has changed there. With the cache the merger copies
+ * the stored composition into the group's projection instead and
+ * starts compositing from the active child.
+ *
+ * The cache is filled by the merger as a side effect of the normal
+ * updates and is invalidated:
+ *
+ *   - when any child below the active one (or any of its descendants)
+ *     is marked dirty, see notifyNodeDirty()
+ *
+ *   - when the graph sequence number of the image changes, that is,
+ *     the nodes are added, removed or moved
+ *
+ *   - when the whole subtree is refreshed, see notifySubtreeRefreshed()
+ *
+ * The cache is used for level of detail 0 only. It is disabled by
+ * default and is controlled by KisImageConfig::useBelowStackCache().
+ */
+class KRITAIMAGE_EXPORT KisBelowStackCache
+{
+public:
+    KisBelowStackCache();
+    ~KisBelowStackCache();
+
+    /**
+     * Enables or disables caching for all the groups. When disabled,
+     * all the existing caches are invalidated and free their memory.
+     */
+    static void setEnabled(bool value);
+    static bool isEnabled();
+
+    /**
+     * Copies the composition of the layers below \p activeNode in
+     * \p rect into \p dst. Returns false if the cache doesn't have
+     * this area. In both cases \p generation is set to the value
+     * that should be passed to store() after compositing the layers.
+     */
+    bool fetch(const KisNode *activeNode, const QRect &rect,
+               KisPaintDeviceSP dst, int graphSequenceNumber,
+               quint64 *generation);
+
+    /**
+     * Saves \p rect of \p src as the composition of the layers below
+     * \p activeNode. If the cache has been invalidated since the
+     * \p generation was fetched, the data is dropped.
+     */
+    void store(const KisNode *activeNode, const QRect &rect,
+               KisPaintDeviceSP src, int graphSequenceNumber,
+               quint64 generation);
+
+    /**
+     * Drops all the cached data and frees the memory
+     */
+    void invalidate();
+
+    /**
+     * Drops the cached data if \p changedChild is placed below the
+     * active child of the group
+     */
+    void invalidateIfBelowActive(const KisNode *changedChild);
+
+    /**
+     * \return true if \p rect of \p activeNode is present in the cache
+     */
+    bool contains(const KisNode *activeNode, const QRect &rect) const;
+
+    /**
+     * \return the device with the cached data or null if the cache
+     * is empty. Used for memory statistics only.
+     */
+    KisPaintDeviceSP device() const;
+
+    /**
+     * Invalidates the caches of all the groups whose stack below the
+     * active child includes \p node
+     */
+    static void notifyNodeDirty(KisNode *node);
+
+    /**
+     * Invalidates the caches of all the groups inside \p root and of
+     * the groups that contain it
+     */
+    static void notifySubtreeRefreshed(KisNode *root);
+
+private:
+    Q_DISABLE_COPY(KisBelowStackCache)
+
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISBELOWSTACKCACHE_H
@@ -0,0 +1,212 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDirtyTileMap.h"
+
+#include "tiles3/kis_tile_data_interface.h"
+#include "kis_assert.h"
+
+namespace {
+
+// the mask of a cell is stored in a single 64-bit integer
+const int maxCellSide = 8;
+
+inline int divFloor(int value, int divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+struct Run {
+    int firstColumn;
+    int lastColumn;
+    int lastRow;
+    QRect bounds;
+};
+
+}
+
+KisDirtyTileMap::KisDirtyTileMap()
+    : KisDirtyTileMap(QSize(KisTileData::WIDTH, KisTileData::HEIGHT),
+                      QSize(maxCellSide * KisTileData::WIDTH, maxCellSide * KisTileData::HEIGHT))
+{
+}
+
+KisDirtyTileMap::KisDirtyTileMap(const QSize &tileSize, const QSize &batchSize)
+    : m_tileWidth(qMax(1, tileSize.width())),
+      m_tileHeight(qMax(1, tileSize.height())),
+      m_cellColumns(qBound(1, batchSize.width() / m_tileWidth, maxCellSide)),
+      m_cellRows(qBound(1, batchSize.height() / m_tileHeight, maxCellSide))
+{
+}
+
+void KisDirtyTileMap::addRect(const QRect &rc)
+{
+    if (rc.isEmpty()) return;
+
+    const int cellWidth = m_cellColumns * m_tileWidth;
+    const int cellHeight = m_cellRows * m_tileHeight;
+
+    const int firstCellColumn = divFloor(rc.left(), cellWidth);
+    const int lastCellColumn = divFloor(rc.right(), cellWidth);
+    const int firstCellRow = divFloor(rc.top(), cellHeight);
+    const int lastCellRow = divFloor(rc.bottom(), cellHeight);
+
+    for (int cellRow = firstCellRow; cellRow <= lastCellRow; cellRow++) {
+        for (int cellColumn = firstCellColumn; cellColumn <= lastCellColumn; cellColumn++) {
+            Cell &cell = m_cells[CellIndex(cellRow, cellColumn)];
+            addRectToCell(cell, cellRow, cellColumn, rc);
+        }
+    }
+}
+
+void KisDirtyTileMap::addRectToCell(Cell &cell, int cellRow, int cellColumn, const QRect &rc)
+{
+    if (cell.tileBounds.isEmpty()) {
+        cell.tileBounds.resize(m_cellColumns * m_cellRows);
+    }
+
+    const QRect cellRect(cellColumn * m_cellColumns * m_tileWidth,
+                         cellRow * m_cellRows * m_tileHeight,
+                         m_cellColumns * m_tileWidth,
+                         m_cellRows * m_tileHeight);
+
+    const QRect dirtyRect = rc & cellRect;
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!dirtyRect.isEmpty());
+
+    const int firstColumn = (dirtyRect.left() - cellRect.left()) / m_tileWidth;
+    const int lastColumn = (dirtyRect.right() - cellRect.left()) / m_tileWidth;
+    const int firstRow = (dirtyRect.top() - cellRect.top()) / m_tileHeight;
+    const int lastRow = (dirtyRect.bottom() - cellRect.top()) / m_tileHeight;
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            const QRect tileRect(cellRect.left() + column * m_tileWidth,
+                                 cellRect.top() + row * m_tileHeight,
+                                 m_tileWidth, m_tileHeight);
+
+            const int index = row * m_cellColumns + column;
+
+            cell.dirtyMask |= quint64(1) << index;
+            cell.tileBounds[index] |= dirtyRect & tileRect;
+        }
+    }
+}
+
+void KisDirtyTileMap::addRects(const QVector<QRect> &rects)
+{
+    Q_FOREACH (const QRect &rc, rects) {
+        addRect(rc);
+    }
+}
+
+void KisDirtyTileMap::clear()
+{
+    m_cells.clear();
+}
+
+bool KisDirtyTileMap::isEmpty() const
+{
+    return m_cells.isEmpty();
+}
+
+int KisDirtyTileMap::numDirtyTiles() const
+{
+    int result = 0;
+
+    for (auto it = m_cells.constBegin(); it != m_cells.constEnd(); ++it) {
+        result += qPopulationCount(it.value().dirtyMask);
+    }
+
+    return result;
+}
+
+QRect KisDirtyTileMap::boundingRect() const
+{
+    QRect result;
+
+    for (auto it = m_cells.constBegin(); it != m_cells.constEnd(); ++it) {
+        Q_FOREACH (const QRect &rc, it.value().tileBounds) {
+            result |= rc;
+        }
+    }
+
+    return result;
+}
+
+QVector<QRect> KisDirtyTileMap::batches() const
+{
+    QVector<QRect> result;
+    QVector<Run> runs;
+
+    const quint64 rowMask = (quint64(1) << m_cellColumns) - 1;
+
+    for (auto it = m_cells.constBegin(); it != m_cells.constEnd(); ++it) {
+        const Cell &cell = it.value();
+        runs.clear();
+
+        for (int row = 0; row < m_cellRows; row++) {
+            quint64 rowBits = (cell.dirtyMask >> (row * m_cellColumns)) & rowMask;
+            int column = 0;
+
+            while (rowBits) {
+                while (!(rowBits & 1)) {
+                    rowBits >>= 1;
+                    column++;
+                }
+
+                const int firstColumn = column;
+                QRect bounds;
+
+                while (rowBits & 1) {
+                    bounds |= cell.tileBounds[row * m_cellColumns + column];
+                    rowBits >>= 1;
+                    column++;
+                }
+
+                const int lastColumn = column - 1;
+
+                /**
+                 * Try to continue the run of the previous row, the runs
+                 * of different width are kept separate, otherwise the
+                 * merged rect could grab a lot of clean area
+                 */
+                bool merged = false;
+
+                for (auto runIt = runs.begin(); runIt != runs.end(); ++runIt) {
+                    if (runIt->lastRow == row - 1 &&
+                        runIt->firstColumn == firstColumn &&
+                        runIt->lastColumn == lastColumn) {
+
+                        runIt->lastRow = row;
+                        runIt->bounds |= bounds;
+                        merged = true;
+                        break;
+                    }
+                }
+
+                if (!merged) {
+                    runs.append({firstColumn, lastColumn, row, bounds});
+                }
+            }
+        }
+
+        Q_FOREACH (const Run &run, runs) {
+            result.append(run.bounds);
+        }
+    }
+
+    return result;
+}
+
+QSize KisDirtyTileMap::tileSize() const
+{
+    return QSize(m_tileWidth, m_tileHeight);
+}
+
+QSize KisDirtyTileMap::batchSize() const
+{
+    return QSize(m_cellColumns * m_tileWidth, m_cellRows * m_tileHeight);
+}
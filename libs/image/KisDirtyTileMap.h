@@ -0,0 +1,96 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDIRTYTILEMAP_H
+#define KISDIRTYTILEMAP_H
+
+#include "kritaimage_export.h"
+
+#include <QMap>
+#include <QPair>
+#include <QRect>
+#include <QSize>
+#include <QVector>
+
+/**
+ * A sparse bitmap of dirty tiles.
+ *
+ * The plane is split into cells of up to 8x8 tiles, every cell keeps
+ * a bit mask of its dirty tiles and the exact bounds of the dirty area
+ * inside every tile. Cells are allocated only when some of their tiles
+ * become dirty, so the map is cheap for the updates scattered over a
+ * huge image.
+ *
+ * The map is used to coalesce lots of small update rects, e.g. the ones
+ * generated by a spray brush or by the multihand tool. Calling batches()
+ * converts the dirty tiles into a set of rects that never cross the
+ * border of a cell. Adjacent dirty tiles are merged together, isolated
+ * dabs keep their exact size.
+ */
+class KRITAIMAGE_EXPORT KisDirtyTileMap
+{
+public:
+    /**
+     * Creates a map with the tiles of the size of KisTileData and the
+     * cells of 8x8 tiles
+     */
+    KisDirtyTileMap();
+
+    /**
+     * \p tileSize defines the granularity of the map, \p batchSize
+     * defines the maximum size of the batch rects. The batch size is
+     * rounded down to a whole number of tiles, but cannot be smaller
+     * than one tile and larger than 8x8 tiles.
+     */
+    KisDirtyTileMap(const QSize &tileSize, const QSize &batchSize);
+
+    void addRect(const QRect &rc);
+    void addRects(const QVector<QRect> &rects);
+
+    void clear();
+    bool isEmpty() const;
+
+    int numDirtyTiles() const;
+
+    /**
+     * The union of the rects added into the map
+     */
+    QRect boundingRect() const;
+
+    /**
+     * Returns the rects covering all the dirty areas of the map. The
+     * horizontal runs of dirty tiles are merged into a single rect,
+     * the runs in the adjacent rows of the same cell are merged when
+     * they have the same horizontal span. Every rect is the union of
+     * the dirty bounds of its tiles, not of the tiles themselves.
+     *
+     * The rects are sorted in row-major order of the cells.
+     */
+    QVector<QRect> batches() const;
+
+    QSize tileSize() const;
+    QSize batchSize() const;
+
+private:
+    struct Cell {
+        quint64 dirtyMask = 0;
+        QVector<QRect> tileBounds;
+    };
+
+    using CellIndex = QPair<int, int>;
+
+    void addRectToCell(Cell &cell, int cellRow, int cellColumn, const QRect &rc);
+
+private:
+    int m_tileWidth;
+    int m_tileHeight;
+    int m_cellColumns;
+    int m_cellRows;
+
+    QMap<CellIndex, Cell> m_cells;
+};
+
+#endif // KISDIRTYTILEMAP_H
@@ -0,0 +1,165 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisMergeCostEstimator.h"
+
+#include <QtMath>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRect>
+
+#include "kis_node.h"
+#include "tiles3/kis_tile_data_interface.h"
+
+namespace {
+
+// the jobs smaller than a single tile are not measured
+const qint64 minMeasuredPixels = KisTileData::WIDTH * KisTileData::HEIGHT;
+
+// the weight of the new measurement in the moving average
+const qreal newSampleWeight = 0.2;
+
+// every thread gets a couple of jobs to balance uneven patches
+const int jobsPerThread = 2;
+
+// the minimal time of a job to amortize the cost of the walker
+const qreal minJobNsecs = 2e6;
+
+int alignedPatchSide(qreal side, int maxSide)
+{
+    const int tileSide = KisTileData::WIDTH;
+    const int alignedSide = qCeil(side / tileSide) * tileSide;
+
+    return qBound(qMin(tileSide, maxSide), alignedSide, maxSide);
+}
+
+int numNodesInSubtree(KisNodeSP node)
+{
+    int result = 1;
+
+    for (KisNodeSP child = node->firstChild(); child; child = child->nextSibling()) {
+        result += numNodesInSubtree(child);
+    }
+
+    return result;
+}
+
+}
+
+struct KisMergeCostEstimator::Private
+{
+    mutable QMutex lock;
+
+    int numThreads = 1;
+    qreal nsecsPerPixel = 0.0;
+    bool hasEstimation = false;
+};
+
+KisMergeCostEstimator::KisMergeCostEstimator()
+    : m_d(new Private)
+{
+}
+
+KisMergeCostEstimator::~KisMergeCostEstimator()
+{
+}
+
+void KisMergeCostEstimator::setNumThreads(int value)
+{
+    QMutexLocker l(&m_d->lock);
+    m_d->numThreads = qMax(1, value);
+}
+
+int KisMergeCostEstimator::numThreads() const
+{
+    QMutexLocker l(&m_d->lock);
+    return m_d->numThreads;
+}
+
+void KisMergeCostEstimator::reportMergeJob(const QRect &rect, int numLayers, qint64 nsecs)
+{
+    const qint64 numPixels = qint64(rect.width()) * rect.height() * qMax(1, numLayers);
+    if (numPixels < minMeasuredPixels) return;
+
+    const qreal value = qreal(nsecs) / numPixels;
+
+    QMutexLocker l(&m_d->lock);
+
+    if (m_d->hasEstimation) {
+        m_d->nsecsPerPixel += newSampleWeight * (value - m_d->nsecsPerPixel);
+    } else {
+        m_d->nsecsPerPixel = value;
+        m_d->hasEstimation = true;
+    }
+}
+
+bool KisMergeCostEstimator::hasEstimation() const
+{
+    QMutexLocker l(&m_d->lock);
+    return m_d->hasEstimation;
+}
+
+qreal KisMergeCostEstimator::nsecsPerPixel() const
+{
+    QMutexLocker l(&m_d->lock);
+    return m_d->nsecsPerPixel;
+}
+
+void KisMergeCostEstimator::reset()
+{
+    QMutexLocker l(&m_d->lock);
+    m_d->nsecsPerPixel = 0.0;
+    m_d->hasEstimation = false;
+}
+
+QSize KisMergeCostEstimator::patchSize(const QRect &rc, int numLayers, const QSize &maxPatchSize) const
+{
+    int numThreads = 1;
+    qreal nsecsPerPixel = 0.0;
+    bool hasEstimation = false;
+
+    {
+        QMutexLocker l(&m_d->lock);
+        numThreads = m_d->numThreads;
+        nsecsPerPixel = m_d->nsecsPerPixel;
+        hasEstimation = m_d->hasEstimation;
+    }
+
+    if (!hasEstimation || numThreads <= 1 || rc.isEmpty()) return maxPatchSize;
+
+    const qreal area = qreal(rc.width()) * rc.height();
+    const qreal cost = area * qMax(1, numLayers) * nsecsPerPixel;
+
+    const int numJobs = int(qMin(qreal(jobsPerThread * numThreads), cost / minJobNsecs));
+
+    const int numMaxPatches =
+        qCeil(qreal(rc.width()) / maxPatchSize.width()) *
+        qCeil(qreal(rc.height()) / maxPatchSize.height());
+
+    if (numJobs <= numMaxPatches) return maxPatchSize;
+
+    const qreal side = qSqrt(area / numJobs);
+
+    return QSize(alignedPatchSide(side, maxPatchSize.width()),
+                 alignedPatchSide(side, maxPatchSize.height()));
+}
+
+qreal KisMergeCostEstimator::estimatedCost(const QRect &rc, int numLayers) const
+{
+    QMutexLocker l(&m_d->lock);
+    return qreal(rc.width()) * rc.height() * qMax(1, numLayers) * m_d->nsecsPerPixel;
+}
+
+int KisMergeCostEstimator::numCompositedLayers(KisNodeSP node, bool isFullRefresh)
+{
+    int result = isFullRefresh ? numNodesInSubtree(node) - 1 : 0;
+
+    for (KisNodeSP parent = node->parent(); parent; parent = parent->parent()) {
+        result += parent->childCount();
+    }
+
+    return qMax(1, result);
+}
@@ -0,0 +1,103 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISMERGECOSTESTIMATOR_H
+#define KISMERGECOSTESTIMATOR_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+#include <QScopedPointer>
+#include <QSize>
+
+class QRect;
+
+/**
+ * Measures the cost of the merge jobs and chooses the size of the
+ * patches the big update rects are split into.
+ *
+ * KisSimpleUpdateQueue splits every big update rect into patches, and
+ * every patch is processed by a separate merge job. With a fixed patch
+ * size a single huge update (a filter applied to the whole image, a
+ * committed transformation) is processed by a few jobs only, so most of
+ * the threads stay idle. On the other hand, the patches cannot be too
+ * small, otherwise the overhead of the walkers and the scheduling
+ * outweighs the compositing itself.
+ *
+ * The estimator keeps a moving average of the time needed to composite
+ * one pixel of one layer. It is updated by KisUpdateJobItem after every
+ * merge job. The patch size is selected so that every thread gets a
+ * couple of jobs, but every job takes at least a couple of milliseconds.
+ * The patch size never exceeds the one set in KisImageConfig.
+ *
+ * The object is owned by KisUpdaterContext, all the methods are
+ * thread-safe.
+ */
+class KRITAIMAGE_EXPORT KisMergeCostEstimator
+{
+public:
+    KisMergeCostEstimator();
+    ~KisMergeCostEstimator();
+
+    /**
+     * Set the number of threads the merge jobs are executed on
+     */
+    void setNumThreads(int value);
+    int numThreads() const;
+
+    /**
+     * Register the time spent on merging \p numLayers layers in
+     * \p rect. Too small jobs are ignored, their timing is dominated
+     * by the overhead.
+     */
+    void reportMergeJob(const QRect &rect, int numLayers, qint64 nsecs);
+
+    /**
+     * \return true if at least one merge job has been measured
+     */
+    bool hasEstimation() const;
+
+    /**
+     * The average time needed to composite a single pixel of a
+     * single layer
+     */
+    qreal nsecsPerPixel() const;
+
+    /**
+     * Forget all the measured values
+     */
+    void reset();
+
+    /**
+     * \return the size of the patches \p rc should be split into when
+     * \p numLayers layers should be composited in it. If no jobs have
+     * been measured yet or there is only one thread, \p maxPatchSize
+     * is returned.
+     */
+    QSize patchSize(const QRect &rc, int numLayers, const QSize &maxPatchSize) const;
+
+    /**
+     * \return the estimated time in nanoseconds needed to composite
+     * \p numLayers layers in \p rc, or 0 if there is no estimation yet
+     */
+    qreal estimatedCost(const QRect &rc, int numLayers) const;
+
+    /**
+     * \return the number of layers that are composited when \p node
+     * is updated. The merge walker recomposites all the siblings of the
+     * node and of its parents, the full refresh walker additionally
+     * recomposites the whole subtree of the node.
+     */
+    static int numCompositedLayers(KisNodeSP node, bool isFullRefresh);
+
+private:
+    Q_DISABLE_COPY(KisMergeCostEstimator)
+
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISMERGECOSTESTIMATOR_H
@@ -0,0 +1,42 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisSwapOutToBudgetJob.h"
+#include "kis_layer_utils.h"
+#include "kis_node.h"
+
+KisSwapOutToBudgetJob::KisSwapOutToBudgetJob(KisNodeSP rootNode, qint64 budget)
+    : m_rootNode(rootNode),
+      m_budget(budget)
+{
+    setExclusive(true);
+}
+
+bool KisSwapOutToBudgetJob::overrides(const KisSpontaneousJob *_otherJob)
+{
+    const KisSwapOutToBudgetJob *otherJob =
+        dynamic_cast<const KisSwapOutToBudgetJob*>(_otherJob);
+
+    return otherJob &&
+        otherJob->m_rootNode == m_rootNode;
+}
+
+void KisSwapOutToBudgetJob::run()
+{
+    KisNodeSP rootNode = m_rootNode;
+    if (rootNode) {
+        KisLayerUtils::recursiveSwapOutToBudget(rootNode, m_budget);
+    }
+}
+
+int KisSwapOutToBudgetJob::levelOfDetail() const
+{
+    return 0;
+}
+
+QString KisSwapOutToBudgetJob::debugName() const
+{
+    return "KisSwapOutToBudgetJob";
+}
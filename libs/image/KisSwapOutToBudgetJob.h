@@ -0,0 +1,37 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISSWAPOUTTOBUDGETJOB_H
+#define KISSWAPOUTTOBUDGETJOB_H
+
+#include "kis_types.h"
+#include "kis_spontaneous_job.h"
+
+/**
+ * A job for collecting the tile data of all the nodes of an image
+ * and requesting the swapper to evict the least recently used of them
+ * until the image fits into the memory budget, \see
+ * KisLayerUtils::recursiveSwapOutToBudget(). Walking through the
+ * nodes and their tiles takes quite a lot of time for big images, so
+ * it is done by the image's workers instead of the GUI thread. The
+ * job is exclusive to ensure the nodes are not changed meanwhile.
+ */
+class KRITAIMAGE_EXPORT KisSwapOutToBudgetJob : public KisSpontaneousJob
+{
+public:
+    KisSwapOutToBudgetJob(KisNodeSP rootNode, qint64 budget);
+
+    bool overrides(const KisSpontaneousJob *otherJob) override;
+    void run() override;
+    int levelOfDetail() const override;
+
+    QString debugName() const override;
+
+private:
+    KisNodeWSP m_rootNode;
+    qint64 m_budget;
+};
+
+#endif // KISSWAPOUTTOBUDGETJOB_H
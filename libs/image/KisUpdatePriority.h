@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISUPDATEPRIORITY_H
+#define KISUPDATEPRIORITY_H
+
+/**
+ * The order in which KisSimpleUpdateQueue processes the update jobs.
+ * The priority of a job is defined by its position relative to the
+ * priority rect, which is usually the visible area of the canvas.
+ *
+ * When no priority rect is set, all the updates are considered
+ * visible and are processed in the order they were added.
+ *
+ * \see KisImage::setUpdatesPriorityRect()
+ */
+enum class KisUpdatePriority : int
+{
+    Visible = 0,    ///< the updates intersecting the priority rect
+    LevelOfDetail,  ///< the offscreen updates of the level-of-detail plane
+    Offscreen       ///< all the other updates
+};
+
+#endif // KISUPDATEPRIORITY_H
@@ -0,0 +1,246 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisWorkStealingThreadPool.h"
+
+#include <atomic>
+#include <deque>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "kis_assert.h"
+
+struct KisWorkStealingThreadPool::Private
+{
+    struct Worker;
+
+    QVector<Worker*> workers;
+
+    /**
+     * The lock guards the sleeping/waking of the workers and the
+     * `quit` flag. It is never held together with any of the queue
+     * locks.
+     */
+    QMutex sleepLock;
+    QWaitCondition wakeCondition;
+    QWaitCondition doneCondition;
+    int numSleepingWorkers = 0;
+    bool quit = false;
+
+    /**
+     * The number of jobs sitting in the queues, i.e. the jobs that
+     * have been started, but not yet taken by any worker
+     */
+    std::atomic<int> numPendingJobs {0};
+
+    /**
+     * The number of jobs that have been started, but not yet
+     * completed. Used by waitForDone()
+     */
+    std::atomic<int> numUnfinishedJobs {0};
+
+    std::atomic<unsigned int> nextQueue {0};
+
+    QRunnable* takeJob(int index);
+    void jobCompleted();
+
+    void startWorkers(int count);
+    void stopWorkers();
+};
+
+struct KisWorkStealingThreadPool::Private::Worker : public QThread
+{
+    Worker(Private *_pool, int _index)
+        : pool(_pool),
+          index(_index)
+    {
+    }
+
+    void run() override;
+
+    Private *pool;
+    const int index;
+
+    QMutex queueLock;
+    std::deque<QRunnable*> queue;
+};
+
+void KisWorkStealingThreadPool::Private::Worker::run()
+{
+    while (1) {
+        QRunnable *job = pool->takeJob(index);
+
+        if (job) {
+            // the runnable may be restarted and even deleted by someone
+            // else right after run() returns, so don't touch it after that
+            const bool autoDelete = job->autoDelete();
+            job->run();
+            if (autoDelete) {
+                delete job;
+            }
+
+            pool->jobCompleted();
+            continue;
+        }
+
+        QMutexLocker l(&pool->sleepLock);
+
+        if (pool->quit) break;
+
+        /**
+         * The job might have been added after we checked the queues, but
+         * before we took the lock. The counter is incremented before the
+         * waker takes the lock, so we either see it here or are woken up.
+         */
+        if (pool->numPendingJobs > 0) continue;
+
+        pool->numSleepingWorkers++;
+        pool->wakeCondition.wait(&pool->sleepLock);
+        pool->numSleepingWorkers--;
+    }
+}
+
+QRunnable* KisWorkStealingThreadPool::Private::takeJob(int index)
+{
+    QRunnable *job = 0;
+
+    {
+        Worker *self = workers[index];
+        QMutexLocker l(&self->queueLock);
+
+        if (!self->queue.empty()) {
+            job = self->queue.back();
+            self->queue.pop_back();
+        }
+    }
+
+    for (int i = 1; !job && i < workers.size(); i++) {
+        Worker *victim = workers[(index + i) % workers.size()];
+        QMutexLocker l(&victim->queueLock);
+
+        if (!victim->queue.empty()) {
+            job = victim->queue.front();
+            victim->queue.pop_front();
+        }
+    }
+
+    if (job) {
+        numPendingJobs--;
+    }
+
+    return job;
+}
+
+void KisWorkStealingThreadPool::Private::jobCompleted()
+{
+    if (numUnfinishedJobs.fetch_sub(1) == 1) {
+        QMutexLocker l(&sleepLock);
+        doneCondition.wakeAll();
+    }
+}
+
+void KisWorkStealingThreadPool::Private::startWorkers(int count)
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(workers.isEmpty());
+
+    for (int i = 0; i < count; i++) {
+        workers.append(new Worker(this, i));
+    }
+
+    Q_FOREACH (Worker *worker, workers) {
+        worker->start();
+    }
+}
+
+void KisWorkStealingThreadPool::Private::stopWorkers()
+{
+    {
+        QMutexLocker l(&sleepLock);
+        quit = true;
+        wakeCondition.wakeAll();
+    }
+
+    Q_FOREACH (Worker *worker, workers) {
+        worker->wait();
+    }
+
+    qDeleteAll(workers);
+    workers.clear();
+
+    quit = false;
+}
+
+KisWorkStealingThreadPool::KisWorkStealingThreadPool(int maxThreadCount)
+    : m_d(new Private)
+{
+    m_d->startWorkers(qMax(1, maxThreadCount));
+}
+
+KisWorkStealingThreadPool::~KisWorkStealingThreadPool()
+{
+    waitForDone();
+    m_d->stopWorkers();
+}
+
+void KisWorkStealingThreadPool::start(QRunnable *runnable)
+{
+    /**
+     * The jobs started by the worker itself (which happens when a job
+     * item schedules new jobs on completion) go into its own queue,
+     * so the other workers will steal them
+     */
+    Private::Worker *self = dynamic_cast<Private::Worker*>(QThread::currentThread());
+
+    const int index =
+        self && self->pool == m_d.data() ?
+            self->index :
+            int(m_d->nextQueue++ % unsigned(m_d->workers.size()));
+
+    m_d->numUnfinishedJobs++;
+
+    {
+        Private::Worker *worker = m_d->workers[index];
+        QMutexLocker l(&worker->queueLock);
+        worker->queue.push_back(runnable);
+    }
+
+    m_d->numPendingJobs++;
+
+    QMutexLocker l(&m_d->sleepLock);
+    if (m_d->numSleepingWorkers > 0) {
+        m_d->wakeCondition.wakeOne();
+    }
+}
+
+void KisWorkStealingThreadPool::waitForDone()
+{
+    QMutexLocker l(&m_d->sleepLock);
+
+    while (m_d->numUnfinishedJobs > 0) {
+        m_d->doneCondition.wait(&m_d->sleepLock);
+    }
+}
+
+void KisWorkStealingThreadPool::setMaxThreadCount(int value)
+{
+    value = qMax(1, value);
+    if (value == m_d->workers.size()) return;
+
+    KIS_SAFE_ASSERT_RECOVER_NOOP(m_d->numUnfinishedJobs == 0);
+
+    m_d->stopWorkers();
+    m_d->startWorkers(value);
+}
+
+int KisWorkStealingThreadPool::maxThreadCount() const
+{
+    return m_d->workers.size();
+}
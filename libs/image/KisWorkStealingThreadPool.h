@@ -0,0 +1,65 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISWORKSTEALINGTHREADPOOL_H
+#define KISWORKSTEALINGTHREADPOOL_H
+
+#include "kritaimage_export.h"
+
+#include <QScopedPointer>
+
+class QRunnable;
+
+/**
+ * A thread pool with a separate job queue for every worker thread.
+ *
+ * A job started from inside a worker thread is pushed into the
+ * queue of that very thread, jobs started from other threads are
+ * distributed over the queues in a round-robin manner. The owner
+ * of the queue takes the most recent job from it, while idle
+ * workers steal the oldest jobs from the queues of other threads.
+ *
+ * Unlike QThreadPool, the workers never touch a single shared
+ * queue, so adding and taking the jobs doesn't serialize all the
+ * threads on one mutex. The pool is used by KisUpdaterContext as
+ * an alternative to QThreadPool, it has a compatible subset of its
+ * interface.
+ *
+ * The pool doesn't know anything about the nature of the jobs,
+ * all the conflict checks must be done by the caller before
+ * starting a job.
+ */
+class KRITAIMAGE_EXPORT KisWorkStealingThreadPool
+{
+public:
+    KisWorkStealingThreadPool(int maxThreadCount);
+    ~KisWorkStealingThreadPool();
+
+    /**
+     * Adds \p runnable to the queue and wakes up an idle worker,
+     * if there is any. If runnable->autoDelete() is true, the
+     * runnable is deleted after completion.
+     */
+    void start(QRunnable *runnable);
+
+    /**
+     * Blocks until all the started jobs are completed
+     */
+    void waitForDone();
+
+    /**
+     * Recreates the worker threads. The pool must have no
+     * running or pending jobs.
+     */
+    void setMaxThreadCount(int value);
+    int maxThreadCount() const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISWORKSTEALINGTHREADPOOL_H
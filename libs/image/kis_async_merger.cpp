@@ -33,6 +33,7 @@
 #include "kis_refresh_subtree_walker.h"
 
 #include "kis_abstract_projection_plane.h"
+#include "KisBelowStackCache.h"
 
 
 //#define DEBUG_MERGER
@@ -203,11 +204,21 @@ private:
 /*                     KisAsyncMerger                                */
 /*********************************************************************/
 
+KisAsyncMerger::KisAsyncMerger()
+{
+}
+
+KisAsyncMerger::~KisAsyncMerger()
+{
+}
+
 void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
     KisMergeWalker::LeafStack &leafStack = walker.leafStack();
 
     const bool useTempProjections = walker.needRectVaries();
 
+    m_belowStackCacheStore = BelowStackCacheStore();
+
     while(!leafStack.isEmpty()) {
         KisMergeWalker::JobItem item = leafStack.pop();
         KisProjectionLeafSP currentLeaf = item.m_leaf;
@@ -246,6 +257,17 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 
         if (!m_currentProjection) {
             setupProjection(currentLeaf, applyRect, useTempProjections);
+
+            if (item.m_position & KisMergeWalker::N_BELOW_FILTHY &&
+                tryFetchBelowStackCache(walker, currentLeaf)) {
+
+                DEBUG_NODE_ACTION("Fetched below-stack cache", "", currentLeaf->parent(), applyRect);
+                continue;
+            }
+        }
+
+        if (currentLeaf == m_belowStackCacheStore.activeLeaf) {
+            storeBelowStackCache();
         }
 
         KisUpdateOriginalVisitor originalVisitor(applyRect,
@@ -279,6 +301,16 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
             /* nothing to do */
         }
 
+        if (!(item.m_position & KisMergeWalker::N_BELOW_FILTHY)) {
+            /**
+             * The projection of the leaf might have changed. Usually the
+             * caches are already invalidated by the dirty notification,
+             * but the update of a lower node may be processed after the
+             * update of the active one, which has just cached the old data.
+             */
+            KisBelowStackCache::notifyNodeDirty(currentLeaf->node().data());
+        }
+
         compositeWithProjection(currentLeaf, applyRect);
 
         if(item.m_position & KisMergeWalker::N_TOPMOST) {
@@ -361,6 +393,110 @@ bool KisAsyncMerger::compositeWithProjection(KisProjectionLeafSP leaf, const QRe
     return true;
 }
 
+bool KisAsyncMerger::tryFetchBelowStackCache(KisBaseRectsWalker &walker, KisProjectionLeafSP firstLeaf) {
+    if (!KisBelowStackCache::isEnabled()) return false;
+    if (!m_currentProjection) return false;
+
+    /**
+     * Full refresh walkers and LoD planes are not cached. The former
+     * may come after the layers have been changed without any
+     * notification, the latter would just thrash the cache.
+     */
+    if (walker.type() != KisBaseRectsWalker::UPDATE || walker.levelOfDetail() > 0) return false;
+
+    KisProjectionLeafSP parentLeaf = firstLeaf->parent();
+    KisGroupLayerSP group = qobject_cast<KisGroupLayer*>(parentLeaf->node().data());
+    if (!group) return false;
+
+    /**
+     * The children of pass-through groups are composited directly
+     * into the parent of the group. The cache cannot track their
+     * changes, so skip such stacks completely.
+     */
+    if (firstLeaf->node()->parent().data() != group.data()) return false;
+
+    /**
+     * The leaves of one group lie in the stack contiguously: the ones
+     * below the filthy node first, then the "active" leaf (the filthy
+     * node itself or the group containing it) and the ones above it.
+     */
+    KisMergeWalker::LeafStack &leafStack = walker.leafStack();
+    int activeIndex = -1;
+
+    for (int i = leafStack.size() - 1; i >= 0; i--) {
+        const KisMergeWalker::JobItem &item = leafStack[i];
+
+        if (item.m_leaf->parent() != parentLeaf ||
+            item.m_leaf->node()->parent().data() != group.data() ||
+            item.m_position & KisMergeWalker::N_EXTRA) {
+
+            return false;
+        }
+
+        if (!(item.m_position & KisMergeWalker::N_BELOW_FILTHY)) {
+            activeIndex = i;
+            break;
+        }
+    }
+
+    if (activeIndex < 0) return false;
+
+    /**
+     * The cache can replace the lower layers only if neither the
+     * active leaf nor the ones above it need anything outside the
+     * apply rect of the active leaf
+     */
+    const QRect rect = leafStack[activeIndex].m_applyRect;
+
+    for (int i = activeIndex; i >= 0; i--) {
+        const KisMergeWalker::JobItem &item = leafStack[i];
+
+        if (item.m_leaf->parent() != parentLeaf ||
+            !rect.contains(item.m_applyRect)) {
+
+            return false;
+        }
+
+        if (item.m_position & KisMergeWalker::N_TOPMOST) break;
+    }
+
+    KisProjectionLeafSP activeLeaf = leafStack[activeIndex].m_leaf;
+    const int graphSequenceNumber = group->graphSequenceNumber();
+    quint64 generation = 0;
+
+    if (group->belowStackCache()->fetch(activeLeaf->node().data(), rect,
+                                        m_currentProjection,
+                                        graphSequenceNumber, &generation)) {
+
+        while (leafStack.size() > activeIndex + 1) {
+            leafStack.pop();
+        }
+
+        return true;
+    }
+
+    m_belowStackCacheStore.group = group;
+    m_belowStackCacheStore.activeLeaf = activeLeaf;
+    m_belowStackCacheStore.rect = rect;
+    m_belowStackCacheStore.graphSequenceNumber = graphSequenceNumber;
+    m_belowStackCacheStore.generation = generation;
+
+    return false;
+}
+
+void KisAsyncMerger::storeBelowStackCache() {
+    if (m_currentProjection) {
+        m_belowStackCacheStore.group->belowStackCache()->store(
+            m_belowStackCacheStore.activeLeaf->node().data(),
+            m_belowStackCacheStore.rect,
+            m_currentProjection,
+            m_belowStackCacheStore.graphSequenceNumber,
+            m_belowStackCacheStore.generation);
+    }
+
+    m_belowStackCacheStore = BelowStackCacheStore();
+}
+
 void KisAsyncMerger::doNotifyClones(KisBaseRectsWalker &walker) {
     KisBaseRectsWalker::CloneNotificationsVector &vector =
         walker.cloneNotifications();
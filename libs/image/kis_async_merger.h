@@ -9,12 +9,16 @@
 #include "kritaimage_export.h"
 #include "kis_types.h"
 
-class QRect;
+#include <QRect>
+
 class KisBaseRectsWalker;
 
 class KRITAIMAGE_EXPORT KisAsyncMerger
 {
 public:
+    KisAsyncMerger();
+    ~KisAsyncMerger();
+
     void startMerge(KisBaseRectsWalker &walker, bool notifyClones = true);
 
 private:
@@ -23,6 +27,8 @@ private:
     inline void writeProjection(KisProjectionLeafSP topmostLeaf, bool useTempProjection, const QRect &rect);
     inline bool compositeWithProjection(KisProjectionLeafSP leaf, const QRect &rect);
     inline void doNotifyClones(KisBaseRectsWalker &walker);
+    bool tryFetchBelowStackCache(KisBaseRectsWalker &walker, KisProjectionLeafSP firstLeaf);
+    void storeBelowStackCache();
 
 private:
     /**
@@ -49,6 +55,22 @@ private:
      * setupProjection()
      */
     KisPaintDeviceSP m_cachedPaintDevice;
+
+    /**
+     * When the composition of the layers below the active one is
+     * not found in the group's KisBelowStackCache, the merger
+     * composites them as usual and saves the result right before
+     * processing the active leaf
+     */
+    struct BelowStackCacheStore {
+        KisGroupLayerSP group;
+        KisProjectionLeafSP activeLeaf;
+        QRect rect;
+        int graphSequenceNumber = -1;
+        quint64 generation = 0;
+    };
+
+    BelowStackCacheStore m_belowStackCacheStore;
 };
 
 
@@ -11,6 +11,12 @@
 #include "kis_convolution_worker.h"
 #include "kis_math_toolbox.h"
 
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 template <class _IteratorFactory_>
 class KisConvolutionWorkerSpatial : public KisConvolutionWorker<_IteratorFactory_>
 {
@@ -21,6 +27,7 @@ public:
         ,  m_alphaRealPos(-1)
         ,  m_pixelPtrCache(0)
         ,  m_pixelPtrCacheCopy(0)
+        ,  m_interimConvoResults(0)
         ,  m_minClamp(0)
         ,  m_maxClamp(0)
         ,  m_absoluteOffset(0)
@@ -121,6 +128,7 @@ public:
             return;
 
         m_kernelFactor = kernel->factor() ? 1.0 / kernel->factor() : 1;
+        m_interimConvoResults = new qreal[m_convChannelList.count()];
         m_maxClamp = new qreal[m_convChannelList.count()];
         m_minClamp = new qreal[m_convChannelList.count()];
         m_absoluteOffset = new qreal[m_convChannelList.count()];
@@ -247,14 +255,40 @@ public:
         }
     }
 
-    template <bool additionalMultiplierActive>
-    inline qreal convolveOneChannelFromCache(quint8* dstPtr, quint32 channel, qreal additionalMultiplier = 0.0) {
-        qreal interimConvoResult = 0;
+    /**
+     * Convolves all the channels at once. The channels of a cached
+     * pixel are stored contiguously, so the loop over them can use
+     * SIMD, while every channel is still summed up in the same order
+     * as before, that is the results don't change.
+     */
+    inline void convolveAllChannelsFromCache() {
+        qreal *results = m_interimConvoResults;
+        std::fill(results, results + m_convolveChannelsNo, 0.0);
 
         for (quint32 pIndex = 0; pIndex < m_cacheSize; ++pIndex) {
-            qreal cacheValue = m_pixelPtrCache[pIndex][channel];
-            interimConvoResult += m_kernelData[m_cacheSize - pIndex - 1] * cacheValue;
+            const qreal kernelValue = m_kernelData[m_cacheSize - pIndex - 1];
+            const qreal *cacheValues = m_pixelPtrCache[pIndex];
+
+            quint32 k = 0;
+
+#ifdef __SSE2__
+            const __m128d kernelValues = _mm_set1_pd(kernelValue);
+
+            for (; k + 2 <= m_convolveChannelsNo; k += 2) {
+                const __m128d products = _mm_mul_pd(kernelValues, _mm_loadu_pd(cacheValues + k));
+                _mm_storeu_pd(results + k, _mm_add_pd(_mm_loadu_pd(results + k), products));
+            }
+#endif
+
+            for (; k < m_convolveChannelsNo; ++k) {
+                results[k] += kernelValue * cacheValues[k];
+            }
         }
+    }
+
+    template <bool additionalMultiplierActive>
+    inline qreal convolveOneChannelFromCache(quint8* dstPtr, quint32 channel, qreal additionalMultiplier = 0.0) {
+        const qreal interimConvoResult = m_interimConvoResults[channel];
 
         qreal channelPixelValue;
         if (additionalMultiplierActive) {
@@ -272,6 +306,8 @@ public:
     }
 
     inline void convolveCache(quint8* dstPtr) {
+        convolveAllChannelsFromCache();
+
         if (m_alphaCachePos >= 0) {
             qreal alphaValue = convolveOneChannelFromCache<false>(dstPtr, m_alphaCachePos);
 
@@ -346,6 +382,7 @@ public:
         delete[] m_pixelPtrCache;
         delete[] m_pixelPtrCacheCopy;
 
+        delete[] m_interimConvoResults;
         delete[] m_minClamp;
         delete[] m_maxClamp;
         delete[] m_absoluteOffset;
@@ -362,6 +399,7 @@ private:
 
     qreal *m_kernelData;
     qreal** m_pixelPtrCache, ** m_pixelPtrCacheCopy;
+    qreal* m_interimConvoResults;
     qreal* m_minClamp, *m_maxClamp, *m_absoluteOffset;
 
     qreal m_kernelFactor;
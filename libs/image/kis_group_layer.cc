@@ -25,6 +25,7 @@
 #include "kis_selection_mask.h"
 #include "kis_psd_layer_style.h"
 #include "kis_layer_properties_icons.h"
+#include "KisBelowStackCache.h"
 
 
 struct Q_DECL_HIDDEN KisGroupLayer::Private
@@ -42,6 +43,7 @@ public:
     qint32 x;
     qint32 y;
     bool passThroughMode;
+    KisBelowStackCache belowStackCache;
 };
 
 KisGroupLayer::KisGroupLayer(KisImageWSP image, const QString &name, quint8 opacity) :
@@ -205,6 +207,8 @@ void KisGroupLayer::resetCache(const KoColorSpace *colorSpace)
 
         m_d->paintDevice->clear();
     }
+
+    m_d->belowStackCache.invalidate();
 }
 
 KisLayer* KisGroupLayer::onlyMeaningfulChild() const
@@ -286,9 +290,15 @@ bool KisGroupLayer::projectionIsValid() const
     return !tryObligeChild();
 }
 
+KisBelowStackCache* KisGroupLayer::belowStackCache() const
+{
+    return &m_d->belowStackCache;
+}
+
 void KisGroupLayer::setDefaultProjectionColor(KoColor color)
 {
     m_d->paintDevice->setDefaultPixel(color);
+    m_d->belowStackCache.invalidate();
 }
 
 KoColor KisGroupLayer::defaultProjectionColor() const
@@ -307,6 +317,7 @@ void KisGroupLayer::setPassThroughMode(bool value)
     if (m_d->passThroughMode == value) return;
 
     m_d->passThroughMode = value;
+    m_d->belowStackCache.invalidate();
 
     baseNodeChangedCallback();
     baseNodeInvalidateAllFramesCallback();
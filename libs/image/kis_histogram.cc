@@ -15,6 +15,7 @@
 #include "KoColorSpace.h"
 #include "kis_debug.h"
 #include "kis_iterator_ng.h"
+#include "KoOptimizedHistogramAccumulatorFactory.h"
 
 KisHistogram::KisHistogram(const KisPaintLayerSP layer,
                            KoHistogramProducer *producer,
@@ -73,7 +74,6 @@ void KisHistogram::updateHistogram()
         return;
     }
 
-    KisSequentialConstIterator srcIt(m_paintDevice, m_bounds);
     const KoColorSpace* cs = m_paintDevice->colorSpace();
 
     // Let the producer do it's work
@@ -85,14 +85,69 @@ void KisHistogram::updateHistogram()
     //      explicit selection to the createRectIterator call, that broke because
     //      paint devices didn't know about their selections anymore.
     //      updateHistogram should get a selection parameter.
+    if (m_producer->canAddAccumulatedBins(cs)) {
+        updateHistogramOptimized(cs);
+    } else {
+        KisSequentialConstIterator srcIt(m_paintDevice, m_bounds);
+
+        int numConseqPixels = srcIt.nConseqPixels();
+        while (srcIt.nextPixels(numConseqPixels)) {
+
+            numConseqPixels = srcIt.nConseqPixels();
+            m_producer->addRegionToBin(srcIt.oldRawData(), 0, numConseqPixels, cs);
+        }
+    }
+
+    computeHistogram();
+}
+
+void KisHistogram::updateHistogramOptimized(const KoColorSpace *cs)
+{
+    KisSequentialConstIterator srcIt(m_paintDevice, m_bounds);
+
+    QScopedPointer<KoOptimizedHistogramAccumulatorBase> accumulator(
+        KoOptimizedHistogramAccumulatorFactory::create(cs));
+
+    const int pixelSize = cs->pixelSize();
+    const bool skipTransparent = m_producer->skipTransparent();
+
+    QVector<quint8> opacity;
+    quint32 numCountedPixels = 0;
+
     int numConseqPixels = srcIt.nConseqPixels();
     while (srcIt.nextPixels(numConseqPixels)) {
 
         numConseqPixels = srcIt.nConseqPixels();
-        m_producer->addRegionToBin(srcIt.oldRawData(), 0, numConseqPixels, cs);
+        const quint8 *pixels = srcIt.oldRawData();
+
+        if (!skipTransparent) {
+            accumulator->accumulate(pixels, pixelSize, numConseqPixels);
+            numCountedPixels += numConseqPixels;
+            continue;
+        }
+
+        /**
+         * Count the runs of non-transparent pixels, the same way
+         * the producer would skip the transparent ones
+         */
+        opacity.resize(numConseqPixels);
+        cs->copyOpacityU8(const_cast<quint8*>(pixels), opacity.data(), numConseqPixels);
+
+        int i = 0;
+        while (i < numConseqPixels) {
+            while (i < numConseqPixels && opacity[i] == OPACITY_TRANSPARENT_U8) i++;
+
+            const int runStart = i;
+            while (i < numConseqPixels && opacity[i] != OPACITY_TRANSPARENT_U8) i++;
+
+            if (i > runStart) {
+                accumulator->accumulate(pixels + runStart * pixelSize, pixelSize, i - runStart);
+                numCountedPixels += i - runStart;
+            }
+        }
     }
 
-    computeHistogram();
+    m_producer->addAccumulatedBins(*accumulator, numCountedPixels);
 }
 
 void KisHistogram::computeHistogram()
@@ -170,6 +170,12 @@ public:
 
 
 private:
+    /**
+     * Counts the pixels with KoOptimizedHistogramAccumulator, used when
+     * the producer supports that, \see KoHistogramProducer::canAddAccumulatedBins()
+     */
+    void updateHistogramOptimized(const KoColorSpace *cs);
+
     // Dump the histogram to debug.
     void dump();
     QVector<Calculations> calculateForRange(double from, double to);
@@ -100,6 +100,7 @@
 #include "KisRunnableStrokeJobsInterface.h"
 
 #include "KisBusyWaitBroker.h"
+#include "KisBelowStackCache.h"
 
 
 // #define SANITY_CHECKS
@@ -566,6 +567,7 @@ void KisImage::aboutToRemoveANode(KisNode *parent, int index)
 void KisImage::nodeChanged(KisNode* node)
 {
     KisNodeGraphListener::nodeChanged(node);
+    KisBelowStackCache::notifyNodeDirty(node);
     requestStrokeEnd();
     m_d->signalRouter.emitNodeChanged(node);
 }
@@ -1809,6 +1811,23 @@ void KisImage::waitForDone()
     KisBusyWaitBroker::instance()->notifyWaitOnImageEnded(this);
 }
 
+void KisImage::waitForUpdates(KisUpdatePriority priority)
+{
+    KisBusyWaitBroker::instance()->notifyWaitOnImageStarted(this);
+    m_d->scheduler.waitForUpdates(priority);
+    KisBusyWaitBroker::instance()->notifyWaitOnImageEnded(this);
+}
+
+void KisImage::setUpdatesPriorityRect(const QRect &rc)
+{
+    m_d->scheduler.setUpdatesPriorityRect(rc);
+}
+
+QRect KisImage::updatesPriorityRect() const
+{
+    return m_d->scheduler.updatesPriorityRect();
+}
+
 KisStrokeId KisImage::startStroke(KisStrokeStrategy *strokeStrategy)
 {
     /**
@@ -2071,6 +2090,7 @@ void KisImage::refreshGraph(KisNodeSP root, const QRect &rc, const QRect &cropRe
 {
     if (!root) root = m_d->rootLayer;
 
+    KisBelowStackCache::notifySubtreeRefreshed(root.data());
     m_d->animationInterface->notifyNodeChanged(root.data(), rc, true);
     m_d->scheduler.fullRefresh(root, rc, cropRect);
 }
@@ -2105,6 +2125,8 @@ void KisImage::refreshGraphAsync(KisNodeSP root, const QVector<QRect> &rects, co
 {
     if (!root) root = m_d->rootLayer;
 
+    KisBelowStackCache::notifySubtreeRefreshed(root.data());
+
     /**
      * We iterate through the filters in a reversed way. It makes the most nested filters
      * to execute first.
@@ -2140,6 +2162,8 @@ void KisImage::requestProjectionUpdateNoFilthy(KisNodeSP pseudoFilthy, const QVe
 {
     KIS_ASSERT_RECOVER_RETURN(pseudoFilthy);
 
+    KisBelowStackCache::notifyNodeDirty(pseudoFilthy.data());
+
     /**
      * We iterate through the filters in a reversed way. It makes the most nested filters
      * to execute first.
@@ -2307,6 +2331,12 @@ void KisImage::requestProjectionUpdateImpl(KisNode *node,
 
 void KisImage::requestProjectionUpdate(KisNode *node, const QVector<QRect> &rects, bool resetAnimationCache)
 {
+    /**
+     * The cache must be invalidated even if the update itself is
+     * filtered out, the filters will issue a refresh later
+     */
+    KisBelowStackCache::notifyNodeDirty(node);
+
     /**
      * We iterate through the filters in a reversed way. It makes the most nested filters
      * to execute first.
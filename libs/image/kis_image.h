@@ -22,6 +22,7 @@
 #include "kis_image_interfaces.h"
 #include "kis_strokes_queue_undo_result.h"
 #include "KisLodPreferences.h"
+#include "KisUpdatePriority.h"
 
 #include <kritaimage_export.h>
 
@@ -991,6 +992,29 @@ public Q_SLOTS:
      */
     void waitForDone();
 
+    /**
+     * Wait until the updates of \p priority and of the more important
+     * priorities are complete. Unlike waitForDone(), doesn't end the
+     * current stroke and doesn't wait for the queued strokes.
+     *
+     * The updates are not processed while an exclusive stroke is
+     * running. If such a stroke is opened and has no jobs to execute,
+     * the function returns without waiting for the updates, so end the
+     * stroke first if you need them to complete.
+     *
+     * \see setUpdatesPriorityRect()
+     */
+    void waitForUpdates(KisUpdatePriority priority = KisUpdatePriority::Offscreen);
+
+    /**
+     * Set the rect whose updates should be processed before the
+     * others, usually the visible area of the canvas. The updates of
+     * the level-of-detail plane go next, the offscreen updates go in
+     * the end. An empty rect disables the prioritization.
+     */
+    void setUpdatesPriorityRect(const QRect &rc);
+    QRect updatesPriorityRect() const;
+
     KisStrokeId startStroke(KisStrokeStrategy *strokeStrategy) override;
     void addJob(KisStrokeId id, KisStrokeJobData *data) override;
     void endStroke(KisStrokeId id) override;
@@ -22,6 +22,7 @@
 #include <QDir>
 
 #include "kis_global.h"
+#include "tiles3/swap/kis_compression_factory.h"
 #include <cmath>
 #include <QTemporaryFile>
 
@@ -167,6 +168,97 @@ void KisImageConfig::setSwapWindowSize(int value)
     m_config.writeEntry("swapWindowSize", value);
 }
 
+bool KisImageConfig::useMappedSwapFile(bool requestDefault) const
+{
+#if defined(Q_OS_UNIX) && QT_POINTER_SIZE == 8
+    const bool defaultValue = true;
+#else
+    const bool defaultValue = false;
+#endif
+
+    return !requestDefault ?
+        m_config.readEntry("useMappedSwapFile", defaultValue) : defaultValue;
+}
+
+void KisImageConfig::setUseMappedSwapFile(bool value)
+{
+    m_config.writeEntry("useMappedSwapFile", value);
+}
+
+QString KisImageConfig::swapCompression(bool requestDefault) const
+{
+    const QString defaultValue = KisCompressionFactory::fastestCompression();
+
+    const QString value = !requestDefault ?
+        m_config.readEntry("swapCompression", defaultValue) : defaultValue;
+
+    return KisCompressionFactory::isAvailable(value) ? value : defaultValue;
+}
+
+void KisImageConfig::setSwapCompression(const QString &value)
+{
+    m_config.writeEntry("swapCompression", value);
+}
+
+QString KisImageConfig::saveCompression(bool requestDefault) const
+{
+    const QString defaultValue = KisCompressionFactory::legacyCompression();
+
+    const QString value = !requestDefault ?
+        m_config.readEntry("saveCompression", defaultValue) : defaultValue;
+
+    return KisCompressionFactory::isAvailable(value) ? value : defaultValue;
+}
+
+void KisImageConfig::setSaveCompression(const QString &value)
+{
+    m_config.writeEntry("saveCompression", value);
+}
+
+bool KisImageConfig::enableParallelTileSaving(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("enableParallelTileSaving", true) : true;
+}
+
+void KisImageConfig::setEnableParallelTileSaving(bool value)
+{
+    m_config.writeEntry("enableParallelTileSaving", value);
+}
+
+bool KisImageConfig::enableTileDeduplication(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("enableTileDeduplication", false) : false;
+}
+
+void KisImageConfig::setEnableTileDeduplication(bool value)
+{
+    m_config.writeEntry("enableTileDeduplication", value);
+}
+
+bool KisImageConfig::enableConstantTiles(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("enableConstantTiles", true) : true;
+}
+
+void KisImageConfig::setEnableConstantTiles(bool value)
+{
+    m_config.writeEntry("enableConstantTiles", value);
+}
+
+int KisImageConfig::backgroundDocumentMemoryBudget(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("backgroundDocumentMemoryBudget", 0) : 0;
+}
+
+void KisImageConfig::setBackgroundDocumentMemoryBudget(int value)
+{
+    m_config.writeEntry("backgroundDocumentMemoryBudget", value);
+}
+
 int KisImageConfig::tilesHardLimit() const
 {
     qreal hp = qreal(memoryHardLimitPercent()) / 100.0;
@@ -544,6 +636,36 @@ void KisImageConfig::setMaxNumberOfThreads(int value)
     }
 }
 
+bool KisImageConfig::useWorkStealingScheduler(bool defaultValue) const
+{
+    return (defaultValue ? false : m_config.readEntry("useWorkStealingScheduler", false));
+}
+
+void KisImageConfig::setUseWorkStealingScheduler(bool value)
+{
+    m_config.writeEntry("useWorkStealingScheduler", value);
+}
+
+bool KisImageConfig::useBelowStackCache(bool defaultValue) const
+{
+    return (defaultValue ? false : m_config.readEntry("useBelowStackCache", false));
+}
+
+void KisImageConfig::setUseBelowStackCache(bool value)
+{
+    m_config.writeEntry("useBelowStackCache", value);
+}
+
+bool KisImageConfig::useAdaptiveUpdatePatchSize(bool defaultValue) const
+{
+    return (defaultValue ? true : m_config.readEntry("useAdaptiveUpdatePatchSize", true));
+}
+
+void KisImageConfig::setUseAdaptiveUpdatePatchSize(bool value)
+{
+    m_config.writeEntry("useAdaptiveUpdatePatchSize", value);
+}
+
 int KisImageConfig::frameRenderingClones(bool defaultValue) const
 {
     const int defaultClonesCount = qMax(1, maxNumberOfThreads(defaultValue) / 2);
@@ -46,6 +46,64 @@ public:
     int swapWindowSize() const;
     void setSwapWindowSize(int value);
 
+    /**
+     * When enabled, the whole swap file is mapped into the address
+     * space at once and swapping never causes remapping. Available
+     * on 64-bit Unix systems only, on other platforms the windowed
+     * swap space is used regardless of this setting.
+     */
+    bool useMappedSwapFile(bool requestDefault = false) const;
+    void setUseMappedSwapFile(bool value);
+
+    /**
+     * Name of the codec used for compressing tiles in the swap file.
+     * \see KisCompressionFactory
+     */
+    QString swapCompression(bool requestDefault = false) const;
+    void setSwapCompression(const QString &value);
+
+    /**
+     * Name of the codec used for compressing tiles of the layers
+     * saved into .kra files. The default one is readable by all
+     * versions of Krita.
+     * \see KisCompressionFactory
+     */
+    QString saveCompression(bool requestDefault = false) const;
+    void setSaveCompression(const QString &value);
+
+    /**
+     * When enabled, the tiles of big paint devices are compressed
+     * on the global thread pool while saving. The resulting file
+     * is byte-identical to the one saved serially.
+     */
+    bool enableParallelTileSaving(bool requestDefault = false) const;
+    void setEnableParallelTileSaving(bool value);
+
+    /**
+     * When enabled, byte-identical tiles of the loaded layers are
+     * merged into a single copy-on-write tile data, even if they
+     * belong to different layers or documents.
+     */
+    bool enableTileDeduplication(bool requestDefault = false) const;
+    void setEnableTileDeduplication(bool value);
+
+    /**
+     * When enabled, the tiles whose pixels are all the same are stored
+     * as a single row of pixels until they are written into.
+     */
+    bool enableConstantTiles(bool requestDefault = false) const;
+    void setEnableConstantTiles(bool value);
+
+    /**
+     * The amount of memory (in MiB) the pixel data of a document may
+     * keep in RAM while the document is not active. The least recently
+     * used tiles of the inactive documents are swapped out to stay
+     * within the budget. Zero means the budget is unlimited. This is
+     * the default value, every document may have its own budget.
+     */
+    int backgroundDocumentMemoryBudget(bool requestDefault = false) const;
+    void setBackgroundDocumentMemoryBudget(int value);
+
     int tilesHardLimit() const; // MiB
     int tilesSoftLimit() const; // MiB
     int poolLimit() const; // MiB
@@ -105,6 +163,15 @@ public:
     int maxNumberOfThreads(bool defaultValue = false) const;
     void setMaxNumberOfThreads(int value);
 
+    bool useWorkStealingScheduler(bool defaultValue = false) const;
+    void setUseWorkStealingScheduler(bool value);
+
+    bool useBelowStackCache(bool defaultValue = false) const;
+    void setUseBelowStackCache(bool value);
+
+    bool useAdaptiveUpdatePatchSize(bool defaultValue = false) const;
+    void setUseAdaptiveUpdatePatchSize(bool value);
+
     int frameRenderingClones(bool defaultValue = false) const;
     void setFrameRenderingClones(int value);
 
@@ -51,6 +51,8 @@
 #include "kis_transparency_mask.h"
 #include "kis_paint_device_frames_interface.h"
 #include "kis_command_ids.h"
+#include "kis_datamanager.h"
+#include "tiles3/kis_tile_data_store.h"
 
 
 namespace KisLayerUtils {
@@ -2094,6 +2096,43 @@ namespace KisLayerUtils {
         return exactBounds;
     }
 
+    void recursivePrefetchRect(KisNodeSP rootNode, const QRect &rect)
+    {
+        recursiveApplyNodes(rootNode, [rect] (KisNodeSP node) {
+            KisPaintDeviceSP device = node->paintDevice();
+            KisPaintDeviceSP projection = node->projection();
+
+            if (device) {
+                device->prefetchRect(rect);
+            }
+
+            if (projection && projection != device) {
+                projection->prefetchRect(rect);
+            }
+        });
+    }
+
+    void recursiveSwapOutToBudget(KisNodeSP rootNode, qint64 budget)
+    {
+        QSet<KisPaintDevice*> devices;
+        QVector<KisTileData*> tileDataList;
+
+        auto addDevice = [&devices, &tileDataList] (KisPaintDeviceSP device) {
+            if (device && !devices.contains(device.data())) {
+                devices.insert(device.data());
+                device->dataManager()->collectTileData(tileDataList);
+            }
+        };
+
+        recursiveApplyNodes(rootNode, [addDevice] (KisNodeSP node) {
+            addDevice(node->paintDevice());
+            addDevice(node->original());
+            addDevice(node->projection());
+        });
+
+        KisTileDataStore::instance()->requestSwapOutLeastRecentlyUsed(tileDataList, budget);
+    }
+
     KisNodeSP findRoot(KisNodeSP node)
     {
         if (!node) return node;
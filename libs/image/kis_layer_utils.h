@@ -35,6 +35,21 @@ namespace KisLayerUtils
     KRITAIMAGE_EXPORT void refreshHiddenAreaAsync(KisImageSP image, KisNodeSP rootNode, const QRect &preparedArea);
     KRITAIMAGE_EXPORT QRect recursiveTightNodeVisibleBounds(KisNodeSP rootNode);
 
+    /**
+     * Asks all the paint devices of \p rootNode and its children to load
+     * \p rect back from the swap in the background, since it is going to
+     * be accessed soon (e.g. it becomes visible or a stroke approaches it)
+     */
+    KRITAIMAGE_EXPORT void recursivePrefetchRect(KisNodeSP rootNode, const QRect &rect);
+
+    /**
+     * Requests swapping out the least recently used tiles of all the
+     * paint devices of \p rootNode and its children, until their pixel
+     * data kept in RAM fits into \p budget bytes. The tiles are
+     * collected right away, but swapped out later in the swapper thread.
+     */
+    KRITAIMAGE_EXPORT void recursiveSwapOutToBudget(KisNodeSP rootNode, qint64 budget);
+
     /**
      * Returns true if:
      *     o \p node is a clone of some layer in \p nodes
@@ -12,6 +12,8 @@
 #include "kis_image.h"
 #include "kis_image_config.h"
 #include "kis_signal_compressor.h"
+#include "kis_group_layer.h"
+#include "KisBelowStackCache.h"
 
 #include "tiles3/kis_tile_data_store.h"
 
@@ -83,7 +85,8 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
                                       QSet<KisPaintDevice*> &devices,
                                       qint64 &layersSize,
                                       qint64 &projectionsSize,
-                                      qint64 &lodSize)
+                                      qint64 &lodSize,
+                                      qint64 &belowStackCacheSize)
 {
     qint64 memBound = 0;
 
@@ -96,10 +99,21 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
     addDevice(node->original(), originalIsProjection, devices, memBound, layersSize, projectionsSize, lodSize);
     addDevice(node->projection(), true, devices, memBound, layersSize, projectionsSize, lodSize);
 
+    KisGroupLayer *group = qobject_cast<KisGroupLayer*>(node.data());
+    if (group) {
+        qint64 cacheSize = 0;
+        qint64 dummyLayersSize = 0;
+        qint64 dummyLodSize = 0;
+
+        addDevice(group->belowStackCache()->device(), true, devices, cacheSize, dummyLayersSize, belowStackCacheSize, dummyLodSize);
+        memBound += cacheSize;
+    }
+
     node = node->firstChild();
     while (node) {
         memBound += calculateNodeMemoryHiBoundStep(node, devices,
-                                                   layersSize, projectionsSize, lodSize);
+                                                   layersSize, projectionsSize, lodSize,
+                                                   belowStackCacheSize);
         node = node->nextSibling();
     }
 
@@ -109,18 +123,21 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
 qint64 calculateNodeMemoryHiBound(KisNodeSP node,
                                   qint64 &layersSize,
                                   qint64 &projectionsSize,
-                                  qint64 &lodSize)
+                                  qint64 &lodSize,
+                                  qint64 &belowStackCacheSize)
 {
     layersSize = 0;
     projectionsSize = 0;
     lodSize = 0;
+    belowStackCacheSize = 0;
 
     QSet<KisPaintDevice*> devices;
     return calculateNodeMemoryHiBoundStep(node,
                                           devices,
                                           layersSize,
                                           projectionsSize,
-                                          lodSize);
+                                          lodSize,
+                                          belowStackCacheSize);
 }
 
 
@@ -136,7 +153,8 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
             calculateNodeMemoryHiBound(image->root(),
                                        stats.layersSize,
                                        stats.projectionsSize,
-                                       stats.lodSize);
+                                       stats.lodSize,
+                                       stats.belowStackCacheSize);
     }
     stats.totalMemorySize = tileStats.totalMemorySize;
     stats.realMemorySize = tileStats.realMemorySize;
@@ -144,6 +162,12 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
     stats.poolSize = tileStats.poolSize;
 
     stats.swapSize = tileStats.swapSize;
+    stats.swapRemapsCount = tileStats.swapRemapsCount;
+    stats.swapInCount = tileStats.swapInCount;
+    stats.swapOutCount = tileStats.swapOutCount;
+    stats.prefetchedCount = tileStats.prefetchedCount;
+    stats.budgetEvictionsCount = tileStats.budgetEvictionsCount;
+    stats.deduplicatedSize = tileStats.deduplicatedSize;
 
     KisImageConfig cfg(true);
 
@@ -151,6 +175,7 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
     stats.tilesSoftLimit = cfg.tilesSoftLimit() * MiB;
     stats.tilesPoolLimit = cfg.poolLimit() * MiB;
     stats.totalMemoryLimit = stats.tilesHardLimit + stats.tilesPoolLimit;
+    stats.backgroundDocumentBudget = qint64(cfg.backgroundDocumentMemoryBudget()) * MiB;
 
     return stats;
 }
@@ -26,6 +26,7 @@ public:
               layersSize(0),
               projectionsSize(0),
               lodSize(0),
+              belowStackCacheSize(0),
 
               totalMemorySize(0),
               realMemorySize(0),
@@ -33,11 +34,18 @@ public:
               poolSize(0),
 
               swapSize(0),
+              swapRemapsCount(0),
+              swapInCount(0),
+              swapOutCount(0),
+              prefetchedCount(0),
+              budgetEvictionsCount(0),
+              deduplicatedSize(0),
 
               totalMemoryLimit(0),
               tilesHardLimit(0),
               tilesSoftLimit(0),
-              tilesPoolLimit(0)
+              tilesPoolLimit(0),
+              backgroundDocumentBudget(0)
         {
         }
 
@@ -46,6 +54,12 @@ public:
         qint64 projectionsSize;
         qint64 lodSize;
 
+        /**
+         * The memory used by the caches of the layers below the active
+         * one, \see KisBelowStackCache. It is included into imageSize.
+         */
+        qint64 belowStackCacheSize;
+
         qint64 totalMemorySize;
         qint64 realMemorySize;
         qint64 historicalMemorySize;
@@ -53,10 +67,37 @@ public:
 
         qint64 swapSize;
 
+        /**
+         * The number of times the swap file had to be remapped to
+         * access a tile and the number of tiles read from (faulted in)
+         * and written to the swap file since the application start
+         */
+        qint64 swapRemapsCount;
+        qint64 swapInCount;
+        qint64 swapOutCount;
+
+        /**
+         * The number of tiles loaded from the swap file in advance,
+         * before they were accessed
+         */
+        qint64 prefetchedCount;
+
+        /**
+         * The number of tiles swapped out to keep inactive documents
+         * within backgroundDocumentBudget
+         */
+        qint64 budgetEvictionsCount;
+
+        /**
+         * The amount of memory saved by merging identical tiles
+         */
+        qint64 deduplicatedSize;
+
         qint64 totalMemoryLimit;
         qint64 tilesHardLimit;
         qint64 tilesSoftLimit;
         qint64 tilesPoolLimit;
+        qint64 backgroundDocumentBudget;
     };
 
 
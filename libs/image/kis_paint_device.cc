@@ -1517,6 +1517,11 @@ void KisPaintDevice::purgeDefaultPixels()
     dm->purge(dm->extent());
 }
 
+void KisPaintDevice::prefetchRect(const QRect &rect) const
+{
+    m_d->dataManager()->prefetchRect(rect.translated(-x(), -y()));
+}
+
 void KisPaintDevice::setDefaultPixel(const KoColor &defPixel)
 {
     KoColor color(defPixel);
@@ -283,6 +283,13 @@ public:
      */
     void purgeDefaultPixels();
 
+    /**
+     * Hints the paint device that the pixels in \p rect are going to
+     * be accessed soon. If they have been swapped out, they are loaded
+     * back into memory in a background thread. The call doesn't block.
+     */
+    void prefetchRect(const QRect &rect) const;
+
     /**
      * Sets the default pixel. New data will be initialised with this pixel. The pixel is copied: the
      * caller still owns the pointer and needs to delete it to avoid memory leaks.
@@ -12,6 +12,11 @@
 #include "kis_image_config.h"
 #include "kis_full_refresh_walker.h"
 #include "kis_spontaneous_job.h"
+#include "KisDirtyTileMap.h"
+#include "KisMergeCostEstimator.h"
+#include "kis_update_time_monitor.h"
+#include "kis_lod_transform_base.h"
+#include "tiles3/kis_tile_data_interface.h"
 
 
 //#define ENABLE_DEBUG_JOIN
@@ -42,7 +47,8 @@
 
 
 KisSimpleUpdateQueue::KisSimpleUpdateQueue()
-    : m_overrideLevelOfDetail(-1)
+    : m_mergeCostEstimator(0),
+      m_overrideLevelOfDetail(-1)
 {
     updateSettings();
 }
@@ -64,6 +70,7 @@ void KisSimpleUpdateQueue::updateSettings()
 
     m_patchWidth = config.updatePatchWidth();
     m_patchHeight = config.updatePatchHeight();
+    m_useAdaptivePatchSize = config.useAdaptiveUpdatePatchSize();
 
     m_maxCollectAlpha = config.maxCollectAlpha();
     m_maxMergeAlpha = config.maxMergeAlpha();
@@ -75,6 +82,11 @@ int KisSimpleUpdateQueue::overrideLevelOfDetail() const
     return m_overrideLevelOfDetail;
 }
 
+void KisSimpleUpdateQueue::setMergeCostEstimator(KisMergeCostEstimator *estimator)
+{
+    m_mergeCostEstimator = estimator;
+}
+
 void KisSimpleUpdateQueue::processQueue(KisUpdaterContext &updaterContext)
 {
     updaterContext.lock();
@@ -95,6 +107,16 @@ bool KisSimpleUpdateQueue::processOneJob(KisUpdaterContext &updaterContext)
 
     int currentLevelOfDetail = updaterContext.currentLevelOfDetail();
 
+    /**
+     * The jobs are started in the order of their priority: first, the
+     * ones visible on the canvas, then the offscreen parts of the
+     * level-of-detail plane, and the rest of the image in the end.
+     * The jobs of the same priority are started in the order they
+     * were added.
+     */
+    KisBaseRectsWalkerSP bestItem;
+    KisUpdatePriority bestPriority = KisUpdatePriority::Offscreen;
+
     while(iter.hasNext()) {
         item = iter.next();
 
@@ -109,14 +131,22 @@ bool KisSimpleUpdateQueue::processOneJob(KisUpdaterContext &updaterContext)
         if ((currentLevelOfDetail < 0 || currentLevelOfDetail == item->levelOfDetail()) &&
             updaterContext.isJobAllowed(item)) {
 
-            updaterContext.addMergeJob(item);
-            iter.remove();
-            jobAdded = true;
-            break;
+            const KisUpdatePriority priority = walkerPriority(item);
+
+            if (!bestItem || priority < bestPriority) {
+                bestItem = item;
+                bestPriority = priority;
+            }
+
+            if (bestPriority == KisUpdatePriority::Visible) break;
         }
     }
 
-    if (jobAdded) return true;
+    if (bestItem) {
+        updaterContext.addMergeJob(bestItem);
+        m_updatesList.removeOne(bestItem);
+        return true;
+    }
 
     if (!m_spontaneousJobsList.isEmpty()) {
         /**
@@ -180,6 +210,31 @@ void KisSimpleUpdateQueue::addJob(KisNodeSP node, const QVector<QRect> &rects,
                                   const QRect& cropRect,
                                   int levelOfDetail,
                                   KisBaseRectsWalker::UpdateType type)
+{
+    if (rects.size() <= 1) {
+        addJobImpl(node, rects, cropRect, levelOfDetail, type);
+        return;
+    }
+
+    /**
+     * Lots of small scattered rects (spray brush, multihand tool, etc)
+     * are coalesced on a tile basis first. Neighbouring dabs become a
+     * single update, while the distant ones are not merged into a huge
+     * rect. The resulting batches never cross the border of an update
+     * patch, so they can be processed by different threads in parallel.
+     */
+    KisDirtyTileMap tileMap(QSize(KisTileData::WIDTH, KisTileData::HEIGHT),
+                            QSize(m_patchWidth, m_patchHeight));
+    tileMap.addRects(rects);
+
+    addJobImpl(node, tileMap.batches(), cropRect, levelOfDetail, type);
+}
+
+void KisSimpleUpdateQueue::addJobImpl(KisNodeSP node, const QVector<QRect> &rects,
+                                      const QRect& cropRect,
+                                      int levelOfDetail,
+                                      KisBaseRectsWalker::UpdateType type,
+                                      bool allowSplit)
 {
     QList<KisBaseRectsWalkerSP> walkers;
 
@@ -188,7 +243,7 @@ void KisSimpleUpdateQueue::addJob(KisNodeSP node, const QVector<QRect> &rects,
 
         KisBaseRectsWalkerSP walker;
 
-        if(trySplitJob(node, rc, cropRect, levelOfDetail, type)) continue;
+        if(allowSplit && trySplitJob(node, rc, cropRect, levelOfDetail, type)) continue;
         if(tryMergeJob(node, rc, cropRect, levelOfDetail, type)) continue;
 
         if (type == KisBaseRectsWalker::UPDATE) {
@@ -234,6 +289,55 @@ void KisSimpleUpdateQueue::addSpontaneousJob(KisSpontaneousJob *spontaneousJob)
     m_spontaneousJobsList.append(spontaneousJob);
 }
 
+void KisSimpleUpdateQueue::setPriorityRect(const QRect &rc)
+{
+    QMutexLocker locker(&m_lock);
+    m_priorityRect = rc;
+}
+
+QRect KisSimpleUpdateQueue::priorityRect() const
+{
+    QMutexLocker locker(&m_lock);
+    return m_priorityRect;
+}
+
+bool KisSimpleUpdateQueue::hasPendingUpdates(KisUpdatePriority priority) const
+{
+    QMutexLocker locker(&m_lock);
+
+    if (priority == KisUpdatePriority::Offscreen) {
+        return !m_updatesList.isEmpty() || !m_spontaneousJobsList.isEmpty();
+    }
+
+    Q_FOREACH (KisBaseRectsWalkerSP walker, m_updatesList) {
+        if (walkerPriority(walker) <= priority) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+KisUpdatePriority KisSimpleUpdateQueue::walkerPriority(KisBaseRectsWalkerSP walker) const
+{
+    if (m_priorityRect.isEmpty()) return KisUpdatePriority::Visible;
+
+    const int levelOfDetail = walker->levelOfDetail();
+
+    const QRect priorityRect =
+        levelOfDetail > 0 ?
+            KisLodTransformBase::scaledRect(m_priorityRect, levelOfDetail) :
+            m_priorityRect;
+
+    if (walker->requestedRect().intersects(priorityRect)) {
+        return KisUpdatePriority::Visible;
+    }
+
+    return levelOfDetail > 0 ?
+        KisUpdatePriority::LevelOfDetail :
+        KisUpdatePriority::Offscreen;
+}
+
 bool KisSimpleUpdateQueue::isEmpty() const
 {
     QMutexLocker locker(&m_lock);
@@ -251,30 +355,66 @@ bool KisSimpleUpdateQueue::trySplitJob(KisNodeSP node, const QRect& rc,
                                        int levelOfDetail,
                                        KisBaseRectsWalker::UpdateType type)
 {
-    if(rc.width() <= m_patchWidth || rc.height() <= m_patchHeight)
+    /**
+     * The adaptive patches are never smaller than a tile, so the rects
+     * that fit into a tile are never split and we can skip counting
+     * the layers for the tiny dabs
+     */
+    if (rc.width() <= qMin(KisTileData::WIDTH, m_patchWidth) ||
+        rc.height() <= qMin(KisTileData::HEIGHT, m_patchHeight)) {
+
         return false;
+    }
 
-    // a bit of recursive splitting...
+    const int numLayers =
+        KisMergeCostEstimator::numCompositedLayers(node, type == KisBaseRectsWalker::FULL_REFRESH);
+
+    /**
+     * A single huge update (e.g. a filter applied to the whole image)
+     * would be processed by a few jobs only when split into the patches
+     * of the default size. The estimator makes the patches smaller to
+     * give work to all the threads, but not so small that the overhead
+     * of the walkers outweighs the compositing itself.
+     */
+    const QSize splitPatchSize = patchSize(rc, numLayers);
+
+    const qint32 patchWidth = splitPatchSize.width();
+    const qint32 patchHeight = splitPatchSize.height();
+
+    if(rc.width() <= patchWidth || rc.height() <= patchHeight)
+        return false;
 
-    qint32 firstCol = rc.x() / m_patchWidth;
-    qint32 firstRow = rc.y() / m_patchHeight;
+    qint32 firstCol = rc.x() / patchWidth;
+    qint32 firstRow = rc.y() / patchHeight;
 
-    qint32 lastCol = (rc.x() + rc.width()) / m_patchWidth;
-    qint32 lastRow = (rc.y() + rc.height()) / m_patchHeight;
+    qint32 lastCol = (rc.x() + rc.width()) / patchWidth;
+    qint32 lastRow = (rc.y() + rc.height()) / patchHeight;
 
     QVector<QRect> splitRects;
 
     for(qint32 i = firstRow; i <= lastRow; i++) {
         for(qint32 j = firstCol; j <= lastCol; j++) {
-            QRect maxPatchRect(j * m_patchWidth, i * m_patchHeight,
-                               m_patchWidth, m_patchHeight);
+            QRect maxPatchRect(j * patchWidth, i * patchHeight,
+                               patchWidth, patchHeight);
             QRect patchRect = rc & maxPatchRect;
-            splitRects.append(patchRect);
+            if (!patchRect.isEmpty()) {
+                splitRects.append(patchRect);
+            }
         }
     }
 
     KIS_SAFE_ASSERT_RECOVER_NOOP(!splitRects.isEmpty());
-    addJob(node, splitRects, cropRect, levelOfDetail, type);
+
+    KisUpdateTimeMonitor::instance()->reportUpdateSplit(
+        rc, numLayers, splitPatchSize, splitRects.size(),
+        m_mergeCostEstimator ? m_mergeCostEstimator->estimatedCost(rc, numLayers) : 0.0);
+
+    /**
+     * The patches are not split again, otherwise the adaptive patch
+     * size, which depends on the area of the rect, would split them
+     * recursively
+     */
+    addJobImpl(node, splitRects, cropRect, levelOfDetail, type, false);
 
     return true;
 }
@@ -307,7 +447,7 @@ bool KisSimpleUpdateQueue::tryMergeJob(KisNodeSP node, const QRect& rc,
         if(item->cropRect() != cropRect) continue;
         if(item->levelOfDetail() != levelOfDetail) continue;
 
-        if(joinRects(baseRect, item->requestedRect(), m_maxMergeAlpha)) {
+        if(joinRects(baseRect, item->requestedRect(), m_maxMergeAlpha, node, type)) {
             goodCandidate = item;
             break;
         }
@@ -347,7 +487,8 @@ void KisSimpleUpdateQueue::collectJobs(KisBaseRectsWalkerSP &baseWalker,
         if(item->cropRect() != baseWalker->cropRect()) continue;
         if(item->levelOfDetail() != baseWalker->levelOfDetail()) continue;
 
-        if(joinRects(baseRect, item->requestedRect(), maxAlpha)) {
+        if(joinRects(baseRect, item->requestedRect(), maxAlpha,
+                     baseWalker->startNode(), baseWalker->type())) {
             iter.remove();
         }
     }
@@ -358,10 +499,12 @@ void KisSimpleUpdateQueue::collectJobs(KisBaseRectsWalkerSP &baseWalker,
 }
 
 bool KisSimpleUpdateQueue::joinRects(QRect& baseRect,
-                                     const QRect& newRect, qreal maxAlpha)
+                                     const QRect& newRect, qreal maxAlpha,
+                                     KisNodeSP node,
+                                     KisBaseRectsWalker::UpdateType type)
 {
     QRect unitedRect = baseRect | newRect;
-    if(unitedRect.width() > m_patchWidth || unitedRect.height() > m_patchHeight)
+    if(!fitsIntoPatch(unitedRect, node, type))
         return false;
 
     bool result = false;
@@ -386,6 +529,38 @@ bool KisSimpleUpdateQueue::joinRects(QRect& baseRect,
     return result;
 }
 
+QSize KisSimpleUpdateQueue::patchSize(const QRect &rc, int numLayers) const
+{
+    const QSize maxPatchSize(m_patchWidth, m_patchHeight);
+
+    return m_useAdaptivePatchSize && m_mergeCostEstimator ?
+        m_mergeCostEstimator->patchSize(rc, numLayers, maxPatchSize) :
+        maxPatchSize;
+}
+
+bool KisSimpleUpdateQueue::fitsIntoPatch(const QRect &rc, KisNodeSP node,
+                                         KisBaseRectsWalker::UpdateType type) const
+{
+    if (rc.width() > m_patchWidth || rc.height() > m_patchHeight) return false;
+    if (!m_useAdaptivePatchSize || !m_mergeCostEstimator) return true;
+
+    if (rc.width() <= qMin(KisTileData::WIDTH, m_patchWidth) &&
+        rc.height() <= qMin(KisTileData::HEIGHT, m_patchHeight)) {
+
+        return true;
+    }
+
+    /**
+     * Don't join the rects that would be split again, otherwise
+     * optimize() would undo the adaptive split of a big update
+     */
+    const int numLayers =
+        KisMergeCostEstimator::numCompositedLayers(node, type == KisBaseRectsWalker::FULL_REFRESH);
+
+    const QSize size = patchSize(rc, numLayers);
+    return rc.width() <= size.width() && rc.height() <= size.height();
+}
+
 KisWalkersList& KisTestableSimpleUpdateQueue::getWalkersList()
 {
     return m_updatesList;
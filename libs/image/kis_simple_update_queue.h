@@ -9,6 +9,9 @@
 
 #include <QMutex>
 #include "kis_updater_context.h"
+#include "KisUpdatePriority.h"
+
+class KisMergeCostEstimator;
 
 typedef QList<KisBaseRectsWalkerSP> KisWalkersList;
 typedef QListIterator<KisBaseRectsWalkerSP> KisWalkersListIterator;
@@ -45,17 +48,49 @@ public:
 
     int overrideLevelOfDetail() const;
 
+    /**
+     * Set the estimator used for choosing the size of the patches
+     * big update rects are split into. If no estimator is set, the
+     * patch size from KisImageConfig is used.
+     */
+    void setMergeCostEstimator(KisMergeCostEstimator *estimator);
+
+    /**
+     * Set the rect (in the coordinates of level of detail 0) whose
+     * updates should be processed first, usually the visible area of
+     * the canvas. Pass an empty rect to process all the updates in
+     * the order they were added.
+     *
+     * \see KisUpdatePriority
+     */
+    void setPriorityRect(const QRect &rc);
+    QRect priorityRect() const;
+
+    /**
+     * \return true if there are updates of \p priority or of a more
+     * important priority waiting in the queue. The Offscreen priority
+     * includes the spontaneous jobs as well.
+     */
+    bool hasPendingUpdates(KisUpdatePriority priority) const;
+
 protected:
     void addJob(KisNodeSP node, const QVector<QRect> &rects, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
+    void addJobImpl(KisNodeSP node, const QVector<QRect> &rects, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type, bool allowSplit = true);
 
     bool processOneJob(KisUpdaterContext &updaterContext);
 
+    KisUpdatePriority walkerPriority(KisBaseRectsWalkerSP walker) const;
+
     bool trySplitJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
     bool tryMergeJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
 
     void collectJobs(KisBaseRectsWalkerSP &baseWalker, QRect baseRect,
                      const qreal maxAlpha);
-    bool joinRects(QRect& baseRect, const QRect& newRect, qreal maxAlpha);
+    bool joinRects(QRect& baseRect, const QRect& newRect, qreal maxAlpha,
+                   KisNodeSP node, KisBaseRectsWalker::UpdateType type);
+
+    QSize patchSize(const QRect &rc, int numLayers) const;
+    bool fitsIntoPatch(const QRect &rc, KisNodeSP node, KisBaseRectsWalker::UpdateType type) const;
 
 protected:
 
@@ -76,6 +111,13 @@ protected:
     qint32 m_patchWidth;
     qint32 m_patchHeight;
 
+    /**
+     * When enabled, the patches are made smaller to feed all the
+     * threads when a single huge update is requested
+     */
+    bool m_useAdaptivePatchSize;
+    KisMergeCostEstimator *m_mergeCostEstimator;
+
     /**
      * Maximum coefficient of work while regular optimization()
      */
@@ -93,6 +135,8 @@ protected:
     qreal m_maxMergeCollectAlpha;
 
     int m_overrideLevelOfDetail;
+
+    QRect m_priorityRect;
 };
 
 class KRITAIMAGE_EXPORT KisTestableSimpleUpdateQueue : public KisSimpleUpdateQueue
@@ -712,6 +712,15 @@ bool KisStrokesQueue::hasOpenedStrokes() const
     return m_d->openedStrokesCounter;
 }
 
+bool KisStrokesQueue::currentStrokeWaitsForJobs() const
+{
+    QMutexLocker locker(&m_d->mutex);
+    if(m_d->strokesQueue.isEmpty()) return false;
+
+    KisStrokeSP stroke = m_d->strokesQueue.head();
+    return !stroke->isEnded() && !stroke->hasJobs();
+}
+
 bool KisStrokesQueue::processOneJob(KisUpdaterContext &updaterContext,
                                     bool externalJobsPending)
 {
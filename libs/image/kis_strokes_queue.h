@@ -50,6 +50,13 @@ public:
     KUndo2MagicString currentStrokeName() const;
     bool hasOpenedStrokes() const;
 
+    /**
+     * \return true if the current stroke is not ended and has no
+     * jobs to execute, that is it cannot progress until someone adds
+     * more jobs to it or ends it
+     */
+    bool currentStrokeWaitsForJobs() const;
+
     bool wrapAroundModeSupported() const;
     qreal balancingRatioOverride() const;
 
@@ -11,6 +11,7 @@
 
 #include <QRunnable>
 #include <QReadWriteLock>
+#include <QElapsedTimer>
 
 #include "kis_stroke_job.h"
 #include "kis_spontaneous_job.h"
@@ -120,8 +121,24 @@ public:
 
 #endif
 
+        /**
+         * The merger consumes the walker's stack, so the layers should
+         * be counted beforehand. The timings are used for choosing the
+         * size of the update patches, see KisMergeCostEstimator.
+         */
+        const int numLayers =
+            KisMergeCostEstimator::numCompositedLayers(m_walker->startNode(),
+                                                       m_walker->type() == KisBaseRectsWalker::FULL_REFRESH);
+
+        QElapsedTimer timer;
+        timer.start();
+
         m_merger.startMerge(*m_walker);
 
+        m_updaterContext->mergeCostEstimator()->reportMergeJob(m_walker->requestedRect(),
+                                                               numLayers,
+                                                               timer.nsecsElapsed());
+
         QRect changeRect = m_walker->changeRect();
         m_updaterContext->continueUpdate(changeRect);
     }
@@ -14,6 +14,7 @@
 #include "kis_updater_context.h"
 #include "kis_simple_update_queue.h"
 #include "kis_strokes_queue.h"
+#include "KisBelowStackCache.h"
 
 #include "kis_queues_progress_updater.h"
 #include "KisImageConfigNotifier.h"
@@ -40,7 +41,9 @@ struct Q_DECL_HIDDEN KisUpdateScheduler::Private {
         : q(_q)
         , updaterContext(KisImageConfig(true).maxNumberOfThreads(), q)
         , projectionUpdateListener(p)
-    {}
+    {
+        updatesQueue.setMergeCostEstimator(updaterContext.mergeCostEstimator());
+    }
 
     KisUpdateScheduler *q;
 
@@ -97,6 +100,27 @@ void KisUpdateScheduler::setThreadsLimit(int value)
     unlock(false);
 }
 
+void KisUpdateScheduler::setUseWorkStealing(bool value)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!m_d->processingBlocked);
+
+    immediateLockForReadOnly();
+    m_d->updaterContext.lock();
+    m_d->updaterContext.setUseWorkStealing(value);
+    m_d->updaterContext.unlock();
+    unlock(false);
+}
+
+void KisUpdateScheduler::setUpdatesPriorityRect(const QRect &rc)
+{
+    m_d->updatesQueue.setPriorityRect(rc);
+}
+
+QRect KisUpdateScheduler::updatesPriorityRect() const
+{
+    return m_d->updatesQueue.priorityRect();
+}
+
 int KisUpdateScheduler::threadsLimit() const
 {
     std::lock_guard<KisUpdaterContext> l(m_d->updaterContext);
@@ -307,6 +331,8 @@ void KisUpdateScheduler::updateSettings()
     KisImageConfig config(true);
     m_d->defaultBalancingRatio = config.schedulerBalancingRatio();
     setThreadsLimit(config.maxNumberOfThreads());
+    setUseWorkStealing(config.useWorkStealingScheduler());
+    KisBelowStackCache::setEnabled(config.useBelowStackCache());
 }
 
 void KisUpdateScheduler::immediateLockForReadOnly()
@@ -349,6 +375,30 @@ void KisUpdateScheduler::waitForDone()
     } while(!m_d->updatesQueue.isEmpty() || !m_d->strokesQueue.isEmpty());
 }
 
+void KisUpdateScheduler::waitForUpdates(KisUpdatePriority priority)
+{
+    while (true) {
+        processQueues();
+        m_d->updaterContext.waitForDone();
+
+        if (!m_d->updatesQueue.hasPendingUpdates(priority)) break;
+
+        /**
+         * The updates cannot be started while the processing is blocked
+         * or an exclusive stroke is running. If the exclusive stroke has
+         * no jobs and is not ended, it waits for the caller, so the
+         * updates will never be finished and there is no reason to wait.
+         */
+        const bool cannotProgress =
+            m_d->processingBlocked ||
+            m_d->updatesLockCounter ||
+            (m_d->strokesQueue.needsExclusiveAccess() &&
+             m_d->strokesQueue.currentStrokeWaitsForJobs());
+
+        if (cannotProgress) break;
+    }
+}
+
 bool KisUpdateScheduler::tryBarrierLock()
 {
     if(!m_d->updatesQueue.isEmpty() || !m_d->strokesQueue.isEmpty()) {
@@ -15,6 +15,7 @@
 #include "kis_stroke_strategy_factory.h"
 #include "kis_strokes_queue_undo_result.h"
 #include "KisLodPreferences.h"
+#include "KisUpdatePriority.h"
 
 class QRect;
 class KoProgressProxy;
@@ -41,6 +42,24 @@ public:
      */
     int threadsLimit() const;
 
+    /**
+     * Execute the jobs with KisWorkStealingThreadPool instead of
+     * QThreadPool
+     *
+     * \see KisUpdaterContext::setUseWorkStealing()
+     */
+    void setUseWorkStealing(bool value);
+
+    /**
+     * Set the rect whose updates should be processed first, usually
+     * the visible area of the canvas. The rect is in the coordinates
+     * of level of detail 0.
+     *
+     * \see KisSimpleUpdateQueue::setPriorityRect()
+     */
+    void setUpdatesPriorityRect(const QRect &rc);
+    QRect updatesPriorityRect() const;
+
     /**
      * Sets the proxy that is going to be notified about the progress
      * of processing of the queues. If you want to switch the proxy
@@ -78,6 +97,23 @@ public:
      */
     void waitForDone();
 
+    /**
+     * Waits until all the updates of \p priority and of the more
+     * important priorities are finished. Unlike waitForDone(), it
+     * doesn't wait for the queued strokes and for the updates of
+     * less important priorities.
+     *
+     * If some other thread adds updates in parallel, then you may
+     * wait forever.
+     *
+     * If the updates cannot be processed because the processing is
+     * blocked or an opened exclusive stroke doesn't have any jobs to
+     * execute, the function returns without waiting for them.
+     *
+     * \see KisUpdatePriority
+     */
+    void waitForUpdates(KisUpdatePriority priority);
+
     /**
      * Waits until the queues become empty, then blocks the processing.
      * To unblock processing you should use unlock().
@@ -14,6 +14,7 @@
 #include <QPointF>
 #include <QRect>
 #include <QRegion>
+#include <QSize>
 #include <QFile>
 #include <QDir>
 
@@ -72,6 +73,8 @@ struct Q_DECL_HIDDEN KisUpdateTimeMonitor::Private
           responseTime(0),
           numTickets(0),
           numUpdates(0),
+          numSplits(0),
+          numSplitPatches(0),
           mousePath(0.0),
           loggingEnabled(false)
     {
@@ -85,6 +88,8 @@ struct Q_DECL_HIDDEN KisUpdateTimeMonitor::Private
     qint64 responseTime;
     qint32 numTickets;
     qint32 numUpdates;
+    qint32 numSplits;
+    qint32 numSplitPatches;
     QMutex mutex;
 
     qreal mousePath;
@@ -127,6 +132,8 @@ void KisUpdateTimeMonitor::startStrokeMeasure()
     m_d->responseTime = 0;
     m_d->numTickets = 0;
     m_d->numUpdates = 0;
+    m_d->numSplits = 0;
+    m_d->numSplitPatches = 0;
     m_d->mousePath = 0;
 
     m_d->lastMousePos = QPointF();
@@ -173,6 +180,7 @@ void KisUpdateTimeMonitor::printValues()
     qreal nonUpdateTime = qreal(m_d->jobsTime) / m_d->numTickets;
     qreal jobsPerUpdate = qreal(m_d->numTickets) / m_d->numUpdates;
     qreal mouseSpeed = qreal(m_d->mousePath) / strokeTime;
+    qreal patchesPerSplit = m_d->numSplits ? qreal(m_d->numSplitPatches) / m_d->numSplits : 0.0;
 
     QString prefix;
 
@@ -191,6 +199,7 @@ void KisUpdateTimeMonitor::printValues()
            << i18n("Mouse Speed:") << QString::number( mouseSpeed, 'f', 3 ) << "\t"
            << i18n("Jobs/Update:") << QString::number( jobsPerUpdate, 'f', 3 ) << "\t"
            << i18n("Non Update Time:") << QString::number( nonUpdateTime, 'f', 3 ) << "\t"
+           << i18n("Patches/Split:") << QString::number( patchesPerSplit, 'f', 3 ) << "\t"
            << i18n("Response Time:") << responseTime << endl; // 'endl' will use the correct OS line ending
     logFile.close();
 }
@@ -244,3 +253,27 @@ void KisUpdateTimeMonitor::reportUpdateFinished(const QRect &rect)
     }
     m_d->numUpdates++;
 }
+
+void KisUpdateTimeMonitor::reportUpdateSplit(const QRect &rect, int numLayers,
+                                             const QSize &patchSize, int numPatches,
+                                             qreal estimatedCost)
+{
+    if (!m_d->loggingEnabled) return;
+
+    QMutexLocker locker(&m_d->mutex);
+
+    m_d->numSplits++;
+    m_d->numSplitPatches += numPatches;
+
+    QFile logFile("log/updatesplit.rdata");
+    logFile.open(QIODevice::Append);
+    QTextStream stream(&logFile);
+
+    stream << i18n("Rect:") << rect.x() << "," << rect.y() << ","
+           << rect.width() << "," << rect.height() << "\t"
+           << i18n("Layers:") << numLayers << "\t"
+           << i18n("Patch Size:") << patchSize.width() << "x" << patchSize.height() << "\t"
+           << i18n("Patches:") << numPatches << "\t"
+           << i18n("Estimated Time:") << QString::number( estimatedCost / 1e6, 'f', 3 ) << endl;
+    logFile.close();
+}
@@ -14,6 +14,7 @@
 #include <QVector>
 class QPointF;
 class QRect;
+class QSize;
 
 
 class KRITAIMAGE_EXPORT KisUpdateTimeMonitor
@@ -34,6 +35,15 @@ public:
     void reportJobFinished(void *key, const QVector<QRect> &rects);
     void reportUpdateFinished(const QRect &rect);
 
+    /**
+     * Logs the patches \p rect has been split into by the update
+     * queue. \p estimatedCost is the expected time of compositing
+     * the whole rect in nanoseconds, 0 if unknown.
+     */
+    void reportUpdateSplit(const QRect &rect, int numLayers,
+                           const QSize &patchSize, int numPatches,
+                           qreal estimatedCost);
+
 
 private:
     struct Private;
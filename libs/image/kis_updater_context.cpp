@@ -11,6 +11,7 @@
 
 #include "kis_update_job_item.h"
 #include "kis_stroke_job.h"
+#include "KisWorkStealingThreadPool.h"
 
 const int KisUpdaterContext::useIdealThreadCountTag = -1;
 
@@ -27,7 +28,7 @@ KisUpdaterContext::KisUpdaterContext(qint32 threadCount, KisUpdateScheduler *par
 
 KisUpdaterContext::~KisUpdaterContext()
 {
-    m_threadPool.waitForDone();
+    waitForDone();
 
     if (m_testingMode) {
         clear();
@@ -136,7 +137,7 @@ void KisUpdaterContext::addMergeJob(KisBaseRectsWalkerSP walker)
     // it might happen that we call this function from within
     // the thread itself, right when it finished its work
     if (shouldStartThread && !m_testingMode) {
-        m_threadPool.start(m_jobs[jobIndex]);
+        startJobItem(m_jobs[jobIndex]);
     }
 }
 
@@ -151,7 +152,7 @@ void KisUpdaterContext::addStrokeJob(KisStrokeJob *strokeJob)
     // it might happen that we call this function from within
     // the thread itself, right when it finished its work
     if (shouldStartThread && !m_testingMode) {
-        m_threadPool.start(m_jobs[jobIndex]);
+        startJobItem(m_jobs[jobIndex]);
     }
 }
 
@@ -166,13 +167,17 @@ void KisUpdaterContext::addSpontaneousJob(KisSpontaneousJob *spontaneousJob)
     // it might happen that we call this function from within
     // the thread itself, right when it finished its work
     if (shouldStartThread && !m_testingMode) {
-        m_threadPool.start(m_jobs[jobIndex]);
+        startJobItem(m_jobs[jobIndex]);
     }
 }
 
 void KisUpdaterContext::waitForDone()
 {
-    m_threadPool.waitForDone();
+    if (m_workStealingPool) {
+        m_workStealingPool->waitForDone();
+    } else {
+        m_threadPool.waitForDone();
+    }
 }
 
 bool KisUpdaterContext::walkerIntersectsJob(KisBaseRectsWalkerSP walker,
@@ -191,6 +196,15 @@ qint32 KisUpdaterContext::findSpareThread()
     return -1;
 }
 
+void KisUpdaterContext::startJobItem(KisUpdateJobItem *item)
+{
+    if (m_workStealingPool) {
+        m_workStealingPool->start(item);
+    } else {
+        m_threadPool.start(item);
+    }
+}
+
 void KisUpdaterContext::lock()
 {
     m_lock.lock();
@@ -204,6 +218,11 @@ void KisUpdaterContext::unlock()
 void KisUpdaterContext::setThreadsLimit(int value)
 {
     m_threadPool.setMaxThreadCount(value);
+    m_mergeCostEstimator.setNumThreads(value);
+
+    if (m_workStealingPool) {
+        m_workStealingPool->setMaxThreadCount(value);
+    }
 
     for (int i = 0; i < m_jobs.size(); i++) {
         KIS_SAFE_ASSERT_RECOVER_RETURN(!m_jobs[i]->isRunning());
@@ -227,6 +246,37 @@ int KisUpdaterContext::threadsLimit() const
     return m_jobs.size();
 }
 
+void KisUpdaterContext::setUseWorkStealing(bool value)
+{
+    if (bool(m_workStealingPool) == value) return;
+
+    for (int i = 0; i < m_jobs.size(); i++) {
+        KIS_SAFE_ASSERT_RECOVER_RETURN(!m_jobs[i]->isRunning());
+    }
+
+    /**
+     * The job items may still be finishing their run() loop in
+     * the old executor, even though they are not running anymore
+     */
+    waitForDone();
+
+    if (value) {
+        m_workStealingPool.reset(new KisWorkStealingThreadPool(m_jobs.size()));
+    } else {
+        m_workStealingPool.reset();
+    }
+}
+
+bool KisUpdaterContext::useWorkStealing() const
+{
+    return bool(m_workStealingPool);
+}
+
+KisMergeCostEstimator* KisUpdaterContext::mergeCostEstimator()
+{
+    return &m_mergeCostEstimator;
+}
+
 void KisUpdaterContext::continueUpdate(const QRect& rc)
 {
     if (m_scheduler) m_scheduler->continueUpdate(rc);
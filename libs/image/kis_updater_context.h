@@ -10,15 +10,18 @@
 #include <QMutex>
 #include <QReadWriteLock>
 #include <QThreadPool>
+#include <QScopedPointer>
 
 #include "kis_base_rects_walker.h"
 #include "kis_async_merger.h"
 #include "kis_lock_free_lod_counter.h"
+#include "KisMergeCostEstimator.h"
 
 #include "KisUpdaterContextSnapshotEx.h"
 #include "kis_update_scheduler.h"
 
 class KisUpdateJobItem;
+class KisWorkStealingThreadPool;
 class KisSpontaneousJob;
 class KisStrokeJob;
 class KisUpdateScheduler;
@@ -126,6 +129,24 @@ public:
      */
     int threadsLimit() const;
 
+    /**
+     * Execute the jobs with KisWorkStealingThreadPool instead of
+     * QThreadPool. The conflict checks of the jobs are the same for
+     * both executors. The same requirements as for setThreadsLimit()
+     * apply.
+     *
+     * \see setThreadsLimit()
+     */
+    void setUseWorkStealing(bool value);
+    bool useWorkStealing() const;
+
+    /**
+     * The estimator collects the timings of the merge jobs executed
+     * in the context. It is used by KisSimpleUpdateQueue to choose
+     * the size of the update patches.
+     */
+    KisMergeCostEstimator* mergeCostEstimator();
+
     void continueUpdate(const QRect& rc);
     void doSomeUsefulWork();
     void jobFinished();
@@ -136,6 +157,7 @@ protected:
     static bool walkerIntersectsJob(KisBaseRectsWalkerSP walker,
                                     const KisUpdateJobItem* job);
     qint32 findSpareThread();
+    void startJobItem(KisUpdateJobItem *item);
 
 protected:
     /**
@@ -149,7 +171,9 @@ protected:
     QMutex m_lock;
     QVector<KisUpdateJobItem*> m_jobs;
     QThreadPool m_threadPool;
+    QScopedPointer<KisWorkStealingThreadPool> m_workStealingPool;
     KisLockFreeLodCounter m_lodCounter;
+    KisMergeCostEstimator m_mergeCostEstimator;
     KisUpdateScheduler *m_scheduler;
     bool m_testingMode = false;
 
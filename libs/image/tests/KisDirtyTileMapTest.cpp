@@ -0,0 +1,151 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDirtyTileMapTest.h"
+
+#include "KisDirtyTileMap.h"
+
+#include <QRegion>
+#include <QtMath>
+
+#include <simpletest.h>
+
+namespace {
+const QSize tileSize(64, 64);
+const QSize batchSize(512, 512);
+}
+
+void KisDirtyTileMapTest::testEmpty()
+{
+    KisDirtyTileMap map(tileSize, batchSize);
+
+    map.addRect(QRect());
+
+    QVERIFY(map.isEmpty());
+    QCOMPARE(map.numDirtyTiles(), 0);
+    QVERIFY(map.batches().isEmpty());
+    QVERIFY(map.boundingRect().isEmpty());
+}
+
+void KisDirtyTileMapTest::testSeparateDabs()
+{
+    KisDirtyTileMap map(tileSize, batchSize);
+
+    // two dabs in the same batch, but in different tiles
+    map.addRect(QRect(10, 10, 5, 5));
+    map.addRect(QRect(300, 300, 5, 5));
+
+    QCOMPARE(map.numDirtyTiles(), 2);
+    QCOMPARE(map.boundingRect(), QRect(10, 10, 295, 295));
+
+    const QVector<QRect> batches = map.batches();
+    QCOMPARE(batches.size(), 2);
+    QCOMPARE(batches[0], QRect(10, 10, 5, 5));
+    QCOMPARE(batches[1], QRect(300, 300, 5, 5));
+}
+
+void KisDirtyTileMapTest::testAdjacentTiles()
+{
+    KisDirtyTileMap map(tileSize, batchSize);
+
+    // a 2x2 block of dirty tiles becomes a single batch
+    map.addRect(QRect(60, 60, 10, 10));
+    map.addRect(QRect(0, 0, 5, 5));
+    map.addRect(QRect(120, 120, 5, 5));
+
+    QCOMPARE(map.numDirtyTiles(), 4);
+
+    QVector<QRect> batches = map.batches();
+    QCOMPARE(batches.size(), 1);
+    QCOMPARE(batches[0], QRect(0, 0, 125, 125));
+
+    // the runs of different width are not merged
+    map.clear();
+    map.addRect(QRect(0, 0, 128, 10));
+    map.addRect(QRect(0, 64, 10, 10));
+
+    batches = map.batches();
+    QCOMPARE(batches.size(), 2);
+    QCOMPARE(batches[0], QRect(0, 0, 128, 10));
+    QCOMPARE(batches[1], QRect(0, 64, 10, 10));
+}
+
+void KisDirtyTileMapTest::testBatchSize()
+{
+    KisDirtyTileMap map(tileSize, batchSize);
+
+    map.addRect(QRect(0, 0, 1024, 1024));
+    QCOMPARE(map.numDirtyTiles(), 256);
+
+    const QVector<QRect> batches = map.batches();
+    QCOMPARE(batches.size(), 4);
+    QCOMPARE(batches[0], QRect(0, 0, 512, 512));
+    QCOMPARE(batches[1], QRect(512, 0, 512, 512));
+    QCOMPARE(batches[2], QRect(0, 512, 512, 512));
+    QCOMPARE(batches[3], QRect(512, 512, 512, 512));
+
+    // the batches are limited to 8x8 tiles
+    KisDirtyTileMap bigBatchMap(tileSize, QSize(4096, 100));
+    QCOMPARE(bigBatchMap.batchSize(), QSize(512, 64));
+}
+
+void KisDirtyTileMapTest::testNegativeCoordinates()
+{
+    KisDirtyTileMap map(tileSize, batchSize);
+
+    map.addRect(QRect(-10, -10, 20, 20));
+
+    QCOMPARE(map.numDirtyTiles(), 4);
+
+    const QVector<QRect> batches = map.batches();
+    QCOMPARE(batches.size(), 4);
+
+    QRect totalRect;
+    Q_FOREACH (const QRect &rc, batches) {
+        totalRect |= rc;
+    }
+    QCOMPARE(totalRect, QRect(-10, -10, 20, 20));
+}
+
+void KisDirtyTileMapTest::testRandomCoverage()
+{
+    for (int i = 0; i < 100; i++) {
+        KisDirtyTileMap map(tileSize, batchSize);
+        QVector<QRect> rects;
+
+        const int numRects = 1 + qrand() % 50;
+        for (int j = 0; j < numRects; j++) {
+            rects << QRect(qrand() % 3000 - 1000, qrand() % 3000 - 1000,
+                           1 + qrand() % 100, 1 + qrand() % 100);
+        }
+
+        map.addRects(rects);
+        const QVector<QRect> batches = map.batches();
+
+        QRegion dirtyRegion;
+        Q_FOREACH (const QRect &rc, rects) {
+            dirtyRegion |= rc;
+        }
+
+        QRegion batchesRegion;
+        Q_FOREACH (const QRect &rc, batches) {
+            // the batches never intersect each other...
+            QVERIFY(!batchesRegion.intersects(rc));
+            batchesRegion |= rc;
+
+            // ... and never cross the border of a batch cell
+            const QRect cellRect(QPoint(qFloor(qreal(rc.left()) / batchSize.width()) * batchSize.width(),
+                                        qFloor(qreal(rc.top()) / batchSize.height()) * batchSize.height()),
+                                 batchSize);
+            QVERIFY(cellRect.contains(rc));
+        }
+
+        QCOMPARE(batchesRegion.boundingRect(), map.boundingRect());
+        QVERIFY((dirtyRegion - batchesRegion).isEmpty());
+    }
+}
+
+SIMPLE_TEST_MAIN(KisDirtyTileMapTest)
@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDIRTYTILEMAPTEST_H
+#define KISDIRTYTILEMAPTEST_H
+
+#include <simpletest.h>
+
+class KisDirtyTileMapTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testEmpty();
+    void testSeparateDabs();
+    void testAdjacentTiles();
+    void testBatchSize();
+    void testNegativeCoordinates();
+    void testRandomCoverage();
+};
+
+#endif // KISDIRTYTILEMAPTEST_H
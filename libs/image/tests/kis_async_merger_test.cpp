@@ -31,6 +31,7 @@
 
 #include "kis_image_config.h"
 #include "KisImageConfigNotifier.h"
+#include "KisBelowStackCache.h"
 
 void KisAsyncMergerTest::init()
 {
@@ -496,6 +497,82 @@ void KisAsyncMergerTest::testFilterMaskOnFilterLayer()
                                   "async_merger_test", "mask_on_adj", "initial", 3));
 }
 
+    /*
+      +-----------+
+      |root       |
+      | paint 3   |
+      | paint 2   |
+      | paint 1   |
+      +-----------+
+     */
+
+void KisAsyncMergerTest::testBelowStackCache()
+{
+    const KoColorSpace *colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, 256, 256, colorSpace, "below stack cache test");
+
+    KisPaintLayerSP paintLayer1 = new KisPaintLayer(image, "paint1", OPACITY_OPAQUE_U8);
+    KisPaintLayerSP paintLayer2 = new KisPaintLayer(image, "paint2", 128);
+    KisPaintLayerSP paintLayer3 = new KisPaintLayer(image, "paint3", 200);
+
+    paintLayer1->paintDevice()->fill(image->bounds(), KoColor(Qt::red, colorSpace));
+    paintLayer2->paintDevice()->fill(QRect(64,64,128,128), KoColor(Qt::green, colorSpace));
+
+    image->addNode(paintLayer1, image->rootLayer());
+    image->addNode(paintLayer2, image->rootLayer());
+    image->addNode(paintLayer3, image->rootLayer());
+
+    KisBelowStackCache::setEnabled(true);
+
+    image->initialRefreshGraph();
+
+    KisBelowStackCache *cache = image->rootLayer()->belowStackCache();
+    const QRect dabRect(96,96,32,32);
+
+    // the first update fills the cache...
+    paintLayer3->paintDevice()->fill(dabRect, KoColor(Qt::blue, colorSpace));
+    paintLayer3->setDirty(dabRect);
+    image->waitForDone();
+
+    QVERIFY(cache->contains(paintLayer3.data(), dabRect));
+
+    // ... and the second one uses it
+    paintLayer3->paintDevice()->fill(dabRect, KoColor(Qt::white, colorSpace));
+    paintLayer3->setDirty(dabRect);
+    image->waitForDone();
+
+    QVERIFY(cache->contains(paintLayer3.data(), dabRect));
+
+    // changes below the active layer drop the cache
+    paintLayer1->paintDevice()->fill(dabRect, KoColor(Qt::black, colorSpace));
+    paintLayer1->setDirty(dabRect);
+    image->waitForDone();
+
+    QVERIFY(!cache->contains(paintLayer3.data(), dabRect));
+
+    paintLayer3->setDirty(dabRect);
+    image->waitForDone();
+
+    QVERIFY(cache->contains(paintLayer3.data(), dabRect));
+
+    KisPaintDeviceSP cachedProjection = new KisPaintDevice(*image->projection());
+
+    // disabling the cache frees its memory
+    KisBelowStackCache::setEnabled(false);
+
+    QVERIFY(!cache->contains(paintLayer3.data(), dabRect));
+    QVERIFY(!cache->device());
+
+    // the full refresh drops the cache as well
+    image->refreshGraph();
+    image->waitForDone();
+
+    QVERIFY(!cache->contains(paintLayer3.data(), dabRect));
+
+    QPoint pt;
+    QVERIFY(TestUtil::comparePaintDevices(pt, cachedProjection, image->projection()));
+}
+
 
 SIMPLE_TEST_MAIN(KisAsyncMergerTest)
 
@@ -34,5 +34,45 @@ void KisHistogramTest::testCreation()
     }
 }
 
+void KisHistogramTest::testAccumulatedBins()
+{
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect rc(0, 0, 150, 100);
+    QVector<quint8> pixels(rc.width() * rc.height() * cs->pixelSize());
+
+    for (int i = 0; i < pixels.size(); i++) {
+        pixels[i] = (i * 37 + i / 7) % 256;
+    }
+
+    // a few runs of transparent pixels, they should be skipped
+    for (int i = 0; i < rc.width() * rc.height(); i += 3 + i % 11) {
+        cs->setOpacity(pixels.data() + i * cs->pixelSize(), OPACITY_TRANSPARENT_U8, 1);
+    }
+
+    dev->writeBytes(pixels.data(), rc);
+
+    const QString id = KoHistogramProducerFactoryRegistry::instance()->keysCompatibleWith(cs).first();
+    KoHistogramProducer *producer = KoHistogramProducerFactoryRegistry::instance()->get(id)->generate();
+    QVERIFY(producer->canAddAccumulatedBins(cs));
+
+    KisHistogram histogram(dev, rc, producer, LINEAR);
+
+    QScopedPointer<KoHistogramProducer> reference(KoHistogramProducerFactoryRegistry::instance()->get(id)->generate());
+    reference->clear();
+
+    for (int i = 0; i < rc.width() * rc.height(); i++) {
+        reference->addRegionToBin(pixels.data() + i * cs->pixelSize(), 0, 1, cs);
+    }
+
+    QCOMPARE(producer->count(), reference->count());
+
+    for (int channel = 0; channel < producer->channels().size(); channel++) {
+        for (int bin = 0; bin < producer->numberOfBins(); bin++) {
+            QCOMPARE(producer->getBinAt(channel, bin), reference->getBinAt(channel, bin));
+        }
+    }
+}
 
 KISTEST_MAIN(KisHistogramTest)
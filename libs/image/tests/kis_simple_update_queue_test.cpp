@@ -140,6 +140,165 @@ void KisSimpleUpdateQueueTest::testSplit(bool useFullRefresh)
     QVERIFY(checkWalker(walkersList[3], QRect(512,512,488,488)));
 }
 
+void KisSimpleUpdateQueueTest::testScatteredUpdates()
+{
+    QRect imageRect(0,0,1024,1024);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    /**
+     * The first two dabs lie in the neighbouring tiles, so they are
+     * coalesced, the third one lies in a different update patch
+     */
+    QVector<QRect> dirtyRects;
+    dirtyRects << QRect(10,10,5,5);
+    dirtyRects << QRect(700,700,5,5);
+    dirtyRects << QRect(60,60,10,10);
+
+    KisTestableSimpleUpdateQueue queue;
+    KisWalkersList& walkersList = queue.getWalkersList();
+
+    queue.addUpdateJob(paintLayer, dirtyRects, imageRect, 0);
+
+    QCOMPARE(walkersList.size(), 2);
+    QVERIFY(checkWalker(walkersList[0], QRect(10,10,60,60)));
+    QVERIFY(checkWalker(walkersList[1], QRect(700,700,5,5)));
+}
+
+void KisSimpleUpdateQueueTest::testAdaptiveSplit()
+{
+    QRect imageRect(0,0,1024,1024);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    QRect dirtyRect1(0,0,1000,1000);
+
+    KisMergeCostEstimator estimator;
+    estimator.setNumThreads(8);
+
+    KisTestableSimpleUpdateQueue queue;
+    queue.setMergeCostEstimator(&estimator);
+    KisWalkersList& walkersList = queue.getWalkersList();
+
+    // no measurements yet, the default patch size is used
+    queue.addUpdateJob(paintLayer, dirtyRect1, imageRect, 0);
+    QCOMPARE(walkersList.size(), 4);
+    walkersList.clear();
+
+    /**
+     * A heavy job: 100ns per pixel makes 100ms for the whole rect,
+     * so every of 8 threads should get two patches
+     */
+    estimator.reportMergeJob(QRect(0,0,256,256), 1, 256 * 256 * 100);
+    QVERIFY(estimator.hasEstimation());
+
+    queue.addUpdateJob(paintLayer, dirtyRect1, imageRect, 0);
+
+    QCOMPARE(walkersList.size(), 16);
+    QVERIFY(checkWalker(walkersList[0], QRect(0,0,256,256)));
+    QVERIFY(checkWalker(walkersList[15], QRect(768,768,232,232)));
+
+    // the patches should not be joined back
+    queue.optimize();
+    QCOMPARE(walkersList.size(), 16);
+    walkersList.clear();
+
+    /**
+     * A cheap job is not worth splitting into small patches,
+     * the overhead would be higher than the compositing itself
+     */
+    estimator.reset();
+    estimator.reportMergeJob(QRect(0,0,256,256), 1, 256 * 256 / 100);
+
+    queue.addUpdateJob(paintLayer, dirtyRect1, imageRect, 0);
+    QCOMPARE(walkersList.size(), 4);
+    QVERIFY(checkWalker(walkersList[0], QRect(0,0,512,512)));
+}
+
+void KisSimpleUpdateQueueTest::testPriorityRect()
+{
+    KisTestableUpdaterContext context(1);
+
+    QRect imageRect(0,0,1024,1024);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    QRect offscreenRect(10,10,50,50);
+    QRect lodRect(100,100,20,20);
+    QRect visibleRect(700,700,50,50);
+
+    KisTestableSimpleUpdateQueue queue;
+
+    queue.addUpdateJob(paintLayer, offscreenRect, imageRect, 0);
+
+    {
+        TestUtil::LodOverride l(1, image);
+        queue.addUpdateJob(paintLayer, lodRect, imageRect, 1);
+    }
+
+    queue.addUpdateJob(paintLayer, visibleRect, imageRect, 0);
+
+    queue.setPriorityRect(QRect(512,512,512,512));
+
+    QVERIFY(queue.hasPendingUpdates(KisUpdatePriority::Visible));
+
+    queue.processQueue(context);
+    QVERIFY(checkWalker(context.getJobs()[0]->walker(), visibleRect));
+    context.clear();
+
+    QVERIFY(!queue.hasPendingUpdates(KisUpdatePriority::Visible));
+    QVERIFY(queue.hasPendingUpdates(KisUpdatePriority::LevelOfDetail));
+
+    queue.processQueue(context);
+    QVERIFY(checkWalker(context.getJobs()[0]->walker(), lodRect, 1));
+    context.clear();
+
+    QVERIFY(!queue.hasPendingUpdates(KisUpdatePriority::LevelOfDetail));
+    QVERIFY(queue.hasPendingUpdates(KisUpdatePriority::Offscreen));
+
+    queue.processQueue(context);
+    QVERIFY(checkWalker(context.getJobs()[0]->walker(), offscreenRect));
+    context.clear();
+
+    QVERIFY(queue.isEmpty());
+
+    /**
+     * Without the priority rect the jobs are processed
+     * in the order they were added
+     */
+    queue.setPriorityRect(QRect());
+
+    queue.addUpdateJob(paintLayer, offscreenRect, imageRect, 0);
+    queue.addUpdateJob(paintLayer, visibleRect, imageRect, 0);
+
+    QVERIFY(queue.hasPendingUpdates(KisUpdatePriority::Visible));
+
+    queue.processQueue(context);
+    QVERIFY(checkWalker(context.getJobs()[0]->walker(), offscreenRect));
+    context.clear();
+}
+
 void KisSimpleUpdateQueueTest::testChecksum()
 {
     QRect imageRect(0,0,512,512);
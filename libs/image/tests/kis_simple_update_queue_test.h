@@ -21,6 +21,9 @@ private Q_SLOTS:
     void testJobProcessing();
     void testSplitUpdate();
     void testSplitFullRefresh();
+    void testScatteredUpdates();
+    void testAdaptiveSplit();
+    void testPriorityRect();
     void testChecksum();
     void testMixingTypes();
     void testSpontaneousJobsCompression();
@@ -268,6 +268,23 @@ void KisUpdateSchedulerTest::testEmptyStroke()
     image->waitForDone();
 }
 
+void KisUpdateSchedulerTest::testWaitForUpdatesWithExclusiveStroke()
+{
+    KisImageSP image = buildTestingImage();
+    KisNodeSP paintLayer1 = image->rootLayer()->firstChild();
+
+    KisStrokeId id = image->startStroke(new KisTestingStrokeStrategy(QLatin1String("excl_"), true, false));
+
+    paintLayer1->setDirty(image->bounds());
+
+    // the opened exclusive stroke blocks the updates, so the call
+    // should return instead of waiting forever
+    image->waitForUpdates(KisUpdatePriority::Offscreen);
+
+    image->endStroke(id);
+    image->waitForDone();
+}
+
 #include "kis_lazy_wait_condition.h"
 
 void KisUpdateSchedulerTest::testLazyWaitCondition()
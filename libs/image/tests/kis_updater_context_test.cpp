@@ -10,6 +10,9 @@
 #include "kistest.h"
 
 #include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRandomGenerator>
 #include <KoColorSpace.h>
 #include <KoColorSpaceRegistry.h>
 
@@ -202,9 +205,21 @@ private:
     QAtomicInt &m_hadConcurrency;
 };
 
+void KisUpdaterContextTest::stressTestExclusiveJobs_data()
+{
+    QTest::addColumn<bool>("useWorkStealing");
+
+    QTest::newRow("thread-pool") << false;
+    QTest::newRow("work-stealing") << true;
+}
+
 void KisUpdaterContextTest::stressTestExclusiveJobs()
 {
+    QFETCH(bool, useWorkStealing);
+
     KisUpdaterContext context(NUM_THREADS);
+    context.setUseWorkStealing(useWorkStealing);
+
     QAtomicInt counter;
     QAtomicInt hadConcurrency;
 
@@ -235,5 +250,125 @@ void KisUpdaterContextTest::stressTestExclusiveJobs()
              << "/" << NUM_CHECKS * NUM_JOBS;
 }
 
+/**
+ * The layer checks that no two merge jobs touch intersecting
+ * areas of its projection at the same time
+ */
+class ConflictsCheckerLayer : public KisPaintLayer
+{
+public:
+    ConflictsCheckerLayer(KisImageWSP image, QAtomicInt &numConflicts, QAtomicInt &hadConcurrency)
+        : KisPaintLayer(image, "checker", OPACITY_OPAQUE_U8),
+          m_numConflicts(numConflicts),
+          m_hadConcurrency(hadConcurrency)
+    {
+    }
+
+    bool needProjection() const override {
+        return true;
+    }
+
+protected:
+    void copyOriginalToProjection(const KisPaintDeviceSP original,
+                                  KisPaintDeviceSP projection,
+                                  const QRect& rect) const override {
+        {
+            QMutexLocker l(&m_lock);
+
+            Q_FOREACH (const QRect &rc, m_rectsInProgress) {
+                if (rc.intersects(rect)) {
+                    m_numConflicts.ref();
+                }
+            }
+
+            if (!m_rectsInProgress.isEmpty()) {
+                m_hadConcurrency.ref();
+            }
+
+            m_rectsInProgress.append(rect);
+        }
+
+        QTest::qSleep(CHECK_DELAY);
+        KisPaintLayer::copyOriginalToProjection(original, projection, rect);
+
+        QMutexLocker l(&m_lock);
+        m_rectsInProgress.removeOne(rect);
+    }
+
+private:
+    QAtomicInt &m_numConflicts;
+    QAtomicInt &m_hadConcurrency;
+
+    mutable QMutex m_lock;
+    mutable QVector<QRect> m_rectsInProgress;
+};
+
+void KisUpdaterContextTest::stressTestMergeJobsConflicts_data()
+{
+    QTest::addColumn<bool>("useWorkStealing");
+
+    QTest::newRow("thread-pool") << false;
+    QTest::newRow("work-stealing") << true;
+}
+
+void KisUpdaterContextTest::stressTestMergeJobsConflicts()
+{
+    QFETCH(bool, useWorkStealing);
+
+    const QRect imageRect(0,0,512,512);
+    const int patchSize = 64;
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    QAtomicInt numConflicts;
+    QAtomicInt hadConcurrency;
+
+    KisPaintLayerSP paintLayer = new ConflictsCheckerLayer(image, numConflicts, hadConcurrency);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+    image->waitForDone();
+
+    KisUpdaterContext context(NUM_THREADS);
+    context.setUseWorkStealing(useWorkStealing);
+
+    QRandomGenerator random(0);
+    int numStartedJobs = 0;
+
+    for(int i = 0; i < NUM_JOBS; i++) {
+        const QRect dirtyRect(random.bounded(imageRect.width() - patchSize),
+                              random.bounded(imageRect.height() - patchSize),
+                              patchSize, patchSize);
+
+        KisBaseRectsWalkerSP walker = new KisMergeWalker(imageRect);
+        walker->collectRects(paintLayer, dirtyRect);
+
+        /**
+         * The walkers that intersect with the running ones are just
+         * dropped, the check is exactly the same as in
+         * KisSimpleUpdateQueue::processOneJob()
+         */
+        context.lock();
+        if (context.hasSpareThread() && context.isJobAllowed(walker)) {
+            context.addMergeJob(walker);
+            numStartedJobs++;
+        }
+        context.unlock();
+
+        if (!context.hasSpareThread()) {
+            QTest::qSleep(CHECK_DELAY);
+        }
+    }
+
+    context.waitForDone();
+
+    QVERIFY(numStartedJobs > 0);
+    QCOMPARE(int(numConflicts), 0);
+    dbgKrita << "Merge jobs started:" << numStartedJobs
+             << "concurrency observed:" << hadConcurrency;
+}
+
 KISTEST_MAIN(KisUpdaterContextTest)
 
@@ -16,7 +16,10 @@ class KisUpdaterContextTest : public QObject
 private Q_SLOTS:
     void testJobInterference();
     void testSnapshot();
+    void stressTestExclusiveJobs_data();
     void stressTestExclusiveJobs();
+    void stressTestMergeJobsConflicts_data();
+    void stressTestMergeJobsConflicts();
 };
 
 #endif /* KIS_UPDATER_CONTEXT_TEST_H */
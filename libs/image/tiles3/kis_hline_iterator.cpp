@@ -149,8 +149,7 @@ bool KisHLineIterator2::nextPixels(qint32 n)
 KisHLineIterator2::~KisHLineIterator2()
 {
     for (uint i = 0; i < m_tilesCacheSize; i++) {
-        unlockTile(m_tilesCache[i].tile);
-        unlockOldTile(m_tilesCache[i].oldtile);
+        releaseTileDataFromCache(m_tilesCache[i]);
     }
 }
 
@@ -176,11 +175,13 @@ void KisHLineIterator2::switchToTile(qint32 xInTile)
     // The caller must ensure that we are not out of bounds
     Q_ASSERT(m_index < m_tilesCacheSize);
 
-    m_data = m_tilesCache[m_index].data;
-    m_oldData = m_tilesCache[m_index].oldData;
+    const KisTileInfo &kti = m_tilesCache[m_index];
+
+    m_data = kti.data;
+    m_oldData = kti.oldData;
 
     int offset_row = m_pixelSize * (m_yInTile * KisTileData::WIDTH);
-    m_data += offset_row;
+    m_data += m_yInTile * kti.rowStride;
     m_rightmostInTile = (m_leftCol + m_index + 1) * KisTileData::WIDTH - 1;
     int offset_col = m_pixelSize * xInTile;
     m_data  += offset_col;
@@ -192,18 +193,39 @@ void KisHLineIterator2::fetchTileDataForCache(KisTileInfo& kti, qint32 col, qint
 {
     m_dataManager->getTilesPair(col, row, m_writable, &kti.tile, &kti.oldtile);
 
-    lockTile(kti.tile);
-    kti.data = kti.tile->data();
+    if (m_writable) {
+        lockTile(kti.tile);
+        kti.data = kti.tile->data();
+        kti.lockedTileData = 0;
+        kti.rowStride = m_pixelSize * KisTileData::WIDTH;
+    } else {
+        const quint8 *data = 0;
+        kti.lockedTileData = kti.tile->lockTileDataForRead(data, kti.rowStride);
+
+        // the iterator is read-only, so the data is never written
+        kti.data = const_cast<quint8*>(data);
+    }
 
     lockOldTile(kti.oldtile);
     kti.oldData = kti.oldtile->data();
 }
 
+void KisHLineIterator2::releaseTileDataFromCache(KisTileInfo& kti)
+{
+    if (kti.lockedTileData) {
+        KisTile::unlockTileDataForRead(kti.lockedTileData);
+        kti.lockedTileData = 0;
+    } else {
+        unlockTile(kti.tile);
+    }
+
+    unlockOldTile(kti.oldtile);
+}
+
 void KisHLineIterator2::preallocateTiles()
 {
     for (quint32 i = 0; i < m_tilesCacheSize; ++i){
-        unlockTile(m_tilesCache[i].tile);
-        unlockOldTile(m_tilesCache[i].oldtile);
+        releaseTileDataFromCache(m_tilesCache[i]);
         fetchTileDataForCache(m_tilesCache[i], m_leftCol + i, m_row);
     }
 }
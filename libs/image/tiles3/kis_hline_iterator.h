@@ -21,6 +21,14 @@ public:
         KisTileSP oldtile;
         quint8* data;
         quint8* oldData;
+
+        /**
+         * Read-only iterators lock the tile data directly, so that
+         * a constant tile data is not materialized. In such a case
+         * all the rows share the same pixels and rowStride is zero.
+         */
+        KisTileData *lockedTileData;
+        qint32 rowStride;
     };
 
 
@@ -72,6 +80,7 @@ private:
 
     void switchToTile(qint32 xInTile);
     void fetchTileDataForCache(KisTileInfo& kti, qint32 col, qint32 row);
+    void releaseTileDataFromCache(KisTileInfo& kti);
     void preallocateTiles();
 };
 #endif
@@ -225,6 +225,16 @@ void KisTile::lockForWrite()
 
     blockSwapping();
 
+    /**
+     * The tile data registered in the deduplication index may be
+     * written in place only after it has been dropped from the index,
+     * otherwise someone could start sharing it while we write. Those
+     * who have managed to share it before are handled by COW below.
+     */
+    if (m_tileData->m_deduplicated.loadAcquire()) {
+        m_tileData->m_store->dropDeduplicatedTileData(m_tileData);
+    }
+
     /* We are doing COW here */
     if (lazyCopying()) {
         m_COWMutex.lock();
@@ -260,6 +270,25 @@ void KisTile::lockForWrite()
     DEBUG_LOG_ACTION("lock [W]");
 }
 
+void KisTile::deduplicateTileData()
+{
+    QMutexLocker locker(&m_COWMutex);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!m_lockCounter);
+
+    KisTileData *tileData = m_tileData->m_store->deduplicateTileData(m_tileData);
+
+    if (tileData != m_tileData) {
+        KisTileData *oldTileData = m_tileData;
+        m_tileData = tileData;
+        oldTileData->release();
+
+        KisMementoManager *mm = m_mementoManager.load();
+        if (mm) {
+            mm->registerTileChange(this);
+        }
+    }
+}
+
 void KisTile::unlockForWrite()
 {
     unblockSwapping();
@@ -283,6 +312,39 @@ void KisTile::unlockForRead() const
 }
 
 
+KisTileData* KisTile::lockTileDataForRead(const quint8 *&data, qint32 &rowStride)
+{
+    /**
+     * The tile data may be replaced by COW at any moment, so
+     * reference it while holding the COW mutex
+     */
+    m_COWMutex.lock();
+    KisTileData *tileData = m_tileData;
+    tileData->ref();
+    m_COWMutex.unlock();
+
+    bool isConstant = false;
+    data = tileData->blockSwappingForRead(isConstant);
+    rowStride = isConstant ? 0 : KisTileData::WIDTH * tileData->pixelSize();
+
+    DEBUG_LOG_ACTION("lock [R, td]");
+
+    return tileData;
+}
+
+void KisTile::unlockTileDataForRead(KisTileData *td)
+{
+    td->unblockSwapping();
+    td->deref();
+}
+
+KisTileData* KisTile::referenceTileData()
+{
+    QMutexLocker locker(&m_COWMutex);
+    m_tileData->ref();
+    return m_tileData;
+}
+
 #include <stdio.h>
 void KisTile::debugPrintInfo()
 {
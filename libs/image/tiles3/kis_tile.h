@@ -75,11 +75,38 @@ public:
     void debugPrintInfo();
     void debugDumpTile();
 
+    /**
+     * Makes the tile share its tile data with another tile data of
+     * exactly the same content, if the store knows one. The content
+     * of the tile must not be changed concurrently, and the tile
+     * must not be locked by the caller.
+     *
+     * \see KisTileDataStore::deduplicateTileData()
+     */
+    void deduplicateTileData();
+
     void lockForRead() const;
     void lockForWrite();
     void unlockForWrite();
     void unlockForRead() const;
 
+    /**
+     * Locks the current tile data of the tile for reading. Unlike
+     * lockForRead(), it doesn't materialize a tile data stored in a
+     * constant form. \p data is set to the pixels of the tile and
+     * \p rowStride to the distance between its rows, which is zero
+     * for a constant tile data. The returned tile data must be passed
+     * to unlockTileDataForRead() when reading is finished.
+     */
+    KisTileData* lockTileDataForRead(const quint8 *&data, qint32 &rowStride);
+    static void unlockTileDataForRead(KisTileData *td);
+
+    /**
+     * Returns the current tile data of the tile with its reference
+     * counter incremented. The caller must deref() it when done.
+     */
+    KisTileData* referenceTileData();
+
 
     /* this allows us work directly on tile's data */
     inline quint8 *data() const {
@@ -10,6 +10,8 @@
 #include "kis_tile_data_store.h"
 
 #include <kis_debug.h>
+#include <QVector>
+#include <QMutex>
 
 #include <boost/pool/singleton_pool.hpp>
 #include "kis_tile_data_store_iterators.h"
@@ -21,11 +23,159 @@
 typedef boost::singleton_pool<KisTileData, TILE_SIZE_4BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 256, 4096> BoostPool4BPP;
 typedef boost::singleton_pool<KisTileData, TILE_SIZE_8BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 128, 2048> BoostPool8BPP;
 
-const qint32 KisTileData::WIDTH = __TILE_DATA_WIDTH;
-const qint32 KisTileData::HEIGHT = __TILE_DATA_HEIGHT;
+constexpr qint32 KisTileData::WIDTH;
+constexpr qint32 KisTileData::HEIGHT;
 
 SimpleCache KisTileData::m_cache;
 
+/**
+ * Incremented every time the pools are purged in
+ * releaseInternalPools(). The blocks cached by the threads
+ * before that moment do not exist anymore. The generation is
+ * changed *before* the pools are purged, so a thread that sees
+ * the same generation after taking a block from its cache can
+ * be sure the block is still alive.
+ */
+static QAtomicInt s_poolsGeneration;
+
+/**
+ * Serializes purging of the pools with the exiting threads
+ * returning their cached blocks into the shared cache
+ */
+static QMutex s_poolsPurgeLock;
+
+/**
+ * Every thread keeps a small stack of free tile blocks of each pooled
+ * size. A block freed by a thread is put into its own stack without any
+ * locking or atomic operations, and the next allocation in the same
+ * thread takes it back from there. Apart from avoiding contention on the
+ * shared pools, it keeps the blocks in the memory of the NUMA node the
+ * thread is running on. When the stack is full or empty, the shared
+ * lockless cache and the pools are used as before.
+ */
+class KisTileDataThreadCache
+{
+public:
+    KisTileDataThreadCache()
+        : m_generation(s_poolsGeneration.loadAcquire())
+    {
+        for (int i = 0; i < NumSlots; i++) {
+            m_blocks[i].reserve(capacity(slotPixelSize(i)));
+        }
+    }
+
+    ~KisTileDataThreadCache()
+    {
+        QMutexLocker l(&s_poolsPurgeLock);
+        checkGeneration();
+
+        // return the blocks of the exiting thread to the shared cache
+        for (int i = 0; i < NumSlots; i++) {
+            for (auto it = m_blocks[i].begin(); it != m_blocks[i].end(); ++it) {
+                KisTileData::m_cache.push(slotPixelSize(i), *it);
+            }
+        }
+    }
+
+    inline bool pop(qint32 pixelSize, quint8 *&ptr) {
+        const int slot = slotForPixelSize(pixelSize);
+        if (slot < 0) return false;
+
+        checkGeneration();
+
+        QVector<quint8*> &blocks = m_blocks[slot];
+        if (blocks.isEmpty()) return false;
+
+        ptr = blocks.takeLast();
+
+        /**
+         * The pools could have been purged while we were taking the
+         * block, then it should be dropped together with the rest
+         * of the stack.
+         */
+        if (isPooledSlot(slot) &&
+            s_poolsGeneration.loadAcquire() != m_generation) {
+
+            ptr = 0;
+            checkGeneration();
+            return false;
+        }
+
+        return true;
+    }
+
+    inline bool push(qint32 pixelSize, quint8 *ptr) {
+        const int slot = slotForPixelSize(pixelSize);
+        if (slot < 0) return false;
+
+        checkGeneration();
+
+        QVector<quint8*> &blocks = m_blocks[slot];
+        if (blocks.size() >= capacity(pixelSize)) return false;
+
+        blocks.append(ptr);
+        return true;
+    }
+
+private:
+    enum {
+        NumSlots = 3,
+        BytesPerSlot = 512 * 1024
+    };
+
+    static inline int slotForPixelSize(qint32 pixelSize) {
+        switch (pixelSize) {
+        case 4:
+            return 0;
+        case 8:
+            return 1;
+        case 16:
+            return 2;
+        default:
+            return -1;
+        }
+    }
+
+    static inline qint32 slotPixelSize(int slot) {
+        return 4 << slot;
+    }
+
+    static inline bool isPooledSlot(int slot) {
+        return slot < 2;
+    }
+
+    static inline int capacity(qint32 pixelSize) {
+        return BytesPerSlot / (pixelSize * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT);
+    }
+
+    inline void checkGeneration() {
+        const int generation = s_poolsGeneration.loadAcquire();
+
+        if (generation != m_generation) {
+            for (int i = 0; i < NumSlots; i++) {
+                /**
+                 * The pooled blocks have been purged together with
+                 * the pools, the malloc'ed ones should be freed the
+                 * same way SimpleCache::clear() does
+                 */
+                if (!isPooledSlot(i)) {
+                    Q_FOREACH (quint8 *ptr, m_blocks[i]) {
+                        free(ptr);
+                    }
+                }
+                m_blocks[i].clear();
+            }
+            m_generation = generation;
+        }
+    }
+
+private:
+    QVector<quint8*> m_blocks[NumSlots];
+    int m_generation;
+};
+
+static thread_local KisTileDataThreadCache s_threadCache;
+
 SimpleCache::~SimpleCache()
 {
     clear();
@@ -52,6 +202,9 @@ void SimpleCache::clear()
 
 KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataStore *store, bool checkFreeMemory)
     : m_state(NORMAL),
+      m_constantRow(0),
+      m_deduplicated(0),
+      m_contentHash(0),
       m_mementoFlag(0),
       m_age(0),
       m_usersCount(0),
@@ -81,6 +234,9 @@ KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataSt
  */
 KisTileData::KisTileData(const KisTileData& rhs, bool checkFreeMemory)
     : m_state(NORMAL),
+      m_constantRow(0),
+      m_deduplicated(0),
+      m_contentHash(0),
       m_mementoFlag(0),
       m_age(0),
       m_usersCount(0),
@@ -100,6 +256,7 @@ KisTileData::KisTileData(const KisTileData& rhs, bool checkFreeMemory)
 KisTileData::~KisTileData()
 {
     releaseMemory();
+    delete[] m_constantRow;
 }
 
 void KisTileData::fillWithPixel(const quint8 *defPixel)
@@ -136,7 +293,9 @@ quint8* KisTileData::allocateData(const qint32 pixelSize)
 {
     quint8 *ptr = 0;
 
-    if (!m_cache.pop(pixelSize, ptr)) {
+    if (!s_threadCache.pop(pixelSize, ptr) &&
+        !m_cache.pop(pixelSize, ptr)) {
+
         switch (pixelSize) {
         case 4:
             ptr = (quint8*)BoostPool4BPP::malloc();
@@ -155,7 +314,9 @@ quint8* KisTileData::allocateData(const qint32 pixelSize)
 
 void KisTileData::freeData(quint8* ptr, const qint32 pixelSize)
 {
-    if (!m_cache.push(pixelSize, ptr)) {
+    if (!s_threadCache.push(pixelSize, ptr) &&
+        !m_cache.push(pixelSize, ptr)) {
+
         switch (pixelSize) {
         case 4:
             BoostPool4BPP::free(ptr);
@@ -221,9 +382,14 @@ void KisTileData::releaseInternalPools()
 
         if (!failedToLock) {
             // purge the pools memory
-            m_cache.clear();
-            BoostPool4BPP::purge_memory();
-            BoostPool8BPP::purge_memory();
+            {
+                QMutexLocker l(&s_poolsPurgeLock);
+
+                s_poolsGeneration.ref();
+                m_cache.clear();
+                BoostPool4BPP::purge_memory();
+                BoostPool8BPP::purge_memory();
+            }
 
             auto it = dataObjects.begin();
             auto chunkIt = memoryChunks.constBegin();
@@ -53,7 +53,17 @@ inline bool KisTileData::acquire() {
 }
 
 inline bool KisTileData::release() {
-    m_usersCount.deref();
+    /**
+     * The deduplication index doesn't own its tile data, so the
+     * data should be dropped from it when the last user goes away,
+     * that is before the data can be freed
+     */
+    if (m_usersCount.fetchAndAddOrdered(-1) == 1 &&
+        m_deduplicated.loadAcquire()) {
+
+        m_store->dropDeduplicatedTileData(this);
+    }
+
     bool _ref = deref();
     return _ref;
 }
@@ -85,6 +95,25 @@ inline void KisTileData::blockSwapping() {
     resetAge();
 }
 
+inline const quint8* KisTileData::blockSwappingForRead(bool &isConstant) {
+    m_swapLock.lockForRead();
+
+    if (!m_data && m_state == CONSTANT) {
+        isConstant = true;
+        return m_constantRow;
+    }
+
+    isConstant = false;
+
+    if (!m_data) {
+        m_swapLock.unlock();
+        m_store->ensureTileDataLoaded(this);
+    }
+    resetAge();
+
+    return m_data;
+}
+
 inline void KisTileData::unblockSwapping() {
     m_swapLock.unlock();
 }
@@ -14,6 +14,8 @@
 #include "kis_lockless_stack.h"
 #include "swap/kis_chunk_allocator.h"
 
+#include "config-tile-size.h"
+
 class KisTileData;
 class KisTileDataStore;
 
@@ -21,8 +23,12 @@ class KisTileDataStore;
  * WARNING: Those definitions for internal use only!
  * Please use KisTileData::WIDTH/HEIGHT instead
  */
-#define __TILE_DATA_WIDTH 64
-#define __TILE_DATA_HEIGHT 64
+#define __TILE_DATA_WIDTH KRITA_TILE_SIZE
+#define __TILE_DATA_HEIGHT KRITA_TILE_SIZE
+
+static_assert(__TILE_DATA_WIDTH >= 32 && __TILE_DATA_WIDTH <= 256 &&
+              !(__TILE_DATA_WIDTH & (__TILE_DATA_WIDTH - 1)),
+              "Tile size must be a power of two in range [32, 256]");
 
 typedef KisLocklessStack<KisTileData*> KisTileDataCache;
 
@@ -99,7 +105,8 @@ public:
     enum EnumTileDataState {
         NORMAL = 0,
         COMPRESSED,
-        SWAPPED
+        SWAPPED,
+        CONSTANT
     };
 
     /**
@@ -147,6 +154,16 @@ public:
     inline void blockSwapping();
     inline void unblockSwapping();
 
+    /**
+     * Same as blockSwapping(), but doesn't materialize the tile data
+     * if it is stored in a constant form. In such a case \p isConstant
+     * is set to true and the returned pointer points to a single row of
+     * pixels, which is the same for all the rows of the tile. The
+     * returned pixels must not be modified. Unlock the tile data with
+     * unblockSwapping().
+     */
+    inline const quint8* blockSwappingForRead(bool &isConstant);
+
     /**
      * The position of the tile data in a swap file
      */
@@ -252,6 +269,28 @@ private:
      */
     KisChunk m_swapChunk;
 
+    /**
+     * When all the pixels of the tile data are the same, the store may
+     * free m_data and keep only a single row of the pixels here. The
+     * state is set to CONSTANT then. The data is materialized back on
+     * the first access that needs the whole tile.
+     */
+    quint8 *m_constantRow;
+
+
+    /**
+     * Set by KisTileDataStore when the tile data is registered in its
+     * deduplication index. The index doesn't hold a user of the tile
+     * data, so the data is dropped from it before being written in
+     * place or when the last user releases it.
+     */
+    QAtomicInt m_deduplicated;
+
+    /**
+     * The hash of the content the tile data has been registered in
+     * the deduplication index with
+     */
+    uint m_contentHash;
 
     /**
      * The flag is set by KisMementoItem to show this
@@ -307,9 +346,17 @@ private:
     KisTileDataStore *m_store;
     static SimpleCache m_cache;
 
+    friend class KisTileDataThreadCache;
+
 public:
-    static const qint32 WIDTH;
-    static const qint32 HEIGHT;
+    /**
+     * The size of the tiles is selected at build time with
+     * KRITA_TILE_SIZE cmake option. It is a compile-time constant,
+     * so that the compiler could replace all the divisions and
+     * modulos in the iterators with shifts and masks.
+     */
+    static constexpr qint32 WIDTH = __TILE_DATA_WIDTH;
+    static constexpr qint32 HEIGHT = __TILE_DATA_HEIGHT;
 };
 
 #endif /* KIS_TILE_DATA_INTERFACE_H_ */
@@ -9,6 +9,9 @@
 #include "config-memory-leak-tracker.h"
 
 #include <QGlobalStatic>
+#include <QVector>
+
+#include <algorithm>
 
 #include "kis_tile_data_store.h"
 #include "kis_tile_data.h"
@@ -58,17 +61,22 @@ qint64 __preclone_miss_age = 0;
 KisTileDataStore::KisTileDataStore()
     : m_pooler(this),
       m_swapper(this),
+      m_prefetcher(this),
       m_numTiles(0),
+      m_numConstantTiles(0),
+      m_numBudgetEvictions(0),
       m_memoryMetric(0),
       m_counter(1),
       m_clockIndex(1)
 {
     m_pooler.start();
     m_swapper.start();
+    m_prefetcher.start();
 }
 
 KisTileDataStore::~KisTileDataStore()
 {
+    m_prefetcher.terminatePrefetcher();
     m_pooler.terminatePooler();
     m_swapper.terminateSwapper();
 
@@ -99,6 +107,24 @@ KisTileDataStore::MemoryStatistics KisTileDataStore::memoryStatistics()
     stats.totalMemorySize = memoryMetric() * metricCoeff + stats.poolSize;
 
     stats.swapSize = m_swappedStore.totalMemoryMetric() * metricCoeff;
+    stats.swapRemapsCount = m_swappedStore.numSwapRemaps();
+    stats.swapInCount = m_swappedStore.numSwapIns();
+    stats.swapOutCount = m_swappedStore.numSwapOuts();
+    stats.prefetchedCount = m_prefetcher.numPrefetchedTiles();
+    stats.budgetEvictionsCount = m_numBudgetEvictions.loadAcquire();
+
+    stats.deduplicatedSize = 0;
+    {
+        QMutexLocker locker(&m_deduplicationLock);
+
+        Q_FOREACH (KisTileData *td, m_deduplicationIndex) {
+            const qint32 numSharingUsers = td->numUsers();
+            if (numSharingUsers > 1) {
+                stats.deduplicatedSize +=
+                    (numSharingUsers - 1) * td->pixelSize() * metricCoeff;
+            }
+        }
+    }
 
     return stats;
 }
@@ -177,8 +203,14 @@ KisTileData *KisTileDataStore::duplicateTileData(KisTileData *rhs)
         DEBUG_PRECLONE_ACTION("+ Pre-clone HIT", rhs, td);
         DEBUG_COUNT_PRECLONE_HIT(rhs);
     } else {
-        rhs->blockSwapping();
-        td = new KisTileData(*rhs);
+        bool isConstant = false;
+        const quint8 *data = rhs->blockSwappingForRead(isConstant);
+
+        // a constant tile data can be cloned without materializing it
+        td = isConstant ?
+            new KisTileData(rhs->pixelSize(), data, this) :
+            new KisTileData(*rhs);
+
         rhs->unblockSwapping();
         DEBUG_PRECLONE_ACTION("- Pre-clone #MISS#", rhs, td);
         DEBUG_COUNT_PRECLONE_MISS(rhs);
@@ -198,7 +230,11 @@ void KisTileDataStore::freeTileData(KisTileData *td)
     td->m_swapLock.lockForWrite();
 
     if (!td->data()) {
-        m_swappedStore.forgetTileData(td);
+        if (td->m_state == KisTileData::CONSTANT) {
+            m_numConstantTiles.deref();
+        } else {
+            m_swappedStore.forgetTileData(td);
+        }
     } else {
         unregisterTileDataImp(td);
     }
@@ -241,7 +277,11 @@ void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
         if (!td->data()) {
             td->m_swapLock.lockForWrite();
 
-            m_swappedStore.swapInTileData(td);
+            if (td->m_state == KisTileData::CONSTANT) {
+                materializeConstantTileData(td);
+            } else {
+                m_swappedStore.swapInTileData(td);
+            }
             registerTileDataImp(td);
 
             td->m_swapLock.unlock();
@@ -257,6 +297,101 @@ void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
     }
 }
 
+bool KisTileDataStore::prefetchTileData(KisTileData *td)
+{
+    td->m_swapLock.lockForRead();
+    const bool needsLoading = !td->data() && td->m_state != KisTileData::CONSTANT;
+    td->m_swapLock.unlock();
+
+    if (!needsLoading) return false;
+
+    /**
+     * blockSwappingForRead() does all the heavy locking and doesn't
+     * materialize the tile if it has become constant meanwhile
+     */
+    bool isConstant = false;
+    td->blockSwappingForRead(isConstant);
+    td->unblockSwapping();
+
+    return !isConstant;
+}
+
+KisTileData* KisTileDataStore::deduplicateTileData(KisTileData *td)
+{
+    const qint32 pixelSize = td->pixelSize();
+    const qint32 dataSize = pixelSize * KisTileData::WIDTH * KisTileData::HEIGHT;
+
+    td->blockSwapping();
+    const uint hash = qHashBits(td->data(), dataSize, pixelSize);
+
+    /**
+     * Candidates are acquired while the index is locked, so they
+     * cannot be freed or changed in place while we compare the
+     * content. The tile data that lost its last user is skipped,
+     * it is being dropped from the index right now. The comparison
+     * itself may need to swap the candidates in, so it is done
+     * without holding the lock.
+     */
+    QVector<KisTileData*> candidates;
+    {
+        QMutexLocker locker(&m_deduplicationLock);
+
+        auto it = m_deduplicationIndex.constFind(hash);
+        for (; it != m_deduplicationIndex.constEnd() && it.key() == hash; ++it) {
+            KisTileData *candidate = it.value();
+            if (candidate != td &&
+                candidate->pixelSize() == td->pixelSize() &&
+                candidate->numUsers() > 0) {
+
+                candidate->acquire();
+                candidates << candidate;
+            }
+        }
+    }
+
+    KisTileData *result = 0;
+
+    Q_FOREACH (KisTileData *candidate, candidates) {
+        if (!result) {
+            candidate->blockSwapping();
+            if (!memcmp(candidate->data(), td->data(), dataSize)) {
+                result = candidate;
+            }
+            candidate->unblockSwapping();
+        }
+
+        if (candidate != result) {
+            candidate->release();
+        }
+    }
+
+    if (!result) {
+        QMutexLocker locker(&m_deduplicationLock);
+
+        if (!td->m_deduplicated.loadAcquire()) {
+            td->m_contentHash = hash;
+            td->m_deduplicated.storeRelease(1);
+            m_deduplicationIndex.insert(hash, td);
+        }
+
+        result = td;
+    }
+
+    td->unblockSwapping();
+
+    return result;
+}
+
+void KisTileDataStore::dropDeduplicatedTileData(KisTileData *td)
+{
+    QMutexLocker locker(&m_deduplicationLock);
+
+    if (!td->m_deduplicated.loadAcquire()) return;
+
+    m_deduplicationIndex.remove(td->m_contentHash, td);
+    td->m_deduplicated.storeRelease(0);
+}
+
 bool KisTileDataStore::trySwapTileData(KisTileData *td)
 {
     /**
@@ -267,7 +402,13 @@ bool KisTileDataStore::trySwapTileData(KisTileData *td)
     if (!td->m_swapLock.tryLockForWrite()) return result;
 
     if (td->data()) {
-        if (m_swappedStore.trySwapOutTileData(td)) {
+        /**
+         * A uniform tile doesn't need to go to the swap file: keeping
+         * a single row of it in memory is cheaper than any compression
+         */
+        if (tryMakeTileDataConstantImp(td) ||
+            m_swappedStore.trySwapOutTileData(td)) {
+
             unregisterTileDataImp(td);
             result = true;
         }
@@ -277,6 +418,130 @@ bool KisTileDataStore::trySwapTileData(KisTileData *td)
     return result;
 }
 
+qint64 KisTileDataStore::swapOutLeastRecentlyUsed(const QVector<KisTileData*> &tileDataList,
+                                                  qint64 budget)
+{
+    // the same tile data may be shared by several devices
+    QVector<KisTileData*> sortedList = tileDataList;
+    std::sort(sortedList.begin(), sortedList.end());
+    sortedList.erase(std::unique(sortedList.begin(), sortedList.end()), sortedList.end());
+
+    qint64 residentBytes = 0;
+
+    /**
+     * The swapper ages the tiles only when the memory is short, so
+     * every budget enforcement ages the tiles of the list as well.
+     * Then the age of a tile is the number of enforcements it has
+     * survived without being accessed, which gives the LRU order
+     * even when no pressure passes happen.
+     */
+    Q_FOREACH (KisTileData *td, sortedList) {
+        if (td->data()) {
+            residentBytes += td->pixelSize() * KisTileData::WIDTH * KisTileData::HEIGHT;
+        }
+        td->markOld();
+    }
+
+    const qint64 bytesToFree = residentBytes - budget;
+    qint64 freedBytes = 0;
+
+    if (bytesToFree > 0) {
+        std::stable_sort(sortedList.begin(), sortedList.end(),
+                         [] (const KisTileData *lhs, const KisTileData *rhs) {
+                             return lhs->age() > rhs->age();
+                         });
+
+        /**
+         * trySwapTileData() should be called with the iterator lock
+         * held, see its comment. The lock blocks creation and deletion
+         * of all the tiles, so it is released after every batch.
+         */
+        const int batchSize = 64;
+        int i = 0;
+
+        while (i < sortedList.size() && freedBytes < bytesToFree) {
+            QWriteLocker locker(&m_iteratorLock);
+
+            const int batchEnd = qMin(i + batchSize, sortedList.size());
+
+            for (; i < batchEnd && freedBytes < bytesToFree; i++) {
+                KisTileData *td = sortedList[i];
+
+                if (trySwapTileData(td)) {
+                    freedBytes += td->pixelSize() * KisTileData::WIDTH * KisTileData::HEIGHT;
+                    m_numBudgetEvictions.ref();
+                }
+            }
+        }
+    }
+
+    Q_FOREACH (KisTileData *td, tileDataList) {
+        td->deref();
+    }
+
+    return freedBytes;
+}
+
+bool KisTileDataStore::tryMakeTileDataConstant(KisTileData *td)
+{
+    QReadLocker lock(&m_iteratorLock);
+    QWriteLocker swapLock(&td->m_swapLock);
+
+    bool result = false;
+
+    if (td->data() && tryMakeTileDataConstantImp(td)) {
+        unregisterTileDataImp(td);
+        result = true;
+    }
+
+    return result;
+}
+
+bool KisTileDataStore::tryMakeTileDataConstantImp(KisTileData *td)
+{
+    const qint32 pixelSize = td->pixelSize();
+    const qint32 dataSize = pixelSize * KisTileData::WIDTH * KisTileData::HEIGHT;
+    const quint8 *data = td->data();
+
+    /**
+     * If every pixel is equal to the next one, then all the
+     * pixels are equal to the first one
+     */
+    if (memcmp(data, data + pixelSize, dataSize - pixelSize) != 0) {
+        return false;
+    }
+
+    const qint32 rowSize = pixelSize * KisTileData::WIDTH;
+    td->m_constantRow = new quint8[rowSize];
+    memcpy(td->m_constantRow, data, rowSize);
+
+    td->releaseMemory();
+    td->m_state = KisTileData::CONSTANT;
+    m_numConstantTiles.ref();
+
+    return true;
+}
+
+void KisTileDataStore::materializeConstantTileData(KisTileData *td)
+{
+    Q_ASSERT(td->m_state == KisTileData::CONSTANT);
+
+    td->allocateMemory();
+
+    const qint32 rowSize = td->pixelSize() * KisTileData::WIDTH;
+    quint8 *dstPtr = td->data();
+
+    for (qint32 i = 0; i < KisTileData::HEIGHT; i++) {
+        memcpy(dstPtr, td->m_constantRow, rowSize);
+        dstPtr += rowSize;
+    }
+
+    delete[] td->m_constantRow;
+    td->m_constantRow = 0;
+    td->m_state = KisTileData::NORMAL;
+    m_numConstantTiles.deref();
+}
+
 KisTileDataStoreIterator* KisTileDataStore::beginIteration()
 {
     m_iteratorLock.lockForWrite();
@@ -347,7 +612,16 @@ void KisTileDataStore::debugSwapAll()
 
 void KisTileDataStore::debugClear()
 {
+    // the prefetcher keeps references to the tile data
+    m_prefetcher.testingWaitForIdle();
+
     QWriteLocker l(&m_iteratorLock);
+
+    {
+        QMutexLocker locker(&m_deduplicationLock);
+        m_deduplicationIndex.clear();
+    }
+
     ConcurrentMap<int, KisTileData*>::Iterator iter(m_tileDataMap);
 
     while (iter.isValid()) {
@@ -358,9 +632,16 @@ void KisTileDataStore::debugClear()
     m_counter = 1;
     m_clockIndex = 1;
     m_numTiles = 0;
+    m_numConstantTiles = 0;
+    m_numBudgetEvictions = 0;
     m_memoryMetric = 0;
 }
 
+void KisTileDataStore::testingWaitForPrefetcher()
+{
+    m_prefetcher.testingWaitForIdle();
+}
+
 void KisTileDataStore::testingRereadConfig()
 {
     m_pooler.testingRereadConfig();
@@ -11,10 +11,13 @@
 #include "kritaimage_export.h"
 
 #include <QReadWriteLock>
+#include <QMutex>
+#include <QMultiHash>
 #include "kis_tile_data_interface.h"
 
 #include "kis_tile_data_pooler.h"
 #include "swap/kis_tile_data_swapper.h"
+#include "swap/kis_tile_data_prefetcher.h"
 #include "swap/kis_swapped_data_store.h"
 #include "3rdparty/lock_free_map/concurrent_map.h"
 
@@ -42,6 +45,22 @@ public:
         qint64 poolSize;
 
         qint64 swapSize;
+        qint64 swapRemapsCount;
+        qint64 swapInCount;
+        qint64 swapOutCount;
+        qint64 prefetchedCount;
+
+        /**
+         * The number of tiles swapped out for keeping the documents
+         * within their memory budgets
+         */
+        qint64 budgetEvictionsCount;
+
+        /**
+         * The amount of memory saved by sharing tile data registered
+         * in the deduplication index between several tiles
+         */
+        qint64 deduplicatedSize;
     };
 
     MemoryStatistics memoryStatistics();
@@ -53,7 +72,16 @@ public:
      */
     inline qint32 numTiles() const
     {
-        return m_numTiles.loadAcquire() + m_swappedStore.numTiles();
+        return m_numTiles.loadAcquire() + m_swappedStore.numTiles() +
+            m_numConstantTiles.loadAcquire();
+    }
+
+    /**
+     * Returns the number of tiles stored in a constant form
+     */
+    inline qint32 numConstantTiles() const
+    {
+        return m_numConstantTiles.loadAcquire();
     }
 
     /**
@@ -100,6 +128,46 @@ public:
         m_swapper.kick();
     }
 
+    /**
+     * Schedules loading of \p tileDataList from the swap in a
+     * background thread. Every tile data in the list should be
+     * ref()'ed by the caller, the store will deref() it when
+     * the loading is finished.
+     */
+    inline void schedulePrefetch(const QVector<KisTileData*> &tileDataList)
+    {
+        m_prefetcher.prefetch(tileDataList);
+    }
+
+    /**
+     * Loads \p td from the swap if it has been swapped out. Constant
+     * tiles are not materialized. Returns true if the tile data has
+     * actually been loaded.
+     */
+    bool prefetchTileData(KisTileData *td);
+
+    /**
+     * Swaps out the least recently used tile data from \p tileDataList
+     * until the tile data of the list that are still kept in memory
+     * occupy no more than \p budget bytes. Every tile data in the list
+     * should be ref()'ed by the caller, the store deref()'s them.
+     * Returns the number of bytes freed.
+     *
+     * The tile data are swapped out in small batches and the iterator
+     * lock is released between them, so the other threads are not
+     * blocked for the whole operation. Still, it may take a while, so
+     * consider requestSwapOutLeastRecentlyUsed() instead.
+     */
+    qint64 swapOutLeastRecentlyUsed(const QVector<KisTileData*> &tileDataList, qint64 budget);
+
+    /**
+     * Same as swapOutLeastRecentlyUsed(), but the tile data are swapped
+     * out asynchronously in the swapper thread
+     */
+    void requestSwapOutLeastRecentlyUsed(const QVector<KisTileData*> &tileDataList, qint64 budget) {
+        m_swapper.requestSwapOutToBudget(tileDataList, budget);
+    }
+
     /**
      * Try swap out the tile data.
      * It may fail in case the tile is being accessed
@@ -107,6 +175,16 @@ public:
      */
     bool trySwapTileData(KisTileData *td);
 
+    /**
+     * If all the pixels of \p td are the same, frees its data and keeps
+     * only one row of the pixels. The data is materialized back on the
+     * first access in ensureTileDataLoaded(). Returns true if the tile
+     * data has been converted.
+     * PRECONDITIONS: td->m_swapLock is *unlocked*
+     *                m_listRWLock is *unlocked*
+     */
+    bool tryMakeTileDataConstant(KisTileData *td);
+
 
     /**
      * WARN: The following three method are only for usage
@@ -132,11 +210,36 @@ public:
     void registerTileData(KisTileData *td);
     void unregisterTileData(KisTileData *td);
 
+    /**
+     * Looks up the deduplication index for a tile data with exactly
+     * the same content as \p td. If it is found, it is acquired and
+     * returned, so the caller should replace its \p td with it.
+     * Otherwise, \p td itself is registered in the index and returned.
+     *
+     * The index doesn't hold a user of the registered tile data, so
+     * the data is shared only by the tiles that actually use it. A
+     * tile that is going to write into its unshared data in place
+     * should drop it from the index first.
+     *
+     * PRECONDITIONS: the content of \p td is not being changed by
+     *                anyone during the call
+     */
+    KisTileData* deduplicateTileData(KisTileData *td);
+
+    /**
+     * Removes \p td from the deduplication index. Called when the last
+     * user of \p td releases it or right before \p td is changed in
+     * place by KisTile::lockForWrite().
+     */
+    void dropDeduplicatedTileData(KisTileData *td);
+
 private:
     KisTileData *allocTileData(qint32 pixelSize, const quint8 *defPixel);
 
     inline void registerTileDataImp(KisTileData *td);
     inline void unregisterTileDataImp(KisTileData *td);
+    bool tryMakeTileDataConstantImp(KisTileData *td);
+    void materializeConstantTileData(KisTileData *td);
     void freeRegisteredTiles();
 
     friend class DeadlockyThread;
@@ -150,9 +253,12 @@ private:
 
     friend class KisLowMemoryBenchmark;
     void testingRereadConfig();
+
+    void testingWaitForPrefetcher();
 private:
     KisTileDataPooler m_pooler;
     KisTileDataSwapper m_swapper;
+    KisTileDataPrefetcher m_prefetcher;
 
     friend class KisTileDataStoreTest;
     friend class KisTileDataPoolerTest;
@@ -164,11 +270,20 @@ private:
      * metric = num_bytes / (KisTileData::WIDTH * KisTileData::HEIGHT)
      */
     QAtomicInt m_numTiles;
+    QAtomicInt m_numConstantTiles;
+    QAtomicInteger<qint64> m_numBudgetEvictions;
     QAtomicInt m_memoryMetric;
     QAtomicInt m_counter;
     QAtomicInt m_clockIndex;
     ConcurrentMap<int, KisTileData*> m_tileDataMap;
     QReadWriteLock m_iteratorLock;
+
+    /**
+     * Tile data with known content hashes, used for merging
+     * byte-identical tiles into a single tile data
+     */
+    QMultiHash<uint, KisTileData*> m_deduplicationIndex;
+    QMutex m_deduplicationLock;
 };
 
 template<typename T>
@@ -8,6 +8,8 @@
 
 #include <QRect>
 #include <QVector>
+#include <QThread>
+#include <QtConcurrent>
 
 #include "kis_tile.h"
 #include "kis_tiled_data_manager.h"
@@ -16,12 +18,55 @@
 #include "kis_memento_manager.h"
 #include "swap/kis_legacy_tile_compressor.h"
 #include "swap/kis_tile_compressor_factory.h"
+#include "swap/kis_tile_compressor_2.h"
 
 #include "kis_paint_device_writer.h"
 
 #include "kis_global.h"
+#include "kis_image_config.h"
 
 
+namespace {
+
+/**
+ * The number of tiles compressed by a single job in
+ * writeTilesParallel(). Smaller devices are saved serially,
+ * because the overhead of the thread pool is not worth it.
+ */
+const int TILES_PER_SERIALIZATION_JOB = 64;
+
+class KisByteArrayPaintDeviceWriter : public KisPaintDeviceWriter
+{
+public:
+    KisByteArrayPaintDeviceWriter(QByteArray *array)
+        : m_array(array)
+    {
+    }
+
+    bool write(const QByteArray &data) override {
+        m_array->append(data);
+        return true;
+    }
+
+    bool write(const char *data, qint64 length) override {
+        m_array->append(data, length);
+        return true;
+    }
+
+private:
+    QByteArray *m_array;
+};
+
+struct TileSerializationJob
+{
+    int firstTile = 0;
+    int lastTile = 0;
+    QByteArray buffer;
+    bool result = true;
+};
+
+}
+
 /* The data area is divided into tiles each say 64x64 pixels (defined at compiletime)
  * The tiles are laid out in a matrix that can have negative indexes.
  * The matrix grows automatically if needed (a call for writeacces to a tile
@@ -113,11 +158,29 @@ bool KisTiledDataManager::write(KisPaintDeviceWriter &store)
     }
 
 
+    KisImageConfig config(true);
+    const QString compressionName = config.saveCompression();
+
     KisTileHashTableConstIterator iter(m_hashTable);
     KisTileSP tile;
 
+    if (CURRENT_VERSION != LEGACY_VERSION &&
+        config.enableParallelTileSaving() &&
+        m_hashTable->numTiles() >= 2 * TILES_PER_SERIALIZATION_JOB) {
+
+        QVector<KisTileSP> tiles;
+        tiles.reserve(m_hashTable->numTiles());
+
+        while ((tile = iter.tile())) {
+            tiles.append(tile);
+            iter.next();
+        }
+
+        return retval && writeTilesParallel(store, tiles, compressionName);
+    }
+
     KisAbstractTileCompressorSP compressor =
-        KisTileCompressorFactory::create(CURRENT_VERSION);
+        KisTileCompressorFactory::create(CURRENT_VERSION, compressionName);
 
     while ((tile = iter.tile())) {
         retval = compressor->writeTile(tile, store);
@@ -130,6 +193,72 @@ bool KisTiledDataManager::write(KisPaintDeviceWriter &store)
 
     return retval;
 }
+
+bool KisTiledDataManager::writeTilesParallel(KisPaintDeviceWriter &store,
+                                             const QVector<KisTileSP> &tiles,
+                                             const QString &compressionName)
+{
+    /**
+     * The tiles are split into jobs of consecutive tiles. Every job
+     * is compressed on the global thread pool into its own buffer
+     * using its own compressor, then the buffers are written into
+     * the store in the original order. Therefore the output is
+     * byte-identical to the one of the serial path.
+     *
+     * To keep the memory footprint limited, the tiles are processed
+     * in batches of a few jobs per thread.
+     */
+
+    const int numThreads = qMax(1, QThread::idealThreadCount());
+    const int batchSize = 2 * numThreads * TILES_PER_SERIALIZATION_JOB;
+
+    /**
+     * The header of a tile consists of four numbers, so 64
+     * bytes are always enough for it
+     */
+    const int maxSerializedTileSize = m_pixelSize * KisTileData::WIDTH * KisTileData::HEIGHT + 1 + 64;
+
+    bool retval = true;
+
+    for (int batchStart = 0; batchStart < tiles.size() && retval; batchStart += batchSize) {
+        const int batchEnd = qMin(tiles.size(), batchStart + batchSize);
+
+        QVector<TileSerializationJob> jobs;
+
+        for (int i = batchStart; i < batchEnd; i += TILES_PER_SERIALIZATION_JOB) {
+            TileSerializationJob job;
+            job.firstTile = i;
+            job.lastTile = qMin(batchEnd, i + TILES_PER_SERIALIZATION_JOB);
+            jobs.append(job);
+        }
+
+        QtConcurrent::blockingMap(jobs,
+            [&tiles, &compressionName, maxSerializedTileSize] (TileSerializationJob &job) {
+                job.buffer.reserve((job.lastTile - job.firstTile) * maxSerializedTileSize);
+
+                KisAbstractTileCompressorSP compressor =
+                    KisTileCompressorFactory::create(CURRENT_VERSION, compressionName);
+                KisByteArrayPaintDeviceWriter writer(&job.buffer);
+
+                for (int i = job.firstTile; i < job.lastTile; i++) {
+                    if (!compressor->writeTile(tiles[i], writer)) {
+                        job.result = false;
+                        break;
+                    }
+                }
+            });
+
+        Q_FOREACH (const TileSerializationJob &job, jobs) {
+            retval = job.result && store.write(job.buffer);
+            if (!retval) {
+                warnFile << "Failed to write tile";
+                break;
+            }
+        }
+    }
+
+    return retval;
+}
 bool KisTiledDataManager::read(QIODevice *stream)
 {
     clear();
@@ -148,6 +277,8 @@ bool KisTiledDataManager::read(QIODevice *stream)
 
     quint32 numTiles;
     qint32 tilesVersion = LEGACY_VERSION;
+    qint32 tileWidth = KisTileData::WIDTH;
+    qint32 tileHeight = KisTileData::HEIGHT;
 
     if (line[0] == 'V') {
         QList<QByteArray> lineItems = line.split(' ');
@@ -157,20 +288,88 @@ bool KisTiledDataManager::read(QIODevice *stream)
 
         tilesVersion = lineItems.takeFirst().toInt();
 
-        if(!processTilesHeader(stream, numTiles))
+        if(!processTilesHeader(stream, numTiles, tileWidth, tileHeight))
             return false;
     }
     else {
+        /**
+         * The legacy format has no header, its tiles are always 64x64
+         */
+        if (KisTileData::WIDTH != 64 || KisTileData::HEIGHT != 64) {
+            warnTiles << "Cannot read legacy tiles with tile size"
+                      << KisTileData::WIDTH << "x" << KisTileData::HEIGHT;
+            m_mementoManager->commit();
+            return false;
+        }
+
         numTiles = line.toUInt();
     }
 
-    KisAbstractTileCompressorSP compressor =
-        KisTileCompressorFactory::create(tilesVersion);
-
     bool readSuccess = true;
-    for (quint32 i = 0; i < numTiles; i++) {
-        if (!compressor->readTile(stream, this)) {
-            readSuccess = false;
+
+    if (tileWidth != KisTileData::WIDTH || tileHeight != KisTileData::HEIGHT) {
+        /**
+         * The data was saved by a build with a different tile size,
+         * so we should cut the stored tiles into our own ones
+         */
+        KisTileCompressor2 compressor;
+
+        for (quint32 i = 0; i < numTiles; i++) {
+            if (!compressor.readRetiledTile(stream, this, tileWidth, tileHeight)) {
+                readSuccess = false;
+            }
+        }
+    } else {
+        KisAbstractTileCompressorSP compressor =
+            KisTileCompressorFactory::create(tilesVersion);
+
+        for (quint32 i = 0; i < numTiles; i++) {
+            if (!compressor->readTile(stream, this)) {
+                readSuccess = false;
+            }
+        }
+    }
+
+    KisImageConfig cfg(true);
+    const bool enableDeduplication = cfg.enableTileDeduplication();
+    const bool enableConstantTiles = cfg.enableConstantTiles();
+
+    if (enableDeduplication || enableConstantTiles) {
+        QVector<KisTileSP> defaultTiles;
+
+        {
+            KisTileHashTableIterator iter(m_hashTable);
+
+            while (!iter.isDone()) {
+                KisTileSP tile = iter.tile();
+
+                if (enableDeduplication) {
+                    tile->deduplicateTileData();
+                }
+
+                if (enableConstantTiles &&
+                    KisTileDataStore::instance()->tryMakeTileDataConstant(tile->tileData())) {
+
+                    const quint8 *data = 0;
+                    qint32 rowStride = 0;
+                    KisTileData *td = tile->lockTileDataForRead(data, rowStride);
+
+                    // the tile is filled with the default pixel, so it is not needed
+                    if (!memcmp(data, m_defaultPixel, pixelSize())) {
+                        defaultTiles << tile;
+                    }
+
+                    KisTile::unlockTileDataForRead(td);
+                }
+
+                iter.next();
+            }
+        }
+
+        Q_FOREACH (KisTileSP tile, defaultTiles) {
+            if (m_hashTable->deleteTile(tile)) {
+                m_extentManager.notifyTileRemoved(tile->col(), tile->row());
+            }
         }
     }
 
@@ -206,7 +405,8 @@ bool KisTiledDataManager::writeTilesHeader(KisPaintDeviceWriter &store, quint32
     } while(0)                                                  \
 
 
-bool KisTiledDataManager::processTilesHeader(QIODevice *stream, quint32 &numTiles)
+bool KisTiledDataManager::processTilesHeader(QIODevice *stream, quint32 &numTiles,
+                                             qint32 &tileWidth, qint32 &tileHeight)
 {
     /**
      * We assume that there is only one version of this header
@@ -225,13 +425,19 @@ bool KisTiledDataManager::processTilesHeader(QIODevice *stream, quint32 &numTile
     while(!foundDataMark && stream->canReadLine()) {
         takeOneLine(stream, maxLineLength, keyword, value);
 
+        /**
+         * Tiles of any sane size can be read, they will be
+         * re-tiled on loading if necessary
+         */
         if (keyword == "TILEWIDTH") {
-            if(value != KisTileData::WIDTH)
+            if(value <= 0 || value > 1024)
                 goto wrongString;
+            tileWidth = value;
         }
         else if (keyword == "TILEHEIGHT") {
-            if(value != KisTileData::HEIGHT)
+            if(value <= 0 || value > 1024)
                 goto wrongString;
+            tileHeight = value;
         }
         else if (keyword == "PIXELSIZE") {
             if((quint32)value != pixelSize())
@@ -260,6 +466,56 @@ wrongString:
     return false;
 }
 
+void KisTiledDataManager::prefetchRect(const QRect &rect)
+{
+    const QRect rc = rect & extent();
+    if (rc.isEmpty()) return;
+
+    QVector<KisTileData*> tileDataList;
+
+    {
+        QReadLocker locker(&m_lock);
+
+        const qint32 firstColumn = xToCol(rc.left());
+        const qint32 lastColumn = xToCol(rc.right());
+        const qint32 firstRow = yToRow(rc.top());
+        const qint32 lastRow = yToRow(rc.bottom());
+
+        for (qint32 row = firstRow; row <= lastRow; ++row) {
+            for (qint32 column = firstColumn; column <= lastColumn; ++column) {
+                KisTileSP tile = m_hashTable->getExistingTile(column, row);
+                if (!tile) continue;
+
+                KisTileData *td = tile->referenceTileData();
+
+                // the check is racy, but the prefetcher will check it again
+                if (!td->data()) {
+                    tileDataList << td;
+                } else {
+                    td->deref();
+                }
+            }
+        }
+    }
+
+    if (!tileDataList.isEmpty()) {
+        KisTileDataStore::instance()->schedulePrefetch(tileDataList);
+    }
+}
+
+void KisTiledDataManager::collectTileData(QVector<KisTileData*> &tileDataList)
+{
+    QReadLocker locker(&m_lock);
+
+    KisTileHashTableConstIterator iter(m_hashTable);
+    KisTileSP tile;
+
+    while ((tile = iter.tile())) {
+        tileDataList << tile->referenceTileData();
+        iter.next();
+    }
+}
+
 void KisTiledDataManager::purge(const QRect& area)
 {
     QList<KisTileSP> tilesToDelete;
@@ -274,11 +530,17 @@ void KisTiledDataManager::purge(const QRect& area)
 
         while ((tile = iter.tile())) {
             if (tile->extent().intersects(area)) {
-                tile->lockForRead();
-                if(memcmp(defaultData, tile->data(), tileDataSize) == 0) {
+                const quint8 *data = 0;
+                qint32 rowStride = 0;
+                KisTileData *td = tile->lockTileDataForRead(data, rowStride);
+
+                // a constant tile data keeps a single row only
+                const qint32 dataSize = rowStride ? tileDataSize : KisTileData::WIDTH * pixelSize();
+
+                if(memcmp(defaultData, data, dataSize) == 0) {
                     tilesToDelete.push_back(tile);
                 }
-                tile->unlockForRead();
+                KisTile::unlockTileDataForRead(td);
             }
             iter.next();
         }
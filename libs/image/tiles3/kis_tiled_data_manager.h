@@ -216,6 +216,21 @@ public:
 
     KisRegion region() const;
 
+    /**
+     * Asynchronously loads the tiles intersecting \p rect from the
+     * swap file, so that they are already in memory when they are
+     * accessed. The call doesn't block, the tiles are loaded in
+     * a background thread.
+     */
+    void prefetchRect(const QRect &rect);
+
+    /**
+     * Appends the current tile data of all the tiles of the data
+     * manager to \p tileDataList. Every tile data is ref()'ed, the
+     * caller is responsible for deref()'ing it.
+     */
+    void collectTileData(QVector<KisTileData*> &tileDataList);
+
     void clear(QRect clearRect, quint8 clearValue);
     void clear(QRect clearRect, const quint8 *clearPixel);
     void clear(qint32 x, qint32 y, qint32 w, qint32 h, quint8 clearValue);
@@ -352,7 +367,11 @@ private:
     void setDefaultPixelImpl(const quint8 *defPixel);
 
     bool writeTilesHeader(KisPaintDeviceWriter &store, quint32 numTiles);
-    bool processTilesHeader(QIODevice *stream, quint32 &numTiles);
+    bool writeTilesParallel(KisPaintDeviceWriter &store,
+                            const QVector<KisTileSP> &tiles,
+                            const QString &compressionName);
+    bool processTilesHeader(QIODevice *stream, quint32 &numTiles,
+                            qint32 &tileWidth, qint32 &tileHeight);
 
     qint32 divideRoundDown(qint32 x, const qint32 y) const;
 
@@ -9,6 +9,7 @@
 
 #include "kritaimage_export.h"
 #include <QtGlobal>
+#include <QString>
 
 /**
  * Base class for compression operations
@@ -59,6 +60,15 @@ public:
      */
     virtual void adjustForDataSize(qint32 dataSize);
 
+    /**
+     * Returns the unique name of the codec. The name is written into
+     * the header of every compressed tile, so it must never change
+     * once the codec has been released.
+     *
+     * \see KisCompressionFactory
+     */
+    virtual QString name() const = 0;
+
 public:
     /**
      * Additional interface for jumbling color channels order
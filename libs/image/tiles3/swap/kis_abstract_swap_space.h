@@ -0,0 +1,45 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_ABSTRACT_SWAP_SPACE_H
+#define __KIS_ABSTRACT_SWAP_SPACE_H
+
+#include "kritaimage_export.h"
+#include "kis_chunk_allocator.h"
+
+
+/**
+ * Base class for the objects giving access to the chunks of the
+ * swap file. The pointers returned by getReadChunkPtr() and
+ * getWriteChunkPtr() are valid only until the next call to any of
+ * these methods, unless the implementation guarantees otherwise.
+ */
+class KRITAIMAGE_EXPORT KisAbstractSwapSpace
+{
+public:
+    KisAbstractSwapSpace();
+    virtual ~KisAbstractSwapSpace();
+
+    inline quint8* getReadChunkPtr(KisChunk readChunk) {
+        return getReadChunkPtr(readChunk.data());
+    }
+
+    inline quint8* getWriteChunkPtr(KisChunk writeChunk) {
+        return getWriteChunkPtr(writeChunk.data());
+    }
+
+    virtual quint8* getReadChunkPtr(const KisChunkData &readChunk) = 0;
+    virtual quint8* getWriteChunkPtr(const KisChunkData &writeChunk) = 0;
+
+    /**
+     * Returns the number of times the mapping of the swap file had
+     * to be changed to access a chunk
+     */
+    virtual quint64 numRemaps() const = 0;
+};
+
+#endif /* __KIS_ABSTRACT_SWAP_SPACE_H */
+
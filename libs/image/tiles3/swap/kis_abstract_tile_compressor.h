@@ -90,6 +90,11 @@ protected:
     inline qint32 pixelSize(KisTiledDataManager *dm) {
         return dm->pixelSize();
     }
+
+    inline void writeBytes(KisTiledDataManager *dm, const quint8 *data,
+                           qint32 x, qint32 y, qint32 width, qint32 height) {
+        dm->writeBytesBody(data, x, y, width, height);
+    }
 };
 
 #endif /* __KIS_ABSTRACT_TILE_COMPRESSOR_H */
@@ -0,0 +1,75 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_compression_factory.h"
+
+#include <config-tile-compression.h>
+
+#include "kis_lzf_compression.h"
+#include "kis_zlib_compression.h"
+
+#ifdef HAVE_LZ4
+#include "kis_lz4_compression.h"
+#endif
+
+#ifdef HAVE_ZSTD
+#include "kis_zstd_compression.h"
+#endif
+
+
+KisAbstractCompression* KisCompressionFactory::create(const QString &name)
+{
+    if (name == QLatin1String("LZF")) {
+        return new KisLzfCompression();
+    } else if (name == QLatin1String("ZLIB")) {
+        return new KisZlibCompression();
+#ifdef HAVE_LZ4
+    } else if (name == QLatin1String("LZ4")) {
+        return new KisLz4Compression();
+#endif
+#ifdef HAVE_ZSTD
+    } else if (name == QLatin1String("ZSTD")) {
+        return new KisZstdCompression();
+#endif
+    }
+
+    return 0;
+}
+
+QStringList KisCompressionFactory::availableCompressions()
+{
+    QStringList result;
+
+    result << QStringLiteral("LZF");
+#ifdef HAVE_LZ4
+    result << QStringLiteral("LZ4");
+#endif
+    result << QStringLiteral("ZLIB");
+#ifdef HAVE_ZSTD
+    result << QStringLiteral("ZSTD");
+#endif
+
+    return result;
+}
+
+bool KisCompressionFactory::isAvailable(const QString &name)
+{
+    return availableCompressions().contains(name);
+}
+
+QString KisCompressionFactory::legacyCompression()
+{
+    return QStringLiteral("LZF");
+}
+
+QString KisCompressionFactory::fastestCompression()
+{
+#ifdef HAVE_LZ4
+    return QStringLiteral("LZ4");
+#else
+    return legacyCompression();
+#endif
+}
@@ -0,0 +1,58 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_COMPRESSION_FACTORY_H
+#define __KIS_COMPRESSION_FACTORY_H
+
+#include "kritaimage_export.h"
+#include <QStringList>
+
+class KisAbstractCompression;
+
+/**
+ * Registry of all the codecs that can be used for compressing
+ * tile data in the swap file and in .kra files.
+ *
+ * LZF and ZLIB are always available, LZ4 and ZSTD are available
+ * only when Krita is built with the corresponding libraries. The
+ * name of the codec is saved in the header of every tile, so the
+ * files saved with any codec can be loaded as long as the codec is
+ * present in the registry.
+ */
+class KRITAIMAGE_EXPORT KisCompressionFactory
+{
+public:
+    /**
+     * Creates a codec with name \p name. Returns null if the codec
+     * is not known or not available in this build. The caller takes
+     * the ownership of the returned object.
+     */
+    static KisAbstractCompression* create(const QString &name);
+
+    /**
+     * Names of all the codecs available in this build
+     */
+    static QStringList availableCompressions();
+
+    static bool isAvailable(const QString &name);
+
+    /**
+     * The codec that was used by Krita before the registry was
+     * introduced. Files saved with it are readable by any version
+     * of Krita.
+     */
+    static QString legacyCompression();
+
+    /**
+     * The fastest-decompressing codec available in this build
+     */
+    static QString fastestCompression();
+
+private:
+    KisCompressionFactory();
+};
+
+#endif /* __KIS_COMPRESSION_FACTORY_H */
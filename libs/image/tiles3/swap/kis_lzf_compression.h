@@ -20,6 +20,8 @@ public:
 
     qint32 outputBufferSize(qint32 dataSize) override;
 
+    QString name() const override;
+
     //void adjustForDataSize(qint32 dataSize);
 };
 
@@ -0,0 +1,163 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_debug.h"
+#include "kis_mapped_swap_space.h"
+
+#include <QDir>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define SWP_PREFIX "KRITA_SWAP_FILE_XXXXXX"
+
+/**
+ * All the extents are aligned to the size of a huge page, so that
+ * the kernel would be able to back them with huge pages if it wants to
+ */
+#define EXTENT_ALIGNMENT (2*MiB)
+#define ALIGN_UP(size, alignment) (((size) + (alignment) - 1) & ~((alignment) - 1))
+
+
+KisMappedSwapSpace::KisMappedSwapSpace(const QString &swapDir, quint64 maxSwapSize, quint64 extentSize)
+    : m_valid(false),
+      m_base(0),
+      m_reservedSize(ALIGN_UP(maxSwapSize, EXTENT_ALIGNMENT)),
+      m_mappedSize(0),
+      m_extentSize(ALIGN_UP(qMax(extentSize, quint64(1)), EXTENT_ALIGNMENT)),
+      m_numExtents(0)
+{
+#if defined(Q_OS_UNIX) && QT_POINTER_SIZE == 8
+    KIS_SAFE_ASSERT_RECOVER_NOOP(!swapDir.isEmpty());
+
+    QDir d(swapDir);
+    if (!d.exists() && !d.mkpath(swapDir)) {
+        warnTiles << "KisMappedSwapSpace: could not create swap directory" << swapDir;
+        return;
+    }
+
+    m_file.setFileTemplate(swapDir + '/' + SWP_PREFIX);
+    if (!m_file.open() || m_file.fileName().isEmpty()) {
+        warnTiles << "KisMappedSwapSpace: could not create or open swapfile in" << swapDir;
+        return;
+    }
+
+    /**
+     * Reserve the address space only. No physical memory or swap file
+     * space is committed until the extents are mapped over it.
+     */
+    void *ptr = mmap(0, m_reservedSize, PROT_NONE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (ptr == MAP_FAILED) {
+        warnTiles << "KisMappedSwapSpace: failed to reserve" << m_reservedSize / MiB
+                  << "MiB of address space for the swap file";
+        return;
+    }
+
+    m_base = static_cast<quint8*>(ptr);
+    m_valid = true;
+#else
+    Q_UNUSED(swapDir);
+#endif
+}
+
+KisMappedSwapSpace::~KisMappedSwapSpace()
+{
+#ifdef Q_OS_UNIX
+    if (m_base) {
+        munmap(m_base, m_reservedSize);
+    }
+#endif
+}
+
+bool KisMappedSwapSpace::isValid() const
+{
+    return m_valid;
+}
+
+quint8* KisMappedSwapSpace::getReadChunkPtr(const KisChunkData &readChunk)
+{
+    if (!ensureMapped(readChunk)) {
+        return nullptr;
+    }
+
+    return m_base + readChunk.m_begin;
+}
+
+quint8* KisMappedSwapSpace::getWriteChunkPtr(const KisChunkData &writeChunk)
+{
+    if (!ensureMapped(writeChunk)) {
+        return nullptr;
+    }
+
+    return m_base + writeChunk.m_begin;
+}
+
+quint64 KisMappedSwapSpace::numRemaps() const
+{
+    return m_numExtents.loadAcquire();
+}
+
+quint64 KisMappedSwapSpace::numExtents() const
+{
+    return m_numExtents.loadAcquire();
+}
+
+quint64 KisMappedSwapSpace::mappedSize() const
+{
+    return m_mappedSize;
+}
+
+bool KisMappedSwapSpace::ensureMapped(const KisChunkData &chunk)
+{
+    if (!m_valid) return false;
+
+    const quint64 requiredSize = chunk.m_end + 1;
+    if (requiredSize <= m_mappedSize) return true;
+
+#ifdef Q_OS_UNIX
+    if (requiredSize > m_reservedSize) {
+        warnTiles << "KisMappedSwapSpace: the requested chunk lies outside the reserved swap space";
+        return false;
+    }
+
+    const quint64 newSize = qMin(ALIGN_UP(requiredSize, m_extentSize), m_reservedSize);
+
+    if (!m_file.resize(newSize)) {
+        warnTiles << "KisMappedSwapSpace: failed to grow the swap file to" << newSize / MiB << "MiB";
+        return false;
+    }
+
+    const quint64 extentLength = newSize - m_mappedSize;
+
+    /**
+     * The new extent is mapped right after the previous one, replacing
+     * the reserved (PROT_NONE) pages. The previous extents stay intact.
+     */
+    void *ptr = mmap(m_base + m_mappedSize, extentLength,
+                     PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                     m_file.handle(), off_t(m_mappedSize));
+
+    if (ptr == MAP_FAILED) {
+        warnTiles << "KisMappedSwapSpace: failed to map an extent of the swap file";
+        return false;
+    }
+
+#ifdef MADV_HUGEPAGE
+    madvise(ptr, extentLength, MADV_HUGEPAGE);
+#endif
+
+    m_mappedSize = newSize;
+    m_numExtents.ref();
+
+    return true;
+#else
+    return false;
+#endif
+}
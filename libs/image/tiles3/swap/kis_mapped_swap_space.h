@@ -0,0 +1,88 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_MAPPED_SWAP_SPACE_H
+#define __KIS_MAPPED_SWAP_SPACE_H
+
+#include <QTemporaryFile>
+#include <QAtomicInteger>
+
+#include "kis_abstract_swap_space.h"
+
+
+/**
+ * A swap space that maps the whole swap file into the address space
+ * of the process at once.
+ *
+ * On construction the object reserves a contiguous range of virtual
+ * addresses big enough to hold \p maxSwapSize bytes. The swap file is
+ * then grown in extents of \p extentSize bytes (rounded up to the size
+ * of a huge page) and every new extent is mapped right after the
+ * previous one. The already mapped extents are never touched again,
+ * so, unlike KisMemoryWindow, the object never remaps them and the
+ * pointers it returns stay valid for the whole lifetime of the swap
+ * space.
+ *
+ * The reservation is possible on 64-bit Unix systems only. Check
+ * isValid() after construction and fall back to KisMemoryWindow if it
+ * returns false.
+ */
+class KRITAIMAGE_EXPORT KisMappedSwapSpace : public KisAbstractSwapSpace
+{
+public:
+    /**
+     * @param swapDir If the dir doesn't exist, it'll be created
+     * @param maxSwapSize the maximum size of the swap file
+     * @param extentSize the swap file is grown by this amount of bytes
+     */
+    KisMappedSwapSpace(const QString &swapDir, quint64 maxSwapSize, quint64 extentSize);
+    ~KisMappedSwapSpace() override;
+
+    /**
+     * Returns true if the platform supports the mapping and the address
+     * space for the swap file has been reserved successfully
+     */
+    bool isValid() const;
+
+    using KisAbstractSwapSpace::getReadChunkPtr;
+    using KisAbstractSwapSpace::getWriteChunkPtr;
+
+    quint8* getReadChunkPtr(const KisChunkData &readChunk) override;
+    quint8* getWriteChunkPtr(const KisChunkData &writeChunk) override;
+
+    /**
+     * Returns the number of times a new extent has been mapped. The
+     * existing mappings are never changed, so this is the number of
+     * mmap() calls done after the reservation of the address space.
+     */
+    quint64 numRemaps() const override;
+
+    /**
+     * Returns the number of extents the swap file has been grown by
+     */
+    quint64 numExtents() const;
+
+    /**
+     * Returns the size of the currently mapped part of the swap file
+     */
+    quint64 mappedSize() const;
+
+private:
+    bool ensureMapped(const KisChunkData &chunk);
+
+private:
+    QTemporaryFile m_file;
+
+    bool m_valid;
+    quint8 *m_base;
+    quint64 m_reservedSize;
+    quint64 m_mappedSize;
+    quint64 m_extentSize;
+    QAtomicInteger<quint64> m_numExtents;
+};
+
+#endif /* __KIS_MAPPED_SWAP_SPACE_H */
+
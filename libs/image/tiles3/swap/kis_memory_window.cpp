@@ -12,7 +12,8 @@
 #define SWP_PREFIX "KRITA_SWAP_FILE_XXXXXX"
 
 KisMemoryWindow::KisMemoryWindow(const QString &swapDir, quint64 writeWindowSize)
-    : m_readWindowEx(writeWindowSize / 4),
+    : m_numRemaps(0),
+      m_readWindowEx(writeWindowSize / 4),
       m_writeWindowEx(writeWindowSize)
 {
     m_valid = true;
@@ -65,6 +66,11 @@ quint8* KisMemoryWindow::getWriteChunkPtr(const KisChunkData &writeChunk)
     return m_writeWindowEx.calculatePointer(writeChunk);
 }
 
+quint64 KisMemoryWindow::numRemaps() const
+{
+    return m_numRemaps.loadAcquire();
+}
+
 bool KisMemoryWindow::adjustWindow(const KisChunkData &requestedChunk,
                                    MappingWindow *adjustingWindow,
                                    MappingWindow *otherWindow)
@@ -73,6 +79,10 @@ bool KisMemoryWindow::adjustWindow(const KisChunkData &requestedChunk,
        !(requestedChunk.m_begin >= adjustingWindow->chunk.m_begin &&
          requestedChunk.m_end <= adjustingWindow->chunk.m_end))
     {
+        if (adjustingWindow->window) {
+            m_numRemaps.ref();
+        }
+
         m_file.unmap(adjustingWindow->window);
 
         quint64 windowSize = adjustingWindow->defaultSize;
@@ -8,13 +8,14 @@
 #define __KIS_MEMORY_WINDOW_H
 
 #include <QTemporaryFile>
+#include <QAtomicInteger>
 
-#include "kis_chunk_allocator.h"
+#include "kis_abstract_swap_space.h"
 
 
 #define DEFAULT_WINDOW_SIZE (16*MiB)
 
-class KRITAIMAGE_EXPORT KisMemoryWindow
+class KRITAIMAGE_EXPORT KisMemoryWindow : public KisAbstractSwapSpace
 {
 public:
     /**
@@ -22,18 +23,15 @@ public:
      * @param writeWindowSize write window size.
      */
     KisMemoryWindow(const QString &swapDir, quint64 writeWindowSize = DEFAULT_WINDOW_SIZE);
-    ~KisMemoryWindow();
+    ~KisMemoryWindow() override;
 
-    inline quint8* getReadChunkPtr(KisChunk readChunk) {
-        return getReadChunkPtr(readChunk.data());
-    }
+    using KisAbstractSwapSpace::getReadChunkPtr;
+    using KisAbstractSwapSpace::getWriteChunkPtr;
 
-    inline quint8* getWriteChunkPtr(KisChunk writeChunk) {
-        return getWriteChunkPtr(writeChunk.data());
-    }
+    quint8* getReadChunkPtr(const KisChunkData &readChunk) override;
+    quint8* getWriteChunkPtr(const KisChunkData &writeChunk) override;
 
-    quint8* getReadChunkPtr(const KisChunkData &readChunk);
-    quint8* getWriteChunkPtr(const KisChunkData &writeChunk);
+    quint64 numRemaps() const override;
 
 private:
     struct MappingWindow {
@@ -63,6 +61,7 @@ private:
     QTemporaryFile m_file;
 
     bool m_valid;
+    QAtomicInteger<quint64> m_numRemaps;
     MappingWindow m_readWindowEx;
     MappingWindow m_writeWindowEx;
 };
@@ -7,6 +7,7 @@
 //#include "kis_debug.h"
 #include "kis_swapped_data_store.h"
 #include "kis_memory_window.h"
+#include "kis_mapped_swap_space.h"
 #include "kis_image_config.h"
 
 #include "kis_tile_compressor_2.h"
@@ -14,7 +15,10 @@
 //#define COMPRESSOR_VERSION 2
 
 KisSwappedDataStore::KisSwappedDataStore()
-    : m_memoryMetric(0)
+    : m_swapSpace(0),
+      m_memoryMetric(0),
+      m_numSwapIns(0),
+      m_numSwapOuts(0)
 {
     KisImageConfig config(true);
     const quint64 maxSwapSize = config.maxSwapSize() * MiB;
@@ -22,10 +26,23 @@ KisSwappedDataStore::KisSwappedDataStore()
     const quint64 swapWindowSize = config.swapWindowSize() * MiB;
 
     m_allocator = new KisChunkAllocator(swapSlabSize, maxSwapSize);
-    m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize);
 
-    // FIXME: use a factory after the patch is committed
-    m_compressor = new KisTileCompressor2();
+    if (config.useMappedSwapFile()) {
+        KisMappedSwapSpace *mappedSpace =
+            new KisMappedSwapSpace(config.swapDir(), maxSwapSize, swapSlabSize);
+
+        if (mappedSpace->isValid()) {
+            m_swapSpace = mappedSpace;
+        } else {
+            delete mappedSpace;
+        }
+    }
+
+    if (!m_swapSpace) {
+        m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize);
+    }
+
+    m_compressor = new KisTileCompressor2(config.swapCompression());
 }
 
 KisSwappedDataStore::~KisSwappedDataStore()
@@ -73,6 +90,7 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
     td->setSwapChunk(chunk);
 
     m_memoryMetric += td->pixelSize();
+    m_numSwapOuts.ref();
 
     return true;
 }
@@ -95,6 +113,7 @@ void KisSwappedDataStore::swapInTileData(KisTileData *td)
     m_allocator->freeChunk(chunk);
 
     m_memoryMetric -= td->pixelSize();
+    m_numSwapIns.ref();
 }
 
 void KisSwappedDataStore::forgetTileData(KisTileData *td)
@@ -112,6 +131,21 @@ qint64 KisSwappedDataStore::totalMemoryMetric() const
     return m_memoryMetric;
 }
 
+quint64 KisSwappedDataStore::numSwapRemaps() const
+{
+    return m_swapSpace->numRemaps();
+}
+
+quint64 KisSwappedDataStore::numSwapIns() const
+{
+    return m_numSwapIns.loadAcquire();
+}
+
+quint64 KisSwappedDataStore::numSwapOuts() const
+{
+    return m_numSwapOuts.loadAcquire();
+}
+
 void KisSwappedDataStore::debugStatistics()
 {
     m_allocator->sanityCheck();
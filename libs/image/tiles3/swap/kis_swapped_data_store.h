@@ -11,13 +11,14 @@
 
 #include <QMutex>
 #include <QByteArray>
+#include <QAtomicInteger>
 
 
 class QMutex;
 class KisTileData;
 class KisAbstractTileCompressor;
 class KisChunkAllocator;
-class KisMemoryWindow;
+class KisAbstractSwapSpace;
 
 class KRITAIMAGE_EXPORT KisSwappedDataStore
 {
@@ -59,6 +60,22 @@ public:
      */
     qint64 totalMemoryMetric() const;
 
+    /**
+     * Returns the number of times the swap file had to be remapped
+     * to access a tile
+     */
+    quint64 numSwapRemaps() const;
+
+    /**
+     * Returns the number of tiles read back from the swap file
+     */
+    quint64 numSwapIns() const;
+
+    /**
+     * Returns the number of tiles written into the swap file
+     */
+    quint64 numSwapOuts() const;
+
     /**
      * Some debugging output
      */
@@ -69,11 +86,18 @@ private:
     KisAbstractTileCompressor *m_compressor;
 
     KisChunkAllocator *m_allocator;
-    KisMemoryWindow *m_swapSpace;
+    KisAbstractSwapSpace *m_swapSpace;
 
     QMutex m_lock;
 
     qint64 m_memoryMetric;
+
+    /**
+     * The counters are updated by the swapper thread and read by
+     * the memory statistics server in the GUI thread
+     */
+    QAtomicInteger<quint64> m_numSwapIns;
+    QAtomicInteger<quint64> m_numSwapOuts;
 };
 
 #endif /* __KIS_SWAPPED_DATA_STORE_H */
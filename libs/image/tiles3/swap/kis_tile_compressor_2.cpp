@@ -5,17 +5,29 @@
  */
 
 #include "kis_tile_compressor_2.h"
-#include "kis_lzf_compression.h"
+#include "kis_abstract_compression.h"
+#include "kis_compression_factory.h"
 #include <QIODevice>
 #include "kis_paint_device_writer.h"
 #define TILE_DATA_SIZE(pixelSize) ((pixelSize) * KisTileData::WIDTH * KisTileData::HEIGHT)
 
-const QString KisTileCompressor2::m_compressionName = "LZF";
 
-
-KisTileCompressor2::KisTileCompressor2()
+KisTileCompressor2::KisTileCompressor2(const QString &compressionName)
+    : m_compression(0)
 {
-    m_compression = new KisLzfCompression();
+    if (!compressionName.isEmpty()) {
+        m_compression = KisCompressionFactory::create(compressionName);
+
+        if (!m_compression) {
+            warnTiles << "Tile compression" << compressionName
+                      << "is not available, falling back to"
+                      << KisCompressionFactory::legacyCompression();
+        }
+    }
+
+    if (!m_compression) {
+        m_compression = KisCompressionFactory::create(KisCompressionFactory::legacyCompression());
+    }
 }
 
 KisTileCompressor2::~KisTileCompressor2()
@@ -50,7 +62,22 @@ bool KisTileCompressor2::writeTile(KisTileSP tile, KisPaintDeviceWriter &store)
 
 bool KisTileCompressor2::readTile(QIODevice *stream, KisTiledDataManager *dm)
 {
-    const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize(dm));
+    return readTileImpl(stream, dm, KisTileData::WIDTH, KisTileData::HEIGHT);
+}
+
+bool KisTileCompressor2::readRetiledTile(QIODevice *stream, KisTiledDataManager *dm,
+                                         qint32 tileWidth, qint32 tileHeight)
+{
+    return readTileImpl(stream, dm, tileWidth, tileHeight);
+}
+
+bool KisTileCompressor2::readTileImpl(QIODevice *stream, KisTiledDataManager *dm,
+                                      qint32 tileWidth, qint32 tileHeight)
+{
+    const bool needsRetiling =
+        tileWidth != KisTileData::WIDTH || tileHeight != KisTileData::HEIGHT;
+
+    const qint32 tileDataSize = pixelSize(dm) * tileWidth * tileHeight;
     prepareStreamingBuffer(tileDataSize);
 
     QByteArray header = stream->readLine(maxHeaderLength());
@@ -63,17 +90,43 @@ bool KisTileCompressor2::readTile(QIODevice *stream, KisTiledDataManager *dm)
         qint32 dataSize = headerItems.takeFirst().toInt();
 
         Q_ASSERT(headerItems.isEmpty());
-        Q_ASSERT(compressionName == m_compressionName);
+
+        KisAbstractCompression *compression = compressionForName(compressionName);
+
+        if (!compression || dataSize > m_streamingBuffer.size()) {
+            warnTiles << "Unknown tile compression or broken tile:"
+                      << compressionName << dataSize;
+            stream->skip(dataSize);
+            return false;
+        }
+
+        stream->read(m_streamingBuffer.data(), dataSize);
+
+        if (needsRetiling) {
+            if (m_retilingBuffer.size() < tileDataSize) {
+                m_retilingBuffer.resize(tileDataSize);
+            }
+
+            bool res = decompressTileDataImpl(compression,
+                                              (quint8*)m_streamingBuffer.data(), dataSize,
+                                              (quint8*)m_retilingBuffer.data(), tileDataSize,
+                                              pixelSize(dm));
+            if (res) {
+                writeBytes(dm, (quint8*)m_retilingBuffer.data(), x, y, tileWidth, tileHeight);
+            }
+            return res;
+        }
 
         qint32 row = yToRow(dm, y);
         qint32 col = xToCol(dm, x);
 
         KisTileSP tile = dm->getTile(col, row, true);
 
-        stream->read(m_streamingBuffer.data(), dataSize);
-
         tile->lockForWrite();
-        bool res = decompressTileData((quint8*)m_streamingBuffer.data(), dataSize, tile->tileData());
+        bool res = decompressTileDataImpl(compression,
+                                          (quint8*)m_streamingBuffer.data(), dataSize,
+                                          tile->tileData()->data(), tileDataSize,
+                                          tile->pixelSize());
         tile->unlockForWrite();
         return res;
     }
@@ -122,7 +175,11 @@ void KisTileCompressor2::compressTileData(KisTileData *tileData,
     compressedBytes = m_compression->compress((quint8*)m_linearizationBuffer.data(), tileDataSize,
                                               (quint8*)m_compressionBuffer.data(), m_compressionBuffer.size());
 
-    if(compressedBytes < tileDataSize) {
+    /**
+     * The codecs return 0 on failure, such a tile should be
+     * stored raw, otherwise it could not be decoded back
+     */
+    if(compressedBytes > 0 && compressedBytes < tileDataSize) {
         buffer[0] = COMPRESSED_DATA_FLAG;
         memcpy(buffer + 1, m_compressionBuffer.data(), compressedBytes);
         bytesWritten = compressedBytes + 1;
@@ -139,24 +196,35 @@ bool KisTileCompressor2::decompressTileData(quint8 *buffer,
                                             KisTileData *tileData)
 {
     const qint32 pixelSize = tileData->pixelSize();
-    const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize);
 
+    return decompressTileDataImpl(m_compression, buffer, bufferSize,
+                                  tileData->data(), TILE_DATA_SIZE(pixelSize),
+                                  pixelSize);
+}
+
+bool KisTileCompressor2::decompressTileDataImpl(KisAbstractCompression *compression,
+                                                quint8 *buffer,
+                                                qint32 bufferSize,
+                                                quint8 *dstData,
+                                                qint32 tileDataSize,
+                                                qint32 pixelSize)
+{
     if(buffer[0] == COMPRESSED_DATA_FLAG) {
         prepareWorkBuffers(tileDataSize);
 
         qint32 bytesWritten;
-        bytesWritten = m_compression->decompress(buffer + 1, bufferSize - 1,
+        bytesWritten = compression->decompress(buffer + 1, bufferSize - 1,
                                                  (quint8*)m_linearizationBuffer.data(), tileDataSize);
         if (bytesWritten == tileDataSize) {
             KisAbstractCompression::delinearizeColors((quint8*)m_linearizationBuffer.data(),
-                                                      tileData->data(),
+                                                      dstData,
                                                       tileDataSize, pixelSize);
             return true;
         }
         return false;
     }
     else {
-        memcpy(tileData->data(), buffer + 1, tileDataSize);
+        memcpy(dstData, buffer + 1, tileDataSize);
         return true;
     }
     return false;
@@ -168,6 +236,24 @@ qint32 KisTileCompressor2::tileDataBufferSize(KisTileData *tileData)
     return TILE_DATA_SIZE(tileData->pixelSize()) + 1;
 }
 
+QString KisTileCompressor2::compressionName() const
+{
+    return m_compression->name();
+}
+
+KisAbstractCompression* KisTileCompressor2::compressionForName(const QString &name)
+{
+    if (name == m_compression->name()) {
+        return m_compression;
+    }
+
+    if (!m_foreignCompression || m_foreignCompression->name() != name) {
+        m_foreignCompression.reset(KisCompressionFactory::create(name));
+    }
+
+    return m_foreignCompression.data();
+}
+
 inline qint32 KisTileCompressor2::maxHeaderLength()
 {
     static const qint32 QINT32_LENGTH = 11;
@@ -184,5 +270,5 @@ inline QString KisTileCompressor2::getHeader(KisTileSP tile,
     qint32 width, height;
     tile->extent().getRect(&x, &y, &width, &height);
 
-    return QString("%1,%2,%3,%4\n").arg(x).arg(y).arg(m_compressionName).arg(compressedSize);
+    return QString("%1,%2,%3,%4\n").arg(x).arg(y).arg(m_compression->name()).arg(compressedSize);
 }
@@ -9,23 +9,50 @@
 
 #include "kis_abstract_tile_compressor.h"
 
+#include <QScopedPointer>
+
 class KisAbstractCompression;
 
+/**
+ * Writes tiles in the format of the version 2 of the tiles stream.
+ * Every tile header contains the name of the codec used for it, so
+ * the stream may be written with any codec registered in
+ * KisCompressionFactory, and read back regardless of the codec the
+ * compressor was created with.
+ */
 class KRITAIMAGE_EXPORT KisTileCompressor2 : public KisAbstractTileCompressor
 {
 public:
-    KisTileCompressor2();
+    /**
+     * Creates a compressor that writes data using codec \p compressionName.
+     * If the name is empty or the codec is not available in this build,
+     * the legacy LZF codec is used.
+     */
+    KisTileCompressor2(const QString &compressionName = QString());
     ~KisTileCompressor2() override;
 
     bool writeTile(KisTileSP tile, KisPaintDeviceWriter &store) override;
     bool readTile(QIODevice *io, KisTiledDataManager *dm) override;
 
+    /**
+     * Reads a tile that was saved by a build with a different tile
+     * size (\p tileWidth x \p tileHeight) and writes its pixels into
+     * \p dm, spreading them over the tiles of the current size.
+     */
+    bool readRetiledTile(QIODevice *io, KisTiledDataManager *dm,
+                         qint32 tileWidth, qint32 tileHeight);
+
 
     void compressTileData(KisTileData *tileData,quint8 *buffer,
                           qint32 bufferSize, qint32 &bytesWritten) override;
     bool decompressTileData(quint8 *buffer, qint32 bufferSize, KisTileData *tileData) override;
     qint32 tileDataBufferSize(KisTileData *tileData) override;
 
+    /**
+     * The name of the codec used for writing the tiles
+     */
+    QString compressionName() const;
+
 private:
     /**
      * Quite self describing
@@ -37,6 +64,16 @@ private:
     void prepareWorkBuffers(qint32 tileDataSize);
     void prepareStreamingBuffer(qint32 tileDataSize);
 
+    bool decompressTileDataImpl(KisAbstractCompression *compression,
+                                quint8 *buffer, qint32 bufferSize,
+                                quint8 *dstData, qint32 tileDataSize,
+                                qint32 pixelSize);
+
+    bool readTileImpl(QIODevice *stream, KisTiledDataManager *dm,
+                      qint32 tileWidth, qint32 tileHeight);
+
+    KisAbstractCompression* compressionForName(const QString &name);
+
 private:
     static const qint8 RAW_DATA_FLAG = 0;
     static const qint8 COMPRESSED_DATA_FLAG = 1;
@@ -45,8 +82,14 @@ private:
     QByteArray m_linearizationBuffer;
     QByteArray m_compressionBuffer;
     QByteArray m_streamingBuffer;
+    QByteArray m_retilingBuffer;
     KisAbstractCompression *m_compression;
-    static const QString m_compressionName;
+
+    /**
+     * The codec for reading tiles written with a codec different
+     * from m_compression. Created lazily.
+     */
+    QScopedPointer<KisAbstractCompression> m_foreignCompression;
 };
 
 #endif /* __KIS_TILE_COMPRESSOR_2_H */
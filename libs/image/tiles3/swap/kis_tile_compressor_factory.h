@@ -13,13 +13,19 @@
 class KRITAIMAGE_EXPORT KisTileCompressorFactory
 {
 public:
-    static KisAbstractTileCompressorSP create(qint32 version) {
+    /**
+     * Creates a tile compressor for the stream of version \p version.
+     * The \p compressionName is used for writing only, the reading
+     * side picks up the codec from the headers of the tiles. It is
+     * ignored by the legacy compressor, which supports LZF only.
+     */
+    static KisAbstractTileCompressorSP create(qint32 version, const QString &compressionName = QString()) {
         switch(version) {
         case 1:
             return KisAbstractTileCompressorSP(new KisLegacyTileCompressor());
             break;
         case 2:
-            return KisAbstractTileCompressorSP(new KisTileCompressor2());
+            return KisAbstractTileCompressorSP(new KisTileCompressor2(compressionName));
             break;
         default:
             qFatal("Unknown version of the tiles");
@@ -0,0 +1,141 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_data_prefetcher.h"
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+
+#include "tiles3/kis_tile_data.h"
+#include "tiles3/kis_tile_data_store.h"
+
+/**
+ * When the user pans the canvas quickly, the requests become outdated
+ * faster than we can fulfill them, so keep only the most recent ones
+ */
+const int KisTileDataPrefetcher::MAX_QUEUE_SIZE = 4096;
+
+struct Q_DECL_HIDDEN KisTileDataPrefetcher::Private
+{
+    KisTileDataStore *store;
+
+    QMutex lock;
+    QWaitCondition hasWork;
+    QWaitCondition isIdle;
+    QQueue<KisTileData*> queue;
+    bool isProcessing = false;
+    bool shouldExit = false;
+
+    QAtomicInteger<qint64> numPrefetchedTiles;
+};
+
+KisTileDataPrefetcher::KisTileDataPrefetcher(KisTileDataStore *store)
+    : QThread(),
+      m_d(new Private())
+{
+    m_d->store = store;
+}
+
+KisTileDataPrefetcher::~KisTileDataPrefetcher()
+{
+    dropQueue();
+    delete m_d;
+}
+
+void KisTileDataPrefetcher::prefetch(const QVector<KisTileData*> &tileDataList)
+{
+    QVector<KisTileData*> droppedTileData;
+
+    {
+        QMutexLocker l(&m_d->lock);
+
+        Q_FOREACH (KisTileData *td, tileDataList) {
+            m_d->queue.enqueue(td);
+        }
+
+        while (m_d->queue.size() > MAX_QUEUE_SIZE) {
+            droppedTileData << m_d->queue.dequeue();
+        }
+
+        m_d->hasWork.wakeOne();
+    }
+
+    /**
+     * deref() may free the tile data, so do it without
+     * holding the lock
+     */
+    Q_FOREACH (KisTileData *td, droppedTileData) {
+        td->deref();
+    }
+}
+
+void KisTileDataPrefetcher::terminatePrefetcher()
+{
+    {
+        QMutexLocker l(&m_d->lock);
+        m_d->shouldExit = true;
+        m_d->hasWork.wakeOne();
+    }
+
+    wait();
+    dropQueue();
+}
+
+qint64 KisTileDataPrefetcher::numPrefetchedTiles() const
+{
+    return m_d->numPrefetchedTiles.loadAcquire();
+}
+
+void KisTileDataPrefetcher::testingWaitForIdle()
+{
+    QMutexLocker l(&m_d->lock);
+
+    while (!m_d->queue.isEmpty() || m_d->isProcessing) {
+        m_d->isIdle.wait(&m_d->lock);
+    }
+}
+
+void KisTileDataPrefetcher::dropQueue()
+{
+    QQueue<KisTileData*> queue;
+
+    {
+        QMutexLocker l(&m_d->lock);
+        std::swap(queue, m_d->queue);
+    }
+
+    Q_FOREACH (KisTileData *td, queue) {
+        td->deref();
+    }
+}
+
+void KisTileDataPrefetcher::run()
+{
+    QMutexLocker l(&m_d->lock);
+
+    while (!m_d->shouldExit) {
+        if (m_d->queue.isEmpty()) {
+            m_d->isIdle.wakeAll();
+            m_d->hasWork.wait(&m_d->lock);
+            continue;
+        }
+
+        KisTileData *td = m_d->queue.dequeue();
+        m_d->isProcessing = true;
+        l.unlock();
+
+        if (m_d->store->prefetchTileData(td)) {
+            m_d->numPrefetchedTiles.ref();
+        }
+        td->deref();
+
+        l.relock();
+        m_d->isProcessing = false;
+    }
+
+    m_d->isIdle.wakeAll();
+}
@@ -0,0 +1,66 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_TILE_DATA_PREFETCHER_H_
+#define KIS_TILE_DATA_PREFETCHER_H_
+
+#include <QThread>
+#include <QVector>
+
+#include "kritaimage_export.h"
+
+
+class KisTileDataStore;
+class KisTileData;
+
+/**
+ * Loads swapped-out tile data back into memory in a background
+ * thread, before the tiles are actually accessed by the user.
+ *
+ * The requests are just hints: the tiles that are still waiting in
+ * the queue when newer requests come may be dropped if the queue
+ * grows too big.
+ */
+class KRITAIMAGE_EXPORT KisTileDataPrefetcher : public QThread
+{
+    Q_OBJECT
+
+public:
+    KisTileDataPrefetcher(KisTileDataStore *store);
+    ~KisTileDataPrefetcher() override;
+
+    /**
+     * Adds \p tileDataList to the prefetch queue. Every tile data in
+     * the list should be ref()'ed by the caller, the prefetcher
+     * takes the ownership of the reference.
+     */
+    void prefetch(const QVector<KisTileData*> &tileDataList);
+
+    void terminatePrefetcher();
+
+    /**
+     * The total number of tile data objects that have been loaded
+     * from the swap by the prefetcher
+     */
+    qint64 numPrefetchedTiles() const;
+
+    /**
+     * Blocks until the queue becomes empty. Used by unittests only.
+     */
+    void testingWaitForIdle();
+
+private:
+    void run() override;
+    void dropQueue();
+
+private:
+    static const int MAX_QUEUE_SIZE;
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* KIS_TILE_DATA_PREFETCHER_H_ */
@@ -17,6 +17,8 @@
 
 const qint32 KisTileDataSwapper::TIMEOUT = -1;
 const qint32 KisTileDataSwapper::DELAY = 0.7 * SEC;
+const int KisTileDataSwapper::MAX_TRACKED_AGE = 15;
+const int KisTileDataSwapper::CANDIDATES_OVERSHOOT = 4;
 
 //#define DEBUG_SWAPPER
 
@@ -32,6 +34,14 @@ class SoftSwapStrategy;
 class AggressiveSwapStrategy;
 
 
+namespace {
+struct BudgetRequest
+{
+    QVector<KisTileData*> tileDataList;
+    qint64 budget;
+};
+}
+
 struct Q_DECL_HIDDEN KisTileDataSwapper::Private
 {
 public:
@@ -40,6 +50,9 @@ public:
     KisTileDataStore *store;
     KisStoreLimits limits;
     QMutex cycleLock;
+
+    QMutex budgetRequestsLock;
+    QVector<BudgetRequest> budgetRequests;
 };
 
 KisTileDataSwapper::KisTileDataSwapper(KisTileDataStore *store)
@@ -79,12 +92,45 @@ void KisTileDataSwapper::run()
     while (1) {
         waitForWork();
 
-        if (m_d->shouldExitFlag)
+        if (m_d->shouldExitFlag) {
+            processBudgetRequests(true);
             return;
+        }
 
         QThread::msleep(DELAY);
 
         doJob();
+        processBudgetRequests(false);
+    }
+}
+
+void KisTileDataSwapper::requestSwapOutToBudget(const QVector<KisTileData*> &tileDataList, qint64 budget)
+{
+    {
+        QMutexLocker locker(&m_d->budgetRequestsLock);
+        m_d->budgetRequests.append({tileDataList, budget});
+    }
+
+    kick();
+}
+
+void KisTileDataSwapper::processBudgetRequests(bool dropRequests)
+{
+    QVector<BudgetRequest> requests;
+
+    {
+        QMutexLocker locker(&m_d->budgetRequestsLock);
+        std::swap(requests, m_d->budgetRequests);
+    }
+
+    Q_FOREACH (const BudgetRequest &request, requests) {
+        if (dropRequests) {
+            Q_FOREACH (KisTileData *td, request.tileDataList) {
+                td->deref();
+            }
+        } else {
+            m_d->store->swapOutLeastRecentlyUsed(request.tileDataList, request.budget);
+        }
     }
 }
 
@@ -135,10 +181,10 @@ void KisTileDataSwapper::doJob()
 class SoftSwapStrategy
 {
 public:
-    typedef KisTileDataStoreIterator iterator;
+    typedef KisTileDataStoreClockIterator iterator;
 
     static inline iterator* beginIteration(KisTileDataStore *store) {
-        return store->beginIteration();
+        return store->beginClockIteration();
     }
 
     static inline void endIteration(KisTileDataStore *store, iterator *iter) {
@@ -149,10 +195,6 @@ public:
         // We are working with mementoed tiles only...
         return td->historical();
     }
-
-    static inline bool swapOutFirst(KisTileData *td) {
-        return td->age() > 0;
-    }
 };
 
 class AggressiveSwapStrategy
@@ -173,10 +215,6 @@ public:
         Q_UNUSED(td);
         return true; // >:)
     }
-
-    static inline bool swapOutFirst(KisTileData *td) {
-        return td->age() > 0;
-    }
 };
 
 
@@ -184,37 +222,47 @@ template<class strategy>
 qint64 KisTileDataSwapper::pass(qint64 needToFreeMetric)
 {
     qint64 freedMetric = 0;
-    QList<KisTileData*> additionalCandidates;
+
+    /**
+     * The pass works like a clock: the hand resumes where the
+     * previous pass has stopped and makes all the visited tiles
+     * older, while every access to a tile resets its age. So the
+     * age of a tile is the number of times the hand has passed
+     * it without the tile being touched.
+     *
+     * The hand stops as soon as it has collected a few times more
+     * candidates than needed, so a small pass doesn't walk the
+     * whole store under the iterator lock. Among the collected
+     * candidates the oldest ones are swapped out first, which
+     * gives a good approximation of LRU.
+     */
+    const qint64 candidatesMetricLimit = CANDIDATES_OVERSHOOT * needToFreeMetric;
+    qint64 candidatesMetric = 0;
+
+    QVector<QVector<KisTileData*>> candidatesByAge(MAX_TRACKED_AGE + 1);
 
     typename strategy::iterator *iter =
         strategy::beginIteration(m_d->store);
 
     KisTileData *item = 0;
 
-    while (iter->hasNext()) {
+    while (iter->hasNext() && candidatesMetric < candidatesMetricLimit) {
         item = iter->next();
 
-        if (freedMetric >= needToFreeMetric) break;
-
         if (!strategy::isInteresting(item)) continue;
 
-        if (strategy::swapOutFirst(item)) {
-            if (iter->trySwapOut(item)) {
-                freedMetric += item->pixelSize();
-            }
-        }
-        else {
-            item->markOld();
-            additionalCandidates.append(item);
-        }
-
+        candidatesByAge[qMin(item->age(), MAX_TRACKED_AGE)].append(item);
+        candidatesMetric += item->pixelSize();
+        item->markOld();
     }
 
-    Q_FOREACH (item, additionalCandidates) {
-        if (freedMetric >= needToFreeMetric) break;
+    for (int age = MAX_TRACKED_AGE; age >= 0; age--) {
+        Q_FOREACH (item, candidatesByAge[age]) {
+            if (freedMetric >= needToFreeMetric) break;
 
-        if (iter->trySwapOut(item)) {
-            freedMetric += item->pixelSize();
+            if (iter->trySwapOut(item)) {
+                freedMetric += item->pixelSize();
+            }
         }
     }
 
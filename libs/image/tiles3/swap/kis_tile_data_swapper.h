@@ -8,6 +8,7 @@
 
 #include <QObject>
 #include <QThread>
+#include <QVector>
 
 #include "kritaimage_export.h"
 
@@ -28,6 +29,16 @@ public:
     void terminateSwapper();
     void checkFreeMemory();
 
+    /**
+     * Asks the swapper thread to swap out the least recently used tile
+     * data of \p tileDataList until the ones kept in memory fit into
+     * \p budget bytes. Every tile data in the list should be ref()'ed
+     * by the caller, the swapper deref()'s them when done.
+     *
+     * \see KisTileDataStore::swapOutLeastRecentlyUsed()
+     */
+    void requestSwapOutToBudget(const QVector<KisTileData*> &tileDataList, qint64 budget);
+
     void testingRereadConfig();
 
 private:
@@ -35,12 +46,25 @@ private:
     void run() override;
 
     void doJob();
+    void processBudgetRequests(bool dropRequests);
     template<class strategy> qint64 pass(qint64 needToFreeMetric);
 
 private:
     static const qint32 TIMEOUT;
     static const qint32 DELAY;
 
+    /**
+     * The tiles that haven't been accessed during this number of
+     * swapper passes are considered equally old
+     */
+    static const int MAX_TRACKED_AGE;
+
+    /**
+     * A pass stops looking for the candidates for swapping out when
+     * it has found this number of times more of them than it needs
+     */
+    static const int CANDIDATES_OVERSHOOT;
+
 private:
     struct Private;
     Private * const m_d;
@@ -0,0 +1,55 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_zlib_compression.h"
+
+#include <zlib.h>
+
+/**
+ * Level 6 is zlib's own default. Higher levels make saving several
+ * times slower without any noticeable gain on the linearized tile data.
+ */
+static const int ZLIB_COMPRESSION_LEVEL = 6;
+
+
+KisZlibCompression::KisZlibCompression()
+{
+}
+
+KisZlibCompression::~KisZlibCompression()
+{
+}
+
+qint32 KisZlibCompression::compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    uLongf destLength = outputLength;
+
+    const int result = compress2(output, &destLength,
+                                 input, inputLength,
+                                 ZLIB_COMPRESSION_LEVEL);
+
+    return result == Z_OK ? qint32(destLength) : 0;
+}
+
+qint32 KisZlibCompression::decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    uLongf destLength = outputLength;
+
+    const int result = uncompress(output, &destLength,
+                                  input, inputLength);
+
+    return result == Z_OK ? qint32(destLength) : 0;
+}
+
+qint32 KisZlibCompression::outputBufferSize(qint32 dataSize)
+{
+    return compressBound(dataSize);
+}
+
+QString KisZlibCompression::name() const
+{
+    return QStringLiteral("ZLIB");
+}
@@ -0,0 +1,31 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_ZLIB_COMPRESSION_H
+#define __KIS_ZLIB_COMPRESSION_H
+
+#include "kis_abstract_compression.h"
+
+/**
+ * Deflate-based codec. It is noticeably slower than LZF, but gives
+ * much better compression ratio, so it is a good choice for saving
+ * documents to disk.
+ */
+class KRITAIMAGE_EXPORT KisZlibCompression : public KisAbstractCompression
+{
+public:
+    KisZlibCompression();
+    ~KisZlibCompression() override;
+
+    qint32 compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+    qint32 decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+
+    qint32 outputBufferSize(qint32 dataSize) override;
+
+    QString name() const override;
+};
+
+#endif /* __KIS_ZLIB_COMPRESSION_H */
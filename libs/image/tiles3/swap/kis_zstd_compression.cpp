@@ -0,0 +1,51 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_zstd_compression.h"
+
+#include <zstd.h>
+
+/**
+ * Level 3 is the default level of the library. It is already better
+ * than zlib in terms of ratio and is much faster than the "ultra" levels.
+ */
+static const int ZSTD_COMPRESSION_LEVEL = 3;
+
+
+KisZstdCompression::KisZstdCompression()
+{
+}
+
+KisZstdCompression::~KisZstdCompression()
+{
+}
+
+qint32 KisZstdCompression::compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const size_t result = ZSTD_compress(output, outputLength,
+                                        input, inputLength,
+                                        ZSTD_COMPRESSION_LEVEL);
+
+    return ZSTD_isError(result) ? 0 : qint32(result);
+}
+
+qint32 KisZstdCompression::decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const size_t result = ZSTD_decompress(output, outputLength,
+                                          input, inputLength);
+
+    return ZSTD_isError(result) ? 0 : qint32(result);
+}
+
+qint32 KisZstdCompression::outputBufferSize(qint32 dataSize)
+{
+    return ZSTD_compressBound(dataSize);
+}
+
+QString KisZstdCompression::name() const
+{
+    return QStringLiteral("ZSTD");
+}
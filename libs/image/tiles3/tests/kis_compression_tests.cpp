@@ -11,6 +11,7 @@
 
 #include "../../../sdk/tests/testutil.h"
 #include "tiles3/swap/kis_lzf_compression.h"
+#include "tiles3/swap/kis_compression_factory.h"
 #include <kis_debug.h>
 
 #define TEST_FILE "tile.png"
@@ -209,6 +210,26 @@ void KisCompressionTests::testLzfOverflow()
     delete compression;
 }
 
+void KisCompressionTests::testAllCompressionsRoundTrip()
+{
+    Q_FOREACH (const QString &name, KisCompressionFactory::availableCompressions()) {
+        QScopedPointer<KisAbstractCompression> compression(KisCompressionFactory::create(name));
+        QVERIFY(compression);
+        QCOMPARE(compression->name(), name);
+
+        roundTrip(compression.data());
+        roundTripTwoPass(compression.data());
+    }
+}
+
+void KisCompressionTests::testAllCompressionsOverflow()
+{
+    Q_FOREACH (const QString &name, KisCompressionFactory::availableCompressions()) {
+        QScopedPointer<KisAbstractCompression> compression(KisCompressionFactory::create(name));
+        testOverflow(compression.data());
+    }
+}
+
 void KisCompressionTests::benchmarkMemCpy()
 {
     QImage image(QString(FILES_DATA_DIR) + QDir::separator() + TEST_FILE);
@@ -249,6 +270,35 @@ void KisCompressionTests::benchmarkDecompressionLzfTwoPass()
     benchmarkDecompressionTwoPass(compression);
     delete compression;
 }
+void KisCompressionTests::benchmarkCompressionAll_data()
+{
+    QTest::addColumn<QString>("compressionName");
+
+    Q_FOREACH (const QString &name, KisCompressionFactory::availableCompressions()) {
+        QTest::newRow(name.toLatin1()) << name;
+    }
+}
+
+void KisCompressionTests::benchmarkCompressionAll()
+{
+    QFETCH(QString, compressionName);
+
+    QScopedPointer<KisAbstractCompression> compression(KisCompressionFactory::create(compressionName));
+    benchmarkCompressionTwoPass(compression.data());
+}
+
+void KisCompressionTests::benchmarkDecompressionAll_data()
+{
+    benchmarkCompressionAll_data();
+}
+
+void KisCompressionTests::benchmarkDecompressionAll()
+{
+    QFETCH(QString, compressionName);
+
+    QScopedPointer<KisAbstractCompression> compression(KisCompressionFactory::create(compressionName));
+    benchmarkDecompressionTwoPass(compression.data());
+}
 
 SIMPLE_TEST_MAIN(KisCompressionTests)
 
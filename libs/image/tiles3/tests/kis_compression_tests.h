@@ -30,12 +30,20 @@ private Q_SLOTS:
     void testLzfRoundTrip();
     void testLzfOverflow();
 
+    void testAllCompressionsRoundTrip();
+    void testAllCompressionsOverflow();
+
     void benchmarkMemCpy();
 
     void benchmarkCompressionLzf();
     void benchmarkCompressionLzfTwoPass();
     void benchmarkDecompressionLzf();
     void benchmarkDecompressionLzfTwoPass();
+
+    void benchmarkCompressionAll_data();
+    void benchmarkCompressionAll();
+    void benchmarkDecompressionAll_data();
+    void benchmarkDecompressionAll();
 };
 
 #endif /* KIS_COMPRESSION_TESTS_H */
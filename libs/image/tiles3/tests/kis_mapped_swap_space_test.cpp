@@ -0,0 +1,118 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_mapped_swap_space_test.h"
+#include <simpletest.h>
+
+#include "kis_debug.h"
+#include <QTemporaryDir>
+
+#include "../swap/kis_mapped_swap_space.h"
+#include "../swap/kis_memory_window.h"
+
+#define SKIP_IF_NOT_SUPPORTED(space)                                    \
+    if (!(space).isValid()) {                                           \
+        QSKIP("The mapped swap space is not supported on this platform"); \
+    }
+
+void KisMappedSwapSpaceTest::testReadWrite()
+{
+    QTemporaryDir swapDir;
+    KisMappedSwapSpace memory(swapDir.path(), 64 * MiB, 1 * MiB);
+    SKIP_IF_NOT_SUPPORTED(memory);
+
+    quint8 oddValue = 0xee;
+    const quint8 chunkLength = 10;
+
+    quint8 oddBuf[chunkLength];
+    memset(oddBuf, oddValue, chunkLength);
+
+    KisChunkData chunk1(0, chunkLength);
+    KisChunkData chunk2(5 * MiB + 1, chunkLength);
+
+    quint8 *ptr;
+
+    ptr = memory.getWriteChunkPtr(chunk1);
+    QVERIFY(ptr);
+    memcpy(ptr, oddBuf, chunkLength);
+    QCOMPARE(memory.numExtents(), 1ULL);
+    QCOMPARE(memory.mappedSize(), 2 * MiB);
+
+    ptr = memory.getWriteChunkPtr(chunk2);
+    QVERIFY(ptr);
+    memcpy(ptr, oddBuf, chunkLength);
+    QCOMPARE(memory.numExtents(), 2ULL);
+    QCOMPARE(memory.mappedSize(), 6 * MiB);
+
+    ptr = memory.getReadChunkPtr(chunk2);
+    QVERIFY(!memcmp(ptr, oddBuf, chunkLength));
+
+    ptr = memory.getReadChunkPtr(chunk1);
+    QVERIFY(!memcmp(ptr, oddBuf, chunkLength));
+
+    // reading the already mapped extents maps nothing new
+    QCOMPARE(memory.numRemaps(), 2ULL);
+}
+
+void KisMappedSwapSpaceTest::testPointersAreStable()
+{
+    QTemporaryDir swapDir;
+    KisMappedSwapSpace memory(swapDir.path(), 64 * MiB, 2 * MiB);
+    SKIP_IF_NOT_SUPPORTED(memory);
+
+    const qint64 chunkLength = 64 * 1024;
+    const int numChunks = 512; // 32 MiB in total
+
+    QVector<quint8*> pointers;
+
+    for (int i = 0; i < numChunks; i++) {
+        quint8 *ptr = memory.getWriteChunkPtr(KisChunkData(i * chunkLength, chunkLength));
+        QVERIFY(ptr);
+        memset(ptr, i & 0xff, chunkLength);
+        pointers << ptr;
+    }
+
+    QVERIFY(memory.numExtents() >= 16);
+
+    for (int i = 0; i < numChunks; i++) {
+        quint8 *ptr = memory.getReadChunkPtr(KisChunkData(i * chunkLength, chunkLength));
+        QCOMPARE(ptr, pointers[i]);
+        QCOMPARE(ptr[0], quint8(i & 0xff));
+        QCOMPARE(ptr[chunkLength - 1], quint8(i & 0xff));
+    }
+
+    QCOMPARE(memory.numRemaps(), memory.numExtents());
+}
+
+void KisMappedSwapSpaceTest::testOutOfReservedSpace()
+{
+    QTemporaryDir swapDir;
+    KisMappedSwapSpace memory(swapDir.path(), 4 * MiB, 1 * MiB);
+    SKIP_IF_NOT_SUPPORTED(memory);
+
+    QVERIFY(memory.getWriteChunkPtr(KisChunkData(0, 1024)));
+    QVERIFY(!memory.getWriteChunkPtr(KisChunkData(4 * MiB, 1024)));
+    QVERIFY(!memory.getReadChunkPtr(KisChunkData(4 * MiB - 512, 1024)));
+}
+
+void KisMappedSwapSpaceTest::testWindowCountsRemaps()
+{
+    QTemporaryDir swapDir;
+    KisMemoryWindow memory(swapDir.path(), 1024);
+
+    const quint8 chunkLength = 10;
+
+    memory.getWriteChunkPtr(KisChunkData(0, chunkLength));
+    QCOMPARE(memory.numRemaps(), 0ULL);
+
+    memory.getWriteChunkPtr(KisChunkData(1025, chunkLength));
+    QCOMPARE(memory.numRemaps(), 1ULL);
+
+    memory.getWriteChunkPtr(KisChunkData(1030, chunkLength));
+    QCOMPARE(memory.numRemaps(), 1ULL);
+}
+
+SIMPLE_TEST_MAIN(KisMappedSwapSpaceTest)
@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_MAPPED_SWAP_SPACE_TEST_H
+#define KIS_MAPPED_SWAP_SPACE_TEST_H
+
+#include <simpletest.h>
+
+
+class KisMappedSwapSpaceTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testReadWrite();
+    void testPointersAreStable();
+    void testOutOfReservedSpace();
+    void testWindowCountsRemaps();
+};
+
+#endif /* KIS_MAPPED_SWAP_SPACE_TEST_H */
+
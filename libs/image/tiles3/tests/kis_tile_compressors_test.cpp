@@ -10,6 +10,7 @@
 #include "tiles3/kis_tiled_data_manager.h"
 #include "tiles3/swap/kis_legacy_tile_compressor.h"
 #include "tiles3/swap/kis_tile_compressor_2.h"
+#include "tiles3/swap/kis_compression_factory.h"
 
 #include "tiles_test_utils.h"
 
@@ -167,6 +168,56 @@ void KisTileCompressorsTest::testLowLevelRoundTripIncompressible2()
     delete compressor;
 }
 
+void KisTileCompressorsTest::testRoundTripAllCompressions()
+{
+    Q_FOREACH (const QString &name, KisCompressionFactory::availableCompressions()) {
+        KisTileCompressor2 compressor(name);
+        QCOMPARE(compressor.compressionName(), name);
+        doRoundTrip(&compressor);
+    }
+}
+
+void KisTileCompressorsTest::testLowLevelRoundTripAllCompressions()
+{
+    Q_FOREACH (const QString &name, KisCompressionFactory::availableCompressions()) {
+        KisTileCompressor2 compressor(name);
+        doLowLevelRoundTrip(&compressor);
+        doLowLevelRoundTripIncompressible(&compressor);
+    }
+}
+
+void KisTileCompressorsTest::testReadForeignCompression()
+{
+    quint8 defaultPixel = 0;
+    quint8 oddPixel1 = 128;
+
+    /**
+     * The stream should be readable by a compressor created
+     * for any other codec, since the codec is stored in the
+     * tile header
+     */
+    Q_FOREACH (const QString &writeName, KisCompressionFactory::availableCompressions()) {
+        Q_FOREACH (const QString &readName, KisCompressionFactory::availableCompressions()) {
+            KisTiledDataManager dm(1, &defaultPixel);
+            dm.clear(64, 64, 64, 64, &oddPixel1);
+
+            KoStoreFake fakeStore;
+            KisFakePaintDeviceWriter writer(&fakeStore);
+
+            KisTileCompressor2 writeCompressor(writeName);
+            QVERIFY(writeCompressor.writeTile(dm.getTile(1, 1, false), writer));
+
+            fakeStore.startReading();
+            dm.clear();
+
+            KisTileCompressor2 readCompressor(readName);
+            QVERIFY(readCompressor.readTile(fakeStore.device(), &dm));
+
+            KisTileSP tile11 = dm.getTile(1, 1, false);
+            QVERIFY(memoryIsFilled(oddPixel1, tile11->data(), TILESIZE));
+        }
+    }
+}
 
 SIMPLE_TEST_MAIN(KisTileCompressorsTest)
 
@@ -17,6 +17,9 @@
 #include "tiles3/kis_tile_data_store.h"
 #include "tiles3/kis_tile_data_store_iterators.h"
 
+#include "kis_datamanager.h"
+#include "tiles3/kis_hline_iterator.h"
+
 
 void KisTileDataStoreTest::testClockIterator()
 {
@@ -176,5 +179,267 @@ void KisTileDataStoreTest::testSwapping()
     }
 }
 
+void KisTileDataStoreTest::testDeduplication()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    KisTiledDataManager *dm1 = new KisTiledDataManager(pixelSize, &defaultPixel);
+    KisTiledDataManager *dm2 = new KisTiledDataManager(pixelSize, &defaultPixel);
+
+    KisTileSP tile1 = dm1->getTile(0, 0, true);
+    KisTileSP tile2 = dm2->getTile(0, 0, true);
+    KisTileSP tile3 = dm2->getTile(1, 0, true);
+
+    tile1->lockForWrite();
+    memset(tile1->data(), 0x42, TILESIZE);
+    tile1->unlockForWrite();
+
+    tile2->lockForWrite();
+    memset(tile2->data(), 0x42, TILESIZE);
+    tile2->unlockForWrite();
+
+    tile3->lockForWrite();
+    memset(tile3->data(), 0x43, TILESIZE);
+    tile3->unlockForWrite();
+
+    QVERIFY(tile1->tileData() != tile2->tileData());
+
+    tile1->deduplicateTileData();
+    tile2->deduplicateTileData();
+    tile3->deduplicateTileData();
+
+    QCOMPARE(tile1->tileData(), tile2->tileData());
+    QVERIFY(tile1->tileData() != tile3->tileData());
+    QCOMPARE(store->memoryStatistics().deduplicatedSize, qint64(TILESIZE));
+
+    // the index doesn't own the tile data, so an unshared tile is
+    // still written in place
+    KisTileData *tileData3 = tile3->tileData();
+    QCOMPARE(tileData3->numUsers(), 1);
+    tile3->lockForWrite();
+    QCOMPARE(tile3->tileData(), tileData3);
+    tile3->unlockForWrite();
+
+    // writing into a shared tile should not affect the other one
+    tile2->lockForWrite();
+    QVERIFY(tile1->tileData() != tile2->tileData());
+    memset(tile2->data(), 0x44, TILESIZE);
+    tile2->unlockForWrite();
+
+    tile1->lockForRead();
+    QVERIFY(memoryIsFilled(0x42, tile1->data(), TILESIZE));
+    tile1->unlockForRead();
+
+    QCOMPARE(store->memoryStatistics().deduplicatedSize, qint64(0));
+
+    tile1 = 0;
+    tile2 = 0;
+    tile3 = 0;
+
+    delete dm1;
+    delete dm2;
+
+    QCOMPARE(store->numTiles(), 0);
+}
+
+void KisTileDataStoreTest::testConstantTiles()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    KisDataManager dm(pixelSize, &defaultPixel);
+
+    KisTileSP tile = dm.getTile(0, 0, true);
+    tile->lockForWrite();
+    memset(tile->data(), 0x42, TILESIZE);
+    tile->unlockForWrite();
+
+    QVERIFY(store->tryMakeTileDataConstant(tile->tileData()));
+    QCOMPARE(store->numConstantTiles(), 1);
+    QVERIFY(!tile->tileData()->data());
+
+    // reading through an iterator doesn't materialize the tile
+    {
+        KisHLineIterator2 it(&dm, 0, 0, 64, 0, 0, false, 0);
+
+        for (int y = 0; y < 64; y++) {
+            do {
+                QCOMPARE(*it.rawDataConst(), quint8(0x42));
+            } while (it.nextPixel());
+            it.nextRow();
+        }
+    }
+
+    QCOMPARE(store->numConstantTiles(), 1);
+
+    // writing materializes it back
+    {
+        KisHLineIterator2 it(&dm, 0, 10, 64, 0, 0, true, 0);
+        *it.rawData() = 0x43;
+    }
+
+    QCOMPARE(store->numConstantTiles(), 0);
+
+    tile = dm.getTile(0, 0, false);
+    tile->lockForRead();
+    QCOMPARE(tile->data()[10 * 64], quint8(0x43));
+    QVERIFY(memoryIsFilled(0x42, tile->data(), 10 * 64));
+    QVERIFY(memoryIsFilled(0x42, tile->data() + 10 * 64 + 1, TILESIZE - 10 * 64 - 1));
+    tile->unlockForRead();
+
+    // a non-uniform tile stays as it is
+    QVERIFY(!store->tryMakeTileDataConstant(dm.getTile(0, 0, false)->tileData()));
+}
+
+void KisTileDataStoreTest::testPrefetch()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    KisDataManager dm(pixelSize, &defaultPixel);
+
+    QVector<KisTileSP> tiles;
+
+    for (qint32 col = 0; col < 4; col++) {
+        KisTileSP tile = dm.getTile(col, 0, true);
+        tile->lockForWrite();
+        // non-uniform, so that the tile could not become constant
+        for (int i = 0; i < TILESIZE; i++) {
+            tile->data()[i] = i % 251;
+        }
+        tile->unlockForWrite();
+
+        tiles << tile;
+    }
+
+    KisTileDataStoreIterator *iter = store->beginIteration();
+    Q_FOREACH (KisTileSP tile, tiles) {
+        QVERIFY(store->trySwapTileData(tile->tileData()));
+        QVERIFY(!tile->tileData()->data());
+    }
+    store->endIteration(iter);
+
+    const qint64 prefetchedBefore = store->memoryStatistics().prefetchedCount;
+
+    // request the first two tiles only
+    dm.prefetchRect(QRect(0, 0, 2 * KisTileData::WIDTH, 1));
+    store->testingWaitForPrefetcher();
+
+    QCOMPARE(store->memoryStatistics().prefetchedCount, prefetchedBefore + 2);
+
+    QVERIFY(tiles[0]->tileData()->data());
+    QVERIFY(tiles[1]->tileData()->data());
+    QVERIFY(!tiles[2]->tileData()->data());
+    QVERIFY(!tiles[3]->tileData()->data());
+
+    for (int i = 0; i < TILESIZE; i++) {
+        QCOMPARE(tiles[0]->tileData()->data()[i], quint8(i % 251));
+    }
+}
+
+void KisTileDataStoreTest::testSwapOutLeastRecentlyUsed()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    KisDataManager dm(pixelSize, &defaultPixel);
+
+    QVector<KisTileSP> tiles;
+
+    for (qint32 col = 0; col < 4; col++) {
+        KisTileSP tile = dm.getTile(col, 0, true);
+        tile->lockForWrite();
+        for (int i = 0; i < TILESIZE; i++) {
+            tile->data()[i] = (i + col) % 251;
+        }
+        tile->unlockForWrite();
+
+        tiles << tile;
+    }
+
+    // the odd tiles have not been accessed for a long time
+    tiles[1]->tileData()->markOld();
+    tiles[1]->tileData()->markOld();
+    tiles[3]->tileData()->markOld();
+
+    const qint64 budget = 2 * TILESIZE;
+
+    QVector<KisTileData*> tileDataList;
+    dm.collectTileData(tileDataList);
+    QCOMPARE(tileDataList.size(), 4);
+
+    QCOMPARE(store->swapOutLeastRecentlyUsed(tileDataList, budget), budget);
+
+    QVERIFY(tiles[0]->tileData()->data());
+    QVERIFY(!tiles[1]->tileData()->data());
+    QVERIFY(tiles[2]->tileData()->data());
+    QVERIFY(!tiles[3]->tileData()->data());
+
+    // already within the budget, nothing to do
+    tileDataList.clear();
+    dm.collectTileData(tileDataList);
+    QCOMPARE(store->swapOutLeastRecentlyUsed(tileDataList, budget), qint64(0));
+
+    // the data survives the round trip
+    tiles[1]->lockForRead();
+    for (int i = 0; i < TILESIZE; i++) {
+        QCOMPARE(tiles[1]->data()[i], quint8((i + 1) % 251));
+    }
+    tiles[1]->unlockForRead();
+}
+
+void KisTileDataStoreTest::testSwapOutLeastRecentlyUsedWithoutPressure()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    KisDataManager dm(pixelSize, &defaultPixel);
+
+    QVector<KisTileSP> tiles;
+
+    for (qint32 col = 0; col < 4; col++) {
+        KisTileSP tile = dm.getTile(col, 0, true);
+        tile->lockForWrite();
+        for (int i = 0; i < TILESIZE; i++) {
+            tile->data()[i] = (i + col) % 251;
+        }
+        tile->unlockForWrite();
+
+        tiles << tile;
+    }
+
+    QVector<KisTileData*> tileDataList;
+
+    // the document is within the budget, but its tiles become older
+    dm.collectTileData(tileDataList);
+    QCOMPARE(store->swapOutLeastRecentlyUsed(tileDataList, 4 * TILESIZE), qint64(0));
+
+    // only the even tiles are accessed after that
+    tiles[0]->lockForRead();
+    tiles[0]->unlockForRead();
+    tiles[2]->lockForRead();
+    tiles[2]->unlockForRead();
+
+    tileDataList.clear();
+    dm.collectTileData(tileDataList);
+    QCOMPARE(store->swapOutLeastRecentlyUsed(tileDataList, 2 * TILESIZE), qint64(2 * TILESIZE));
+
+    QVERIFY(tiles[0]->tileData()->data());
+    QVERIFY(!tiles[1]->tileData()->data());
+    QVERIFY(tiles[2]->tileData()->data());
+    QVERIFY(!tiles[3]->tileData()->data());
+}
+
 SIMPLE_TEST_MAIN(KisTileDataStoreTest)
 
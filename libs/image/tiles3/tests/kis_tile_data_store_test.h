@@ -18,6 +18,11 @@ private Q_SLOTS:
     void testClockIterator();
     void testLeaks();
     void testSwapping();
+    void testDeduplication();
+    void testConstantTiles();
+    void testPrefetch();
+    void testSwapOutLeastRecentlyUsed();
+    void testSwapOutLeastRecentlyUsedWithoutPressure();
 };
 
 #endif /* KIS_TILE_DATA_STORE_TEST_H */
@@ -11,6 +11,9 @@
 
 #include "tiles_test_utils.h"
 #include "config-limit-long-tests.h"
+#include "kis_image_config.h"
+
+#include <QBuffer>
 
 bool KisTiledDataManagerTest::checkHole(quint8* buffer,
                                         quint8 holeColor, QRect holeRect,
@@ -1116,5 +1119,125 @@ void KisTiledDataManagerTest::benchmaskOverlappedKisRegion()
 #endif
 }
 
+class KisWritableTestingDataManager : public KisTiledDataManager
+{
+public:
+    KisWritableTestingDataManager(quint32 pixelSize, const quint8 *defPixel)
+        : KisTiledDataManager(pixelSize, defPixel)
+    {
+    }
+
+    using KisTiledDataManager::write;
+    using KisTiledDataManager::read;
+};
+
+class KisByteArrayWriter : public KisPaintDeviceWriter
+{
+public:
+    bool write(const QByteArray &data) override {
+        m_data.append(data);
+        return true;
+    }
+
+    bool write(const char* data, qint64 length) override {
+        m_data.append(data, length);
+        return true;
+    }
+
+    QByteArray m_data;
+};
+
+void KisTiledDataManagerTest::testParallelWriteIsByteIdentical()
+{
+    const quint8 defaultPixel = 0;
+    KisWritableTestingDataManager dm(1, &defaultPixel);
+
+    /**
+     * Fill enough tiles with some compressible, but
+     * non-uniform data to enable the parallel path
+     */
+    const QRect rc(-100, -100, 20 * 64, 20 * 64);
+    QByteArray data(rc.width() * rc.height(), 0);
+    for (int i = 0; i < data.size(); i++) {
+        data[i] = (i / 7) % 13;
+    }
+    dm.writeBytes((quint8*)data.data(), rc.x(), rc.y(), rc.width(), rc.height());
+
+    const bool oldParallelSaving = KisImageConfig(true).enableParallelTileSaving();
+
+    KisByteArrayWriter serialWriter;
+    KisImageConfig(false).setEnableParallelTileSaving(false);
+    QVERIFY(dm.write(serialWriter));
+
+    KisByteArrayWriter parallelWriter;
+    KisImageConfig(false).setEnableParallelTileSaving(true);
+    QVERIFY(dm.write(parallelWriter));
+
+    KisImageConfig(false).setEnableParallelTileSaving(oldParallelSaving);
+
+    QCOMPARE(parallelWriter.m_data, serialWriter.m_data);
+
+    KisWritableTestingDataManager loadedDm(1, &defaultPixel);
+    QBuffer buffer(&parallelWriter.m_data);
+    buffer.open(QIODevice::ReadOnly);
+    QVERIFY(loadedDm.read(&buffer));
+
+    QByteArray loadedData(rc.width() * rc.height(), 1);
+    loadedDm.readBytes((quint8*)loadedData.data(), rc.x(), rc.y(), rc.width(), rc.height());
+    QCOMPARE(loadedData, data);
+}
+
+void KisTiledDataManagerTest::testReadForeignTileSize()
+{
+    /**
+     * Emulate a file saved by a build with the tiles of half size:
+     * a 2x3 grid of raw tiles starting at a negative offset
+     */
+    const qint32 foreignSize = KisTileData::WIDTH / 2;
+    const QRect rc(-foreignSize, -foreignSize, 2 * foreignSize, 3 * foreignSize);
+
+    QByteArray stream;
+    stream += QString("VERSION 2\n"
+                      "TILEWIDTH %1\n"
+                      "TILEHEIGHT %1\n"
+                      "PIXELSIZE 1\n"
+                      "DATA 6\n").arg(foreignSize).toLatin1();
+
+    QByteArray data(rc.width() * rc.height(), 0);
+
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 2; col++) {
+            const qint32 x = rc.x() + col * foreignSize;
+            const qint32 y = rc.y() + row * foreignSize;
+
+            QByteArray tileData(foreignSize * foreignSize, 0);
+            for (int i = 0; i < tileData.size(); i++) {
+                tileData[i] = (row * 2 + col + 1) * 10 + i % 7;
+
+                const int dataX = x - rc.x() + i % foreignSize;
+                const int dataY = y - rc.y() + i / foreignSize;
+                data[dataY * rc.width() + dataX] = tileData[i];
+            }
+
+            stream += QString("%1,%2,LZF,%3\n").arg(x).arg(y).arg(tileData.size() + 1).toLatin1();
+            stream += char(0); // RAW_DATA_FLAG
+            stream += tileData;
+        }
+    }
+
+    const quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    QBuffer buffer(&stream);
+    buffer.open(QIODevice::ReadOnly);
+    QVERIFY(dm.read(&buffer));
+
+    QByteArray loadedData(rc.width() * rc.height(), 1);
+    dm.readBytes((quint8*)loadedData.data(), rc.x(), rc.y(), rc.width(), rc.height());
+    QCOMPARE(loadedData, data);
+
+    QVERIFY(dm.extent().contains(rc));
+}
+
 SIMPLE_TEST_MAIN(KisTiledDataManagerTest)
 
@@ -40,6 +40,8 @@ private Q_SLOTS:
     void testTransactions();
     void testPurgeHistory();
     void testUndoSetDefaultPixel();
+    void testParallelWriteIsByteIdentical();
+    void testReadForeignTileSize();
 
     void benchmarkReadOnlyTileLazy();
     void benchmarkSharedPointers();
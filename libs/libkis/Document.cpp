@@ -785,6 +785,18 @@ void Document::waitForDone()
     d->document->image()->waitForDone();
 }
 
+void Document::waitForVisibleUpdates()
+{
+    if (!d->document || !d->document->image()) return;
+    d->document->image()->waitForUpdates(KisUpdatePriority::Visible);
+}
+
+void Document::waitForAllUpdates()
+{
+    if (!d->document || !d->document->image()) return;
+    d->document->image()->waitForUpdates(KisUpdatePriority::Offscreen);
+}
+
 bool Document::tryBarrierLock()
 {
     if (!d->document || !d->document->image()) return false;
@@ -729,6 +729,36 @@ print(root.childNodes())
      */
     void waitForDone();
 
+    /**
+     * Wait until the part of the image visible on the canvas is up to
+     * date and return without locking the image. The visible updates are
+     * processed before the others, so the offscreen parts of the image
+     * may still be updating when this function returns.
+     *
+     * If the document has never been shown in a view, there is no visible
+     * area, so the function waits for all the updates.
+     *
+     * The updates are not processed while an unfinished action (stroke)
+     * needs exclusive access to the image. In this case the function
+     * returns without waiting for them; call waitForDone() instead to
+     * finish the action first.
+     */
+    void waitForVisibleUpdates();
+
+    /**
+     * Wait until the updates of all priorities (the visible area, the
+     * level-of-detail plane and the offscreen areas) are complete and
+     * return without locking the image. Unlike waitForDone(), this
+     * function doesn't wait for the unfinished actions (strokes) to
+     * complete.
+     *
+     * The updates are not processed while an unfinished action (stroke)
+     * needs exclusive access to the image. In this case the function
+     * returns without waiting for them; call waitForDone() instead to
+     * finish the action first.
+     */
+    void waitForAllUpdates();
+
     /**
      * @brief Tries to lock the image without waiting for the jobs to finish
      *
@@ -18,12 +18,14 @@
 #endif
 
 #include <KoColorModelStandardIds.h>
+#include <KoColorModelStandardIdsUtils.h>
 #include <KoColorSpace.h>
 #include <KoColorSpaceMaths.h>
 #include <KoColorSpaceTraits.h>
 
 #include "KisDitherOp.h"
 #include "KisDitherMaths.h"
+#include "dithering/KisOptimizedDitherKernelFactory.h"
 
 template<typename srcCSTraits, typename dstCSTraits, DitherType dType> class KisDitherOpImpl : public KisDitherOp
 {
@@ -32,8 +34,7 @@ template<typename srcCSTraits, typename dstCSTraits, DitherType dType> class Kis
 
 public:
     KisDitherOpImpl(const KoID &srcId, const KoID &dstId)
-        : m_srcDepthId(srcId)
-        , m_dstDepthId(dstId)
+        : KisDitherOpImpl(srcId, dstId, createOptimizedKernel(0))
     {
     }
 
@@ -62,6 +63,33 @@ public:
         return dType;
     }
 
+protected:
+    /**
+     * Takes ownership of \p optimizedKernel, which is used for dithering
+     * rows of pixels, if not null
+     */
+    KisDitherOpImpl(const KoID &srcId, const KoID &dstId, KisOptimizedDitherKernelBase *optimizedKernel)
+        : m_optimizedKernel(optimizedKernel)
+        , m_srcDepthId(srcId)
+        , m_dstDepthId(dstId)
+    {
+    }
+
+    /**
+     * Creates a vectorized kernel for dithering rows of pixels. Returns
+     * nullptr if there is none for this combination of depths.
+     */
+    static KisOptimizedDitherKernelBase *createOptimizedKernel(quint32 truncatedChannels)
+    {
+        return KisOptimizedDitherKernelFactory::create(colorDepthIdForChannelType<srcChannelsType>(),
+                                                       colorDepthIdForChannelType<dstChannelsType>(),
+                                                       dType,
+                                                       srcCSTraits::channels_nb,
+                                                       truncatedChannels);
+    }
+
+    QScopedPointer<KisOptimizedDitherKernelBase> m_optimizedKernel;
+
 private:
     const KoID m_srcDepthId, m_dstDepthId;
 
@@ -137,6 +165,11 @@ private:
     template<DitherType t = dType, typename std::enable_if<t != DITHER_NONE, void>::type * = nullptr>
     inline void ditherImpl(const quint8 *srcRowStart, int srcRowStride, quint8 *dstRowStart, int dstRowStride, int x, int y, int columns, int rows) const
     {
+        if (m_optimizedKernel) {
+            m_optimizedKernel->dither(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            return;
+        }
+
         const quint8 *nativeSrc = srcRowStart;
         quint8 *nativeDst = dstRowStart;
 
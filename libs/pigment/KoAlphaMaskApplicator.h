@@ -53,6 +53,239 @@ struct KoAlphaMaskApplicator : public KoAlphaMaskApplicatorBase
 
 #include "KoStreamedMath.h"
 
+#include <cstring>
+
+/**
+ * Channel-type-specific arithmetic of the vectorized mask applicator.
+ *
+ * The alpha channels of Vc::float_v::size() pixels are fetched into
+ * a vector, processed and written back. All the operations repeat
+ * exactly what KoColorSpaceTrait does for a single pixel, so the
+ * result is bit-exact with the scalar version.
+ */
+template<typename channels_type, Vc::Implementation _impl, typename EnableDummyType = void>
+struct KoAlphaMaskApplicatorMath;
+
+template<typename channels_type, Vc::Implementation _impl>
+struct KoAlphaMaskApplicatorMath<channels_type, _impl,
+        typename std::enable_if<std::is_integral<channels_type>::value>::type>
+{
+    using uint_v = typename KoStreamedMath<_impl>::uint_v;
+    using int_v = typename KoStreamedMath<_impl>::int_v;
+    using value_v = uint_v;
+
+    static constexpr int bits = 8 * sizeof(channels_type);
+
+    static inline value_v load(const channels_type *src, int stride) {
+        quint32 values[uint_v::size()];
+        for (int i = 0; i < static_cast<int>(uint_v::size()); i++) {
+            values[i] = src[i * stride];
+        }
+
+        uint_v result;
+        result.load(values, Vc::Unaligned);
+        return result;
+    }
+
+    static inline void store(const value_v &value, channels_type *dst, int stride) {
+        quint32 values[uint_v::size()];
+        value.store(values, Vc::Unaligned);
+
+        for (int i = 0; i < static_cast<int>(uint_v::size()); i++) {
+            dst[i * stride] = static_cast<channels_type>(values[i]);
+        }
+    }
+
+    static inline value_v inverseMaskToAlpha(Vc::float_v::AsArg mask) {
+        const float unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+
+        // the float -> int conversion truncates, exactly like channels_type(float) does
+        return uint_v(int_v(Vc::float_v(unitValue) * (Vc::float_v(1.0f) - mask)));
+    }
+
+    // UINT8_MULT() and UINT16_MULT()
+    static inline value_v multiply(const value_v &a, const value_v &b) {
+        const uint_v c = a * b + (1u << (bits - 1));
+        return ((c >> bits) + c) >> bits;
+    }
+};
+
+template<Vc::Implementation _impl>
+struct KoAlphaMaskApplicatorMath<float, _impl>
+{
+    using value_v = Vc::float_v;
+
+    static inline value_v load(const float *src, int stride) {
+        float values[Vc::float_v::size()];
+        for (int i = 0; i < static_cast<int>(Vc::float_v::size()); i++) {
+            values[i] = src[i * stride];
+        }
+        return Vc::float_v(values, Vc::Unaligned);
+    }
+
+    static inline void store(const value_v &value, float *dst, int stride) {
+        float values[Vc::float_v::size()];
+        value.store(values, Vc::Unaligned);
+
+        for (int i = 0; i < static_cast<int>(Vc::float_v::size()); i++) {
+            dst[i * stride] = values[i];
+        }
+    }
+
+    static inline value_v inverseMaskToAlpha(Vc::float_v::AsArg mask) {
+        return Vc::float_v(KoColorSpaceMathsTraits<float>::unitValue) * (Vc::float_v(1.0f) - mask);
+    }
+
+    /**
+     * KoColorSpaceMaths<float>::multiply() calculates the product in
+     * double and divides it by unitValue, which is 1.0. A product of two
+     * floats is always representable in double exactly, so rounding it
+     * to float gives the same value as a plain float multiplication.
+     */
+    static inline value_v multiply(const value_v &a, const value_v &b) {
+        return a * b;
+    }
+};
+
+#ifdef HAVE_OPENEXR
+
+/**
+ * Half values are processed as floats. The intermediate values are
+ * rounded to half at exactly the same points where the scalar version
+ * stores them in half variables.
+ */
+template<Vc::Implementation _impl>
+struct KoAlphaMaskApplicatorMath<half, _impl>
+{
+    using value_v = Vc::float_v;
+    using HalfConversion = KoOptimizedHalfConversion<_impl>;
+
+    static inline value_v load(const half *src, int stride) {
+        half values[Vc::float_v::size()];
+        for (int i = 0; i < static_cast<int>(Vc::float_v::size()); i++) {
+            values[i] = src[i * stride];
+        }
+
+        float floatValues[Vc::float_v::size()];
+        HalfConversion::halfToFloat(values, floatValues, Vc::float_v::size());
+        return Vc::float_v(floatValues, Vc::Unaligned);
+    }
+
+    static inline void store(const value_v &value, half *dst, int stride) {
+        float floatValues[Vc::float_v::size()];
+        value.store(floatValues, Vc::Unaligned);
+
+        half values[Vc::float_v::size()];
+        HalfConversion::floatToHalf(floatValues, values, Vc::float_v::size());
+
+        for (int i = 0; i < static_cast<int>(Vc::float_v::size()); i++) {
+            dst[i * stride] = values[i];
+        }
+    }
+
+    static inline value_v roundToHalf(const value_v &value) {
+        float floatValues[Vc::float_v::size()];
+        value.store(floatValues, Vc::Unaligned);
+
+        half values[Vc::float_v::size()];
+        HalfConversion::floatToHalf(floatValues, values, Vc::float_v::size());
+        HalfConversion::halfToFloat(values, floatValues, Vc::float_v::size());
+
+        return Vc::float_v(floatValues, Vc::Unaligned);
+    }
+
+    static inline value_v inverseMaskToAlpha(Vc::float_v::AsArg mask) {
+        const float unitValue = KoColorSpaceMathsTraits<half>::unitValue;
+        return roundToHalf(Vc::float_v(unitValue) * (Vc::float_v(1.0f) - mask));
+    }
+
+    /**
+     * A product of two half values is exact in float, so the only
+     * rounding happens in store(), just like in the scalar version
+     */
+    static inline value_v multiply(const value_v &a, const value_v &b) {
+        return a * b;
+    }
+};
+
+#endif /* HAVE_OPENEXR */
+
+/**
+ * A generic vectorized version of the applicator for all the color spaces
+ * that have no specialized implementation. Alpha values are calculated
+ * in vectors of Vc::float_v::size() pixels, the color channels are
+ * filled in with a single memcpy() per vector.
+ */
+template<typename _channels_type_,
+         int _channels_nb_,
+         int _alpha_pos_,
+         Vc::Implementation _impl>
+struct KoAlphaMaskApplicator<
+        _channels_type_, _channels_nb_, _alpha_pos_, _impl,
+        typename std::enable_if<_impl != Vc::ScalarImpl &&
+                                !(std::is_same<_channels_type_, quint8>::value &&
+                                  _channels_nb_ == 4 && _alpha_pos_ == 3)>::type> : public KoAlphaMaskApplicatorBase
+{
+    using Trait = KoColorSpaceTrait<_channels_type_, _channels_nb_, _alpha_pos_>;
+    using Math = KoAlphaMaskApplicatorMath<_channels_type_, _impl>;
+    using value_v = typename Math::value_v;
+
+    static constexpr int vectorSize = Vc::float_v::size();
+    static constexpr int pixelSize = Trait::pixelSize;
+
+    void applyInverseNormedFloatMask(quint8 *pixels,
+                                     const float *alpha,
+                                     qint32 nPixels) const override
+    {
+        const int block1 = nPixels / vectorSize;
+        const int block2 = nPixels % vectorSize;
+
+        for (int i = 0; i < block1; i++) {
+            const Vc::float_v maskAlpha(alpha, Vc::Unaligned);
+            _channels_type_ *alphaPtr = Trait::nativeArray(pixels) + _alpha_pos_;
+
+            const value_v pixelAlpha = Math::load(alphaPtr, _channels_nb_);
+            Math::store(Math::multiply(pixelAlpha, Math::inverseMaskToAlpha(maskAlpha)),
+                        alphaPtr, _channels_nb_);
+
+            pixels += vectorSize * pixelSize;
+            alpha += vectorSize;
+        }
+
+        Trait::applyInverseAlphaNormedFloatMask(pixels, alpha, block2);
+    }
+
+    void fillInverseAlphaNormedFloatMaskWithColor(quint8 * pixels,
+                                                  const float * alpha,
+                                                  const quint8 *brushColor,
+                                                  qint32 nPixels) const override {
+        const int block1 = nPixels / vectorSize;
+        const int block2 = nPixels % vectorSize;
+
+        quint8 colorPattern[vectorSize * pixelSize];
+        for (int i = 0; i < vectorSize; i++) {
+            memcpy(colorPattern + i * pixelSize, brushColor, pixelSize);
+        }
+
+        for (int i = 0; i < block1; i++) {
+            const Vc::float_v maskAlpha(alpha, Vc::Unaligned);
+
+            memcpy(pixels, colorPattern, sizeof(colorPattern));
+            Math::store(Math::inverseMaskToAlpha(maskAlpha),
+                        Trait::nativeArray(pixels) + _alpha_pos_, _channels_nb_);
+
+            pixels += vectorSize * pixelSize;
+            alpha += vectorSize;
+        }
+
+        Trait::fillInverseAlphaNormedFloatMaskWithColor(pixels, alpha, brushColor, block2);
+    }
+
+    void fillGrayBrushWithColor(quint8 *dst, const QRgb *brush, quint8 *brushColor, qint32 nPixels) const override {
+        Trait::fillGrayBrushWithColor(dst, brush, brushColor, nPixels);
+    }
+};
+
 template<Vc::Implementation _impl>
 struct KoAlphaMaskApplicator<
         quint8, 4, 3, _impl,
@@ -79,12 +312,13 @@ struct KoAlphaMaskApplicator<
             uint_v data_i;
             data_i.load(reinterpret_cast<const quint32*>(pixels), Vc::Unaligned);
 
-            Vc::float_v pixelAlpha = Vc::simd_cast<Vc::float_v>(data_i >> 24U);
-            pixelAlpha *= Vc::float_v(1.0f) - maskAlpha;
+            // the float -> int conversion truncates, exactly like quint8(float) does
+            const Vc::float_v maskValue = Vc::float_v(255.0f) * (Vc::float_v(1.0f) - maskAlpha);
+            const uint_v maskValue_i = uint_v(int_v(maskValue));
 
             const quint32 colorChannelsMask = 0x00FFFFFF;
 
-            uint_v pixelAlpha_i = uint_v(int_v(Vc::round(pixelAlpha)));
+            const uint_v pixelAlpha_i = multiply(data_i >> 24U, maskValue_i);
             data_i = (data_i & colorChannelsMask) | (pixelAlpha_i << 24);
             data_i.store(reinterpret_cast<quint32 *>(pixels), Vc::Unaligned);
 
@@ -109,7 +343,7 @@ struct KoAlphaMaskApplicator<
             Vc::float_v maskAlpha(alpha, Vc::Unaligned);
             Vc::float_v pixelAlpha = Vc::float_v(255.0f) * (Vc::float_v(1.0f) - maskAlpha);
 
-            uint_v pixelAlpha_i = uint_v(int_v(Vc::round(pixelAlpha)));
+            uint_v pixelAlpha_i = uint_v(int_v(pixelAlpha));
             uint_v data_i = brushColor_i | (pixelAlpha_i << 24);
             data_i.store(reinterpret_cast<quint32 *>(pixels), Vc::Unaligned);
 
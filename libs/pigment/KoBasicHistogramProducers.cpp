@@ -17,6 +17,7 @@
 // #include "Ko_global.h"
 #include "KoIntegerMaths.h"
 #include "KoChannelInfo.h"
+#include "KoOptimizedHistogramAccumulatorBase.h"
 
 static const KoColorSpace* m_labCs = 0;
 
@@ -134,6 +135,24 @@ void KoBasicU8HistogramProducer::addRegionToBin(const quint8 * pixels, const qui
             nPixels--;
         }
     }
+
+    delete[] dstPixels;
+}
+
+bool KoBasicU8HistogramProducer::canAddAccumulatedBins(const KoColorSpace *colorSpace) const
+{
+    // addRegionToBin() converts the pixels of other color spaces
+    return *colorSpace == *m_colorSpace;
+}
+
+void KoBasicU8HistogramProducer::addAccumulatedBins(const KoOptimizedHistogramAccumulatorBase &accumulator, quint32 nPixels)
+{
+    Q_ASSERT(accumulator.channelCount() == m_channels);
+
+    for (int i = 0; i < m_channels; i++) {
+        accumulator.addToBins(i, m_bins[i].data());
+    }
+    m_count += nPixels;
 }
 
 // ------------ U16 ---------------------
@@ -206,6 +225,8 @@ void KoBasicU16HistogramProducer::addRegionToBin(const quint8 * pixels, const qu
             nPixels--;
         }
     }
+
+    delete[] dstPixels;
 }
 
 // ------------ Float32 ---------------------
@@ -279,6 +300,8 @@ void KoBasicF32HistogramProducer::addRegionToBin(const quint8 * pixels, const qu
 
         }
     }
+
+    delete[] dstPixels;
 }
 
 #ifdef HAVE_OPENEXR
@@ -352,6 +375,8 @@ void KoBasicF16HalfHistogramProducer::addRegionToBin(const quint8 * pixels, cons
             nPixels--;
         }
     }
+
+    delete[] dstPixels;
 }
 #endif
 
@@ -95,6 +95,8 @@ public:
     KoBasicU8HistogramProducer(const KoID& id, const KoColorSpace *colorSpace);
     ~KoBasicU8HistogramProducer() override {}
     void addRegionToBin(const quint8 * pixels, const quint8 * selectionMask, quint32 nPixels, const KoColorSpace *colorSpace) override;
+    bool canAddAccumulatedBins(const KoColorSpace *colorSpace) const override;
+    void addAccumulatedBins(const KoOptimizedHistogramAccumulatorBase &accumulator, quint32 nPixels) override;
     QString positionToString(qreal pos) const override;
     qreal maximalZoom() const override {
         return 1.0;
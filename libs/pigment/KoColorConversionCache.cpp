@@ -10,6 +10,9 @@
 #include <QList>
 #include <QMutex>
 #include <QThreadStorage>
+#include <QVector>
+
+#include <algorithm>
 
 #include <KoColorSpace.h>
 
@@ -46,28 +49,102 @@ uint qHash(const KoColorConversionCacheKey& key)
 struct KoColorConversionCache::CachedTransformation {
 
     CachedTransformation(KoColorConversionTransformation* _transfo)
-        : transfo(_transfo), use(0)
+        : transfo(_transfo), ref(1)
     {}
 
     ~CachedTransformation() {
         delete transfo;
     }
 
-    bool isNotInUse() {
-        return !use;
+    /**
+     * The cache itself holds one reference to the transformation, every
+     * KoCachedColorConversionTransformation holds one more. Whoever
+     * drops the last reference deletes the object.
+     */
+    void deref() {
+        if (!ref.deref()) {
+            delete this;
+        }
     }
 
     KoColorConversionTransformation* transfo;
-    QAtomicInt use;
+    QAtomicInt ref;
 };
 
 typedef QPair<KoColorConversionCacheKey, KoCachedColorConversionTransformation> FastPathCacheItem;
 
+namespace {
+
+/**
+ * A tiny MRU list of the transformations used by the current thread. It
+ * is accessed by its owner thread only, so no locking is needed.
+ */
+struct ThreadLocalCache {
+    static const int maxSize = 8;
+
+    ThreadLocalCache(int _generation)
+        : generation(_generation)
+    {
+    }
+
+    ~ThreadLocalCache() {
+        qDeleteAll(items);
+    }
+
+    void clear(int newGeneration) {
+        qDeleteAll(items);
+        items.clear();
+        generation = newGeneration;
+    }
+
+    FastPathCacheItem* find(const KoColorConversionCacheKey &key) {
+        for (int i = 0; i < items.size(); i++) {
+            FastPathCacheItem *item = items[i];
+            if (item->first == key) {
+                if (i > 0) {
+                    std::rotate(items.begin(), items.begin() + i, items.begin() + i + 1);
+                }
+                return item;
+            }
+        }
+        return 0;
+    }
+
+    void push(FastPathCacheItem *item) {
+        if (items.size() >= maxSize) {
+            delete items.takeLast();
+        }
+        items.prepend(item);
+    }
+
+    int generation;
+    QVector<FastPathCacheItem*> items;
+};
+
+}
+
 struct KoColorConversionCache::Private {
-    QMultiHash< KoColorConversionCacheKey, CachedTransformation*> cache;
-    QMutex cacheMutex;
+    static const int numShards = 16;
+
+    struct Shard {
+        QMultiHash< KoColorConversionCacheKey, CachedTransformation*> cache;
+        QMutex mutex;
+    };
+
+    Shard& shardForKey(const KoColorConversionCacheKey &key) {
+        return shards[qHash(key) % numShards];
+    }
+
+    Shard shards[numShards];
 
-    QThreadStorage<FastPathCacheItem*> fastStorage;
+    /**
+     * Incremented every time a color space is destroyed, so that all
+     * the threads could drop their thread-local caches which might
+     * still point to the destroyed color space
+     */
+    QAtomicInt generation;
+
+    QThreadStorage<ThreadLocalCache*> fastStorage;
 };
 
 
@@ -77,8 +154,10 @@ KoColorConversionCache::KoColorConversionCache() : d(new Private)
 
 KoColorConversionCache::~KoColorConversionCache()
 {
-    Q_FOREACH (CachedTransformation* transfo, d->cache) {
-        delete transfo;
+    for (int i = 0; i < Private::numShards; i++) {
+        Q_FOREACH (CachedTransformation* transfo, d->shards[i].cache) {
+            transfo->deref();
+        }
     }
     delete d;
 }
@@ -90,85 +169,124 @@ KoCachedColorConversionTransformation KoColorConversionCache::cachedConverter(co
 {
     KoColorConversionCacheKey key(src, dst, _renderingIntent, _conversionFlags);
 
-    FastPathCacheItem *cacheItem =
-        d->fastStorage.localData();
+    const int generation = d->generation.loadAcquire();
 
+    ThreadLocalCache *localCache = d->fastStorage.localData();
+    if (!localCache) {
+        localCache = new ThreadLocalCache(generation);
+        d->fastStorage.setLocalData(localCache);
+    } else if (localCache->generation != generation) {
+        localCache->clear(generation);
+    }
+
+    FastPathCacheItem *cacheItem = localCache->find(key);
     if (cacheItem) {
-        if (cacheItem->first == key) {
-            return cacheItem->second;
-        }
+        return cacheItem->second;
     }
 
-    cacheItem = 0;
+    Private::Shard &shard = d->shardForKey(key);
 
-    QMutexLocker lock(&d->cacheMutex);
-    QList< CachedTransformation* > cachedTransfos = d->cache.values(key);
-    if (cachedTransfos.size() != 0) {
-        Q_FOREACH (CachedTransformation* ct, cachedTransfos) {
+    {
+        QMutexLocker lock(&shard.mutex);
+        QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::const_iterator it = shard.cache.constFind(key);
+        if (it != shard.cache.constEnd()) {
+            CachedTransformation *ct = it.value();
             ct->transfo->setSrcColorSpace(src);
             ct->transfo->setDstColorSpace(dst);
 
-            cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(this, ct));
-            break;
+            cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct));
         }
     }
+
     if (!cacheItem) {
+        /**
+         * Creating a transformation may be slow, so do that without
+         * holding the lock. If another thread has created the same
+         * transformation in the meantime, just use its copy.
+         */
         KoColorConversionTransformation* transfo = src->createColorConverter(dst, _renderingIntent, _conversionFlags);
-        CachedTransformation* ct = new CachedTransformation(transfo);
-        d->cache.insert(key, ct);
-        cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(this, ct));
+
+        QMutexLocker lock(&shard.mutex);
+        QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::const_iterator it = shard.cache.constFind(key);
+        if (it != shard.cache.constEnd()) {
+            delete transfo;
+            CachedTransformation *ct = it.value();
+            ct->transfo->setSrcColorSpace(src);
+            ct->transfo->setDstColorSpace(dst);
+            cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct));
+        } else {
+            CachedTransformation* ct = new CachedTransformation(transfo);
+            shard.cache.insert(key, ct);
+            cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct));
+        }
     }
 
-    d->fastStorage.setLocalData(cacheItem);
+    localCache->push(cacheItem);
     return cacheItem->second;
 }
 
 void KoColorConversionCache::colorSpaceIsDestroyed(const KoColorSpace* cs)
 {
-    d->fastStorage.setLocalData(0);
-
-    QMutexLocker lock(&d->cacheMutex);
-    QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator endIt = d->cache.end();
-    for (QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator it = d->cache.begin(); it != endIt;) {
-        if (it.key().src == cs || it.key().dst == cs) {
-            Q_ASSERT(it.value()->isNotInUse()); // That's terribely evil, if that assert fails, that means that someone is using a color transformation with a color space which is currently being deleted
-            delete it.value();
-            it = d->cache.erase(it);
-        } else {
-            ++it;
+    d->generation.ref();
+
+    ThreadLocalCache *localCache = d->fastStorage.localData();
+    if (localCache) {
+        localCache->clear(d->generation.loadAcquire());
+    }
+
+    for (int i = 0; i < Private::numShards; i++) {
+        Private::Shard &shard = d->shards[i];
+
+        QMutexLocker lock(&shard.mutex);
+        QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator endIt = shard.cache.end();
+        for (QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator it = shard.cache.begin(); it != endIt;) {
+            if (it.key().src == cs || it.key().dst == cs) {
+                /**
+                 * Thread-local caches of other threads may still hold a
+                 * reference to the transformation until they notice the
+                 * generation change, so the transformation is deleted by
+                 * whoever drops the last reference.
+                 */
+                it.value()->deref();
+                it = shard.cache.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
 }
 
 //--------- KoCachedColorConversionTransformation ----------//
 
-struct KoCachedColorConversionTransformation::Private {
-    KoColorConversionCache* cache;
-    KoColorConversionCache::CachedTransformation* transfo;
-};
-
+KoCachedColorConversionTransformation::KoCachedColorConversionTransformation(KoColorConversionCache::CachedTransformation* transfo)
+    : m_transfo(transfo)
+{
+    m_transfo->ref.ref();
+}
 
-KoCachedColorConversionTransformation::KoCachedColorConversionTransformation(KoColorConversionCache* cache, KoColorConversionCache::CachedTransformation* transfo) : d(new Private)
+KoCachedColorConversionTransformation::KoCachedColorConversionTransformation(const KoCachedColorConversionTransformation& rhs)
+    : m_transfo(rhs.m_transfo)
 {
-    d->cache = cache;
-    d->transfo = transfo;
-    d->transfo->use.ref();
+    m_transfo->ref.ref();
 }
 
-KoCachedColorConversionTransformation::KoCachedColorConversionTransformation(const KoCachedColorConversionTransformation& rhs) : d(new Private(*rhs.d))
+KoCachedColorConversionTransformation& KoCachedColorConversionTransformation::operator=(const KoCachedColorConversionTransformation& rhs)
 {
-    d->transfo->use.ref();
+    if (m_transfo != rhs.m_transfo) {
+        rhs.m_transfo->ref.ref();
+        m_transfo->deref();
+        m_transfo = rhs.m_transfo;
+    }
+    return *this;
 }
 
 KoCachedColorConversionTransformation::~KoCachedColorConversionTransformation()
 {
-    Q_ASSERT(d->transfo->use > 0);
-    d->transfo->use.deref();
-    delete d;
+    Q_ASSERT(m_transfo->ref > 0);
+    m_transfo->deref();
 }
 
 const KoColorConversionTransformation* KoCachedColorConversionTransformation::transformation() const
 {
-    return d->transfo->transfo;
+    return m_transfo->transfo;
 }
-
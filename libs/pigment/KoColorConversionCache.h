@@ -11,13 +11,20 @@ class KoCachedColorConversionTransformation;
 class KoColorSpace;
 
 #include "KoColorConversionTransformation.h"
+#include "kritapigment_export.h"
 
 /**
  * This class holds a cache of KoColorConversionTransformations.
  *
+ * The cache is split into several shards, each protected by its own
+ * mutex, so that threads requesting different conversions don't block
+ * each other. On top of that every thread keeps a small list of the
+ * most recently used transformations, so repeated requests of the
+ * same conversion don't take any locks at all.
+ *
  * This class is not part of public API, and can be changed without notice.
  */
-class KoColorConversionCache
+class KRITAPIGMENT_EXPORT KoColorConversionCache
 {
 public:
     struct CachedTransformation;
@@ -57,20 +64,23 @@ private:
  *
  * This class is not part of public API, and can be changed without notice.
  */
-class KoCachedColorConversionTransformation
+class KRITAPIGMENT_EXPORT KoCachedColorConversionTransformation
 {
     friend class KoColorConversionCache;
 private:
-    KoCachedColorConversionTransformation(KoColorConversionCache* cache,
-                                          KoColorConversionCache::CachedTransformation* transfo);
+    KoCachedColorConversionTransformation(KoColorConversionCache::CachedTransformation* transfo);
 public:
     KoCachedColorConversionTransformation(const KoCachedColorConversionTransformation&);
+    KoCachedColorConversionTransformation& operator=(const KoCachedColorConversionTransformation&);
     ~KoCachedColorConversionTransformation();
 public:
     const KoColorConversionTransformation* transformation() const;
 private:
-    struct Private;
-    Private* const d;
+    /**
+     * The object is copied on every cache hit, so we keep the
+     * data inline to avoid allocations on the hot path
+     */
+    KoColorConversionCache::CachedTransformation* m_transfo;
 };
 
 
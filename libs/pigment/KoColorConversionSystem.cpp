@@ -16,6 +16,7 @@
 #include "KoColorSpace.h"
 #include "KoCopyColorConversionTransformation.h"
 #include "KoMultipleColorConversionTransformation.h"
+#include "KoOptimizedColorDepthConversionTransformation.h"
 
 
 KoColorConversionSystem::KoColorConversionSystem(RegistryInterface *registryInterface)
@@ -225,6 +226,18 @@ KoColorConversionTransformation* KoColorConversionSystem::createColorConverter(c
     if (*srcColorSpace == *dstColorSpace) {
         return new KoCopyColorConversionTransformation(srcColorSpace);
     }
+
+    /**
+     * A change of the bit depth within the same profile doesn't need
+     * the color management engine at all, just rescale the channels
+     */
+    KoColorConversionTransformation *optimizedTransfo =
+        KoOptimizedColorDepthConversionTransformation::tryCreate(srcColorSpace, dstColorSpace,
+                                                                 renderingIntent, conversionFlags);
+    if (optimizedTransfo) {
+        return optimizedTransfo;
+    }
+
     dbgPigmentCCS << srcColorSpace->id() << (srcColorSpace->profile() ? srcColorSpace->profile()->name() : "default");
     dbgPigmentCCS << dstColorSpace->id() << (dstColorSpace->profile() ? dstColorSpace->profile()->name() : "default");
     Path path = findBestPath(
@@ -20,6 +20,7 @@
 #include "KoMixColorsOpImpl.h"
 
 #include "KoConvolutionOpImpl.h"
+#include "KoOptimizedConvolutionOpFactory.h"
 #include "KoInvertColorTransformation.h"
 #include "KoAlphaMaskApplicatorFactory.h"
 #include "KoColorModelStandardIdsUtils.h"
@@ -42,7 +43,7 @@ public:
 
 public:
     KoColorSpaceAbstract(const QString &id, const QString &name)
-        : KoColorSpace(id, name, new KoMixColorsOpImpl< _CSTrait>(), new KoConvolutionOpImpl< _CSTrait>()),
+        : KoColorSpace(id, name, new KoMixColorsOpImpl< _CSTrait>(), createConvolutionOp()),
           m_alphaMaskApplicator(KoAlphaMaskApplicatorFactory::create(colorDepthIdForChannelType<typename _CSTrait::channels_type>(), _CSTrait::channels_nb, _CSTrait::alpha_pos))
     {
     }
@@ -233,6 +234,14 @@ public:
     }
 
 private:
+    static KoConvolutionOp* createConvolutionOp() {
+        KoConvolutionOp *op = KoOptimizedConvolutionOpFactory::create(
+            colorDepthIdForChannelType<typename _CSTrait::channels_type>(),
+            _CSTrait::channels_nb, _CSTrait::alpha_pos);
+
+        return op ? op : new KoConvolutionOpImpl<_CSTrait>();
+    }
+
     template<int srcPixelSize, int dstChannelSize, class TSrcChannel, class TDstChannel>
     void scalePixels(const quint8* src, quint8* dst, quint32 numPixels) const {
         qint32 dstPixelSize = dstChannelSize * _CSTrait::channels_nb;
@@ -85,6 +85,17 @@ public:
             }
         }
 
+        storeTotals(totals, totalWeight, totalWeightTransparent, dst, factor, offset, channelFlags);
+    }
+
+protected:
+
+    /**
+     * Writes the accumulated channel totals into @p dst, handling
+     * the cases A), B) and C) described in convolveColors()
+     */
+    static void storeTotals(const qreal *totals, qreal totalWeight, qreal totalWeightTransparent,
+                            quint8 *dst, qreal factor, qreal offset, const QBitArray &channelFlags) {
         typename _CSTrait::channels_type* dstColor = _CSTrait::nativeArray(dst);
 
         bool allChannels = channelFlags.isEmpty();
@@ -17,6 +17,7 @@
 class QString;
 class KoChannelInfo;
 class KoColorSpace;
+class KoOptimizedHistogramAccumulatorBase;
 
 /**
  * This class is an interface used in the generation of a histogram. It is a container of
@@ -58,6 +59,29 @@ public:
      */
     virtual void addRegionToBin(const quint8 * pixels, const quint8 * selectionMask, quint32 nPixels, const KoColorSpace* colorSpace) = 0;
 
+    /**
+     * Returns true if the producer counts every channel of the pixels of
+     * \p colorSpace in the bin returned by KoColorSpace::scaleToU8(). Then
+     * the pixels can be counted by a KoOptimizedHistogramAccumulator
+     * and passed to the producer with addAccumulatedBins().
+     */
+    virtual bool canAddAccumulatedBins(const KoColorSpace *colorSpace) const {
+        Q_UNUSED(colorSpace);
+        return false;
+    }
+
+    /**
+     * Adds the counts of \p accumulator, which has counted \p nPixels
+     * pixels, to the bins. Should be called only if
+     * canAddAccumulatedBins() returns true for the color space of the
+     * pixels. The transparent pixels should be skipped by the caller
+     * if skipTransparent() is set.
+     */
+    virtual void addAccumulatedBins(const KoOptimizedHistogramAccumulatorBase &accumulator, quint32 nPixels) {
+        Q_UNUSED(accumulator);
+        Q_UNUSED(nPixels);
+    }
+
     // Methods to set what exactly is being added to the bins
     virtual void setView(qreal from, qreal width) = 0;
     virtual void setSkipTransparent(bool set) {
@@ -66,6 +90,9 @@ public:
     virtual void setSkipUnselected(bool set) {
         m_skipUnselected = set;
     }
+    bool skipTransparent() const {
+        return m_skipTransparent;
+    }
 
     // Methods with general information about this specific producer
     virtual const KoID& id() const = 0;
@@ -14,6 +14,8 @@
 #include <type_traits>
 #include <KisCppQuirks.h>
 #include <KoColorSpaceMaths.h>
+#include <KoColorModelStandardIdsUtils.h>
+#include "KoOptimizedMixColorsMixerFactory.h"
 #include "kis_debug.h"
 #include "kis_global.h"
 
@@ -339,7 +341,16 @@ private:
 template<class _CSTrait>
 KoMixColorsOp::Mixer *KoMixColorsOpImpl<_CSTrait>::createMixer() const
 {
-    return new MixerImpl();
+    /**
+     * Try to use a vectorized mixer first. It is available only
+     * for some pixel layouts, so fall back to the generic one
+     * if there is none.
+     */
+    Mixer *mixer = KoOptimizedMixColorsMixerFactory::create(
+        colorDepthIdForChannelType<typename _CSTrait::channels_type>(),
+        _CSTrait::channels_nb, _CSTrait::alpha_pos);
+
+    return mixer ? mixer : new MixerImpl();
 }
 
 #endif
@@ -0,0 +1,176 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedColorDepthConversionTransformation.h"
+
+#include <KoConfig.h>
+#include "KoColorSpace.h"
+#include "KoColorProfile.h"
+#include "KoColorModelStandardIds.h"
+#include "KoOptimizedPixelDataScalerU8ToU16Factory.h"
+#include "KoOptimizedPixelDataScalerToF32Factory.h"
+
+namespace {
+
+int channelSizeForDepth(const KoID &depthId)
+{
+    return
+        depthId == Integer8BitsColorDepthID ? 1 :
+        depthId == Integer16BitsColorDepthID ? 2 :
+#ifdef HAVE_OPENEXR
+        depthId == Float16BitsColorDepthID ? 2 :
+#endif
+        depthId == Float32BitsColorDepthID ? 4 :
+        0;
+}
+
+int channelsForModel(const KoID &modelId)
+{
+    return
+        modelId == RGBAColorModelID ? 4 :
+        modelId == GrayAColorModelID ? 2 :
+        0;
+}
+
+}
+
+bool KoOptimizedColorDepthConversionTransformation::canConvert(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace)
+{
+    if (srcColorSpace->colorModelId() != dstColorSpace->colorModelId() ||
+        srcColorSpace->colorDepthId() == dstColorSpace->colorDepthId()) {
+
+        return false;
+    }
+
+    const int numChannels = channelsForModel(srcColorSpace->colorModelId());
+    const int srcChannelSize = channelSizeForDepth(srcColorSpace->colorDepthId());
+    const int dstChannelSize = channelSizeForDepth(dstColorSpace->colorDepthId());
+
+    if (!numChannels || !srcChannelSize || !dstChannelSize) return false;
+
+    /**
+     * F16 can only be converted into F32 and back, integer
+     * conversions are not implemented
+     */
+    if ((srcColorSpace->colorDepthId() == Float16BitsColorDepthID &&
+         dstColorSpace->colorDepthId() != Float32BitsColorDepthID) ||
+        (dstColorSpace->colorDepthId() == Float16BitsColorDepthID &&
+         srcColorSpace->colorDepthId() != Float32BitsColorDepthID)) {
+
+        return false;
+    }
+
+    /**
+     * Make sure the color spaces use the standard pixel layout, we
+     * don't want to handle any exotic implementations here
+     */
+    if (int(srcColorSpace->channelCount()) != numChannels ||
+        int(dstColorSpace->channelCount()) != numChannels ||
+        int(srcColorSpace->pixelSize()) != numChannels * srcChannelSize ||
+        int(dstColorSpace->pixelSize()) != numChannels * dstChannelSize) {
+
+        return false;
+    }
+
+    const KoColorProfile *srcProfile = srcColorSpace->profile();
+    const KoColorProfile *dstProfile = dstColorSpace->profile();
+
+    return srcProfile && dstProfile && *srcProfile == *dstProfile;
+}
+
+KoColorConversionTransformation *KoOptimizedColorDepthConversionTransformation::tryCreate(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace, Intent renderingIntent, ConversionFlags conversionFlags)
+{
+    if (!canConvert(srcColorSpace, dstColorSpace)) return nullptr;
+
+    return new KoOptimizedColorDepthConversionTransformation(srcColorSpace, dstColorSpace,
+                                                             renderingIntent, conversionFlags);
+}
+
+KoOptimizedColorDepthConversionTransformation::KoOptimizedColorDepthConversionTransformation(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace, Intent renderingIntent, ConversionFlags conversionFlags)
+    : KoColorConversionTransformation(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags)
+{
+    const KoID srcDepth = srcColorSpace->colorDepthId();
+    const KoID dstDepth = dstColorSpace->colorDepthId();
+    const bool isRgb = srcColorSpace->colorModelId() == RGBAColorModelID;
+
+    if (srcDepth == Float16BitsColorDepthID) {
+        m_direction = F16ToF32;
+    } else if (dstDepth == Float16BitsColorDepthID) {
+        m_direction = F32ToF16;
+    } else if (srcDepth == Integer8BitsColorDepthID && dstDepth == Integer16BitsColorDepthID) {
+        m_direction = U8ToU16;
+    } else if (srcDepth == Integer16BitsColorDepthID && dstDepth == Integer8BitsColorDepthID) {
+        m_direction = U16ToU8;
+    } else if (srcDepth == Integer8BitsColorDepthID) {
+        m_direction = U8ToF32;
+    } else if (dstDepth == Integer8BitsColorDepthID) {
+        m_direction = F32ToU8;
+    } else if (srcDepth == Integer16BitsColorDepthID) {
+        m_direction = U16ToF32;
+    } else {
+        m_direction = F32ToU16;
+    }
+
+    if (m_direction == U8ToU16 || m_direction == U16ToU8) {
+        m_integerScaler.reset(isRgb ?
+                              KoOptimizedPixelDataScalerU8ToU16Factory::createRgbaScaler() :
+                              KoOptimizedPixelDataScalerU8ToU16Factory::createGrayaScaler());
+    } else if (m_direction == F16ToF32 || m_direction == F32ToF16) {
+        // both color spaces store data in RGB order
+        m_floatScaler.reset(isRgb ?
+                            KoOptimizedPixelDataScalerToF32Factory::createRgbaScaler(false) :
+                            KoOptimizedPixelDataScalerToF32Factory::createGrayaScaler());
+    } else {
+        /**
+         * Integer RGB color spaces store data in BGR order, floating
+         * point ones in RGB order
+         */
+        m_floatScaler.reset(isRgb ?
+                            KoOptimizedPixelDataScalerToF32Factory::createRgbaScaler(true) :
+                            KoOptimizedPixelDataScalerToF32Factory::createGrayaScaler());
+    }
+}
+
+KoOptimizedColorDepthConversionTransformation::~KoOptimizedColorDepthConversionTransformation()
+{
+}
+
+void KoOptimizedColorDepthConversionTransformation::transform(const quint8 *src, quint8 *dst, qint32 nPixels) const
+{
+    switch (m_direction) {
+    case U8ToU16:
+        m_integerScaler->convertU8ToU16(src, 0, dst, 0, 1, nPixels);
+        break;
+    case U16ToU8:
+        m_integerScaler->convertU16ToU8(src, 0, dst, 0, 1, nPixels);
+        break;
+    case U8ToF32:
+        m_floatScaler->convertU8ToF32(src, 0, dst, 0, 1, nPixels);
+        break;
+    case F32ToU8:
+        m_floatScaler->convertF32ToU8(src, 0, dst, 0, 1, nPixels);
+        break;
+    case U16ToF32:
+        m_floatScaler->convertU16ToF32(src, 0, dst, 0, 1, nPixels);
+        break;
+    case F32ToU16:
+        m_floatScaler->convertF32ToU16(src, 0, dst, 0, 1, nPixels);
+        break;
+#ifdef HAVE_OPENEXR
+    case F16ToF32:
+        m_floatScaler->convertF16ToF32(src, 0, dst, 0, 1, nPixels);
+        break;
+    case F32ToF16:
+        m_floatScaler->convertF32ToF16(src, 0, dst, 0, 1, nPixels);
+        break;
+#else
+    case F16ToF32:
+    case F32ToF16:
+        // F16 color spaces don't exist without OpenEXR
+        break;
+#endif
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOLORDEPTHCONVERSIONTRANSFORMATION_H
+#define KOOPTIMIZEDCOLORDEPTHCONVERSIONTRANSFORMATION_H
+
+#include "KoColorConversionTransformation.h"
+
+#include <QScopedPointer>
+
+class KoOptimizedPixelDataScalerU8ToU16Base;
+class KoOptimizedPixelDataScalerToF32Base;
+
+/**
+ * A conversion between two color spaces that differ only in the bit
+ * depth, i.e. they have the same color model and the same profile.
+ * Such conversion is a pure per-channel rescaling of the data, so we
+ * can skip the color management engine and do it with the vectorized
+ * scalers.
+ *
+ * Only RGBA and GrayA color models in U8, U16 and F32 are supported.
+ * F16 is supported as well, but it can be converted into F32 only.
+ * KoColorConversionSystem tries this transformation before searching
+ * for a conversion path.
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedColorDepthConversionTransformation : public KoColorConversionTransformation
+{
+public:
+    /**
+     * @return true if conversion from \p srcColorSpace to \p dstColorSpace
+     *         is a pure bit-depth change supported by this transformation
+     */
+    static bool canConvert(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace);
+
+    /**
+     * @return a new optimized transformation or nullptr if the color
+     *         spaces are not supported
+     */
+    static KoColorConversionTransformation* tryCreate(const KoColorSpace *srcColorSpace,
+                                                      const KoColorSpace *dstColorSpace,
+                                                      Intent renderingIntent,
+                                                      ConversionFlags conversionFlags);
+
+    ~KoOptimizedColorDepthConversionTransformation() override;
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override;
+
+private:
+    enum Direction {
+        U8ToU16,
+        U16ToU8,
+        U8ToF32,
+        F32ToU8,
+        U16ToF32,
+        F32ToU16,
+        F16ToF32,
+        F32ToF16
+    };
+
+    KoOptimizedColorDepthConversionTransformation(const KoColorSpace *srcColorSpace,
+                                                  const KoColorSpace *dstColorSpace,
+                                                  Intent renderingIntent,
+                                                  ConversionFlags conversionFlags);
+
+private:
+    Direction m_direction;
+    QScopedPointer<KoOptimizedPixelDataScalerU8ToU16Base> m_integerScaler;
+    QScopedPointer<KoOptimizedPixelDataScalerToF32Base> m_floatScaler;
+};
+
+#endif // KOOPTIMIZEDCOLORDEPTHCONVERSIONTRANSFORMATION_H
@@ -0,0 +1,61 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDCONVOLUTIONOP_H
+#define KOOPTIMIZEDCONVOLUTIONOP_H
+
+#include "KoConvolutionOpImpl.h"
+
+#include <KoConfig.h>
+#include <KoColorSpaceMaths.h>
+#include <KoColorSpaceTraits.h>
+#include "KoVcMultiArchBuildSupport.h"
+#include "KoOptimizedDoubleAccumulator.h"
+
+#ifdef __SSE4_1__
+
+/**
+ * Vectorized version of KoConvolutionOpImpl for the pixels with
+ * the alpha channel placed last. The transparency handling and
+ * the final scaling are shared with KoConvolutionOpImpl.
+ */
+template<typename channels_type, int channels_nb, Vc::Implementation _impl>
+class KoOptimizedConvolutionOp
+    : public KoConvolutionOpImpl<KoColorSpaceTrait<channels_type, channels_nb, channels_nb - 1>>
+{
+    using Trait = KoColorSpaceTrait<channels_type, channels_nb, channels_nb - 1>;
+    using BaseClass = KoConvolutionOpImpl<Trait>;
+    using Accumulator = KoOptimizedDoubleAccumulator<channels_type, channels_nb>;
+
+public:
+    void convolveColors(const quint8* const* colors, const qreal* kernelValues, quint8 *dst, qreal factor, qreal offset, qint32 nPixels, const QBitArray & channelFlags) const override {
+        Accumulator accumulator;
+
+        qreal totalWeight = 0;
+        qreal totalWeightTransparent = 0;
+
+        for (; nPixels--; colors++, kernelValues++) {
+            const qreal weight = *kernelValues;
+            if (weight != 0) {
+                if (Trait::opacityU8(*colors) == 0) {
+                    totalWeightTransparent += weight;
+                } else {
+                    accumulator.add(*colors, weight);
+                }
+                totalWeight += weight;
+            }
+        }
+
+        qreal totals[channels_nb];
+        accumulator.store(totals);
+
+        BaseClass::storeTotals(totals, totalWeight, totalWeightTransparent, dst, factor, offset, channelFlags);
+    }
+};
+
+#endif /* __SSE4_1__ */
+
+#endif // KOOPTIMIZEDCONVOLUTIONOP_H
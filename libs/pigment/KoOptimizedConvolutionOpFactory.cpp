@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedConvolutionOpFactory.h"
+
+#include "KoOptimizedConvolutionOpFactoryImpl.h"
+
+KoConvolutionOp *KoOptimizedConvolutionOpFactory::create(const KoID &depthId, int numChannels, int alphaPos)
+{
+    const bool layoutIsSupported =
+        (numChannels == 4 && alphaPos == 3) ||
+        (numChannels == 2 && alphaPos == 1);
+
+    if (!layoutIsSupported) {
+        return nullptr;
+    }
+
+    return createOptimizedPixelOp<KoConvolutionOp, KoOptimizedConvolutionOpFactoryImpl, 4, 2>(depthId, numChannels);
+}
@@ -0,0 +1,32 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDCONVOLUTIONOPFACTORY_H
+#define KOOPTIMIZEDCONVOLUTIONOPFACTORY_H
+
+#include "kritapigment_export.h"
+
+#include <KoID.h>
+
+class KoConvolutionOp;
+
+/**
+ * Creates a vectorized KoConvolutionOp for the pixel layout if there
+ * is one available for the current CPU. Only 4-channel and 2-channel
+ * pixels with the alpha channel placed last are supported.
+ *
+ * Returns nullptr when there is no optimized implementation for
+ * the layout, in which case the caller should use KoConvolutionOpImpl.
+ *
+ * \see KoOptimizedConvolutionOp
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedConvolutionOpFactory
+{
+public:
+    static KoConvolutionOp* create(const KoID &depthId, int numChannels, int alphaPos);
+};
+
+#endif // KOOPTIMIZEDCONVOLUTIONOPFACTORY_H
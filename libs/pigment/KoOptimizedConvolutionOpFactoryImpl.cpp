@@ -0,0 +1,12 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedConvolutionOpFactoryImpl.h"
+#include "KoOptimizedPixelOpFactoryImpl_p.h"
+#include "KoOptimizedConvolutionOp.h"
+
+KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY(KoOptimizedConvolutionOpFactoryImpl, 4)
+KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY(KoOptimizedConvolutionOpFactoryImpl, 2)
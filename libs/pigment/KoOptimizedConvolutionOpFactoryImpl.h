@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDCONVOLUTIONOPFACTORYIMPL_H
+#define KOOPTIMIZEDCONVOLUTIONOPFACTORYIMPL_H
+
+#include <KoConvolutionOp.h>
+#include "KoOptimizedPixelOpFactoryImpl.h"
+
+template<typename channels_type, int channels_nb, Vc::Implementation _impl>
+class KoOptimizedConvolutionOp;
+
+template<typename _channels_type_,
+         int _channels_nb_>
+using KoOptimizedConvolutionOpFactoryImpl =
+    KoOptimizedPixelOpFactoryImpl<KoOptimizedConvolutionOp, KoConvolutionOp, true, _channels_type_, _channels_nb_>;
+
+#endif // KOOPTIMIZEDCONVOLUTIONOPFACTORYIMPL_H
@@ -0,0 +1,143 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDDOUBLEACCUMULATOR_H
+#define KOOPTIMIZEDDOUBLEACCUMULATOR_H
+
+#include <QtGlobal>
+
+#include <KoConfig.h>
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#ifdef __SSE4_1__
+
+/**
+ * Accumulates the weighted channels of the pixels in double lanes,
+ * two channels per SSE register or four channels per AVX register.
+ *
+ * Every channel is converted to double and multiplied by the weight
+ * separately, exactly like KoConvolutionOpImpl and the floating point
+ * path of KoMixColorsOpImpl do. The only difference may come from the
+ * compiler fusing the multiplication and the addition into an FMA
+ * instruction, which changes the last bit of the total when the
+ * product is not representable in double.
+ *
+ * Used by KoOptimizedConvolutionOp and KoOptimizedMixColorsMixer.
+ */
+template<typename channels_type, int channels_nb>
+struct KoOptimizedDoubleAccumulator
+{
+    static_assert(channels_nb == 2 || channels_nb == 4, "only 2- and 4-channel pixels are supported");
+
+#ifdef __AVX2__
+    static constexpr bool useAvx = channels_nb == 4;
+#else
+    static constexpr bool useAvx = false;
+#endif
+
+    static constexpr int numPairs = channels_nb / 2;
+
+    KoOptimizedDoubleAccumulator() {
+#ifdef __AVX2__
+        acc256 = _mm256_setzero_pd();
+#endif
+        for (int i = 0; i < numPairs; i++) {
+            acc[i] = _mm_setzero_pd();
+        }
+    }
+
+    /**
+     * Integer channels are converted into int32 first, which
+     * is exact for both U8 and U16
+     */
+    static inline __m128i loadInt32(const channels_type *channels) {
+        if (std::is_same<channels_type, quint8>::value) {
+            qint32 value;
+            memcpy(&value, channels, sizeof(value));
+            return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(value));
+        } else {
+            return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(channels)));
+        }
+    }
+
+    static inline __m128d loadPair(const channels_type *channels) {
+        if (std::is_same<channels_type, quint8>::value) {
+            quint16 value;
+            memcpy(&value, channels, sizeof(value));
+            return _mm_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(value)));
+        } else if (std::is_same<channels_type, quint16>::value) {
+            qint32 value;
+            memcpy(&value, channels, sizeof(value));
+            return _mm_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_cvtsi32_si128(value)));
+        } else if (std::is_same<channels_type, float>::value) {
+            return _mm_cvtps_pd(_mm_castsi128_ps(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(channels))));
+        } else {
+            return _mm_set_pd(double(float(channels[1])), double(float(channels[0])));
+        }
+    }
+
+#ifdef __AVX2__
+    static inline __m256d loadQuad(const channels_type *channels) {
+        if (std::is_integral<channels_type>::value) {
+            return _mm256_cvtepi32_pd(loadInt32(channels));
+        } else if (std::is_same<channels_type, float>::value) {
+            return _mm256_cvtps_pd(_mm_loadu_ps(reinterpret_cast<const float*>(channels)));
+        } else {
+            return _mm256_set_pd(double(float(channels[3])), double(float(channels[2])),
+                                 double(float(channels[1])), double(float(channels[0])));
+        }
+    }
+#endif
+
+    inline void add(const quint8 *pixel, qreal weight) {
+        const channels_type *channels = reinterpret_cast<const channels_type*>(pixel);
+
+#ifdef __AVX2__
+        if (useAvx) {
+            acc256 = _mm256_add_pd(acc256, _mm256_mul_pd(loadQuad(channels), _mm256_set1_pd(weight)));
+            return;
+        }
+#endif
+
+        const __m128d factor = _mm_set1_pd(weight);
+
+        for (int i = 0; i < numPairs; i++) {
+            acc[i] = _mm_add_pd(acc[i], _mm_mul_pd(loadPair(channels + 2 * i), factor));
+        }
+    }
+
+    inline void store(qreal *totals) const {
+#ifdef __AVX2__
+        if (useAvx) {
+            _mm256_storeu_pd(totals, acc256);
+            return;
+        }
+#endif
+
+        for (int i = 0; i < numPairs; i++) {
+            _mm_storeu_pd(totals + 2 * i, acc[i]);
+        }
+    }
+
+#ifdef __AVX2__
+    __m256d acc256;
+#endif
+    __m128d acc[numPairs];
+};
+
+#endif /* __SSE4_1__ */
+
+#endif // KOOPTIMIZEDDOUBLEACCUMULATOR_H
@@ -0,0 +1,83 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDHALFCONVERSION_H
+#define KOOPTIMIZEDHALFCONVERSION_H
+
+#include <KoConfig.h>
+
+#ifdef HAVE_OPENEXR
+
+#include <half.h>
+#include "KoVcMultiArchBuildSupport.h"
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/**
+ * F16C instructions are not a part of the AVX2 instruction set, but
+ * every CPU supporting AVX2 also supports F16C, so we enable them for
+ * the AVX2 implementation explicitly, even when the compiler is not
+ * told about them via the command line (MSVC doesn't need that).
+ */
+#if defined __AVX2__ && !defined __F16C__ && (defined __GNUC__ || defined __clang__)
+#define KO_F16C_TARGET __attribute__((target("f16c")))
+#else
+#define KO_F16C_TARGET
+#endif
+
+/**
+ * Converts arrays of half values into floats and back. The AVX2
+ * implementation uses F16C instructions, the others fall back to
+ * the table-based conversion of OpenEXR's half.
+ *
+ * The conversion is exact for half -> float direction and uses
+ * round-to-nearest-even in the opposite one, which is exactly
+ * what half(float) does, so the result doesn't depend on the
+ * implementation.
+ */
+template<Vc::Implementation _impl>
+struct KoOptimizedHalfConversion
+{
+    KO_F16C_TARGET
+    static void halfToFloat(const half *src, float *dst, int numValues)
+    {
+        int i = 0;
+
+#ifdef __AVX2__
+        for (; i + 8 <= numValues; i += 8) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(x));
+        }
+#endif
+
+        for (; i < numValues; i++) {
+            dst[i] = float(src[i]);
+        }
+    }
+
+    KO_F16C_TARGET
+    static void floatToHalf(const float *src, half *dst, int numValues)
+    {
+        int i = 0;
+
+#ifdef __AVX2__
+        for (; i + 8 <= numValues; i += 8) {
+            const __m128i x = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), x);
+        }
+#endif
+
+        for (; i < numValues; i++) {
+            dst[i] = half(src[i]);
+        }
+    }
+};
+
+#endif /* HAVE_OPENEXR */
+
+#endif // KOOPTIMIZEDHALFCONVERSION_H
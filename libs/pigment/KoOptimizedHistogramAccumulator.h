@@ -0,0 +1,274 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDHISTOGRAMACCUMULATOR_H
+#define KOOPTIMIZEDHISTOGRAMACCUMULATOR_H
+
+#include "KoOptimizedHistogramAccumulatorBase.h"
+
+#include <KoConfig.h>
+#include <KoColorSpaceMaths.h>
+#include <KoOptimizedHalfConversion.h>
+#include "KoVcMultiArchBuildSupport.h"
+
+#include <QVector>
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Scales arrays of channels to 8 bits with exactly the same rounding
+ * as KoColorSpaceMaths<channels_type, quint8>::scaleToA()
+ */
+template<typename channels_type, Vc::Implementation _impl>
+struct KoOptimizedHistogramScaler
+{
+    static void scaleToU8(const channels_type *src, quint8 *dst, int numValues)
+    {
+        for (int i = 0; i < numValues; i++) {
+            dst[i] = KoColorSpaceMaths<channels_type, quint8>::scaleToA(src[i]);
+        }
+    }
+};
+
+template<Vc::Implementation _impl>
+struct KoOptimizedHistogramScaler<quint16, _impl>
+{
+    static void scaleToU8(const quint16 *src, quint8 *dst, int numValues)
+    {
+        int i = 0;
+
+        // UINT16_TO_UINT8(): c - (c >> 8) + 128 never overflows 16 bits
+
+#ifdef __AVX2__
+        const __m256i offset256 = _mm256_set1_epi16(128);
+
+        for (; i + 16 <= numValues; i += 16) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            x = _mm256_add_epi16(_mm256_sub_epi16(x, _mm256_srli_epi16(x, 8)), offset256);
+            x = _mm256_srli_epi16(x, 8);
+
+            const __m128i result = _mm_packus_epi16(_mm256_castsi256_si128(x),
+                                                    _mm256_extracti128_si256(x, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+        }
+#endif
+
+#ifdef __SSE4_1__
+        const __m128i offset128 = _mm_set1_epi16(128);
+
+        for (; i + 8 <= numValues; i += 8) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            x = _mm_add_epi16(_mm_sub_epi16(x, _mm_srli_epi16(x, 8)), offset128);
+            x = _mm_srli_epi16(x, 8);
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(x, x));
+        }
+#endif
+
+        for (; i < numValues; i++) {
+            dst[i] = KoColorSpaceMaths<quint16, quint8>::scaleToA(src[i]);
+        }
+    }
+};
+
+template<Vc::Implementation _impl>
+struct KoOptimizedHistogramScaler<float, _impl>
+{
+    static void scaleToU8(const float *src, quint8 *dst, int numValues)
+    {
+        int i = 0;
+
+        /**
+         * The same as float2int(CLAMP(v * 255, 0, 255)). NaN values are
+         * converted to zero by max_ps, the scalar version also gives zero
+         * for them on x86.
+         */
+
+#ifdef __AVX2__
+        const __m256 unit256 = _mm256_set1_ps(255.0f);
+        const __m256 half256 = _mm256_set1_ps(0.5f);
+        const __m256 zero256 = _mm256_setzero_ps();
+
+        for (; i + 8 <= numValues; i += 8) {
+            __m256 x = _mm256_mul_ps(_mm256_loadu_ps(src + i), unit256);
+            x = _mm256_min_ps(_mm256_max_ps(x, zero256), unit256);
+
+            const __m256i y = _mm256_cvttps_epi32(_mm256_add_ps(x, half256));
+            __m128i result = _mm_packs_epi32(_mm256_castsi256_si128(y),
+                                             _mm256_extracti128_si256(y, 1));
+            result = _mm_packus_epi16(result, result);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), result);
+        }
+#endif
+
+#ifdef __SSE4_1__
+        const __m128 unit128 = _mm_set1_ps(255.0f);
+        const __m128 half128 = _mm_set1_ps(0.5f);
+        const __m128 zero128 = _mm_setzero_ps();
+
+        for (; i + 4 <= numValues; i += 4) {
+            __m128 x = _mm_mul_ps(_mm_loadu_ps(src + i), unit128);
+            x = _mm_min_ps(_mm_max_ps(x, zero128), unit128);
+
+            __m128i result = _mm_cvttps_epi32(_mm_add_ps(x, half128));
+            result = _mm_packs_epi32(result, result);
+            result = _mm_packus_epi16(result, result);
+
+            const qint32 packed = _mm_cvtsi128_si32(result);
+            memcpy(dst + i, &packed, sizeof(packed));
+        }
+#endif
+
+        for (; i < numValues; i++) {
+            dst[i] = KoColorSpaceMaths<float, quint8>::scaleToA(src[i]);
+        }
+    }
+};
+
+#ifdef HAVE_OPENEXR
+
+template<Vc::Implementation _impl>
+struct KoOptimizedHistogramScaler<half, _impl>
+{
+    static const int blockSize = 256;
+
+    /**
+     * KoColorSpaceMaths<half, quint8>::scaleToA() stores the scaled value
+     * in a half variable before truncating it, so the values are rounded
+     * to half precision between the two steps
+     */
+    static void scaleToU8(const half *src, quint8 *dst, int numValues)
+    {
+        using HalfConversion = KoOptimizedHalfConversion<_impl>;
+
+        float values[blockSize];
+        half scaledValues[blockSize];
+
+        for (int offset = 0; offset < numValues; offset += blockSize) {
+            const int numBlockValues = qMin(int(blockSize), numValues - offset);
+
+            HalfConversion::halfToFloat(src + offset, values, numBlockValues);
+            for (int i = 0; i < numBlockValues; i++) {
+                values[i] *= 255.0f;
+            }
+
+            HalfConversion::floatToHalf(values, scaledValues, numBlockValues);
+            HalfConversion::halfToFloat(scaledValues, values, numBlockValues);
+
+            for (int i = 0; i < numBlockValues; i++) {
+                const float v = values[i];
+                dst[offset + i] = v > 0.0f ? static_cast<quint8>(qMin(v, 255.0f)) : 0;
+            }
+        }
+    }
+};
+
+#endif /* HAVE_OPENEXR */
+
+/**
+ * The pixels are scaled to 8 bits in chunks of `chunkSize` pixels
+ * using KoOptimizedHistogramScaler, then the resulting values are
+ * counted in `numCopies` partial histograms, the pixels being
+ * distributed over them in turn.
+ */
+template<typename channels_type, int channels_nb, Vc::Implementation _impl>
+class KoOptimizedHistogramAccumulator : public KoOptimizedHistogramAccumulatorBase
+{
+    using Scaler = KoOptimizedHistogramScaler<channels_type, _impl>;
+
+    static const int pixelSize = channels_nb * sizeof(channels_type);
+    static const int chunkSize = 64;
+    static const int numCopies = 4;
+    static const int copySize = channels_nb * numBins;
+
+public:
+    KoOptimizedHistogramAccumulator()
+        : KoOptimizedHistogramAccumulatorBase(channels_nb),
+          m_bins(numCopies * copySize, 0)
+    {
+    }
+
+    void accumulate(const quint8 *pixels, int pixelStride, int nPixels) override
+    {
+        quint8 values[chunkSize * channels_nb];
+
+        while (nPixels > 0) {
+            const int numChunkPixels = qMin(nPixels, int(chunkSize));
+            const quint8 *chunkValues = values;
+
+            if (pixelStride == pixelSize) {
+                if (std::is_same<channels_type, quint8>::value) {
+                    chunkValues = pixels;
+                } else {
+                    Scaler::scaleToU8(reinterpret_cast<const channels_type*>(pixels),
+                                      values, numChunkPixels * channels_nb);
+                }
+            } else {
+                for (int i = 0; i < numChunkPixels; i++) {
+                    Scaler::scaleToU8(reinterpret_cast<const channels_type*>(pixels + i * pixelStride),
+                                      values + i * channels_nb, channels_nb);
+                }
+            }
+
+            countValues(chunkValues, numChunkPixels);
+
+            pixels += numChunkPixels * pixelStride;
+            nPixels -= numChunkPixels;
+        }
+    }
+
+    void addToBins(int channel, quint32 *bins) const override
+    {
+        for (int copy = 0; copy < numCopies; copy++) {
+            const quint32 *copyBins = m_bins.constData() + copy * copySize + channel * numBins;
+
+            for (int i = 0; i < numBins; i++) {
+                bins[i] += copyBins[i];
+            }
+        }
+    }
+
+    void clear() override
+    {
+        m_bins.fill(0);
+    }
+
+private:
+    inline void countValues(const quint8 *values, int numPixels)
+    {
+        quint32 *bins = m_bins.data();
+
+        int i = 0;
+        for (; i + numCopies <= numPixels; i += numCopies) {
+            for (int copy = 0; copy < numCopies; copy++) {
+                const quint8 *pixel = values + (i + copy) * channels_nb;
+                quint32 *copyBins = bins + copy * copySize;
+
+                for (int ch = 0; ch < channels_nb; ch++) {
+                    copyBins[ch * numBins + pixel[ch]]++;
+                }
+            }
+        }
+
+        for (; i < numPixels; i++) {
+            const quint8 *pixel = values + i * channels_nb;
+
+            for (int ch = 0; ch < channels_nb; ch++) {
+                bins[ch * numBins + pixel[ch]]++;
+            }
+        }
+    }
+
+private:
+    QVector<quint32> m_bins;
+};
+
+#endif // KOOPTIMIZEDHISTOGRAMACCUMULATOR_H
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedHistogramAccumulatorBase.h"
+
+KoOptimizedHistogramAccumulatorBase::KoOptimizedHistogramAccumulatorBase(int channelCount)
+    : m_channelCount(channelCount)
+{
+}
+
+KoOptimizedHistogramAccumulatorBase::~KoOptimizedHistogramAccumulatorBase()
+{
+}
+
+int KoOptimizedHistogramAccumulatorBase::channelCount() const
+{
+    return m_channelCount;
+}
@@ -0,0 +1,63 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDHISTOGRAMACCUMULATORBASE_H
+#define KOOPTIMIZEDHISTOGRAMACCUMULATORBASE_H
+
+#include "kritapigment_export.h"
+
+#include <QtGlobal>
+
+/**
+ * @brief Collects 8-bit histograms of all the channels of a pixel buffer
+ *
+ * Every channel is scaled to 8 bits exactly like KoColorSpace::scaleToU8()
+ * does and counted in one of `numBins` bins. The channels are indexed in
+ * the order they are stored in the pixel, not in the order of
+ * KoColorSpace::channels().
+ *
+ * The accumulator keeps several partial histograms internally, so that
+ * counting runs of equal pixels would not stall on the same counter.
+ * Use one accumulator per thread and merge the results with addToBins()
+ * when all the pixels have been processed.
+ *
+ * The actual implementation is placed in class `KoOptimizedHistogramAccumulator`,
+ * use KoOptimizedHistogramAccumulatorFactory to create it.
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedHistogramAccumulatorBase
+{
+public:
+    static const int numBins = 256;
+
+public:
+    KoOptimizedHistogramAccumulatorBase(int channelCount);
+    virtual ~KoOptimizedHistogramAccumulatorBase();
+
+    /**
+     * Counts \p nPixels pixels starting at \p pixels. The beginnings
+     * of the pixels are \p pixelStride bytes apart, which can be
+     * larger than the pixel size to count only every n-th pixel.
+     */
+    virtual void accumulate(const quint8 *pixels, int pixelStride, int nPixels) = 0;
+
+    /**
+     * Adds the counts of channel \p channel to the array of
+     * `numBins` values pointed by \p bins
+     */
+    virtual void addToBins(int channel, quint32 *bins) const = 0;
+
+    /**
+     * Resets all the counts to zero
+     */
+    virtual void clear() = 0;
+
+    int channelCount() const;
+
+private:
+    int m_channelCount;
+};
+
+#endif // KOOPTIMIZEDHISTOGRAMACCUMULATORBASE_H
@@ -0,0 +1,83 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedHistogramAccumulatorFactory.h"
+
+#include <QVector>
+
+#include <KoColorSpace.h>
+#include <KoColorModelStandardIds.h>
+
+#include "KoOptimizedHistogramAccumulatorFactoryImpl.h"
+
+namespace {
+
+class GenericHistogramAccumulator : public KoOptimizedHistogramAccumulatorBase
+{
+public:
+    GenericHistogramAccumulator(const KoColorSpace *colorSpace)
+        : KoOptimizedHistogramAccumulatorBase(colorSpace->channelCount()),
+          m_colorSpace(colorSpace),
+          m_bins(colorSpace->channelCount() * numBins, 0)
+    {
+    }
+
+    void accumulate(const quint8 *pixels, int pixelStride, int nPixels) override
+    {
+        const int numChannels = channelCount();
+
+        for (int i = 0; i < nPixels; i++) {
+            for (int ch = 0; ch < numChannels; ch++) {
+                m_bins[ch * numBins + m_colorSpace->scaleToU8(pixels, ch)]++;
+            }
+            pixels += pixelStride;
+        }
+    }
+
+    void addToBins(int channel, quint32 *bins) const override
+    {
+        const quint32 *channelBins = m_bins.constData() + channel * numBins;
+
+        for (int i = 0; i < numBins; i++) {
+            bins[i] += channelBins[i];
+        }
+    }
+
+    void clear() override
+    {
+        m_bins.fill(0);
+    }
+
+private:
+    const KoColorSpace *m_colorSpace;
+    QVector<quint32> m_bins;
+};
+
+}
+
+KoOptimizedHistogramAccumulatorBase *KoOptimizedHistogramAccumulatorFactory::create(const KoColorSpace *colorSpace)
+{
+    KoOptimizedHistogramAccumulatorBase *accumulator = nullptr;
+
+    /**
+     * Lab color spaces override scaleToU8() to map the a and b
+     * channels around their neutral point, which the optimized
+     * accumulators don't know about
+     */
+    if (colorSpace->colorModelId() != LABAColorModelID) {
+        accumulator =
+            createOptimizedPixelOp<KoOptimizedHistogramAccumulatorBase,
+                                   KoOptimizedHistogramAccumulatorFactoryImpl,
+                                   4, 5, 2, 1>(colorSpace->colorDepthId(),
+                                               colorSpace->channelCount());
+    }
+
+    if (!accumulator) {
+        accumulator = new GenericHistogramAccumulator(colorSpace);
+    }
+
+    return accumulator;
+}
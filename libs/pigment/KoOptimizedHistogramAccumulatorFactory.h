@@ -0,0 +1,34 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDHISTOGRAMACCUMULATORFACTORY_H
+#define KOOPTIMIZEDHISTOGRAMACCUMULATORFACTORY_H
+
+#include "kritapigment_export.h"
+
+#include "KoOptimizedHistogramAccumulatorBase.h"
+
+class KoColorSpace;
+
+/**
+ * Creates a histogram accumulator for pixels of \p colorSpace.
+ *
+ * U8, U16, F16 and F32 color spaces with 1, 2, 4 or 5 channels get
+ * an implementation optimized for the current CPU, except for Lab
+ * ones, which have their own scaleToU8(). All the other color
+ * spaces get a generic one, which calls
+ * KoColorSpace::scaleToU8() for every channel, so the function
+ * never returns nullptr.
+ *
+ * \see KoOptimizedHistogramAccumulator
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedHistogramAccumulatorFactory
+{
+public:
+    static KoOptimizedHistogramAccumulatorBase* create(const KoColorSpace *colorSpace);
+};
+
+#endif // KOOPTIMIZEDHISTOGRAMACCUMULATORFACTORY_H
@@ -0,0 +1,14 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedHistogramAccumulatorFactoryImpl.h"
+#include "KoOptimizedPixelOpFactoryImpl_p.h"
+#include "KoOptimizedHistogramAccumulator.h"
+
+KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY(KoOptimizedHistogramAccumulatorFactoryImpl, 4)
+KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY(KoOptimizedHistogramAccumulatorFactoryImpl, 5)
+KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY(KoOptimizedHistogramAccumulatorFactoryImpl, 2)
+KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY(KoOptimizedHistogramAccumulatorFactoryImpl, 1)
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDHISTOGRAMACCUMULATORFACTORYIMPL_H
+#define KOOPTIMIZEDHISTOGRAMACCUMULATORFACTORYIMPL_H
+
+#include "KoOptimizedHistogramAccumulatorBase.h"
+#include "KoOptimizedPixelOpFactoryImpl.h"
+
+template<typename channels_type, int channels_nb, Vc::Implementation _impl>
+class KoOptimizedHistogramAccumulator;
+
+template<typename _channels_type_,
+         int _channels_nb_>
+using KoOptimizedHistogramAccumulatorFactoryImpl =
+    KoOptimizedPixelOpFactoryImpl<KoOptimizedHistogramAccumulator, KoOptimizedHistogramAccumulatorBase, false, _channels_type_, _channels_nb_>;
+
+#endif // KOOPTIMIZEDHISTOGRAMACCUMULATORFACTORYIMPL_H
@@ -0,0 +1,219 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSMIXER_H
+#define KOOPTIMIZEDMIXCOLORSMIXER_H
+
+#include "KoMixColorsOp.h"
+
+#include <KoConfig.h>
+#include <KoColorSpaceMaths.h>
+#include "KoVcMultiArchBuildSupport.h"
+#include "KoOptimizedDoubleAccumulator.h"
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#ifdef __SSE4_1__
+
+/**
+ * Accumulates the weighted channels of a single pixel in vector
+ * registers, one register per two channels.
+ *
+ * Integer channels are accumulated in 64-bit integer lanes, which is
+ * exactly the precision KoMixColorsOpImpl uses, so the result is
+ * bit-exact with the scalar version. Floating point channels are
+ * accumulated in double lanes by KoOptimizedDoubleAccumulator.
+ */
+template<typename channels_type, int channels_nb,
+         bool isInteger = std::is_integral<channels_type>::value>
+struct KoOptimizedMixColorsAccumulator;
+
+template<typename channels_type, int channels_nb>
+struct KoOptimizedMixColorsAccumulator<channels_type, channels_nb, true>
+{
+    static_assert(channels_nb == 2 || channels_nb == 4, "only 2- and 4-channel pixels are supported");
+
+    using mix_type = typename KoColorSpaceMathsTraits<channels_type>::mixtype;
+    static constexpr int numPairs = channels_nb / 2;
+
+    KoOptimizedMixColorsAccumulator() {
+        for (int i = 0; i < numPairs; i++) {
+            acc[i] = _mm_setzero_si128();
+        }
+    }
+
+    static inline __m128i loadRaw(const quint8 *pixel) {
+        const int pixelSize = channels_nb * sizeof(channels_type);
+
+        if (pixelSize == 8) {
+            return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pixel));
+        } else if (pixelSize == 4) {
+            qint32 value;
+            memcpy(&value, pixel, sizeof(value));
+            return _mm_cvtsi32_si128(value);
+        } else {
+            quint16 value;
+            memcpy(&value, pixel, sizeof(value));
+            return _mm_cvtsi32_si128(value);
+        }
+    }
+
+    static inline __m128i unpackLow(__m128i raw) {
+        return std::is_same<channels_type, quint8>::value ?
+            _mm_cvtepu8_epi64(raw) : _mm_cvtepu16_epi64(raw);
+    }
+
+    static inline __m128i unpackHigh(__m128i raw) {
+        return std::is_same<channels_type, quint8>::value ?
+            _mm_cvtepu8_epi64(_mm_srli_si128(raw, 2)) :
+            _mm_cvtepu16_epi64(_mm_srli_si128(raw, 4));
+    }
+
+    inline void add(const quint8 *pixel, mix_type alphaTimesWeight) {
+        /**
+         * alpha * weight always fits into 32 bits for U8 and U16 (the weight
+         * is qint16), so we can use a signed 32x32->64 multiplication
+         */
+        const __m128i factor = _mm_set1_epi32(static_cast<qint32>(alphaTimesWeight));
+        const __m128i raw = loadRaw(pixel);
+
+        acc[0] = _mm_add_epi64(acc[0], _mm_mul_epi32(unpackLow(raw), factor));
+
+        if (numPairs > 1) {
+            acc[numPairs - 1] = _mm_add_epi64(acc[numPairs - 1], _mm_mul_epi32(unpackHigh(raw), factor));
+        }
+    }
+
+    inline void store(mix_type *totals) const {
+        for (int i = 0; i < numPairs; i++) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(totals + 2 * i), acc[i]);
+        }
+    }
+
+    __m128i acc[numPairs];
+};
+
+template<typename channels_type, int channels_nb>
+struct KoOptimizedMixColorsAccumulator<channels_type, channels_nb, false>
+    : public KoOptimizedDoubleAccumulator<channels_type, channels_nb>
+{
+};
+
+/**
+ * A vectorized version of KoMixColorsOpImpl's mixer for color spaces
+ * with 2 or 4 channels and the alpha channel placed last, which covers
+ * all RGBA, Lab and GrayA color spaces.
+ *
+ * The color channels of every pixel are processed together in SIMD
+ * registers, instead of the per-channel scalar loop.
+ *
+ * \see KoOptimizedMixColorsMixerFactory
+ */
+template<typename channels_type, int channels_nb, Vc::Implementation _impl>
+class KoOptimizedMixColorsMixer : public KoMixColorsOp::Mixer
+{
+    using MathsTraits = KoColorSpaceMathsTraits<channels_type>;
+    using mix_type = typename MathsTraits::mixtype;
+    using Accumulator = KoOptimizedMixColorsAccumulator<channels_type, channels_nb>;
+
+    static constexpr int alpha_pos = channels_nb - 1;
+    static constexpr int pixelSize = channels_nb * sizeof(channels_type);
+
+public:
+    void accumulate(const quint8 *data, const qint16 *weights, int weightSum, int nPixels) override
+    {
+        for (int i = 0; i < nPixels; i++) {
+            const channels_type *color = reinterpret_cast<const channels_type*>(data);
+
+            mix_type alphaTimesWeight = color[alpha_pos];
+            alphaTimesWeight *= weights[i];
+
+            m_accumulator.add(data, alphaTimesWeight);
+            m_totalAlpha += alphaTimesWeight;
+
+            data += pixelSize;
+        }
+
+        m_normalizeFactor += weightSum;
+    }
+
+    void accumulateAverage(const quint8 *data, int nPixels) override
+    {
+        for (int i = 0; i < nPixels; i++) {
+            const channels_type *color = reinterpret_cast<const channels_type*>(data);
+            const mix_type alphaTimesWeight = color[alpha_pos];
+
+            m_accumulator.add(data, alphaTimesWeight);
+            m_totalAlpha += alphaTimesWeight;
+
+            data += pixelSize;
+        }
+
+        m_normalizeFactor += nPixels;
+    }
+
+    void computeMixedColor(quint8 *data) override
+    {
+        // the same normalization as in KoMixColorsOpImpl::MixDataResult
+
+        mix_type totals[channels_nb];
+        m_accumulator.store(totals);
+
+        mix_type totalAlpha = m_totalAlpha;
+        const mix_type sumOfWeights = m_normalizeFactor;
+
+        if (totalAlpha > MathsTraits::unitValue * sumOfWeights) {
+            totalAlpha = MathsTraits::unitValue * sumOfWeights;
+        }
+
+        channels_type *dstColor = reinterpret_cast<channels_type*>(data);
+
+        if (totalAlpha > 0) {
+            for (int i = 0; i < alpha_pos; i++) {
+                mix_type v = safeDivideWithRound(totals[i], totalAlpha);
+
+                if (v > MathsTraits::max) {
+                    v = MathsTraits::max;
+                }
+                if (v < MathsTraits::min) {
+                    v = MathsTraits::min;
+                }
+                dstColor[i] = v;
+            }
+
+            dstColor[alpha_pos] = safeDivideWithRound(totalAlpha, sumOfWeights);
+        } else {
+            memset(data, 0, pixelSize);
+        }
+    }
+
+    qint64 currentWeightsSum() const override
+    {
+        return m_normalizeFactor;
+    }
+
+private:
+    template <typename T>
+    static inline T safeDivideWithRound(T dividend, T divisor) {
+        return std::is_integral<T>::value ?
+            (dividend + divisor / 2) / divisor :
+            dividend / divisor;
+    }
+
+private:
+    Accumulator m_accumulator;
+    mix_type m_totalAlpha = 0;
+    qint64 m_normalizeFactor = 0;
+};
+
+#endif /* __SSE4_1__ */
+
+#endif // KOOPTIMIZEDMIXCOLORSMIXER_H
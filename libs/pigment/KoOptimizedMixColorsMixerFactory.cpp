@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedMixColorsMixerFactory.h"
+
+#include "KoOptimizedMixColorsMixerFactoryImpl.h"
+
+KoMixColorsOp::Mixer *KoOptimizedMixColorsMixerFactory::create(const KoID &depthId, int numChannels, int alphaPos)
+{
+    const bool layoutIsSupported =
+        (numChannels == 4 && alphaPos == 3) ||
+        (numChannels == 2 && alphaPos == 1);
+
+    if (!layoutIsSupported) {
+        return nullptr;
+    }
+
+    return createOptimizedPixelOp<KoMixColorsOp::Mixer, KoOptimizedMixColorsMixerFactoryImpl, 4, 2>(depthId, numChannels);
+}
@@ -0,0 +1,32 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSMIXERFACTORY_H
+#define KOOPTIMIZEDMIXCOLORSMIXERFACTORY_H
+
+#include "kritapigment_export.h"
+
+#include <KoID.h>
+#include <KoMixColorsOp.h>
+
+/**
+ * Creates a vectorized KoMixColorsOp::Mixer for the pixel layout
+ * if there is one available for the current CPU. Only 4-channel and
+ * 2-channel pixels with the alpha channel placed last are supported
+ * (RGBA, Lab, GrayA and friends).
+ *
+ * Returns nullptr when there is no optimized implementation for
+ * the layout, in which case the caller should use the generic mixer.
+ *
+ * \see KoOptimizedMixColorsMixer
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedMixColorsMixerFactory
+{
+public:
+    static KoMixColorsOp::Mixer* create(const KoID &depthId, int numChannels, int alphaPos);
+};
+
+#endif // KOOPTIMIZEDMIXCOLORSMIXERFACTORY_H
@@ -0,0 +1,12 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedMixColorsMixerFactoryImpl.h"
+#include "KoOptimizedPixelOpFactoryImpl_p.h"
+#include "KoOptimizedMixColorsMixer.h"
+
+KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY(KoOptimizedMixColorsMixerFactoryImpl, 4)
+KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY(KoOptimizedMixColorsMixerFactoryImpl, 2)
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSMIXERFACTORYIMPL_H
+#define KOOPTIMIZEDMIXCOLORSMIXERFACTORYIMPL_H
+
+#include <KoMixColorsOp.h>
+#include "KoOptimizedPixelOpFactoryImpl.h"
+
+template<typename channels_type, int channels_nb, Vc::Implementation _impl>
+class KoOptimizedMixColorsMixer;
+
+template<typename _channels_type_,
+         int _channels_nb_>
+using KoOptimizedMixColorsMixerFactoryImpl =
+    KoOptimizedPixelOpFactoryImpl<KoOptimizedMixColorsMixer, KoMixColorsOp::Mixer, true, _channels_type_, _channels_nb_>;
+
+#endif // KOOPTIMIZEDMIXCOLORSMIXERFACTORYIMPL_H
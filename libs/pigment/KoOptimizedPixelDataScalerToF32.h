@@ -0,0 +1,358 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerToF32_H
+#define KoOptimizedPixelDataScalerToF32_H
+
+#include "KoOptimizedPixelDataScalerToF32Base.h"
+
+#include "KoVcMultiArchBuildSupport.h"
+#include "KoColorSpaceMaths.h"
+#include "KoOptimizedHalfConversion.h"
+#include "kis_debug.h"
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+
+template<Vc::Implementation _impl>
+class KoOptimizedPixelDataScalerToF32 : public KoOptimizedPixelDataScalerToF32Base
+{
+public:
+    KoOptimizedPixelDataScalerToF32(int channelsPerPixel, bool swapRedBlue)
+        : KoOptimizedPixelDataScalerToF32Base(channelsPerPixel, swapRedBlue)
+    {
+    }
+
+    void convertU8ToF32(const quint8 *src, int srcRowStride,
+                        quint8 *dst, int dstRowStride,
+                        int numRows, int numColumns) const override
+    {
+        if (m_swapRedBlue) {
+            convertIntToF32Impl<quint8, true>(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        } else {
+            convertIntToF32Impl<quint8, false>(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        }
+    }
+
+    void convertF32ToU8(const quint8 *src, int srcRowStride,
+                        quint8 *dst, int dstRowStride,
+                        int numRows, int numColumns) const override
+    {
+        if (m_swapRedBlue) {
+            convertF32ToIntImpl<quint8, true>(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        } else {
+            convertF32ToIntImpl<quint8, false>(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        }
+    }
+
+    void convertU16ToF32(const quint8 *src, int srcRowStride,
+                         quint8 *dst, int dstRowStride,
+                         int numRows, int numColumns) const override
+    {
+        if (m_swapRedBlue) {
+            convertIntToF32Impl<quint16, true>(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        } else {
+            convertIntToF32Impl<quint16, false>(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        }
+    }
+
+    void convertF32ToU16(const quint8 *src, int srcRowStride,
+                         quint8 *dst, int dstRowStride,
+                         int numRows, int numColumns) const override
+    {
+        if (m_swapRedBlue) {
+            convertF32ToIntImpl<quint16, true>(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        } else {
+            convertF32ToIntImpl<quint16, false>(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        }
+    }
+
+#ifdef HAVE_OPENEXR
+    void convertF16ToF32(const quint8 *src, int srcRowStride,
+                         quint8 *dst, int dstRowStride,
+                         int numRows, int numColumns) const override
+    {
+        const int numColorChannels = m_channelsPerPixel * numColumns;
+
+        for (int row = 0; row < numRows; row++) {
+            const half *srcRow = reinterpret_cast<const half*>(src);
+            float *dstRow = reinterpret_cast<float*>(dst);
+
+            if (m_swapRedBlue) {
+                for (int i = 0; i < numColorChannels; i++) {
+                    dstRow[i] = float(srcRow[sourceChannel<true>(i)]);
+                }
+            } else {
+                KoOptimizedHalfConversion<_impl>::halfToFloat(srcRow, dstRow, numColorChannels);
+            }
+
+            src += srcRowStride;
+            dst += dstRowStride;
+        }
+    }
+
+    void convertF32ToF16(const quint8 *src, int srcRowStride,
+                         quint8 *dst, int dstRowStride,
+                         int numRows, int numColumns) const override
+    {
+        const int numColorChannels = m_channelsPerPixel * numColumns;
+
+        for (int row = 0; row < numRows; row++) {
+            const float *srcRow = reinterpret_cast<const float*>(src);
+            half *dstRow = reinterpret_cast<half*>(dst);
+
+            if (m_swapRedBlue) {
+                for (int i = 0; i < numColorChannels; i++) {
+                    dstRow[i] = half(srcRow[sourceChannel<true>(i)]);
+                }
+            } else {
+                KoOptimizedHalfConversion<_impl>::floatToHalf(srcRow, dstRow, numColorChannels);
+            }
+
+            src += srcRowStride;
+            dst += dstRowStride;
+        }
+    }
+#endif
+
+private:
+
+    /**
+     * Index of the source channel that should be written into
+     * the destination channel \p i (counted from the start of the row)
+     */
+    template<bool swapRedBlue>
+    static inline int sourceChannel(int i) {
+        return swapRedBlue && !(i & 1) ? i ^ 2 : i;
+    }
+
+    /**
+     * Both SSE and AVX blocks are multiples of four channels, so
+     * the red and blue channels of a 4-channel pixel can be swapped
+     * with an in-lane shuffle without crossing pixel boundaries.
+     */
+#ifdef __SSE2__
+    template<bool swapRedBlue>
+    static inline __m128 swizzle(__m128 x) {
+        return swapRedBlue ? _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 0, 1, 2)) : x;
+    }
+#endif
+
+#ifdef __AVX2__
+    template<bool swapRedBlue>
+    static inline __m256 swizzle(__m256 x) {
+        return swapRedBlue ? _mm256_permute_ps(x, _MM_SHUFFLE(3, 0, 1, 2)) : x;
+    }
+#endif
+
+    template<typename channels_type, bool swapRedBlue>
+    void convertIntToF32Impl(const quint8 *src, int srcRowStride,
+                             quint8 *dst, int dstRowStride,
+                             int numRows, int numColumns) const
+    {
+        const int numColorChannels = m_channelsPerPixel * numColumns;
+
+#if defined __AVX2__
+        const int channelsPerAvx2Block = 8;
+        const int channelsPerSse2Block = 4;
+        const int avx2Block = numColorChannels / channelsPerAvx2Block;
+        const int rest = numColorChannels % channelsPerAvx2Block;
+        const int sse2Block = rest / channelsPerSse2Block;
+
+        const __m256 rec256 = _mm256_set1_ps(1.0f / KoColorSpaceMathsTraits<channels_type>::unitValue);
+        const __m128 rec128 = _mm_set1_ps(1.0f / KoColorSpaceMathsTraits<channels_type>::unitValue);
+#elif defined __SSE4_1__
+        const int channelsPerSse2Block = 4;
+        const int avx2Block = 0;
+        const int sse2Block = numColorChannels / channelsPerSse2Block;
+
+        const __m128 rec128 = _mm_set1_ps(1.0f / KoColorSpaceMathsTraits<channels_type>::unitValue);
+#else
+        const int avx2Block = 0;
+        const int sse2Block = 0;
+#endif
+
+        for (int row = 0; row < numRows; row++) {
+
+            const channels_type *srcPtr = reinterpret_cast<const channels_type*>(src);
+            float *dstPtr = reinterpret_cast<float*>(dst);
+
+#ifdef __AVX2__
+            for (int i = 0; i < avx2Block; i++) {
+                __m256i y;
+
+                if (std::is_same<channels_type, quint8>::value) {
+                    __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(srcPtr));
+                    y = _mm256_cvtepu8_epi32(x);
+                } else {
+                    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcPtr));
+                    y = _mm256_cvtepu16_epi32(x);
+                }
+
+                __m256 f = _mm256_mul_ps(_mm256_cvtepi32_ps(y), rec256);
+                _mm256_storeu_ps(dstPtr, swizzle<swapRedBlue>(f));
+
+                srcPtr += channelsPerAvx2Block;
+                dstPtr += channelsPerAvx2Block;
+            }
+#else
+            Q_UNUSED(avx2Block);
+#endif
+
+#ifdef __SSE4_1__
+            for (int i = 0; i < sse2Block; i++) {
+                __m128i y;
+
+                if (std::is_same<channels_type, quint8>::value) {
+                    qint32 packed;
+                    memcpy(&packed, srcPtr, sizeof(packed));
+                    y = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+                } else {
+                    __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(srcPtr));
+                    y = _mm_cvtepu16_epi32(x);
+                }
+
+                __m128 f = _mm_mul_ps(_mm_cvtepi32_ps(y), rec128);
+                _mm_storeu_ps(dstPtr, swizzle<swapRedBlue>(f));
+
+                srcPtr += channelsPerSse2Block;
+                dstPtr += channelsPerSse2Block;
+            }
+#else
+            Q_UNUSED(sse2Block);
+            Q_UNUSED(srcPtr);
+#endif
+
+            const channels_type *srcRow = reinterpret_cast<const channels_type*>(src);
+            float *dstRow = reinterpret_cast<float*>(dst);
+
+            for (int i = int(dstPtr - dstRow); i < numColorChannels; i++) {
+                dstRow[i] = KoColorSpaceMaths<channels_type, float>::scaleToA(srcRow[sourceChannel<swapRedBlue>(i)]);
+            }
+
+            src += srcRowStride;
+            dst += dstRowStride;
+        }
+    }
+
+    template<typename channels_type, bool swapRedBlue>
+    void convertF32ToIntImpl(const quint8 *src, int srcRowStride,
+                             quint8 *dst, int dstRowStride,
+                             int numRows, int numColumns) const
+    {
+        const int numColorChannels = m_channelsPerPixel * numColumns;
+
+#if defined __AVX2__
+        const int channelsPerAvx2Block = 8;
+        const int channelsPerSse2Block = 4;
+        const int avx2Block = numColorChannels / channelsPerAvx2Block;
+        const int rest = numColorChannels % channelsPerAvx2Block;
+        const int sse2Block = rest / channelsPerSse2Block;
+
+        const __m256 unit256 = _mm256_set1_ps(float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+        const __m256 zero256 = _mm256_setzero_ps();
+#elif defined __SSE4_1__
+        const int channelsPerSse2Block = 4;
+        const int avx2Block = 0;
+        const int sse2Block = numColorChannels / channelsPerSse2Block;
+#elif defined __SSE2__
+        /**
+         * U8 needs only SSE2 for packing, U16 needs `_mm_packus_epi32`,
+         * which appeared in SSE4.1
+         */
+        const int channelsPerSse2Block = 4;
+        const int avx2Block = 0;
+        const int sse2Block =
+            std::is_same<channels_type, quint8>::value ?
+                numColorChannels / channelsPerSse2Block : 0;
+#else
+        const int avx2Block = 0;
+        const int sse2Block = 0;
+#endif
+
+#ifdef __SSE2__
+        const __m128 unit128 = _mm_set1_ps(float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+        const __m128 zero128 = _mm_setzero_ps();
+#endif
+
+        for (int row = 0; row < numRows; row++) {
+
+            const float *srcPtr = reinterpret_cast<const float*>(src);
+            channels_type *dstPtr = reinterpret_cast<channels_type*>(dst);
+
+#ifdef __AVX2__
+            for (int i = 0; i < avx2Block; i++) {
+                __m256 f = swizzle<swapRedBlue>(_mm256_loadu_ps(srcPtr));
+
+                // NaN values are converted to zero by max_ps
+                f = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(f, unit256), zero256), unit256);
+                __m256i y = _mm256_cvtps_epi32(f);
+
+                __m128i lo = _mm256_castsi256_si128(y);
+                __m128i hi = _mm256_extracti128_si256(y, 1);
+
+                if (std::is_same<channels_type, quint8>::value) {
+                    __m128i x = _mm_packs_epi32(lo, hi);
+                    x = _mm_packus_epi16(x, x);
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(dstPtr), x);
+                } else {
+                    __m128i x = _mm_packus_epi32(lo, hi);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dstPtr), x);
+                }
+
+                srcPtr += channelsPerAvx2Block;
+                dstPtr += channelsPerAvx2Block;
+            }
+#else
+            Q_UNUSED(avx2Block);
+#endif
+
+#ifdef __SSE2__
+            for (int i = 0; i < sse2Block; i++) {
+                __m128 f = swizzle<swapRedBlue>(_mm_loadu_ps(srcPtr));
+
+                f = _mm_min_ps(_mm_max_ps(_mm_mul_ps(f, unit128), zero128), unit128);
+                __m128i y = _mm_cvtps_epi32(f);
+
+                if (std::is_same<channels_type, quint8>::value) {
+                    __m128i x = _mm_packs_epi32(y, y);
+                    x = _mm_packus_epi16(x, x);
+                    const qint32 packed = _mm_cvtsi128_si32(x);
+                    memcpy(dstPtr, &packed, sizeof(packed));
+                } else {
+#ifdef __SSE4_1__
+                    __m128i x = _mm_packus_epi32(y, y);
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(dstPtr), x);
+#endif
+                }
+
+                srcPtr += channelsPerSse2Block;
+                dstPtr += channelsPerSse2Block;
+            }
+#else
+            Q_UNUSED(sse2Block);
+            Q_UNUSED(srcPtr);
+#endif
+
+            const float *srcRow = reinterpret_cast<const float*>(src);
+            channels_type *dstRow = reinterpret_cast<channels_type*>(dst);
+
+            for (int i = int(dstPtr - dstRow); i < numColorChannels; i++) {
+                dstRow[i] = KoColorSpaceMaths<float, channels_type>::scaleToA(srcRow[sourceChannel<swapRedBlue>(i)]);
+            }
+
+            src += srcRowStride;
+            dst += dstRowStride;
+        }
+    }
+};
+
+#endif // KoOptimizedPixelDataScalerToF32_H
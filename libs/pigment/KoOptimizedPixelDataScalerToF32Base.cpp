@@ -0,0 +1,28 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerToF32Base.h"
+
+KoOptimizedPixelDataScalerToF32Base::KoOptimizedPixelDataScalerToF32Base(int channelsPerPixel, bool swapRedBlue)
+    : m_channelsPerPixel(channelsPerPixel),
+      m_swapRedBlue(swapRedBlue)
+{
+    Q_ASSERT(!swapRedBlue || channelsPerPixel == 4);
+}
+
+KoOptimizedPixelDataScalerToF32Base::~KoOptimizedPixelDataScalerToF32Base()
+{
+}
+
+int KoOptimizedPixelDataScalerToF32Base::channelsPerPixel() const
+{
+    return m_channelsPerPixel;
+}
+
+bool KoOptimizedPixelDataScalerToF32Base::swapRedBlue() const
+{
+    return m_swapRedBlue;
+}
@@ -0,0 +1,88 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerToF32Base_H
+#define KoOptimizedPixelDataScalerToF32Base_H
+
+#include <QtGlobal>
+#include <KoConfig.h>
+#include "kritapigment_export.h"
+
+/**
+ * @brief Converts an RGB-like color space between integer (or F16) and F32 formats
+ *
+ * When the source and destination color spaces share the same color
+ * model and the same profile, a change of the bit depth is a pure
+ * per-channel rescaling of the data. There is no need to go through
+ * the full LCMS pipeline for that, so the conversion system uses
+ * this scaler to do that with vector instructions.
+ *
+ * Integer RGB color spaces in Krita store the channels in BGR order,
+ * while the floating point ones use RGB order. Pass `swapRedBlue`
+ * to the factory to swap the red and blue channels on the fly.
+ *
+ * The actual implementation is placed in class
+ * `KoOptimizedPixelDataScalerToF32`.
+ *
+ * \code{.cpp}
+ * QScopedPointer<KoOptimizedPixelDataScalerToF32Base> scaler(
+ *     KoOptimizedPixelDataScalerToF32Factory::createRgbaScaler(true));
+ *
+ * // convert the data from U8 to F32
+ * scaler->convertU8ToF32(src, srcRowStride,
+ *                        dst, dstRowStride,
+ *                        numRows, numColumns);
+ * \endcode
+ *
+ * \see KoOptimizedPixelDataScalerU8ToU16Base
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerToF32Base
+{
+public:
+    KoOptimizedPixelDataScalerToF32Base(int channelsPerPixel, bool swapRedBlue);
+
+    virtual ~KoOptimizedPixelDataScalerToF32Base();
+
+    virtual void convertU8ToF32(const quint8 *src, int srcRowStride,
+                                quint8 *dst, int dstRowStride,
+                                int numRows, int numColumns) const = 0;
+
+    virtual void convertF32ToU8(const quint8 *src, int srcRowStride,
+                                quint8 *dst, int dstRowStride,
+                                int numRows, int numColumns) const = 0;
+
+    virtual void convertU16ToF32(const quint8 *src, int srcRowStride,
+                                 quint8 *dst, int dstRowStride,
+                                 int numRows, int numColumns) const = 0;
+
+    virtual void convertF32ToU16(const quint8 *src, int srcRowStride,
+                                 quint8 *dst, int dstRowStride,
+                                 int numRows, int numColumns) const = 0;
+
+#ifdef HAVE_OPENEXR
+    /**
+     * Half and float color spaces use the same channel order, so
+     * these conversions are usually done by a scaler created without
+     * `swapRedBlue`
+     */
+    virtual void convertF16ToF32(const quint8 *src, int srcRowStride,
+                                 quint8 *dst, int dstRowStride,
+                                 int numRows, int numColumns) const = 0;
+
+    virtual void convertF32ToF16(const quint8 *src, int srcRowStride,
+                                 quint8 *dst, int dstRowStride,
+                                 int numRows, int numColumns) const = 0;
+#endif
+
+    int channelsPerPixel() const;
+    bool swapRedBlue() const;
+
+protected:
+    int m_channelsPerPixel;
+    bool m_swapRedBlue;
+};
+
+#endif // KoOptimizedPixelDataScalerToF32Base_H
@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerToF32Factory.h"
+
+#include "KoOptimizedPixelDataScalerToF32FactoryImpl.h"
+
+
+KoOptimizedPixelDataScalerToF32Base *KoOptimizedPixelDataScalerToF32Factory::createRgbaScaler(bool swapRedBlue)
+{
+    return createOptimizedClass<
+            KoOptimizedPixelDataScalerToF32FactoryImpl>({4, swapRedBlue});
+}
+
+KoOptimizedPixelDataScalerToF32Base *KoOptimizedPixelDataScalerToF32Factory::createGrayaScaler()
+{
+    return createOptimizedClass<
+            KoOptimizedPixelDataScalerToF32FactoryImpl>({2, false});
+}
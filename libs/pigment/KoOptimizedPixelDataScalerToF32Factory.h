@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerToF32FACTORY_H
+#define KoOptimizedPixelDataScalerToF32FACTORY_H
+
+#include "KoOptimizedPixelDataScalerToF32Base.h"
+
+/**
+ * \see KoOptimizedPixelDataScalerToF32Base
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerToF32Factory
+{
+public:
+    static KoOptimizedPixelDataScalerToF32Base* createRgbaScaler(bool swapRedBlue);
+    static KoOptimizedPixelDataScalerToF32Base* createGrayaScaler();
+
+};
+
+
+#endif // KoOptimizedPixelDataScalerToF32FACTORY_H
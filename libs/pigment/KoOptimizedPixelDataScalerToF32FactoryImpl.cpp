@@ -0,0 +1,17 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerToF32FactoryImpl.h"
+
+#include "KoOptimizedPixelDataScalerToF32.h"
+
+template<Vc::Implementation _impl>
+KoOptimizedPixelDataScalerToF32Base *KoOptimizedPixelDataScalerToF32FactoryImpl::create(ParamType param)
+{
+    return new KoOptimizedPixelDataScalerToF32<_impl>(param.channelsPerPixel, param.swapRedBlue);
+}
+
+template KoOptimizedPixelDataScalerToF32Base *KoOptimizedPixelDataScalerToF32FactoryImpl::create<Vc::CurrentImplementation::current()>(ParamType);
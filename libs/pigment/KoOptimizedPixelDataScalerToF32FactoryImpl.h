@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerToF32FACTORYIMPL_H
+#define KoOptimizedPixelDataScalerToF32FACTORYIMPL_H
+
+#include <KoOptimizedPixelDataScalerToF32Base.h>
+#include <KoVcMultiArchBuildSupport.h>
+
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerToF32FactoryImpl
+{
+public:
+    struct ParamType {
+        int channelsPerPixel;
+        bool swapRedBlue;
+    };
+
+    typedef KoOptimizedPixelDataScalerToF32Base* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static KoOptimizedPixelDataScalerToF32Base* create(ParamType);
+};
+
+#endif // KoOptimizedPixelDataScalerToF32FACTORYIMPL_H
@@ -20,3 +20,9 @@ KoOptimizedPixelDataScalerU8ToU16Base *KoOptimizedPixelDataScalerU8ToU16Factory:
     return createOptimizedClass<
             KoOptimizedPixelDataScalerU8ToU16FactoryImpl>(5);
 }
+
+KoOptimizedPixelDataScalerU8ToU16Base *KoOptimizedPixelDataScalerU8ToU16Factory::createGrayaScaler()
+{
+    return createOptimizedClass<
+            KoOptimizedPixelDataScalerU8ToU16FactoryImpl>(2);
+}
@@ -17,6 +17,7 @@ class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerU8ToU16Factory
 public:
     static KoOptimizedPixelDataScalerU8ToU16Base* createRgbaScaler();
     static KoOptimizedPixelDataScalerU8ToU16Base* createCmykaScaler();
+    static KoOptimizedPixelDataScalerU8ToU16Base* createGrayaScaler();
 
 };
 
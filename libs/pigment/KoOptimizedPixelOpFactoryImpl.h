@@ -0,0 +1,92 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDPIXELOPFACTORYIMPL_H
+#define KOOPTIMIZEDPIXELOPFACTORYIMPL_H
+
+#include "kritapigment_export.h"
+
+#include <KoID.h>
+#include <KoColorModelStandardIdsUtils.h>
+#include <KoVcMultiArchBuildSupport.h>
+
+/**
+ * A per-arch factory for the optimized pixel operations that are
+ * parametrized by the channel type and the number of channels, like
+ * KoOptimizedMixColorsMixer or KoOptimizedConvolutionOp. It is passed
+ * to createOptimizedClass().
+ *
+ * If \p requiresSse4 is true, the operation exists for SSE4.1 and
+ * newer architectures only and create() returns nullptr for the older
+ * ones, so that the caller could fall back to the generic scalar code.
+ *
+ * create() is defined in KoOptimizedPixelOpFactoryImpl_p.h, which
+ * should be included only by the files compiled for every architecture.
+ */
+template<template<typename, int, Vc::Implementation> class OptimizedOp,
+         class BaseOp,
+         bool requiresSse4,
+         typename _channels_type_,
+         int _channels_nb_>
+class KRITAPIGMENT_EXPORT KoOptimizedPixelOpFactoryImpl
+{
+public:
+    typedef int ParamType;
+    typedef BaseOp* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static BaseOp* create(int);
+};
+
+namespace KoOptimizedPixelOpFactoryDetail {
+
+template<class BaseOp, template<typename, int> class FactoryImpl, typename channels_type>
+BaseOp* createForChannels(int)
+{
+    return nullptr;
+}
+
+template<class BaseOp, template<typename, int> class FactoryImpl, typename channels_type,
+         int channels_nb, int... otherChannelsNb>
+BaseOp* createForChannels(int numChannels)
+{
+    return numChannels == channels_nb ?
+        createOptimizedClass<FactoryImpl<channels_type, channels_nb>>(0) :
+        createForChannels<BaseOp, FactoryImpl, channels_type, otherChannelsNb...>(numChannels);
+}
+
+}
+
+/**
+ * Creates an optimized operation with \p FactoryImpl for the pixels
+ * of \p depthId with \p numChannels channels. The factory should be
+ * instantiated for every number of channels listed in
+ * \p supportedChannelsNb and for U8, U16, F16 and F32 channels.
+ *
+ * Returns nullptr if the depth or the number of channels is not
+ * supported or if the CPU doesn't support the operation.
+ */
+template<class BaseOp, template<typename, int> class FactoryImpl, int... supportedChannelsNb>
+BaseOp* createOptimizedPixelOp(const KoID &depthId, int numChannels)
+{
+    using KoOptimizedPixelOpFactoryDetail::createForChannels;
+
+    if (depthId == Integer8BitsColorDepthID) {
+        return createForChannels<BaseOp, FactoryImpl, quint8, supportedChannelsNb...>(numChannels);
+    } else if (depthId == Integer16BitsColorDepthID) {
+        return createForChannels<BaseOp, FactoryImpl, quint16, supportedChannelsNb...>(numChannels);
+#ifdef HAVE_OPENEXR
+    } else if (depthId == Float16BitsColorDepthID) {
+        return createForChannels<BaseOp, FactoryImpl, half, supportedChannelsNb...>(numChannels);
+#endif
+    } else if (depthId == Float32BitsColorDepthID) {
+        return createForChannels<BaseOp, FactoryImpl, float, supportedChannelsNb...>(numChannels);
+    }
+
+    return nullptr;
+}
+
+#endif // KOOPTIMIZEDPIXELOPFACTORYIMPL_H
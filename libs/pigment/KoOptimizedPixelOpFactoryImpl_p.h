@@ -0,0 +1,84 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDPIXELOPFACTORYIMPL_P_H
+#define KOOPTIMIZEDPIXELOPFACTORYIMPL_P_H
+
+#include "KoOptimizedPixelOpFactoryImpl.h"
+
+#include <utility>
+
+#include <KoConfig.h>
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
+
+/**
+ * Allocates \p OptimizedOp if it is available for the current
+ * architecture, otherwise returns nullptr
+ */
+template<class OptimizedOp, class BaseOp, bool isAvailable>
+struct KoOptimizedPixelOpAllocator
+{
+    template<typename... Args>
+    static BaseOp* create(Args&&... args) {
+        return new OptimizedOp(std::forward<Args>(args)...);
+    }
+};
+
+template<class OptimizedOp, class BaseOp>
+struct KoOptimizedPixelOpAllocator<OptimizedOp, BaseOp, false>
+{
+    template<typename... Args>
+    static BaseOp* create(Args&&...) {
+        return nullptr;
+    }
+};
+
+#ifdef __SSE4_1__
+static constexpr bool koOptimizedPixelOpHasSse4 = true;
+#else
+static constexpr bool koOptimizedPixelOpHasSse4 = false;
+#endif
+
+template<template<typename, int, Vc::Implementation> class OptimizedOp,
+         class BaseOp,
+         bool requiresSse4,
+         typename _channels_type_,
+         int _channels_nb_>
+template<Vc::Implementation _impl>
+BaseOp*
+KoOptimizedPixelOpFactoryImpl<OptimizedOp, BaseOp, requiresSse4, _channels_type_, _channels_nb_>::create(int)
+{
+    return KoOptimizedPixelOpAllocator<
+            OptimizedOp<_channels_type_, _channels_nb_, _impl>,
+            BaseOp,
+            koOptimizedPixelOpHasSse4 || !requiresSse4>::create();
+}
+
+#define KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY_FOR_TYPE(FactoryImpl, channels_type, channels_nb) \
+    template FactoryImpl<channels_type, channels_nb>::ReturnType \
+    FactoryImpl<channels_type, channels_nb>::create<Vc::CurrentImplementation::current()>(int);
+
+#ifdef HAVE_OPENEXR
+#define KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY_FOR_HALF(FactoryImpl, channels_nb) \
+    KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY_FOR_TYPE(FactoryImpl, half, channels_nb)
+#else
+#define KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY_FOR_HALF(FactoryImpl, channels_nb)
+#endif
+
+/**
+ * Instantiates FactoryImpl::create() for U8, U16, F16 and F32 pixels
+ * with \p channels_nb channels for the architecture the file is
+ * compiled for
+ */
+#define KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY(FactoryImpl, channels_nb) \
+    KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY_FOR_TYPE(FactoryImpl, quint8, channels_nb) \
+    KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY_FOR_TYPE(FactoryImpl, quint16, channels_nb) \
+    KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY_FOR_HALF(FactoryImpl, channels_nb) \
+    KO_INSTANTIATE_OPTIMIZED_PIXEL_OP_FACTORY_FOR_TYPE(FactoryImpl, float, channels_nb)
+
+#endif // KOOPTIMIZEDPIXELOPFACTORYIMPL_P_H
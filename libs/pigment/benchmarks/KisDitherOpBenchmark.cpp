@@ -0,0 +1,104 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KisDitherOpBenchmark.h"
+
+#include <simpletest.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorSpace.h>
+#include <KoColorModelStandardIds.h>
+#include <KisDitherOp.h>
+
+#include <KoConfig.h>
+
+#define IMAGE_WIDTH 1024
+#define IMAGE_HEIGHT 1024
+
+void KisDitherOpBenchmark::benchmarkDither_data()
+{
+    QTest::addColumn<QString>("modelId");
+    QTest::addColumn<QString>("srcDepthId");
+    QTest::addColumn<QString>("dstDepthId");
+    QTest::addColumn<int>("ditherType");
+
+    const QList<KoID> models = {RGBAColorModelID, GrayAColorModelID, CMYKAColorModelID};
+    const QList<KoID> depths = {
+        Integer8BitsColorDepthID,
+        Integer16BitsColorDepthID,
+#ifdef HAVE_OPENEXR
+        Float16BitsColorDepthID,
+#endif
+        Float32BitsColorDepthID
+    };
+
+    Q_FOREACH (const KoID &model, models) {
+        Q_FOREACH (const KoID &srcDepth, depths) {
+            Q_FOREACH (const KoID &dstDepth, depths) {
+                for (int type : {DITHER_NONE, DITHER_BAYER, DITHER_BLUE_NOISE}) {
+                    const QString typeName =
+                        type == DITHER_NONE ? "none" :
+                        type == DITHER_BAYER ? "bayer" : "blue-noise";
+
+                    const QString name =
+                        QString("%1 %2->%3 %4")
+                            .arg(model.id())
+                            .arg(srcDepth.id())
+                            .arg(dstDepth.id())
+                            .arg(typeName);
+
+                    QTest::newRow(name.toLatin1().data())
+                        << model.id() << srcDepth.id() << dstDepth.id() << type;
+                }
+            }
+        }
+    }
+}
+
+void KisDitherOpBenchmark::benchmarkDither()
+{
+    QFETCH(QString, modelId);
+    QFETCH(QString, srcDepthId);
+    QFETCH(QString, dstDepthId);
+    QFETCH(int, ditherType);
+
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->colorSpace(modelId, srcDepthId, 0);
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->colorSpace(modelId, dstDepthId, 0);
+    QVERIFY(srcCs);
+    QVERIFY(dstCs);
+
+    const KisDitherOp *op = srcCs->ditherOp(dstDepthId, DitherType(ditherType));
+    QVERIFY(op);
+
+    const int srcPixelSize = srcCs->pixelSize();
+    const int dstPixelSize = dstCs->pixelSize();
+
+    QVector<quint8> src(IMAGE_WIDTH * IMAGE_HEIGHT * srcPixelSize);
+    QVector<quint8> dst(IMAGE_WIDTH * IMAGE_HEIGHT * dstPixelSize);
+    QVector<float> channels(srcCs->channelCount());
+
+    // a horizontal gradient, the way export dithering is usually seen
+    for (int y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int x = 0; x < IMAGE_WIDTH; x++) {
+            for (int c = 0; c < channels.size(); c++) {
+                channels[c] = qreal(x) / IMAGE_WIDTH;
+            }
+            srcCs->fromNormalisedChannelsValue(src.data() + (y * IMAGE_WIDTH + x) * srcPixelSize, channels);
+        }
+    }
+
+    QBENCHMARK {
+        // dither tile by tile, as KisPaintDevice::convertTo() does
+        for (int y = 0; y < IMAGE_HEIGHT; y += 64) {
+            for (int x = 0; x < IMAGE_WIDTH; x += 64) {
+                op->dither(src.constData() + (y * IMAGE_WIDTH + x) * srcPixelSize, IMAGE_WIDTH * srcPixelSize,
+                           dst.data() + (y * IMAGE_WIDTH + x) * dstPixelSize, IMAGE_WIDTH * dstPixelSize,
+                           x, y, 64, 64);
+            }
+        }
+    }
+}
+
+SIMPLE_TEST_MAIN(KisDitherOpBenchmark)
@@ -0,0 +1,93 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoColorConversionCacheBenchmark.h"
+
+#include <simpletest.h>
+
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorSpace.h>
+
+#define NB_CONVERSIONS_PER_THREAD 100000
+
+namespace {
+
+/**
+ * Emulates a paintop converting a color for every dab: converts one
+ * pixel at a time, alternating between a few color space pairs, so
+ * every call goes through the conversion cache.
+ */
+class ConversionJob : public QRunnable
+{
+public:
+    ConversionJob(const QVector<const KoColorSpace*> &colorSpaces)
+        : m_colorSpaces(colorSpaces)
+    {
+    }
+
+    void run() override {
+        const KoColor srcColor(QColor(180, 120, 30, 200), m_colorSpaces.first());
+
+        for (int i = 0; i < NB_CONVERSIONS_PER_THREAD; i++) {
+            const KoColorSpace *dstCs = m_colorSpaces[i % m_colorSpaces.size()];
+            KoColor color = srcColor.convertedTo(dstCs);
+            Q_UNUSED(color);
+        }
+    }
+
+private:
+    QVector<const KoColorSpace*> m_colorSpaces;
+};
+
+}
+
+void KoColorConversionCacheBenchmark::benchmarkConcurrentLookups_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("8 threads") << 8;
+    QTest::newRow("16 threads") << 16;
+    QTest::newRow("32 threads") << 32;
+    QTest::newRow("64 threads") << 64;
+}
+
+void KoColorConversionCacheBenchmark::benchmarkConcurrentLookups()
+{
+    QFETCH(int, numThreads);
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    const QVector<const KoColorSpace*> colorSpaces = {
+        registry->rgb8(),
+        registry->rgb16(),
+        registry->lab16(),
+        registry->graya8()
+    };
+
+    // warm up the cache, we want to measure the lookups only
+    {
+        ConversionJob job(colorSpaces);
+        job.run();
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(numThreads);
+
+    QBENCHMARK {
+        for (int i = 0; i < numThreads; i++) {
+            pool.start(new ConversionJob(colorSpaces));
+        }
+        pool.waitForDone();
+    }
+}
+
+SIMPLE_TEST_MAIN(KoColorConversionCacheBenchmark)
@@ -0,0 +1,120 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoColorConversionSystemBenchmark.h"
+
+#include <simpletest.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceEngine.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorConversionTransformation.h>
+#include <KoConfig.h>
+
+#define NB_PIXELS 1000000
+
+void KoColorConversionSystemBenchmark::benchmarkDepthConversion_data()
+{
+    QTest::addColumn<QString>("modelId");
+    QTest::addColumn<QString>("srcDepthId");
+    QTest::addColumn<QString>("dstDepthId");
+    QTest::addColumn<bool>("useLcms");
+
+    const QList<KoID> models = {RGBAColorModelID, GrayAColorModelID};
+    const QList<QPair<KoID, KoID>> depths = {
+        {Integer8BitsColorDepthID, Integer16BitsColorDepthID},
+        {Integer16BitsColorDepthID, Integer8BitsColorDepthID},
+        {Integer8BitsColorDepthID, Float32BitsColorDepthID},
+        {Float32BitsColorDepthID, Integer8BitsColorDepthID},
+        {Integer16BitsColorDepthID, Float32BitsColorDepthID},
+        {Float32BitsColorDepthID, Integer16BitsColorDepthID},
+#ifdef HAVE_OPENEXR
+        {Float16BitsColorDepthID, Float32BitsColorDepthID},
+        {Float32BitsColorDepthID, Float16BitsColorDepthID}
+#endif
+    };
+
+    Q_FOREACH (const KoID &model, models) {
+        for (auto it = depths.begin(); it != depths.end(); ++it) {
+            for (int useLcms = 0; useLcms <= 1; useLcms++) {
+                const QString name =
+                    QString("%1 %2->%3 %4")
+                        .arg(model.id())
+                        .arg(it->first.id())
+                        .arg(it->second.id())
+                        .arg(useLcms ? "lcms" : "optimized");
+
+                QTest::newRow(name.toLatin1().data())
+                    << model.id() << it->first.id() << it->second.id() << bool(useLcms);
+            }
+        }
+    }
+}
+
+void KoColorConversionSystemBenchmark::benchmarkDepthConversion()
+{
+    QFETCH(QString, modelId);
+    QFETCH(QString, srcDepthId);
+    QFETCH(QString, dstDepthId);
+    QFETCH(bool, useLcms);
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    /**
+     * Default profiles differ between bit depths (floating point
+     * color spaces are linear by default), so pick the profile of
+     * the U8 color space explicitly
+     */
+    const KoColorProfile *profile =
+        registry->colorSpace(modelId, Integer8BitsColorDepthID.id())->profile();
+
+    const KoColorSpace *srcCs = registry->colorSpace(modelId, srcDepthId, profile);
+    const KoColorSpace *dstCs = registry->colorSpace(modelId, dstDepthId, profile);
+    QVERIFY(srcCs);
+    QVERIFY(dstCs);
+
+    const KoColorConversionTransformation::Intent intent =
+        KoColorConversionTransformation::internalRenderingIntent();
+    const KoColorConversionTransformation::ConversionFlags flags =
+        KoColorConversionTransformation::internalConversionFlags();
+
+    QScopedPointer<KoColorConversionTransformation> transform;
+
+    if (useLcms) {
+        KoColorSpaceEngine *engine = KoColorSpaceEngineRegistry::instance()->get("icc");
+        QVERIFY(engine);
+        transform.reset(engine->createColorTransformation(srcCs, dstCs, intent, flags));
+    } else {
+        transform.reset(registry->createColorConverter(srcCs, dstCs, intent, flags));
+    }
+    QVERIFY(transform);
+
+    QByteArray srcBuf(NB_PIXELS * srcCs->pixelSize(), '\0');
+    QByteArray dstBuf(NB_PIXELS * dstCs->pixelSize(), '\0');
+
+    // fill the source buffer with valid random colors
+    {
+        const KoColorSpace *rgb8 = registry->rgb8();
+        QByteArray rgbBuf(NB_PIXELS * rgb8->pixelSize(), '\0');
+
+        qsrand(1);
+        for (int i = 0; i < rgbBuf.size(); i++) {
+            rgbBuf[i] = qrand() & 0xFF;
+        }
+
+        rgb8->convertPixelsTo(reinterpret_cast<const quint8*>(rgbBuf.constData()),
+                              reinterpret_cast<quint8*>(srcBuf.data()),
+                              srcCs, NB_PIXELS, intent, flags);
+    }
+
+    QBENCHMARK {
+        transform->transform(reinterpret_cast<const quint8*>(srcBuf.constData()),
+                             reinterpret_cast<quint8*>(dstBuf.data()),
+                             NB_PIXELS);
+    }
+}
+
+SIMPLE_TEST_MAIN(KoColorConversionSystemBenchmark)
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef _KO_COLOR_CONVERSION_SYSTEM_BENCHMARK_H_
+#define _KO_COLOR_CONVERSION_SYSTEM_BENCHMARK_H_
+
+#include <QObject>
+
+class KoColorConversionSystemBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkDepthConversion_data();
+    void benchmarkDepthConversion();
+};
+
+#endif
@@ -12,6 +12,9 @@
 
 #include <KoColorSpaceTraits.h>
 #include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
+#include <KoCompositeOpRegistry.h>
+#include <KoConfig.h>
 
 #include <simpletest.h>
 
@@ -97,4 +100,77 @@ void KoCompositeOpsBenchmark::benchmarkCompositeAlphaDarkenCreamy()
 }
 
 
+static const KoColorSpace* colorSpaceForDepth(const QString &depthId)
+{
+    return KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depthId, "");
+}
+
+void KoCompositeOpsBenchmark::benchmarkCompositeAllModes_data()
+{
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<QString>("compositeOpId");
+
+    const QStringList depthIds = {
+        Integer8BitsColorDepthID.id(),
+        Integer16BitsColorDepthID.id(),
+#ifdef HAVE_OPENEXR
+        Float16BitsColorDepthID.id(),
+#endif
+        Float32BitsColorDepthID.id()
+    };
+
+    Q_FOREACH (const QString &depthId, depthIds) {
+        const KoColorSpace *cs = colorSpaceForDepth(depthId);
+        QVERIFY(cs);
+
+        Q_FOREACH (const KoCompositeOp *op, cs->compositeOps()) {
+            QTest::newRow(QString("%1-%2").arg(depthId).arg(op->id()).toLatin1())
+                << depthId << op->id();
+        }
+    }
+}
+
+void KoCompositeOpsBenchmark::benchmarkCompositeAllModes()
+{
+    QFETCH(QString, depthId);
+    QFETCH(QString, compositeOpId);
+
+    const KoColorSpace *cs = colorSpaceForDepth(depthId);
+    const KoCompositeOp *compositeOp = cs->compositeOp(compositeOpId);
+    QVERIFY(compositeOp);
+
+    const int numPixels = IMG_WIDTH * IMG_HEIGHT;
+    const int pixelSize = cs->pixelSize();
+
+    // convert the random 8-bit data to get valid pixels in floating point spaces
+    QVector<quint8> dstBuffer(numPixels * pixelSize);
+    QVector<quint8> srcBuffer(numPixels * pixelSize);
+
+    const KoColorSpace *rgb8 = KoColorSpaceRegistry::instance()->rgb8();
+    rgb8->convertPixelsTo(m_dstBuffer, dstBuffer.data(), cs, numPixels,
+                          KoColorConversionTransformation::internalRenderingIntent(),
+                          KoColorConversionTransformation::internalConversionFlags());
+    rgb8->convertPixelsTo(m_srcBuffer, srcBuffer.data(), cs, numPixels,
+                          KoColorConversionTransformation::internalRenderingIntent(),
+                          KoColorConversionTransformation::internalConversionFlags());
+
+    const int rowStride = IMG_WIDTH * pixelSize;
+    const int maskRowStride = IMG_WIDTH;
+
+    QBENCHMARK {
+        for (int y = 0; y < TILES_IN_HEIGHT; y++) {
+            for (int x = 0; x < TILES_IN_WIDTH; x++) {
+                const int bufOffset = y * TILE_HEIGHT * rowStride + x * TILE_WIDTH * pixelSize;
+                const int maskOffset = y * TILE_HEIGHT * maskRowStride + x * TILE_WIDTH;
+
+                compositeOp->composite(dstBuffer.data() + bufOffset, rowStride,
+                                       srcBuffer.data() + bufOffset, rowStride,
+                                       m_mskBuffer + maskOffset, maskRowStride,
+                                       TILE_HEIGHT, TILE_WIDTH,
+                                       OPACITY_HALF);
+            }
+        }
+    }
+}
+
 QTEST_GUILESS_MAIN(KoCompositeOpsBenchmark)
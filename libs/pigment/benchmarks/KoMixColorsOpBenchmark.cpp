@@ -0,0 +1,153 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoMixColorsOpBenchmark.h"
+
+#include <simpletest.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorSpace.h>
+#include <KoColorModelStandardIds.h>
+#include <KoMixColorsOp.h>
+
+#include <KoConfig.h>
+
+#include <QColor>
+
+#include <cmath>
+#include <random>
+
+#define DAB_SIZE 128
+#define NUM_DABS 100
+
+enum MixingMode {
+    SmudgeWeighted = 0,
+    SmudgeAveraged,
+    RowWeighted,
+    MixColorsWeighted
+};
+
+void KoMixColorsOpBenchmark::benchmarkSmudgeDab_data()
+{
+    QTest::addColumn<QString>("modelId");
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<int>("mode");
+
+    const QList<KoID> models = {RGBAColorModelID, GrayAColorModelID};
+    const QList<KoID> depths = {
+        Integer8BitsColorDepthID,
+        Integer16BitsColorDepthID,
+#ifdef HAVE_OPENEXR
+        Float16BitsColorDepthID,
+#endif
+        Float32BitsColorDepthID
+    };
+
+    const QStringList modeNames = {
+        "smudge-weighted", "smudge-averaged", "row-weighted", "mixcolors-weighted"
+    };
+
+    Q_FOREACH (const KoID &model, models) {
+        Q_FOREACH (const KoID &depth, depths) {
+            for (int mode = 0; mode < modeNames.size(); mode++) {
+                const QString name =
+                    QString("%1 %2 %3")
+                        .arg(model.id())
+                        .arg(depth.id())
+                        .arg(modeNames[mode]);
+
+                QTest::newRow(name.toLatin1().data())
+                    << model.id() << depth.id() << mode;
+            }
+        }
+    }
+}
+
+void KoMixColorsOpBenchmark::benchmarkSmudgeDab()
+{
+    QFETCH(QString, modelId);
+    QFETCH(QString, depthId);
+    QFETCH(int, mode);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace(modelId, depthId, 0);
+    QVERIFY(cs);
+
+    const int pixelSize = cs->pixelSize();
+    const int numPixels = DAB_SIZE * DAB_SIZE;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+
+    /**
+     * Fill the sample with random channel values (cycling through a set of
+     * pre-generated colors keeps the values valid for floating point
+     * color spaces), and the mask with a radial brush dab
+     */
+    QVector<quint8> colors(16 * pixelSize);
+    for (int i = 0; i < 16; i++) {
+        QColor c(byteDist(gen), byteDist(gen), byteDist(gen), byteDist(gen));
+        cs->fromQColor(c, colors.data() + i * pixelSize);
+    }
+
+    QVector<quint8> sample(numPixels * pixelSize);
+    for (int i = 0; i < numPixels; i++) {
+        memcpy(sample.data() + i * pixelSize, colors.data() + (i % 16) * pixelSize, pixelSize);
+    }
+
+    QVector<qint16> mask(numPixels);
+    const qreal radius = 0.5 * DAB_SIZE;
+    for (int y = 0; y < DAB_SIZE; y++) {
+        for (int x = 0; x < DAB_SIZE; x++) {
+            const qreal dist = std::hypot(x + 0.5 - radius, y + 0.5 - radius) / radius;
+            mask[y * DAB_SIZE + x] = qBound(0, qRound(255 * (1.0 - dist)), 255);
+        }
+    }
+
+    int maskSum = 0;
+    Q_FOREACH (qint16 w, mask) {
+        maskSum += w;
+    }
+
+    const KoMixColorsOp *op = cs->mixColorsOp();
+    QVector<quint8> result(pixelSize);
+
+    QBENCHMARK {
+        for (int dab = 0; dab < NUM_DABS; dab++) {
+            if (mode == MixColorsWeighted) {
+                op->mixColors(sample.constData(), mask.constData(), numPixels, result.data(), maskSum);
+                continue;
+            }
+
+            QScopedPointer<KoMixColorsOp::Mixer> mixer(op->createMixer());
+
+            if (mode == SmudgeWeighted) {
+                // the same calls KisColorSmudgeSampleUtils::WeightedSampleWrapper does
+                for (int i = 0; i < numPixels; i++) {
+                    const qint16 opacity = mask[i];
+                    mixer->accumulate(sample.constData() + i * pixelSize, &opacity, opacity, 1);
+                }
+            } else if (mode == SmudgeAveraged) {
+                for (int i = 0; i < numPixels; i++) {
+                    mixer->accumulateAverage(sample.constData() + i * pixelSize, 1);
+                }
+            } else {
+                for (int y = 0; y < DAB_SIZE; y++) {
+                    int rowSum = 0;
+                    for (int x = 0; x < DAB_SIZE; x++) {
+                        rowSum += mask[y * DAB_SIZE + x];
+                    }
+
+                    mixer->accumulate(sample.constData() + y * DAB_SIZE * pixelSize,
+                                      mask.constData() + y * DAB_SIZE,
+                                      rowSum, DAB_SIZE);
+                }
+            }
+
+            mixer->computeMixedColor(result.data());
+        }
+    }
+}
+
+SIMPLE_TEST_MAIN(KoMixColorsOpBenchmark)
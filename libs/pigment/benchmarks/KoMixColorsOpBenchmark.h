@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef _KO_MIX_COLORS_OP_BENCHMARK_H_
+#define _KO_MIX_COLORS_OP_BENCHMARK_H_
+
+#include <QObject>
+
+class KoMixColorsOpBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkSmudgeDab_data();
+    void benchmarkSmudgeDab();
+};
+
+#endif
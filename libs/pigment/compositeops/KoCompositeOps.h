@@ -53,6 +53,20 @@ struct OptimizedOpsSelector
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return new KoCompositeOpCopy2<Traits>(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        Q_UNUSED(cs);
+        Q_UNUSED(id);
+        Q_UNUSED(category);
+        return nullptr;
+    }
+
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        Q_UNUSED(cs);
+        Q_UNUSED(id);
+        Q_UNUSED(category);
+        return nullptr;
+    }
 };
 
 template<>
@@ -70,6 +84,12 @@ struct OptimizedOpsSelector<KoBgrU8Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp32(cs);
     }
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOp32(cs, id, category);
+    }
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericHSLOp32(cs, id, category);
+    }
 };
 
 template<>
@@ -86,6 +106,9 @@ struct OptimizedOpsSelector<KoLabU8Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp32(cs);
     }
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOp32(cs, id, category);
+    }
 };
 
 template<>
@@ -103,6 +126,12 @@ struct OptimizedOpsSelector<KoRgbF32Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp128(cs);
     }
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOp128(cs, id, category);
+    }
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericHSLOp128(cs, id, category);
+    }
 };
 
 template<>
@@ -120,7 +149,38 @@ struct OptimizedOpsSelector<KoBgrU16Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOpU64(cs);
     }
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOpU64(cs, id, category);
+    }
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericHSLOpU64(cs, id, category);
+    }
+};
+
+#ifdef HAVE_OPENEXR
+template<>
+struct OptimizedOpsSelector<KoRgbF16Traits>
+{
+    static KoCompositeOp* createAlphaDarkenOp(const KoColorSpace *cs) {
+        return useCreamyAlphaDarken() ?
+            KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(cs) :
+            KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardF16(cs);
+
+    }
+    static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createOverOpF16(cs);
+    }
+    static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createCopyOpF16(cs);
+    }
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOpF16(cs, id, category);
+    }
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericHSLOpF16(cs, id, category);
+    }
 };
+#endif
 
 
 template<class Traits>
@@ -132,7 +192,8 @@ struct AddGeneralOps<Traits, true>
 
      template<CompositeFunc func>
      static void add(KoColorSpace* cs, const QString& id, const QString& category) {
-         cs->addCompositeOp(new KoCompositeOpGenericSC<Traits, func>(cs, id, category));
+         KoCompositeOp *op = OptimizedOpsSelector<Traits>::createGenericSCOp(cs, id, category);
+         cs->addCompositeOp(op ? op : new KoCompositeOpGenericSC<Traits, func>(cs, id, category));
      }
 
      static void add(KoColorSpace* cs) {
@@ -255,7 +316,8 @@ struct AddRGBOps<Traits, true>
     template<void compositeFunc(Arg, Arg, Arg, Arg&, Arg&, Arg&)>
 
     static void add(KoColorSpace* cs, const QString& id, const QString& category) {
-        cs->addCompositeOp(new KoCompositeOpGenericHSL<Traits, compositeFunc>(cs, id, category));
+        KoCompositeOp *op = OptimizedOpsSelector<Traits>::createGenericHSLOp(cs, id, category);
+        cs->addCompositeOp(op ? op : new KoCompositeOpGenericHSL<Traits, compositeFunc>(cs, id, category));
     }
 
     static void add(KoColorSpace* cs) {
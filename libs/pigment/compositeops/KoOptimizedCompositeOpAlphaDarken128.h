@@ -140,7 +140,7 @@ struct AlphaDarkenCompositor128 {
         PixelWrapper<channels_type, _impl>::normalizeAlpha(dstAlphaNorm);
 
         const float uint8Rec1 = 1.0f / 255.0f;
-        float mskAlphaNorm = haveMask ? float(*mask) * uint8Rec1 * src[alpha_pos] : src[alpha_pos];
+        float mskAlphaNorm = haveMask ? float(*mask) * uint8Rec1 * float(src[alpha_pos]) : float(src[alpha_pos]);
         PixelWrapper<channels_type, _impl>::normalizeAlpha(mskAlphaNorm);
 
         Q_UNUSED(opacity);
@@ -260,5 +260,49 @@ public:
         : KoOptimizedCompositeOpAlphaDarkenU64Impl<_impl, KoAlphaDarkenParamsWrapperCreamy>(cs) {}
 };
 
+#ifdef HAVE_OPENEXR
+/**
+ * An optimized version of a composite op for the use in RGBA F16
+ * colorspaces. The pixels are converted into floats on the fly
+ * and processed exactly in the same way as in the F32 version.
+ */
+template<Vc::Implementation _impl, typename ParamsWrapper>
+class KoOptimizedCompositeOpAlphaDarkenF16Impl : public KoCompositeOp
+{
+public:
+    KoOptimizedCompositeOpAlphaDarkenF16Impl(const KoColorSpace* cs)
+        : KoCompositeOp(cs, COMPOSITE_ALPHA_DARKEN, KoCompositeOp::categoryMix()) {}
+
+    using KoCompositeOp::composite;
+
+    virtual void composite(const KoCompositeOp::ParameterInfo& params) const override
+    {
+        if(params.maskRowStart) {
+            KoStreamedMath<_impl>::template genericComposite64<true, true, AlphaDarkenCompositor128<half, ParamsWrapper> >(params);
+        } else {
+            KoStreamedMath<_impl>::template genericComposite64<false, true, AlphaDarkenCompositor128<half, ParamsWrapper> >(params);
+        }
+    }
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpAlphaDarkenHardF16
+    : public KoOptimizedCompositeOpAlphaDarkenF16Impl<_impl, KoAlphaDarkenParamsWrapperHard>
+{
+public:
+    KoOptimizedCompositeOpAlphaDarkenHardF16(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpAlphaDarkenF16Impl<_impl, KoAlphaDarkenParamsWrapperHard>(cs) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpAlphaDarkenCreamyF16
+    : public KoOptimizedCompositeOpAlphaDarkenF16Impl<_impl, KoAlphaDarkenParamsWrapperCreamy>
+{
+public:
+    KoOptimizedCompositeOpAlphaDarkenCreamyF16(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpAlphaDarkenF16Impl<_impl, KoAlphaDarkenParamsWrapperCreamy>(cs) {}
+};
+#endif /* HAVE_OPENEXR */
+
 
 #endif // KOOPTIMIZEDCOMPOSITEOPALPHADARKEN128_H
@@ -104,7 +104,7 @@ struct CopyCompositor128 {
                     dst_c2 /= newAlpha;
                     dst_c3 /= newAlpha;
 
-                    Vc::float_v unitValue(KoColorSpaceMathsTraits<channels_type>::unitValue);
+                    Vc::float_v unitValue(float(KoColorSpaceMathsTraits<channels_type>::unitValue));
 
                     dst_c1 = Vc::min(dst_c1, unitValue);
                     dst_c2 = Vc::min(dst_c2, unitValue);
@@ -238,9 +238,9 @@ struct CopyCompositor128 {
                     } else {
                         // Precondition: dstAlpha == 0 && !alphaLocked
                         const QBitArray &channelFlags = oparams.channelFlags;
-                        d[0] = channelFlags.at(0) ? dst_c1 : KoColorSpaceMathsTraits<channels_type>::zeroValue;
-                        d[1] = channelFlags.at(1) ? dst_c2 : KoColorSpaceMathsTraits<channels_type>::zeroValue;
-                        d[2] = channelFlags.at(2) ? dst_c3 : KoColorSpaceMathsTraits<channels_type>::zeroValue;
+                        d[0] = channelFlags.at(0) ? channels_type(dst_c1) : KoColorSpaceMathsTraits<channels_type>::zeroValue;
+                        d[1] = channelFlags.at(1) ? channels_type(dst_c2) : KoColorSpaceMathsTraits<channels_type>::zeroValue;
+                        d[2] = channelFlags.at(2) ? channels_type(dst_c3) : KoColorSpaceMathsTraits<channels_type>::zeroValue;
                     }
                 }
 
@@ -346,6 +346,56 @@ public:
     }
 };
 
+#ifdef HAVE_OPENEXR
+/**
+ * Same as KoOptimizedCompositeOpCopy128, but for 8 byte half
+ * float pixels: C1_C2_C3_A
+ */
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpCopyF16 : public KoCompositeOp
+{
+public:
+    KoOptimizedCompositeOpCopyF16(const KoColorSpace* cs)
+        : KoCompositeOp(cs, COMPOSITE_COPY, KoCompositeOp::categoryMix()) {}
+
+    using KoCompositeOp::composite;
+
+    virtual void composite(const KoCompositeOp::ParameterInfo& params) const
+    {
+        if(params.maskRowStart) {
+            composite<true>(params);
+        } else {
+            composite<false>(params);
+        }
+    }
+
+    template <bool haveMask>
+    inline void composite(const KoCompositeOp::ParameterInfo& params) const {
+        if (params.channelFlags.isEmpty() ||
+            params.channelFlags == QBitArray(4, true)) {
+
+            KoStreamedMath<_impl>::template genericComposite64<haveMask, false, CopyCompositor128<half, false, true> >(params);
+        } else {
+            const bool allChannelsFlag =
+                params.channelFlags.at(0) &&
+                params.channelFlags.at(1) &&
+                params.channelFlags.at(2);
+
+            const bool alphaLocked =
+                !params.channelFlags.at(3);
+
+            if (allChannelsFlag && alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite64_novector<haveMask, false, CopyCompositor128<half, true, true> >(params);
+            } else if (!allChannelsFlag && !alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite64_novector<haveMask, false, CopyCompositor128<half, false, false> >(params);
+            } else /*if (!allChannelsFlag && alphaLocked) */{
+                KoStreamedMath<_impl>::template genericComposite64_novector<haveMask, false, CopyCompositor128<half, true, false> >(params);
+            }
+        }
+    }
+};
+#endif /* HAVE_OPENEXR */
+
 
 template<Vc::Implementation _impl>
 class KoOptimizedCompositeOpCopy32 : public KoCompositeOp
@@ -7,6 +7,11 @@
 #include "KoOptimizedCompositeOpFactoryPerArch.h" // vc.h must come first
 #include "KoOptimizedCompositeOpFactory.h"
 
+#include <KoConfig.h>
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
+
 #if defined(__clang__)
 #pragma GCC diagnostic ignored "-Wundef"
 #endif
@@ -83,3 +88,113 @@ KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpU64(const KoColorSpace
 {
     return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyU64> >(cs);
 }
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOp32(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericSCFactoryPerArch<quint8> >({cs, id, category});
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOpU64(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericSCFactoryPerArch<quint16> >({cs, id, category});
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOp128(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericSCFactoryPerArch<float> >({cs, id, category});
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericHSLOp32(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint8> >({cs, id, category});
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericHSLOpU64(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint16> >({cs, id, category});
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericHSLOp128(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericHSLFactoryPerArch<float> >({cs, id, category});
+}
+
+#ifdef HAVE_OPENEXR
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createOverOpF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<
+        KoOptimizedCompositeOpFactoryPerArch<
+            KoOptimizedCompositeOpAlphaDarkenHardF16>>(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<
+        KoOptimizedCompositeOpFactoryPerArch<
+            KoOptimizedCompositeOpAlphaDarkenCreamyF16>>(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOpF16(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericSCFactoryPerArch<half> >({cs, id, category});
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericHSLOpF16(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericHSLFactoryPerArch<half> >({cs, id, category});
+}
+
+#else /* HAVE_OPENEXR */
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createOverOpF16(const KoColorSpace *cs)
+{
+    Q_UNUSED(cs);
+    return nullptr;
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpF16(const KoColorSpace *cs)
+{
+    Q_UNUSED(cs);
+    return nullptr;
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardF16(const KoColorSpace *cs)
+{
+    Q_UNUSED(cs);
+    return nullptr;
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(const KoColorSpace *cs)
+{
+    Q_UNUSED(cs);
+    return nullptr;
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOpF16(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    Q_UNUSED(cs);
+    Q_UNUSED(id);
+    Q_UNUSED(category);
+    return nullptr;
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericHSLOpF16(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    Q_UNUSED(cs);
+    Q_UNUSED(id);
+    Q_UNUSED(category);
+    return nullptr;
+}
+
+#endif /* HAVE_OPENEXR */
@@ -9,6 +9,7 @@
 
 #include "kritapigment_export.h"
 
+class QString;
 class KoCompositeOp;
 class KoColorSpace;
 
@@ -39,6 +40,36 @@ public:
     static KoCompositeOp* createCopyOp32(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpHardU64(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpCreamyU64(const KoColorSpace *cs);
+
+    /**
+     * The ops for RGBA F16 color spaces. When Krita is built without
+     * OpenEXR support, there are no F16 color spaces, so these functions
+     * return nullptr.
+     */
+    static KoCompositeOp* createOverOpF16(const KoColorSpace *cs);
+    static KoCompositeOp* createCopyOpF16(const KoColorSpace *cs);
+    static KoCompositeOp* createAlphaDarkenOpHardF16(const KoColorSpace *cs);
+    static KoCompositeOp* createAlphaDarkenOpCreamyF16(const KoColorSpace *cs);
+
+    /**
+     * Create an optimized version of a separable composite op \p id.
+     * Return nullptr if the op has no optimized version, in which case
+     * KoCompositeOpGenericSC should be used.
+     */
+    static KoCompositeOp* createGenericSCOp32(const KoColorSpace *cs, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericSCOpU64(const KoColorSpace *cs, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericSCOp128(const KoColorSpace *cs, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericSCOpF16(const KoColorSpace *cs, const QString &id, const QString &category);
+
+    /**
+     * Create an optimized version of a non-separable (HSX) composite op \p id.
+     * Return nullptr if the op has no optimized version, in which case
+     * KoCompositeOpGenericHSL should be used.
+     */
+    static KoCompositeOp* createGenericHSLOp32(const KoColorSpace *cs, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericHSLOpU64(const KoColorSpace *cs, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericHSLOp128(const KoColorSpace *cs, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericHSLOpF16(const KoColorSpace *cs, const QString &id, const QString &category);
 };
 
 #endif /* KOOPTIMIZEDCOMPOSITEOPFACTORY_H */
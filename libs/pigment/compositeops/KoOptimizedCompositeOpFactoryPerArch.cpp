@@ -14,11 +14,14 @@
 #include "KoOptimizedCompositeOpOver32.h"
 #include "KoOptimizedCompositeOpOver128.h"
 #include "KoOptimizedCompositeOpCopy128.h"
+#include "KoOptimizedCompositeOpGeneric.h"
+#include "KoOptimizedCompositeOpGenericHSL.h"
 
 #include <QString>
 #include "DebugPigment.h"
 
 #include <KoCompositeOpRegistry.h>
+#include <KoColorSpaceTraits.h>
 
 #if defined(__clang__)
 #pragma GCC diagnostic ignored "-Wlocal-type-template-args"
@@ -121,3 +124,103 @@ KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyU64>
 {
     return new KoOptimizedCompositeOpAlphaDarkenCreamyU64<Vc::CurrentImplementation::current()>(param);
 }
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint8>::ReturnType
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint8>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedCompositeOpGenericSC<Vc::CurrentImplementation::current(), quint8>(param.cs, param.id, param.category);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint16>::ReturnType
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedCompositeOpGenericSC<Vc::CurrentImplementation::current(), quint16>(param.cs, param.id, param.category);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericSCFactoryPerArch<float>::ReturnType
+KoOptimizedCompositeOpGenericSCFactoryPerArch<float>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedCompositeOpGenericSC<Vc::CurrentImplementation::current(), float>(param.cs, param.id, param.category);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint8>::ReturnType
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint8>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedCompositeOpGenericHSL<Vc::CurrentImplementation::current(), KoBgrU8Traits>(param.cs, param.id, param.category);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint16>::ReturnType
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedCompositeOpGenericHSL<Vc::CurrentImplementation::current(), KoBgrU16Traits>(param.cs, param.id, param.category);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<float>::ReturnType
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<float>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedCompositeOpGenericHSL<Vc::CurrentImplementation::current(), KoRgbF32Traits>(param.cs, param.id, param.category);
+}
+
+#ifdef HAVE_OPENEXR
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpOverF16<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpCopyF16<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpAlphaDarkenHardF16<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpAlphaDarkenCreamyF16<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericSCFactoryPerArch<half>::ReturnType
+KoOptimizedCompositeOpGenericSCFactoryPerArch<half>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedCompositeOpGenericSC<Vc::CurrentImplementation::current(), half>(param.cs, param.id, param.category);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<half>::ReturnType
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<half>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedCompositeOpGenericHSL<Vc::CurrentImplementation::current(), KoRgbF16Traits>(param.cs, param.id, param.category);
+}
+
+#endif /* HAVE_OPENEXR */
@@ -51,6 +51,18 @@ class KoOptimizedCompositeOpCopyU64;
 template<Vc::Implementation _impl>
 class KoOptimizedCompositeOpCopy32;
 
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpOverF16;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpCopyF16;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpAlphaDarkenHardF16;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpAlphaDarkenCreamyF16;
+
 template<template<Vc::Implementation I> class CompositeOp>
 struct KoOptimizedCompositeOpFactoryPerArch
 {
@@ -61,5 +73,45 @@ struct KoOptimizedCompositeOpFactoryPerArch
     static ReturnType create(ParamType param);
 };
 
+/**
+ * A factory for the optimized versions of the separable composite
+ * ops (KoCompositeOpGenericSC). The id of the op is passed at runtime
+ * and create() returns nullptr if there is no optimized version of
+ * the requested op, so the caller should fall back to the generic one.
+ *
+ * \p channels_type defines the type of the channels of a C1_C2_C3_A
+ * pixel: quint8, quint16, half or float
+ */
+template<typename channels_type>
+struct KoOptimizedCompositeOpGenericSCFactoryPerArch
+{
+    struct ParamType {
+        const KoColorSpace *cs;
+        QString id;
+        QString category;
+    };
+
+    typedef KoCompositeOp* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static ReturnType create(ParamType param);
+};
+
+
+/**
+ * Same as KoOptimizedCompositeOpGenericSCFactoryPerArch, but for
+ * the non-separable composite ops (KoCompositeOpGenericHSL). The
+ * 8- and 16-bit pixels are expected to have BGR layout, the floating
+ * point ones --- RGB layout.
+ */
+template<typename channels_type>
+struct KoOptimizedCompositeOpGenericHSLFactoryPerArch
+{
+    typedef typename KoOptimizedCompositeOpGenericSCFactoryPerArch<channels_type>::ParamType ParamType;
+    typedef KoCompositeOp* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static ReturnType create(ParamType param);
+};
 
 #endif /* KOOPTIMIZEDCOMPOSITEOPFACTORYPERARCH_H */
@@ -109,3 +109,118 @@ KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyU64>
     return new KoCompositeOpAlphaDarken<KoBgrU16Traits, KoAlphaDarkenParamsWrapperCreamy>(param);
 }
 
+template<>
+template<>
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint8>::ReturnType
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint8>::create<Vc::ScalarImpl>(ParamType param)
+{
+    // the scalar version is provided by KoCompositeOpGenericSC itself
+    Q_UNUSED(param);
+    return nullptr;
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint16>::ReturnType
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    // the scalar version is provided by KoCompositeOpGenericSC itself
+    Q_UNUSED(param);
+    return nullptr;
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericSCFactoryPerArch<float>::ReturnType
+KoOptimizedCompositeOpGenericSCFactoryPerArch<float>::create<Vc::ScalarImpl>(ParamType param)
+{
+    // the scalar version is provided by KoCompositeOpGenericSC itself
+    Q_UNUSED(param);
+    return nullptr;
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint8>::ReturnType
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint8>::create<Vc::ScalarImpl>(ParamType param)
+{
+    // the scalar version is provided by KoCompositeOpGenericHSL itself
+    Q_UNUSED(param);
+    return nullptr;
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint16>::ReturnType
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    // the scalar version is provided by KoCompositeOpGenericHSL itself
+    Q_UNUSED(param);
+    return nullptr;
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<float>::ReturnType
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<float>::create<Vc::ScalarImpl>(ParamType param)
+{
+    // the scalar version is provided by KoCompositeOpGenericHSL itself
+    Q_UNUSED(param);
+    return nullptr;
+}
+
+#ifdef HAVE_OPENEXR
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpOver<KoRgbF16Traits>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpCopy2<KoRgbF16Traits>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperHard>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperCreamy>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericSCFactoryPerArch<half>::ReturnType
+KoOptimizedCompositeOpGenericSCFactoryPerArch<half>::create<Vc::ScalarImpl>(ParamType param)
+{
+    // the scalar version is provided by KoCompositeOpGenericSC itself
+    Q_UNUSED(param);
+    return nullptr;
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<half>::ReturnType
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<half>::create<Vc::ScalarImpl>(ParamType param)
+{
+    // the scalar version is provided by KoCompositeOpGenericHSL itself
+    Q_UNUSED(param);
+    return nullptr;
+}
+
+#endif /* HAVE_OPENEXR */
@@ -0,0 +1,704 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERIC_H
+#define KOOPTIMIZEDCOMPOSITEOPGENERIC_H
+
+#include <limits>
+
+#include "KoCompositeOpBase.h"
+#include "KoCompositeOpRegistry.h"
+#include "KoStreamedMath.h"
+
+/**
+ * Vectorized versions of the separable blending functions defined in
+ * KoCompositeOpFunctions.h. All the functions operate on the channel values
+ * normalized into 0.0...1.0 range (floating point channels are passed as
+ * is) and follow the behavior of their scalar counterparts, including
+ * the handling of the division-by-zero cases and clamping of the result
+ * for integer color spaces.
+ */
+namespace KoStreamedBlendFunctions {
+
+template<typename channels_type, Vc::Implementation _impl>
+struct ChannelTraits
+{
+    ALWAYS_INLINE static float unitValue() {
+        return float(KoColorSpaceMathsTraits<channels_type>::unitValue);
+    }
+
+    ALWAYS_INLINE static Vc::float_v halfValue() {
+        return Vc::float_v(float(KoColorSpaceMathsTraits<channels_type>::halfValue) /
+                           float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+    }
+
+    ALWAYS_INLINE static Vc::float_v maxValue() {
+        return Vc::float_v::One();
+    }
+
+    ALWAYS_INLINE static Vc::float_v clamp(Vc::float_v::AsArg x) {
+        return Vc::min(Vc::max(x, Vc::float_v::Zero()), Vc::float_v::One());
+    }
+
+    ALWAYS_INLINE static Vc::float_m isUnsafeAsDivisor(Vc::float_v::AsArg x) {
+        return x == Vc::float_v::Zero();
+    }
+
+    ALWAYS_INLINE static Vc::float_v fixInfinite(Vc::float_v::AsArg x) {
+        return x;
+    }
+};
+
+template<Vc::Implementation _impl>
+struct ChannelTraits<float, _impl>
+{
+    ALWAYS_INLINE static float unitValue() {
+        return 1.0f;
+    }
+
+    ALWAYS_INLINE static Vc::float_v halfValue() {
+        return Vc::float_v(0.5f);
+    }
+
+    ALWAYS_INLINE static Vc::float_v maxValue() {
+        return Vc::float_v(std::numeric_limits<float>::max());
+    }
+
+    ALWAYS_INLINE static Vc::float_v clamp(Vc::float_v::AsArg x) {
+        return x;
+    }
+
+    ALWAYS_INLINE static Vc::float_m isUnsafeAsDivisor(Vc::float_v::AsArg x) {
+        return x < Vc::float_v(1e-6f);
+    }
+
+    ALWAYS_INLINE static Vc::float_v fixInfinite(Vc::float_v::AsArg x) {
+        return Vc::iif(Vc::isfinite(x), x, maxValue());
+    }
+};
+
+#ifdef HAVE_OPENEXR
+/**
+ * Half channels are processed in floats, the only difference
+ * is the maximum value, which is much lower for half
+ */
+template<Vc::Implementation _impl>
+struct ChannelTraits<half, _impl> : public ChannelTraits<float, _impl>
+{
+    ALWAYS_INLINE static Vc::float_v maxValue() {
+        return Vc::float_v(float(KoColorSpaceMathsTraits<half>::max));
+    }
+
+    ALWAYS_INLINE static Vc::float_v fixInfinite(Vc::float_v::AsArg x) {
+        return Vc::iif(Vc::isfinite(x), x, maxValue());
+    }
+};
+#endif
+
+struct Multiply {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return src * dst;
+    }
+};
+
+struct Screen {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return src + dst - src * dst;
+    }
+};
+
+struct DarkenOnly {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return Vc::min(src, dst);
+    }
+};
+
+struct LightenOnly {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return Vc::max(src, dst);
+    }
+};
+
+struct Difference {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return Vc::max(src, dst) - Vc::min(src, dst);
+    }
+};
+
+struct Addition {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return ChannelTraits<channels_type, _impl>::clamp(src + dst);
+    }
+};
+
+struct Subtract {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return ChannelTraits<channels_type, _impl>::clamp(dst - src);
+    }
+};
+
+struct InverseSubtract {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return ChannelTraits<channels_type, _impl>::clamp(dst - (Vc::float_v::One() - src));
+    }
+};
+
+struct Exclusion {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        const Vc::float_v x = src * dst;
+        return ChannelTraits<channels_type, _impl>::clamp(dst + src - (x + x));
+    }
+};
+
+struct Divide {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        using Traits = ChannelTraits<channels_type, _impl>;
+
+        const Vc::float_v zeroValue = Vc::float_v::Zero();
+        const Vc::float_v unsafeResult = Vc::iif(dst == zeroValue, zeroValue, Vc::float_v::One());
+        return Vc::iif(Traits::isUnsafeAsDivisor(src), unsafeResult, Traits::clamp(dst / src));
+    }
+};
+
+struct LinearBurn {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return ChannelTraits<channels_type, _impl>::clamp(src + dst - Vc::float_v::One());
+    }
+};
+
+struct LinearLight {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return ChannelTraits<channels_type, _impl>::clamp(src + src + dst - Vc::float_v::One());
+    }
+};
+
+struct GrainMerge {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        using Traits = ChannelTraits<channels_type, _impl>;
+        return Traits::clamp(dst + src - Traits::halfValue());
+    }
+};
+
+struct GrainExtract {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        using Traits = ChannelTraits<channels_type, _impl>;
+        return Traits::clamp(dst - src + Traits::halfValue());
+    }
+};
+
+struct Allanon {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return (src + dst) * ChannelTraits<channels_type, _impl>::halfValue();
+    }
+};
+
+struct GeometricMean {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return ChannelTraits<channels_type, _impl>::clamp(Vc::sqrt(src * dst));
+    }
+};
+
+struct HardLight {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        const Vc::float_v src2 = src + src;
+        const Vc::float_v screenSrc = src2 - Vc::float_v::One();
+
+        return Vc::iif(src > ChannelTraits<channels_type, _impl>::halfValue(),
+                       screenSrc + dst - screenSrc * dst,
+                       src2 * dst);
+    }
+};
+
+struct Overlay {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return HardLight::blend<channels_type, _impl>(dst, src);
+    }
+};
+
+struct PinLight {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        const Vc::float_v src2 = src + src;
+        return Vc::max(src2 - Vc::float_v::One(), Vc::min(dst, src2));
+    }
+};
+
+struct SoftLight {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        const Vc::float_v oneValue = Vc::float_v::One();
+        const Vc::float_v src2 = src + src;
+
+        const Vc::float_v lightResult = dst + (src2 - oneValue) * (Vc::sqrt(dst) - dst);
+        const Vc::float_v darkResult = dst - (oneValue - src2) * dst * (oneValue - dst);
+
+        return ChannelTraits<channels_type, _impl>::clamp(
+            Vc::iif(src > Vc::float_v(0.5f), lightResult, darkResult));
+    }
+};
+
+struct SoftLightSvg {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        const Vc::float_v oneValue = Vc::float_v::One();
+        const Vc::float_v src2 = src + src;
+
+        const Vc::float_v D =
+            Vc::iif(dst > Vc::float_v(0.25f),
+                    Vc::sqrt(dst),
+                    ((Vc::float_v(16.0f) * dst - Vc::float_v(12.0f)) * dst + Vc::float_v(4.0f)) * dst);
+
+        const Vc::float_v lightResult = dst + (src2 - oneValue) * (D - dst);
+        const Vc::float_v darkResult = dst - (oneValue - src2) * dst * (oneValue - dst);
+
+        return ChannelTraits<channels_type, _impl>::clamp(
+            Vc::iif(src > Vc::float_v(0.5f), lightResult, darkResult));
+    }
+};
+
+struct ColorDodge {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        using Traits = ChannelTraits<channels_type, _impl>;
+
+        const Vc::float_v zeroValue = Vc::float_v::Zero();
+        const Vc::float_v oneValue = Vc::float_v::One();
+
+        // see the comment in colorDodgeHelper() about the zero denominator
+        const Vc::float_v unitSrcResult = Vc::iif(dst == zeroValue, zeroValue, Traits::maxValue());
+        const Vc::float_v result = Traits::clamp(dst / (oneValue - src));
+
+        return Traits::fixInfinite(Vc::iif(src == oneValue, unitSrcResult, result));
+    }
+};
+
+struct ColorBurn {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        using Traits = ChannelTraits<channels_type, _impl>;
+
+        const Vc::float_v zeroValue = Vc::float_v::Zero();
+        const Vc::float_v oneValue = Vc::float_v::One();
+
+        // see the comment in colorBurnHelper() about the zero denominator
+        const Vc::float_v zeroSrcResult = Vc::iif(dst == oneValue, zeroValue, Traits::maxValue());
+        const Vc::float_v result = Traits::clamp((oneValue - dst) / src);
+
+        return oneValue - Traits::fixInfinite(Vc::iif(src == zeroValue, zeroSrcResult, result));
+    }
+};
+
+struct VividLight {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        using Traits = ChannelTraits<channels_type, _impl>;
+
+        const Vc::float_v zeroValue = Vc::float_v::Zero();
+        const Vc::float_v oneValue = Vc::float_v::One();
+        const Vc::float_v src2 = src + src;
+
+        // min(1,max(0,1-(1-dst) / (2*src)))
+        const Vc::float_v burnResult =
+            Vc::iif(Traits::isUnsafeAsDivisor(src),
+                    Vc::iif(dst == oneValue, oneValue, zeroValue),
+                    Traits::clamp(oneValue - (oneValue - dst) / src2));
+
+        // min(1,max(0, dst / (2*(1-src)))
+        const Vc::float_v srci2 = (oneValue - src) + (oneValue - src);
+        const Vc::float_v dodgeResult =
+            Vc::iif(src == oneValue,
+                    Vc::iif(dst == zeroValue, zeroValue, oneValue),
+                    Traits::clamp(dst / srci2));
+
+        return Vc::iif(src < Traits::halfValue(), burnResult, dodgeResult);
+    }
+};
+
+struct HardMixPhotoshop {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        using Traits = ChannelTraits<channels_type, _impl>;
+
+        // the scalar version compares the sum of the integer channels with
+        // the unit value exactly, the sum of the normalized ones may exceed
+        // 1.0 by a rounding error when they are equal
+        const Vc::float_v threshold(std::numeric_limits<channels_type>::is_integer ?
+                                    1.0f + 0.5f / Traits::unitValue() : 1.0f);
+
+        return Vc::iif(src + dst > threshold, Vc::float_v::One(), Vc::float_v::Zero());
+    }
+};
+
+struct HardMixSofterPhotoshop {
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v blend(Vc::float_v::AsArg src, Vc::float_v::AsArg dst) {
+        return ChannelTraits<channels_type, _impl>::clamp(
+            Vc::float_v(3.0f) * dst - Vc::float_v(2.0f) * (Vc::float_v::One() - src));
+    }
+};
+
+}
+
+/**
+ * Applies a separable blending function to every color channel
+ * of the pixel independently
+ */
+template<class BlendFunction>
+struct SeparableBlender {
+    static const bool needsExactNormalization = false;
+
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg src_c0, Vc::float_v::AsArg src_c1, Vc::float_v::AsArg src_c2,
+                                    Vc::float_v::AsArg dst_c0, Vc::float_v::AsArg dst_c1, Vc::float_v::AsArg dst_c2,
+                                    Vc::float_v &result_c0, Vc::float_v &result_c1, Vc::float_v &result_c2)
+    {
+        result_c0 = BlendFunction::template blend<channels_type, _impl>(src_c0, dst_c0);
+        result_c1 = BlendFunction::template blend<channels_type, _impl>(src_c1, dst_c1);
+        result_c2 = BlendFunction::template blend<channels_type, _impl>(src_c2, dst_c2);
+    }
+};
+
+/**
+ * A compositor for KoStreamedMath that implements the blending
+ * formula of KoCompositeOpGenericSC and KoCompositeOpGenericHSL:
+ *
+ *     newAlpha = srcAlpha + dstAlpha - srcAlpha * dstAlpha
+ *     dst = (dst * dstAlpha * (1 - srcAlpha) +
+ *            src * srcAlpha * (1 - dstAlpha) +
+ *            f(src, dst) * srcAlpha * dstAlpha) / newAlpha
+ *
+ * The blending function f() is provided by \p PixelBlender, which
+ * receives the color channels in the order they are stored in
+ * memory. The pixels are expected to have C1_C2_C3_A layout.
+ *
+ * If PixelBlender::needsExactNormalization is true, the channels are
+ * normalized with a division, like KoLuts do for the scalar ops, since
+ * a multiplication by the reciprocal of the unit value may be one ulp
+ * off, which the non-separable functions amplify.
+ */
+template<typename channels_type, class PixelBlender, bool alphaLocked, bool allChannelsFlag>
+struct GenericBlendCompositor128 {
+    struct ParamsWrapper {
+        ParamsWrapper(const KoCompositeOp::ParameterInfo& params)
+            : channelFlags(params.channelFlags)
+        {
+        }
+        const QBitArray &channelFlags;
+    };
+
+    template<bool haveMask, bool src_aligned, Vc::Implementation _impl>
+    static ALWAYS_INLINE void compositeVector(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        Q_UNUSED(oparams);
+
+        using Traits = KoStreamedBlendFunctions::ChannelTraits<channels_type, _impl>;
+
+        Vc::float_v src_alpha;
+        Vc::float_v src_c1;
+        Vc::float_v src_c2;
+        Vc::float_v src_c3;
+
+        PixelWrapper<channels_type, _impl> dataWrapper;
+        dataWrapper.read(const_cast<quint8*>(src), src_c1, src_c2, src_c3, src_alpha);
+
+        src_alpha *= Vc::float_v(opacity);
+
+        if (haveMask) {
+            const Vc::float_v uint8MaxRec1(1.0f / 255.0f);
+            Vc::float_v mask_vec = KoStreamedMath<_impl>::fetch_mask_8(mask);
+            src_alpha *= mask_vec * uint8MaxRec1;
+        }
+
+        const Vc::float_v zeroValue(0.0f);
+        // The source cannot change the colors in the destination,
+        // since its fully transparent
+        if ((src_alpha == zeroValue).isFull()) {
+            return;
+        }
+
+        Vc::float_v dst_alpha;
+        Vc::float_v dst_c1;
+        Vc::float_v dst_c2;
+        Vc::float_v dst_c3;
+
+        dataWrapper.read(dst, dst_c1, dst_c2, dst_c3, dst_alpha);
+
+        const Vc::float_v oneValue(1.0f);
+        const Vc::float_v unitValue(Traits::unitValue());
+        const Vc::float_v unitValueRec1(1.0f / Traits::unitValue());
+
+        if (PixelBlender::needsExactNormalization) {
+            src_c1 /= unitValue;
+            src_c2 /= unitValue;
+            src_c3 /= unitValue;
+            dst_c1 /= unitValue;
+            dst_c2 /= unitValue;
+            dst_c3 /= unitValue;
+        } else {
+            src_c1 *= unitValueRec1;
+            src_c2 *= unitValueRec1;
+            src_c3 *= unitValueRec1;
+            dst_c1 *= unitValueRec1;
+            dst_c2 *= unitValueRec1;
+            dst_c3 *= unitValueRec1;
+        }
+
+        Vc::float_v result_c1;
+        Vc::float_v result_c2;
+        Vc::float_v result_c3;
+
+        if (std::is_same<channels_type, quint8>::value) {
+            // 8-bit pixel wrapper returns the channels in reversed order
+            PixelBlender::template blend<channels_type, _impl>(src_c3, src_c2, src_c1,
+                                                               dst_c3, dst_c2, dst_c1,
+                                                               result_c3, result_c2, result_c1);
+        } else {
+            PixelBlender::template blend<channels_type, _impl>(src_c1, src_c2, src_c3,
+                                                               dst_c1, dst_c2, dst_c3,
+                                                               result_c1, result_c2, result_c3);
+        }
+
+        const Vc::float_v srcOnlyAlpha = src_alpha * (oneValue - dst_alpha);
+        const Vc::float_v dstOnlyAlpha = dst_alpha * (oneValue - src_alpha);
+        const Vc::float_v bothAlpha = src_alpha * dst_alpha;
+
+        /**
+         * The value of new_alpha can have *some* zero values,
+         * which will result in NaN values while division.
+         */
+        Vc::float_v new_alpha = src_alpha + dst_alpha - bothAlpha;
+        Vc::float_v new_alpha_rec = unitValue / new_alpha;
+        new_alpha_rec.setZero(new_alpha == zeroValue);
+
+        dst_c1 = (dstOnlyAlpha * dst_c1 + srcOnlyAlpha * src_c1 + bothAlpha * result_c1) * new_alpha_rec;
+        dst_c2 = (dstOnlyAlpha * dst_c2 + srcOnlyAlpha * src_c2 + bothAlpha * result_c2) * new_alpha_rec;
+        dst_c3 = (dstOnlyAlpha * dst_c3 + srcOnlyAlpha * src_c3 + bothAlpha * result_c3) * new_alpha_rec;
+
+        if (std::numeric_limits<channels_type>::is_integer) {
+            // packing of the integer channels doesn't saturate
+            dst_c1 = Vc::min(Vc::max(dst_c1, zeroValue), unitValue);
+            dst_c2 = Vc::min(Vc::max(dst_c2, zeroValue), unitValue);
+            dst_c3 = Vc::min(Vc::max(dst_c3, zeroValue), unitValue);
+        }
+
+        dataWrapper.write(dst, dst_c1, dst_c2, dst_c3, new_alpha);
+    }
+
+    template <bool haveMask, Vc::Implementation _impl>
+    static ALWAYS_INLINE void compositeOnePixelScalar(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        using Traits = KoStreamedBlendFunctions::ChannelTraits<channels_type, _impl>;
+        const qint32 alpha_pos = 3;
+
+        const channels_type *s = reinterpret_cast<const channels_type*>(src);
+        channels_type *d = reinterpret_cast<channels_type*>(dst);
+
+        // the channels disabled by the flags should not keep the color
+        // of a transparent pixel, like in KoCompositeOpBase
+        if (!allChannelsFlag && d[alpha_pos] == KoColorSpaceMathsTraits<channels_type>::zeroValue) {
+            memset(dst, 0, 4 * sizeof(channels_type));
+        }
+
+        float srcAlpha = s[alpha_pos];
+        PixelWrapper<channels_type, _impl>::normalizeAlpha(srcAlpha);
+        srcAlpha *= opacity;
+
+        if (haveMask) {
+            const float uint8Rec1 = 1.0f / 255.0f;
+            srcAlpha *= float(*mask) * uint8Rec1;
+        }
+
+        if (srcAlpha == 0.0f) return;
+
+        float dstAlpha = d[alpha_pos];
+        PixelWrapper<channels_type, _impl>::normalizeAlpha(dstAlpha);
+
+        if (alphaLocked && dstAlpha == 0.0f) return;
+
+        const float unitValue = Traits::unitValue();
+        const float unitValueRec1 = 1.0f / unitValue;
+
+        float src_c[3];
+        float dst_c[3];
+
+        for (int i = 0; i < 3; i++) {
+            if (PixelBlender::needsExactNormalization) {
+                src_c[i] = float(s[i]) / unitValue;
+                dst_c[i] = float(d[i]) / unitValue;
+            } else {
+                src_c[i] = float(s[i]) * unitValueRec1;
+                dst_c[i] = float(d[i]) * unitValueRec1;
+            }
+        }
+
+        /**
+         * The blending function is shared with the vectorized
+         * code path, so the pixel is processed in the first
+         * lane of the vectors
+         */
+        Vc::float_v result[3];
+        PixelBlender::template blend<channels_type, _impl>(Vc::float_v(src_c[0]), Vc::float_v(src_c[1]), Vc::float_v(src_c[2]),
+                                                           Vc::float_v(dst_c[0]), Vc::float_v(dst_c[1]), Vc::float_v(dst_c[2]),
+                                                           result[0], result[1], result[2]);
+
+        const QBitArray &channelFlags = oparams.channelFlags;
+
+        if (alphaLocked) {
+            for (int i = 0; i < 3; i++) {
+                if (allChannelsFlag || channelFlags.testBit(i)) {
+                    const float value = dst_c[i] + srcAlpha * (result[i][0] - dst_c[i]);
+                    d[i] = channelFromNormalized<_impl>(value, unitValue);
+                }
+            }
+        } else {
+            const float newAlpha = srcAlpha + dstAlpha - srcAlpha * dstAlpha;
+
+            if (newAlpha != 0.0f) {
+                const float srcOnlyAlpha = srcAlpha * (1.0f - dstAlpha);
+                const float dstOnlyAlpha = dstAlpha * (1.0f - srcAlpha);
+                const float bothAlpha = srcAlpha * dstAlpha;
+
+                for (int i = 0; i < 3; i++) {
+                    if (allChannelsFlag || channelFlags.testBit(i)) {
+                        const float value =
+                            (dstOnlyAlpha * dst_c[i] + srcOnlyAlpha * src_c[i] + bothAlpha * result[i][0]) / newAlpha;
+                        d[i] = channelFromNormalized<_impl>(value, unitValue);
+                    }
+                }
+            }
+
+            d[alpha_pos] = PixelWrapper<channels_type, _impl>::roundFloatToUint(newAlpha * unitValue);
+        }
+    }
+
+private:
+    template <Vc::Implementation _impl>
+    static ALWAYS_INLINE channels_type channelFromNormalized(float value, float unitValue) {
+        if (std::numeric_limits<channels_type>::is_integer) {
+            value = qBound(0.0f, value, 1.0f);
+        }
+        return PixelWrapper<channels_type, _impl>::roundFloatToUint(value * unitValue);
+    }
+};
+
+/**
+ * An optimized version of KoCompositeOpGenericSC and KoCompositeOpGenericHSL
+ * for the use in 4-channel colorspaces with alpha channel placed at the last
+ * position of the pixel: C1_C2_C3_A. The size of the pixel is defined by
+ * \p channels_type, that is quint8, quint16, half and float are supported.
+ */
+template<Vc::Implementation _impl, typename channels_type, class PixelBlender>
+class KoOptimizedCompositeOpGenericBlend : public KoCompositeOp
+{
+    static const int pixelSize = 4 * sizeof(channels_type);
+
+public:
+    KoOptimizedCompositeOpGenericBlend(const KoColorSpace* cs, const QString& id, const QString& category)
+        : KoCompositeOp(cs, id, category) {}
+
+    using KoCompositeOp::composite;
+
+    void composite(const KoCompositeOp::ParameterInfo& params) const override
+    {
+        if(params.maskRowStart) {
+            composite<true>(params);
+        } else {
+            composite<false>(params);
+        }
+    }
+
+    template <bool haveMask>
+    inline void composite(const KoCompositeOp::ParameterInfo& params) const {
+        if (params.channelFlags.isEmpty() ||
+            params.channelFlags == QBitArray(4, true)) {
+
+            KoStreamedMath<_impl>::template genericComposite<haveMask, false, GenericBlendCompositor128<channels_type, PixelBlender, false, true>, pixelSize>(params);
+        } else {
+            const bool allChannelsFlag =
+                params.channelFlags.at(0) &&
+                params.channelFlags.at(1) &&
+                params.channelFlags.at(2);
+
+            const bool alphaLocked =
+                !params.channelFlags.at(3);
+
+            if (allChannelsFlag && alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericBlendCompositor128<channels_type, PixelBlender, true, true>, pixelSize>(params);
+            } else if (!allChannelsFlag && !alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericBlendCompositor128<channels_type, PixelBlender, false, false>, pixelSize>(params);
+            } else /*if (!allChannelsFlag && alphaLocked) */{
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericBlendCompositor128<channels_type, PixelBlender, true, false>, pixelSize>(params);
+            }
+        }
+    }
+};
+
+/**
+ * Creates an optimized version of the separable composite op \p id, or
+ * returns nullptr if the blending function of the op is not vectorized yet
+ */
+template<Vc::Implementation _impl, typename channels_type>
+KoCompositeOp* createOptimizedCompositeOpGenericSC(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    using namespace KoStreamedBlendFunctions;
+
+#define CREATE_GENERIC_SC_OP(opId, blendFunction)                                                        \
+    if (id == opId) {                                                                                    \
+        return new KoOptimizedCompositeOpGenericBlend<_impl, channels_type, SeparableBlender<blendFunction>>(cs, id, category); \
+    }
+
+    CREATE_GENERIC_SC_OP(COMPOSITE_MULT, Multiply)
+    CREATE_GENERIC_SC_OP(COMPOSITE_SCREEN, Screen)
+    CREATE_GENERIC_SC_OP(COMPOSITE_OVERLAY, Overlay)
+    CREATE_GENERIC_SC_OP(COMPOSITE_HARD_LIGHT, HardLight)
+    CREATE_GENERIC_SC_OP(COMPOSITE_SOFT_LIGHT_PHOTOSHOP, SoftLight)
+    CREATE_GENERIC_SC_OP(COMPOSITE_SOFT_LIGHT_SVG, SoftLightSvg)
+    CREATE_GENERIC_SC_OP(COMPOSITE_DODGE, ColorDodge)
+    CREATE_GENERIC_SC_OP(COMPOSITE_BURN, ColorBurn)
+    CREATE_GENERIC_SC_OP(COMPOSITE_LINEAR_DODGE, Addition)
+    CREATE_GENERIC_SC_OP(COMPOSITE_ADD, Addition)
+    CREATE_GENERIC_SC_OP(COMPOSITE_LINEAR_BURN, LinearBurn)
+    CREATE_GENERIC_SC_OP(COMPOSITE_LINEAR_LIGHT, LinearLight)
+    CREATE_GENERIC_SC_OP(COMPOSITE_VIVID_LIGHT, VividLight)
+    CREATE_GENERIC_SC_OP(COMPOSITE_PIN_LIGHT, PinLight)
+    CREATE_GENERIC_SC_OP(COMPOSITE_DARKEN, DarkenOnly)
+    CREATE_GENERIC_SC_OP(COMPOSITE_LIGHTEN, LightenOnly)
+    CREATE_GENERIC_SC_OP(COMPOSITE_DIFF, Difference)
+    CREATE_GENERIC_SC_OP(COMPOSITE_EXCLUSION, Exclusion)
+    CREATE_GENERIC_SC_OP(COMPOSITE_SUBTRACT, Subtract)
+    CREATE_GENERIC_SC_OP(COMPOSITE_INVERSE_SUBTRACT, InverseSubtract)
+    CREATE_GENERIC_SC_OP(COMPOSITE_DIVIDE, Divide)
+    CREATE_GENERIC_SC_OP(COMPOSITE_GRAIN_MERGE, GrainMerge)
+    CREATE_GENERIC_SC_OP(COMPOSITE_GRAIN_EXTRACT, GrainExtract)
+    CREATE_GENERIC_SC_OP(COMPOSITE_ALLANON, Allanon)
+    CREATE_GENERIC_SC_OP(COMPOSITE_GEOMETRIC_MEAN, GeometricMean)
+    CREATE_GENERIC_SC_OP(COMPOSITE_HARD_MIX_PHOTOSHOP, HardMixPhotoshop)
+    CREATE_GENERIC_SC_OP(COMPOSITE_HARD_MIX_SOFTER_PHOTOSHOP, HardMixSofterPhotoshop)
+
+#undef CREATE_GENERIC_SC_OP
+
+    return nullptr;
+}
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERIC_H
@@ -0,0 +1,383 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERICHSL_H
+#define KOOPTIMIZEDCOMPOSITEOPGENERICHSL_H
+
+#include "KoOptimizedCompositeOpGeneric.h"
+
+/**
+ * Vectorized versions of the non-separable (HSX) blending functions
+ * defined in KoCompositeOpFunctions.h. The functions receive normalized
+ * RGB values and follow the scalar implementation of getLightness(),
+ * getSaturation(), addLightness() and setSaturation() from
+ * KoColorSpaceMaths.h lane-by-lane.
+ */
+namespace KoStreamedBlendFunctions {
+
+template<Vc::Implementation _impl>
+ALWAYS_INLINE Vc::float_v min3(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+    return Vc::min(Vc::min(r, g), b);
+}
+
+template<Vc::Implementation _impl>
+ALWAYS_INLINE Vc::float_v max3(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+    return Vc::max(Vc::max(r, g), b);
+}
+
+template<class HSXType>
+struct HSXTraits;
+
+template<>
+struct HSXTraits<HSYType>
+{
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v getLightness(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+        return Vc::float_v(0.299f) * r + Vc::float_v(0.587f) * g + Vc::float_v(0.114f) * b;
+    }
+
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v getSaturation(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+        return max3<_impl>(r, g, b) - min3<_impl>(r, g, b);
+    }
+};
+
+template<>
+struct HSXTraits<HSIType>
+{
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v getLightness(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+        return (r + g + b) * Vc::float_v(0.33333333333333333333f);
+    }
+
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v getSaturation(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+        const Vc::float_v max = max3<_impl>(r, g, b);
+        const Vc::float_v min = min3<_impl>(r, g, b);
+        const Vc::float_v chroma = max - min;
+
+        return Vc::iif(chroma > Vc::float_v(std::numeric_limits<float>::epsilon()),
+                       Vc::float_v::One() - min / getLightness<_impl>(r, g, b),
+                       Vc::float_v::Zero());
+    }
+};
+
+template<>
+struct HSXTraits<HSLType>
+{
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v getLightness(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+        return (max3<_impl>(r, g, b) + min3<_impl>(r, g, b)) * Vc::float_v(0.5f);
+    }
+
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v getSaturation(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+        const Vc::float_v max = max3<_impl>(r, g, b);
+        const Vc::float_v min = min3<_impl>(r, g, b);
+        const Vc::float_v chroma = max - min;
+        const Vc::float_v light = (max + min) * Vc::float_v(0.5f);
+        const Vc::float_v div = Vc::float_v::One() - Vc::abs(Vc::float_v(2.0f) * light - Vc::float_v::One());
+
+        return Vc::iif(div > Vc::float_v(std::numeric_limits<float>::epsilon()),
+                       chroma / div,
+                       Vc::float_v::One());
+    }
+};
+
+template<>
+struct HSXTraits<HSVType>
+{
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v getLightness(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+        return max3<_impl>(r, g, b);
+    }
+
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE Vc::float_v getSaturation(Vc::float_v::AsArg r, Vc::float_v::AsArg g, Vc::float_v::AsArg b) {
+        const Vc::float_v max = max3<_impl>(r, g, b);
+        const Vc::float_v min = min3<_impl>(r, g, b);
+
+        return Vc::iif(max == Vc::float_v::Zero(), Vc::float_v::Zero(), (max - min) / max);
+    }
+};
+
+template<class HSXType, Vc::Implementation _impl>
+ALWAYS_INLINE void addLightness(Vc::float_v &r, Vc::float_v &g, Vc::float_v &b, Vc::float_v::AsArg light)
+{
+    const Vc::float_v zeroValue = Vc::float_v::Zero();
+    const Vc::float_v oneValue = Vc::float_v::One();
+
+    r += light;
+    g += light;
+    b += light;
+
+    const Vc::float_v l = HSXTraits<HSXType>::template getLightness<_impl>(r, g, b);
+    const Vc::float_v n = min3<_impl>(r, g, b);
+    const Vc::float_v x = max3<_impl>(r, g, b);
+
+    const Vc::float_m underflow = n < zeroValue;
+
+    if (!underflow.isEmpty()) {
+        const Vc::float_v iln = oneValue / (l - n);
+        r = Vc::iif(underflow, l + ((r - l) * l) * iln, r);
+        g = Vc::iif(underflow, l + ((g - l) * l) * iln, g);
+        b = Vc::iif(underflow, l + ((b - l) * l) * iln, b);
+    }
+
+    const Vc::float_m overflow =
+        x > oneValue && (x - l) > Vc::float_v(std::numeric_limits<float>::epsilon());
+
+    if (!overflow.isEmpty()) {
+        const Vc::float_v il = oneValue - l;
+        const Vc::float_v ixl = oneValue / (x - l);
+        r = Vc::iif(overflow, l + ((r - l) * il) * ixl, r);
+        g = Vc::iif(overflow, l + ((g - l) * il) * ixl, g);
+        b = Vc::iif(overflow, l + ((b - l) * il) * ixl, b);
+    }
+}
+
+template<class HSXType, Vc::Implementation _impl>
+ALWAYS_INLINE void setLightness(Vc::float_v &r, Vc::float_v &g, Vc::float_v &b, Vc::float_v::AsArg light)
+{
+    addLightness<HSXType, _impl>(r, g, b, light - HSXTraits<HSXType>::template getLightness<_impl>(r, g, b));
+}
+
+/**
+ * The scalar version sorts the channels and stretches the middle one;
+ * for the maximum and the minimum channels the same formula gives
+ * exactly `sat` and zero, so no sorting is needed
+ */
+template<Vc::Implementation _impl>
+ALWAYS_INLINE void setSaturation(Vc::float_v &r, Vc::float_v &g, Vc::float_v &b, Vc::float_v::AsArg sat)
+{
+    const Vc::float_v min = min3<_impl>(r, g, b);
+    const Vc::float_v chroma = max3<_impl>(r, g, b) - min;
+
+    const Vc::float_v scale = Vc::iif(chroma > Vc::float_v::Zero(), sat / chroma, Vc::float_v::Zero());
+
+    r = (r - min) * scale;
+    g = (g - min) * scale;
+    b = (b - min) * scale;
+}
+
+template<class HSXType>
+struct Color {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        const Vc::float_v lum = HSXTraits<HSXType>::template getLightness<_impl>(dr, dg, db);
+        dr = sr;
+        dg = sg;
+        db = sb;
+        setLightness<HSXType, _impl>(dr, dg, db, lum);
+    }
+};
+
+template<class HSXType>
+struct Lightness {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        setLightness<HSXType, _impl>(dr, dg, db, HSXTraits<HSXType>::template getLightness<_impl>(sr, sg, sb));
+    }
+};
+
+template<class HSXType>
+struct IncreaseLightness {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        addLightness<HSXType, _impl>(dr, dg, db, HSXTraits<HSXType>::template getLightness<_impl>(sr, sg, sb));
+    }
+};
+
+template<class HSXType>
+struct DecreaseLightness {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        addLightness<HSXType, _impl>(dr, dg, db, HSXTraits<HSXType>::template getLightness<_impl>(sr, sg, sb) - Vc::float_v::One());
+    }
+};
+
+template<class HSXType>
+struct Saturation {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        const Vc::float_v sat = HSXTraits<HSXType>::template getSaturation<_impl>(sr, sg, sb);
+        const Vc::float_v light = HSXTraits<HSXType>::template getLightness<_impl>(dr, dg, db);
+        setSaturation<_impl>(dr, dg, db, sat);
+        setLightness<HSXType, _impl>(dr, dg, db, light);
+    }
+};
+
+template<class HSXType>
+struct IncreaseSaturation {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        const Vc::float_v dstSat = HSXTraits<HSXType>::template getSaturation<_impl>(dr, dg, db);
+        const Vc::float_v sat = dstSat + (Vc::float_v::One() - dstSat) * HSXTraits<HSXType>::template getSaturation<_impl>(sr, sg, sb);
+        const Vc::float_v light = HSXTraits<HSXType>::template getLightness<_impl>(dr, dg, db);
+        setSaturation<_impl>(dr, dg, db, sat);
+        setLightness<HSXType, _impl>(dr, dg, db, light);
+    }
+};
+
+template<class HSXType>
+struct DecreaseSaturation {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        const Vc::float_v sat = HSXTraits<HSXType>::template getSaturation<_impl>(dr, dg, db) *
+            HSXTraits<HSXType>::template getSaturation<_impl>(sr, sg, sb);
+        const Vc::float_v light = HSXTraits<HSXType>::template getLightness<_impl>(dr, dg, db);
+        setSaturation<_impl>(dr, dg, db, sat);
+        setLightness<HSXType, _impl>(dr, dg, db, light);
+    }
+};
+
+template<class HSXType>
+struct Hue {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        const Vc::float_v sat = HSXTraits<HSXType>::template getSaturation<_impl>(dr, dg, db);
+        const Vc::float_v lum = HSXTraits<HSXType>::template getLightness<_impl>(dr, dg, db);
+        dr = sr;
+        dg = sg;
+        db = sb;
+        setSaturation<_impl>(dr, dg, db, sat);
+        setLightness<HSXType, _impl>(dr, dg, db, lum);
+    }
+};
+
+template<class HSXType>
+struct DarkerColor {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        const Vc::float_m keepDst =
+            HSXTraits<HSXType>::template getLightness<_impl>(dr, dg, db) <
+            HSXTraits<HSXType>::template getLightness<_impl>(sr, sg, sb);
+
+        dr = Vc::iif(keepDst, dr, sr);
+        dg = Vc::iif(keepDst, dg, sg);
+        db = Vc::iif(keepDst, db, sb);
+    }
+};
+
+template<class HSXType>
+struct LighterColor {
+    template<Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg sr, Vc::float_v::AsArg sg, Vc::float_v::AsArg sb,
+                                    Vc::float_v &dr, Vc::float_v &dg, Vc::float_v &db) {
+        const Vc::float_m keepDst =
+            HSXTraits<HSXType>::template getLightness<_impl>(dr, dg, db) >
+            HSXTraits<HSXType>::template getLightness<_impl>(sr, sg, sb);
+
+        dr = Vc::iif(keepDst, dr, sr);
+        dg = Vc::iif(keepDst, dg, sg);
+        db = Vc::iif(keepDst, db, sb);
+    }
+};
+
+}
+
+/**
+ * Applies a non-separable blending function to the RGB triplet of
+ * the pixel. \p Traits define the position of the color channels
+ * in the pixel.
+ */
+template<class Traits, class BlendFunction>
+struct HSLBlender {
+    static const bool needsExactNormalization = true;
+
+    template<typename channels_type, Vc::Implementation _impl>
+    static ALWAYS_INLINE void blend(Vc::float_v::AsArg src_c0, Vc::float_v::AsArg src_c1, Vc::float_v::AsArg src_c2,
+                                    Vc::float_v::AsArg dst_c0, Vc::float_v::AsArg dst_c1, Vc::float_v::AsArg dst_c2,
+                                    Vc::float_v &result_c0, Vc::float_v &result_c1, Vc::float_v &result_c2)
+    {
+        static_assert(Traits::green_pos == 1, "only RGB and BGR layouts are supported");
+        static_assert(Traits::red_pos + Traits::blue_pos == 2, "only RGB and BGR layouts are supported");
+
+        const bool isRgb = Traits::red_pos == 0;
+
+        Vc::float_v dr = isRgb ? dst_c0 : dst_c2;
+        Vc::float_v dg = dst_c1;
+        Vc::float_v db = isRgb ? dst_c2 : dst_c0;
+
+        BlendFunction::template blend<_impl>(isRgb ? src_c0 : src_c2, src_c1, isRgb ? src_c2 : src_c0,
+                                             dr, dg, db);
+
+        using ChannelTraits = KoStreamedBlendFunctions::ChannelTraits<channels_type, _impl>;
+
+        result_c0 = ChannelTraits::clamp(isRgb ? dr : db);
+        result_c1 = ChannelTraits::clamp(dg);
+        result_c2 = ChannelTraits::clamp(isRgb ? db : dr);
+    }
+};
+
+/**
+ * Creates an optimized version of the non-separable composite op \p id,
+ * or returns nullptr if the blending function of the op is not vectorized
+ */
+template<Vc::Implementation _impl, class Traits>
+KoCompositeOp* createOptimizedCompositeOpGenericHSL(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    using namespace KoStreamedBlendFunctions;
+    typedef typename Traits::channels_type channels_type;
+
+#define CREATE_GENERIC_HSL_OP(opId, blendFunction)                                                        \
+    if (id == opId) {                                                                                     \
+        return new KoOptimizedCompositeOpGenericBlend<_impl, channels_type, HSLBlender<Traits, blendFunction>>(cs, id, category); \
+    }
+
+    CREATE_GENERIC_HSL_OP(COMPOSITE_COLOR, Color<HSYType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_HUE, Hue<HSYType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_SATURATION, Saturation<HSYType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_INC_SATURATION, IncreaseSaturation<HSYType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_DEC_SATURATION, DecreaseSaturation<HSYType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_LUMINIZE, Lightness<HSYType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_INC_LUMINOSITY, IncreaseLightness<HSYType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_DEC_LUMINOSITY, DecreaseLightness<HSYType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_DARKER_COLOR, DarkerColor<HSYType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_LIGHTER_COLOR, LighterColor<HSYType>)
+
+    CREATE_GENERIC_HSL_OP(COMPOSITE_COLOR_HSI, Color<HSIType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_HUE_HSI, Hue<HSIType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_SATURATION_HSI, Saturation<HSIType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_INC_SATURATION_HSI, IncreaseSaturation<HSIType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_DEC_SATURATION_HSI, DecreaseSaturation<HSIType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_INTENSITY, Lightness<HSIType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_INC_INTENSITY, IncreaseLightness<HSIType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_DEC_INTENSITY, DecreaseLightness<HSIType>)
+
+    CREATE_GENERIC_HSL_OP(COMPOSITE_COLOR_HSL, Color<HSLType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_HUE_HSL, Hue<HSLType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_SATURATION_HSL, Saturation<HSLType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_INC_SATURATION_HSL, IncreaseSaturation<HSLType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_DEC_SATURATION_HSL, DecreaseSaturation<HSLType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_LIGHTNESS, Lightness<HSLType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_INC_LIGHTNESS, IncreaseLightness<HSLType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_DEC_LIGHTNESS, DecreaseLightness<HSLType>)
+
+    CREATE_GENERIC_HSL_OP(COMPOSITE_COLOR_HSV, Color<HSVType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_HUE_HSV, Hue<HSVType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_SATURATION_HSV, Saturation<HSVType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_INC_SATURATION_HSV, IncreaseSaturation<HSVType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_DEC_SATURATION_HSV, DecreaseSaturation<HSVType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_VALUE, Lightness<HSVType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_INC_VALUE, IncreaseLightness<HSVType>)
+    CREATE_GENERIC_HSL_OP(COMPOSITE_DEC_VALUE, DecreaseLightness<HSVType>)
+
+#undef CREATE_GENERIC_HSL_OP
+
+    return nullptr;
+}
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERICHSL_H
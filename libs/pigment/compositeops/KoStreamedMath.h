@@ -29,6 +29,7 @@
 #include <KoAlwaysInline.h>
 #include <KoCompositeOp.h>
 #include <KoColorSpaceMaths.h>
+#include <KoOptimizedHalfConversion.h>
 
 #define BLOCKDEBUG 0
 
@@ -696,6 +697,69 @@ struct PixelWrapper<float, _impl>
     const Vc::float_v::IndexType indexes;
 };
 
+#ifdef HAVE_OPENEXR
+
+/**
+ * Half pixels are converted into a temporary buffer of floats and
+ * then processed exactly in the same way as in the float wrapper.
+ * The conversion is done with F16C instructions on AVX2 capable
+ * CPUs, see KoOptimizedHalfConversion.
+ */
+template<Vc::Implementation _impl>
+struct PixelWrapper<half, _impl>
+{
+    static const int numChannels = Vc::float_v::size() * 4;
+
+    ALWAYS_INLINE
+    static half lerpMixedUintFloat(half a, half b, float alpha) {
+        return half(Arithmetic::lerp(float(a), float(b), alpha));
+    }
+
+    ALWAYS_INLINE
+    static half roundFloatToUint(float x) {
+        return half(x);
+    }
+
+    ALWAYS_INLINE
+    static void normalizeAlpha(float &alpha) {
+        Q_UNUSED(alpha);
+    }
+
+    ALWAYS_INLINE
+    static void denormalizeAlpha(float &alpha) {
+        Q_UNUSED(alpha);
+    }
+
+    ALWAYS_INLINE
+    void read(quint8 *dstPtr, Vc::float_v &dst_c1, Vc::float_v &dst_c2, Vc::float_v &dst_c3, Vc::float_v &dst_alpha)
+    {
+        KoOptimizedHalfConversion<_impl>::halfToFloat(reinterpret_cast<const half*>(dstPtr), buffer, numChannels);
+        floatWrapper.read(reinterpret_cast<quint8*>(buffer), dst_c1, dst_c2, dst_c3, dst_alpha);
+    }
+
+    ALWAYS_INLINE
+    void write(quint8 *dstPtr, Vc::float_v &dst_c1, Vc::float_v &dst_c2, Vc::float_v &dst_c3, Vc::float_v &dst_alpha)
+    {
+        floatWrapper.write(reinterpret_cast<quint8*>(buffer), dst_c1, dst_c2, dst_c3, dst_alpha);
+        KoOptimizedHalfConversion<_impl>::floatToHalf(buffer, reinterpret_cast<half*>(dstPtr), numChannels);
+    }
+
+    ALWAYS_INLINE
+    void clearPixels(quint8 *dataDst) {
+        memset(dataDst, 0, Vc::float_v::size() * sizeof(half) * 4);
+    }
+
+    ALWAYS_INLINE
+    void copyPixels(const quint8 *dataSrc, quint8 *dataDst) {
+        memcpy(dataDst, dataSrc, Vc::float_v::size() * sizeof(half) * 4);
+    }
+
+    PixelWrapper<float, _impl> floatWrapper;
+    alignas(Vc::float_v::MemoryAlignment) float buffer[numChannels];
+};
+
+#endif /* HAVE_OPENEXR */
+
 namespace KoStreamedMathFunctions {
 
 template<int pixelSize>
@@ -21,7 +21,7 @@ template<typename srcCSTraits, typename dstCSTraits, DitherType dType> class Kis
 
 public:
     KisCmykDitherOpImpl(const KoID &srcId, const KoID &dstId)
-        : KisDitherOpImpl<srcCSTraits, dstCSTraits, dType>(srcId, dstId)
+        : KisDitherOpImpl<srcCSTraits, dstCSTraits, dType>(srcId, dstId, createCmykOptimizedKernel())
     {
     }
 
@@ -36,6 +36,22 @@ public:
     }
 
 private:
+    static KisOptimizedDitherKernelBase *createCmykOptimizedKernel()
+    {
+        /**
+         * Floating point sources are normalized with unitValueCMYK,
+         * which the optimized kernel doesn't support. Integer sources
+         * are normalized in a standard way, but the color channels are
+         * truncated when written into the destination.
+         */
+        if (!std::numeric_limits<srcChannelsType>::is_integer) {
+            return nullptr;
+        }
+
+        const quint32 truncatedChannels = ((1u << srcCSTraits::channels_nb) - 1) & ~(1u << srcCSTraits::alpha_pos);
+        return KisDitherOpImpl<srcCSTraits, dstCSTraits, dType>::createOptimizedKernel(truncatedChannels);
+    }
+
     template<DitherType t = dType, typename std::enable_if<t == DITHER_NONE && std::is_same<srcCSTraits, dstCSTraits>::value, void>::type * = nullptr> inline void ditherImpl(const quint8 *src, quint8 *dst, int, int) const
     {
         memcpy(dst, src, srcCSTraits::pixelSize);
@@ -131,6 +147,11 @@ private:
     template<DitherType t = dType, typename std::enable_if<t != DITHER_NONE, void>::type * = nullptr>
     inline void ditherImpl(const quint8 *srcRowStart, int srcRowStride, quint8 *dstRowStart, int dstRowStride, int x, int y, int columns, int rows) const
     {
+        if (this->m_optimizedKernel) {
+            this->m_optimizedKernel->dither(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            return;
+        }
+
         const quint8 *nativeSrc = srcRowStart;
         quint8 *nativeDst = dstRowStart;
 
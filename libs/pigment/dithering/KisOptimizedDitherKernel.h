@@ -0,0 +1,202 @@
+/*
+ * This file is part of Krita
+ *
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include "KisOptimizedDitherKernelBase.h"
+
+#include <KoConfig.h>
+#include <KoColorSpaceMaths.h>
+#include "KoVcMultiArchBuildSupport.h"
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+template<typename srcChannelsType, typename dstChannelsType, Vc::Implementation _impl>
+class KisOptimizedDitherKernel;
+
+#ifdef __SSE4_1__
+
+template<typename srcChannelsType, typename dstChannelsType, Vc::Implementation _impl>
+class KisOptimizedDitherKernel : public KisOptimizedDitherKernelBase
+{
+    static_assert(std::is_integral<dstChannelsType>::value, "dithering into floating point types is a no-op");
+
+public:
+    KisOptimizedDitherKernel(DitherType type, int channelsNb, quint32 truncatedChannels)
+        : KisOptimizedDitherKernelBase(type, channelsNb, truncatedChannels)
+    {
+    }
+
+    void dither(const quint8 *srcRowStart, int srcRowStride,
+                quint8 *dstRowStart, int dstRowStride,
+                int x, int y, int columns, int rows) const override
+    {
+        const int numChannels = columns * m_channelsNb;
+
+        /**
+         * Both SSE and AVX blocks are multiples of four channels, so as
+         * long as the period of the factors is `factorPeriod` pixels,
+         * the blocks never cross the wrapping point of the buffer.
+         */
+        const int periodPixels = qMin(columns, int(factorPeriod));
+        const int period = periodPixels * m_channelsNb;
+
+        const float srcUnit = KoColorSpaceMathsTraits<srcChannelsType>::unitValue;
+        const float dstUnit = KoColorSpaceMathsTraits<dstChannelsType>::unitValue;
+        const float scale = 1.f / static_cast<float>(1 << (8 * sizeof(dstChannelsType)));
+
+#ifdef __AVX2__
+        const __m256 srcUnit256 = _mm256_set1_ps(srcUnit);
+        const __m256 dstUnit256 = _mm256_set1_ps(dstUnit);
+        const __m256 scale256 = _mm256_set1_ps(scale);
+        const __m256 zero256 = _mm256_setzero_ps();
+#endif
+
+        const __m128 srcUnit128 = _mm_set1_ps(srcUnit);
+        const __m128 dstUnit128 = _mm_set1_ps(dstUnit);
+        const __m128 scale128 = _mm_set1_ps(scale);
+        const __m128 zero128 = _mm_setzero_ps();
+
+        float factors[factorPeriod * maxChannels];
+
+        for (int row = 0; row < rows; row++) {
+            fillFactors(factors, x, y + row, periodPixels);
+
+            const srcChannelsType *srcPtr = reinterpret_cast<const srcChannelsType*>(srcRowStart);
+            dstChannelsType *dstPtr = reinterpret_cast<dstChannelsType*>(dstRowStart);
+
+            int i = 0;
+            int factorIndex = 0;
+
+#ifdef __AVX2__
+            for (; i + 8 <= numChannels; i += 8) {
+                __m256 c = load8(srcPtr + i, srcUnit256);
+
+                // KisDitherMaths::apply_dither()
+                const __m256 d = _mm256_loadu_ps(factors + factorIndex);
+                c = _mm256_add_ps(c, _mm256_mul_ps(_mm256_sub_ps(d, c), scale256));
+
+                // NaN values are converted to zero by max_ps
+                c = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(c, dstUnit256), zero256), dstUnit256);
+                c = _mm256_add_ps(c, _mm256_loadu_ps(m_roundingOffsets + factorIndex));
+
+                store8(dstPtr + i, _mm256_cvttps_epi32(c));
+
+                factorIndex += 8;
+                if (factorIndex >= period) {
+                    factorIndex -= period;
+                }
+            }
+#endif
+
+            for (; i + 4 <= numChannels; i += 4) {
+                __m128 c = load4(srcPtr + i, srcUnit128);
+
+                const __m128 d = _mm_loadu_ps(factors + factorIndex);
+                c = _mm_add_ps(c, _mm_mul_ps(_mm_sub_ps(d, c), scale128));
+
+                c = _mm_min_ps(_mm_max_ps(_mm_mul_ps(c, dstUnit128), zero128), dstUnit128);
+                c = _mm_add_ps(c, _mm_loadu_ps(m_roundingOffsets + factorIndex));
+
+                store4(dstPtr + i, _mm_cvttps_epi32(c));
+
+                factorIndex += 4;
+                if (factorIndex >= period) {
+                    factorIndex -= period;
+                }
+            }
+
+            for (; i < numChannels; i++) {
+                float c = KoColorSpaceMaths<srcChannelsType, float>::scaleToA(srcPtr[i]);
+                c = c + (factors[factorIndex] - c) * scale;
+                c = qBound(0.0f, c * dstUnit, dstUnit);
+                dstPtr[i] = static_cast<dstChannelsType>(static_cast<int>(c + m_roundingOffsets[factorIndex]));
+
+                factorIndex++;
+                if (factorIndex >= period) {
+                    factorIndex -= period;
+                }
+            }
+
+            srcRowStart += srcRowStride;
+            dstRowStart += dstRowStride;
+        }
+    }
+
+private:
+
+    /**
+     * Integer channels are divided by the unit value instead of being
+     * multiplied by its reciprocal to get exactly the same values as
+     * KoLuts::Uint8ToFloat and KoLuts::Uint16ToFloat
+     */
+    static inline __m128 load4(const srcChannelsType *src, __m128 srcUnit) {
+        if (std::is_same<srcChannelsType, quint8>::value) {
+            qint32 packed;
+            memcpy(&packed, src, sizeof(packed));
+            return _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed))), srcUnit);
+        } else if (std::is_same<srcChannelsType, quint16>::value) {
+            const __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+            return _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(x)), srcUnit);
+        } else if (std::is_same<srcChannelsType, float>::value) {
+            return _mm_loadu_ps(reinterpret_cast<const float*>(src));
+        } else {
+            return _mm_setr_ps(float(src[0]), float(src[1]), float(src[2]), float(src[3]));
+        }
+    }
+
+    static inline void store4(dstChannelsType *dst, __m128i x) {
+        if (std::is_same<dstChannelsType, quint8>::value) {
+            x = _mm_packs_epi32(x, x);
+            x = _mm_packus_epi16(x, x);
+            const qint32 packed = _mm_cvtsi128_si32(x);
+            memcpy(dst, &packed, sizeof(packed));
+        } else {
+            x = _mm_packus_epi32(x, x);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), x);
+        }
+    }
+
+#ifdef __AVX2__
+    static inline __m256 load8(const srcChannelsType *src, __m256 srcUnit) {
+        if (std::is_same<srcChannelsType, quint8>::value) {
+            const __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+            return _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(x)), srcUnit);
+        } else if (std::is_same<srcChannelsType, quint16>::value) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            return _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(x)), srcUnit);
+        } else if (std::is_same<srcChannelsType, float>::value) {
+            return _mm256_loadu_ps(reinterpret_cast<const float*>(src));
+        } else {
+            return _mm256_setr_ps(float(src[0]), float(src[1]), float(src[2]), float(src[3]),
+                                  float(src[4]), float(src[5]), float(src[6]), float(src[7]));
+        }
+    }
+
+    static inline void store8(dstChannelsType *dst, __m256i y) {
+        const __m128i lo = _mm256_castsi256_si128(y);
+        const __m128i hi = _mm256_extracti128_si256(y, 1);
+
+        if (std::is_same<dstChannelsType, quint8>::value) {
+            __m128i x = _mm_packs_epi32(lo, hi);
+            x = _mm_packus_epi16(x, x);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), x);
+        } else {
+            const __m128i x = _mm_packus_epi32(lo, hi);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), x);
+        }
+    }
+#endif
+};
+
+#endif /* __SSE4_1__ */
@@ -0,0 +1,52 @@
+/*
+ * This file is part of Krita
+ *
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOptimizedDitherKernelBase.h"
+
+#include "KisDitherMaths.h"
+#include "kis_assert.h"
+
+KisOptimizedDitherKernelBase::KisOptimizedDitherKernelBase(DitherType type, int channelsNb, quint32 truncatedChannels)
+    : m_type(type)
+    , m_channelsNb(channelsNb)
+{
+    KIS_ASSERT(type == DITHER_BAYER || type == DITHER_BLUE_NOISE);
+    KIS_ASSERT(channelsNb > 0 && channelsNb <= maxChannels);
+
+    for (int i = 0; i < factorPeriod * channelsNb; i++) {
+        const int channel = i % channelsNb;
+        m_roundingOffsets[i] = truncatedChannels & (1u << channel) ? 0.0f : 0.5f;
+    }
+}
+
+KisOptimizedDitherKernelBase::~KisOptimizedDitherKernelBase()
+{
+}
+
+int KisOptimizedDitherKernelBase::channelsNb() const
+{
+    return m_channelsNb;
+}
+
+DitherType KisOptimizedDitherKernelBase::type() const
+{
+    return m_type;
+}
+
+void KisOptimizedDitherKernelBase::fillFactors(float *factors, int x, int y, int numPixels) const
+{
+    for (int i = 0; i < numPixels; i++) {
+        const float f = m_type == DITHER_BAYER ?
+            KisDitherMaths::dither_factor_bayer_8(x + i, y) :
+            KisDitherMaths::dither_factor_blue_noise_64(x + i, y);
+
+        for (int c = 0; c < m_channelsNb; c++) {
+            *factors++ = f;
+        }
+    }
+}
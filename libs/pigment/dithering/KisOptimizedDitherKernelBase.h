@@ -0,0 +1,70 @@
+/*
+ * This file is part of Krita
+ *
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include "kritapigment_export.h"
+
+#include <QtGlobal>
+
+#include "KisDitherOp.h"
+
+/**
+ * @brief A vectorized row dithering kernel used by KisDitherOpImpl
+ *
+ * The kernel converts rows of pixels from one channel type to an
+ * integer channel type, applying ordered or blue-noise dithering.
+ * Since the dither factor depends on the pixel position only, the
+ * row is processed as a flat array of channels and the factors for
+ * every channel are taken from a buffer precomputed per row. Both
+ * Bayer and blue noise matrices repeat every `factorPeriod` pixels,
+ * so the buffer never needs to be longer than that.
+ *
+ * Each channel is rounded to the nearest destination value, unless
+ * its bit is set in `truncatedChannels`. CMYK color spaces need the
+ * latter for their color channels.
+ *
+ * The actual implementation is placed in class `KisOptimizedDitherKernel`,
+ * use KisOptimizedDitherKernelFactory to create it.
+ */
+class KRITAPIGMENT_EXPORT KisOptimizedDitherKernelBase
+{
+public:
+    static const int factorPeriod = 64;
+    static const int maxChannels = 5;
+
+public:
+    KisOptimizedDitherKernelBase(DitherType type, int channelsNb, quint32 truncatedChannels);
+    virtual ~KisOptimizedDitherKernelBase();
+
+    virtual void dither(const quint8 *srcRowStart, int srcRowStride,
+                        quint8 *dstRowStart, int dstRowStride,
+                        int x, int y, int columns, int rows) const = 0;
+
+    int channelsNb() const;
+    DitherType type() const;
+
+protected:
+    /**
+     * Fills \p factors with the dither factors of \p numPixels pixels
+     * starting at (\p x, \p y), each factor repeated for all the channels
+     * of the pixel
+     */
+    void fillFactors(float *factors, int x, int y, int numPixels) const;
+
+protected:
+    DitherType m_type;
+    int m_channelsNb;
+
+    /**
+     * Values added to the scaled channel before truncating it
+     * to an integer, 0.5 for rounded channels, 0.0 for truncated
+     * ones. Has the same layout as the factors buffer.
+     */
+    float m_roundingOffsets[factorPeriod * maxChannels];
+};
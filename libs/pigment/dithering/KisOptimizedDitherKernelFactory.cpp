@@ -0,0 +1,62 @@
+/*
+ * This file is part of Krita
+ *
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOptimizedDitherKernelFactory.h"
+
+#include <KoColorModelStandardIdsUtils.h>
+
+#include "KisOptimizedDitherKernelFactoryImpl.h"
+
+namespace {
+
+template <typename srcChannelsType, typename dstChannelsType>
+KisOptimizedDitherKernelBase* createKernel(DitherType type, int channelsNb, quint32 truncatedChannels)
+{
+    using FactoryImpl = KisOptimizedDitherKernelFactoryImpl<srcChannelsType, dstChannelsType>;
+    return createOptimizedClass<FactoryImpl>({type, channelsNb, truncatedChannels});
+}
+
+template <typename srcChannelsType>
+struct CreateKernel
+{
+    KisOptimizedDitherKernelBase *operator() (const KoID &dstDepthId, DitherType type, int channelsNb, quint32 truncatedChannels) {
+        if (dstDepthId == Integer8BitsColorDepthID) {
+            return createKernel<srcChannelsType, quint8>(type, channelsNb, truncatedChannels);
+        } else if (dstDepthId == Integer16BitsColorDepthID) {
+            return createKernel<srcChannelsType, quint16>(type, channelsNb, truncatedChannels);
+        }
+
+        return nullptr;
+    }
+};
+
+}
+
+KisOptimizedDitherKernelBase *KisOptimizedDitherKernelFactory::create(const KoID &srcDepthId, const KoID &dstDepthId,
+                                                                      DitherType type, int channelsNb,
+                                                                      quint32 truncatedChannels)
+{
+    const bool typeIsSupported =
+        type == DITHER_BAYER || type == DITHER_BLUE_NOISE;
+
+    const bool srcDepthIsSupported =
+        srcDepthId == Integer8BitsColorDepthID ||
+        srcDepthId == Integer16BitsColorDepthID ||
+#ifdef HAVE_OPENEXR
+        srcDepthId == Float16BitsColorDepthID ||
+#endif
+        srcDepthId == Float32BitsColorDepthID;
+
+    if (!typeIsSupported || !srcDepthIsSupported ||
+        channelsNb > KisOptimizedDitherKernelBase::maxChannels) {
+
+        return nullptr;
+    }
+
+    return channelTypeForColorDepthId<CreateKernel>(srcDepthId, dstDepthId, type, channelsNb, truncatedChannels);
+}
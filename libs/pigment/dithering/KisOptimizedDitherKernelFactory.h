@@ -0,0 +1,33 @@
+/*
+ * This file is part of Krita
+ *
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include "kritapigment_export.h"
+
+#include <KoID.h>
+
+#include "KisOptimizedDitherKernelBase.h"
+
+/**
+ * Creates a vectorized row dithering kernel for the current CPU.
+ *
+ * Returns nullptr if there is no optimized kernel for the requested
+ * combination. That is the case for DITHER_NONE, for floating point
+ * destination depths (dithering into them is a plain conversion) and
+ * for CPUs without SSE4.1.
+ *
+ * \see KisOptimizedDitherKernelBase
+ */
+class KRITAPIGMENT_EXPORT KisOptimizedDitherKernelFactory
+{
+public:
+    static KisOptimizedDitherKernelBase* create(const KoID &srcDepthId, const KoID &dstDepthId,
+                                                DitherType type, int channelsNb,
+                                                quint32 truncatedChannels = 0);
+};
@@ -0,0 +1,40 @@
+/*
+ * This file is part of Krita
+ *
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOptimizedDitherKernelFactoryImpl.h"
+#include "KisOptimizedDitherKernel.h"
+#include "KoOptimizedPixelOpFactoryImpl_p.h"
+
+template<typename srcChannelsType, typename dstChannelsType>
+template<Vc::Implementation _impl>
+KisOptimizedDitherKernelBase*
+KisOptimizedDitherKernelFactoryImpl<srcChannelsType, dstChannelsType>::create(ParamType param)
+{
+    /**
+     * The scalar version is implemented in KisDitherOpImpl itself,
+     * the caller should fall back to it.
+     */
+    return KoOptimizedPixelOpAllocator<
+            KisOptimizedDitherKernel<srcChannelsType, dstChannelsType, _impl>,
+            KisOptimizedDitherKernelBase,
+            koOptimizedPixelOpHasSse4>::create(param.type, param.channelsNb, param.truncatedChannels);
+}
+
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<quint8,  quint8>::create<Vc::CurrentImplementation::current()>(ParamType);
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<quint16, quint8>::create<Vc::CurrentImplementation::current()>(ParamType);
+#ifdef HAVE_OPENEXR
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<half,    quint8>::create<Vc::CurrentImplementation::current()>(ParamType);
+#endif
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<float,   quint8>::create<Vc::CurrentImplementation::current()>(ParamType);
+
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<quint8,  quint16>::create<Vc::CurrentImplementation::current()>(ParamType);
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<quint16, quint16>::create<Vc::CurrentImplementation::current()>(ParamType);
+#ifdef HAVE_OPENEXR
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<half,    quint16>::create<Vc::CurrentImplementation::current()>(ParamType);
+#endif
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<float,   quint16>::create<Vc::CurrentImplementation::current()>(ParamType);
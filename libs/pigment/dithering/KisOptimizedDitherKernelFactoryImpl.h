@@ -0,0 +1,28 @@
+/*
+ * This file is part of Krita
+ *
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include "KisOptimizedDitherKernelBase.h"
+#include <KoVcMultiArchBuildSupport.h>
+
+template<typename srcChannelsType, typename dstChannelsType>
+class KRITAPIGMENT_EXPORT KisOptimizedDitherKernelFactoryImpl
+{
+public:
+    struct ParamType {
+        DitherType type;
+        int channelsNb;
+        quint32 truncatedChannels;
+    };
+
+    typedef KisOptimizedDitherKernelBase* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static KisOptimizedDitherKernelBase* create(ParamType);
+};
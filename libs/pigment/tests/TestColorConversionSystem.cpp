@@ -13,6 +13,12 @@
 #include <KoColorSpaceRegistry.h>
 #include <KoColorConversionSystem.h>
 #include <KoColorModelStandardIds.h>
+#include <KoChannelInfo.h>
+#include <KoOptimizedColorDepthConversionTransformation.h>
+#include <KoConfig.h>
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
 #include <sdk/tests/testpigment.h>
 
 TestColorConversionSystem::TestColorConversionSystem()
@@ -417,5 +423,156 @@ void TestColorConversionSystem::testCmykBitnessConversion()
 
 }
 
+void TestColorConversionSystem::testOptimizedDepthConversion_data()
+{
+    QTest::addColumn<QString>("modelId");
+    QTest::addColumn<QString>("depthId");
+
+    QTest::newRow("rgba u16") << RGBAColorModelID.id() << Integer16BitsColorDepthID.id();
+    QTest::newRow("rgba f32") << RGBAColorModelID.id() << Float32BitsColorDepthID.id();
+    QTest::newRow("graya u16") << GrayAColorModelID.id() << Integer16BitsColorDepthID.id();
+    QTest::newRow("graya f32") << GrayAColorModelID.id() << Float32BitsColorDepthID.id();
+}
+
+void TestColorConversionSystem::testOptimizedDepthConversion()
+{
+    QFETCH(QString, modelId);
+    QFETCH(QString, depthId);
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    const KoColorSpace *cs8 = registry->colorSpace(modelId, Integer8BitsColorDepthID.id());
+    const KoColorSpace *csN = registry->colorSpace(modelId, depthId, cs8->profile());
+    QVERIFY(cs8);
+    QVERIFY(csN);
+
+    QScopedPointer<KoColorConversionTransformation> forward(
+        registry->createColorConverter(cs8, csN,
+                                       KoColorConversionTransformation::internalRenderingIntent(),
+                                       KoColorConversionTransformation::internalConversionFlags()));
+
+    QScopedPointer<KoColorConversionTransformation> backward(
+        registry->createColorConverter(csN, cs8,
+                                       KoColorConversionTransformation::internalRenderingIntent(),
+                                       KoColorConversionTransformation::internalConversionFlags()));
+
+    QVERIFY(dynamic_cast<KoOptimizedColorDepthConversionTransformation*>(forward.data()));
+    QVERIFY(dynamic_cast<KoOptimizedColorDepthConversionTransformation*>(backward.data()));
+
+    // an odd number of pixels to check the tails of the vectorized loops
+    const int numPixels = 1023;
+    const int numChannels = int(cs8->channelCount());
+
+    QByteArray srcBuf(numPixels * cs8->pixelSize(), '\0');
+    QByteArray tmpBuf(numPixels * csN->pixelSize(), '\0');
+    QByteArray dstBuf(numPixels * cs8->pixelSize(), '\0');
+
+    qsrand(1);
+    for (int i = 0; i < srcBuf.size(); i++) {
+        srcBuf[i] = qrand() & 0xFF;
+    }
+
+    forward->transform(reinterpret_cast<const quint8*>(srcBuf.constData()),
+                       reinterpret_cast<quint8*>(tmpBuf.data()), numPixels);
+
+    backward->transform(reinterpret_cast<const quint8*>(tmpBuf.constData()),
+                        reinterpret_cast<quint8*>(dstBuf.data()), numPixels);
+
+    QCOMPARE(dstBuf, srcBuf);
+
+    // check that the channels are scaled and placed correctly
+    QVector<float> channels8(numChannels);
+    QVector<float> channelsN(numChannels);
+
+    for (int i = 0; i < numPixels; i++) {
+        cs8->normalisedChannelsValue(reinterpret_cast<const quint8*>(srcBuf.constData()) + i * cs8->pixelSize(), channels8);
+        csN->normalisedChannelsValue(reinterpret_cast<const quint8*>(tmpBuf.constData()) + i * csN->pixelSize(), channelsN);
+
+        for (int ch = 0; ch < numChannels; ch++) {
+            // integer RGB color spaces store channels in BGR order
+            const int displayPosition = cs8->channels()[ch]->displayPosition();
+            const int chN = KoChannelInfo::displayPositionToChannelIndex(displayPosition, csN->channels());
+            QVERIFY(qAbs(channels8[ch] - channelsN[chN]) < 1e-6);
+        }
+    }
+}
+
+
+void TestColorConversionSystem::testOptimizedHalfConversion_data()
+{
+    QTest::addColumn<QString>("modelId");
+
+    QTest::newRow("rgba") << RGBAColorModelID.id();
+    QTest::newRow("graya") << GrayAColorModelID.id();
+}
+
+void TestColorConversionSystem::testOptimizedHalfConversion()
+{
+#ifdef HAVE_OPENEXR
+    QFETCH(QString, modelId);
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    const KoColorSpace *cs32 = registry->colorSpace(modelId, Float32BitsColorDepthID.id());
+    QVERIFY(cs32);
+    const KoColorSpace *cs16 = registry->colorSpace(modelId, Float16BitsColorDepthID.id(), cs32->profile());
+    QVERIFY(cs16);
+
+    QScopedPointer<KoColorConversionTransformation> forward(
+        registry->createColorConverter(cs32, cs16,
+                                       KoColorConversionTransformation::internalRenderingIntent(),
+                                       KoColorConversionTransformation::internalConversionFlags()));
+
+    QScopedPointer<KoColorConversionTransformation> backward(
+        registry->createColorConverter(cs16, cs32,
+                                       KoColorConversionTransformation::internalRenderingIntent(),
+                                       KoColorConversionTransformation::internalConversionFlags()));
+
+    QVERIFY(dynamic_cast<KoOptimizedColorDepthConversionTransformation*>(forward.data()));
+    QVERIFY(dynamic_cast<KoOptimizedColorDepthConversionTransformation*>(backward.data()));
+
+    // an odd number of pixels to check the tails of the vectorized loops
+    const int numPixels = 1023;
+    const int numChannels = int(cs32->channelCount());
+    const int numValues = numPixels * numChannels;
+
+    QVector<float> srcBuf(numValues);
+    QVector<half> tmpBuf(numValues);
+    QVector<float> dstBuf(numValues);
+
+    qsrand(1);
+    for (int i = 0; i < numValues; i++) {
+        // HDR values, values below the half's precision and negative values
+        srcBuf[i] = (float(qrand()) / RAND_MAX - 0.1f) * (i % 3 ? 4.0f : 1e-4f);
+    }
+
+    srcBuf[0] = 0.0f;
+    srcBuf[1] = 1.0f;
+    srcBuf[2] = 1e6f;
+    srcBuf[3] = -1e6f;
+
+    forward->transform(reinterpret_cast<const quint8*>(srcBuf.constData()),
+                       reinterpret_cast<quint8*>(tmpBuf.data()), numPixels);
+
+    backward->transform(reinterpret_cast<const quint8*>(tmpBuf.constData()),
+                        reinterpret_cast<quint8*>(dstBuf.data()), numPixels);
+
+    for (int i = 0; i < numValues; i++) {
+        const half expectedHalf(srcBuf[i]);
+
+        if (tmpBuf[i].bits() != expectedHalf.bits()) {
+            qDebug() << ppVar(i) << ppVar(srcBuf[i]) << ppVar(tmpBuf[i].bits()) << ppVar(expectedHalf.bits());
+            QFAIL("F32 -> F16 conversion is not exact");
+        }
+
+        if (dstBuf[i] != float(expectedHalf)) {
+            qDebug() << ppVar(i) << ppVar(dstBuf[i]) << ppVar(float(expectedHalf));
+            QFAIL("F16 -> F32 conversion is not exact");
+        }
+    }
+#else
+    QSKIP("Krita is built without OpenEXR support");
+#endif
+}
 
 KISTEST_MAIN(TestColorConversionSystem)
@@ -35,6 +35,12 @@ private Q_SLOTS:
     void benchmarkRgbToAlphaConversion();
 
     void testCmykBitnessConversion();
+
+    void testOptimizedDepthConversion_data();
+    void testOptimizedDepthConversion();
+
+    void testOptimizedHalfConversion_data();
+    void testOptimizedHalfConversion();
 private:
     QList< ModelDepthProfile > listModels;
 };
@@ -11,6 +11,13 @@
 #include "../KoColorSpaceAbstract.h"
 #include "../KoColorSpaceTraits.h"
 #include "../DebugPigment.h"
+#include "../KoOptimizedConvolutionOpFactory.h"
+#include "../KoColorModelStandardIdsUtils.h"
+
+#include <KoConfig.h>
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
 
 void TestConvolutionOpImpl::testConvolutionOpImpl()
 {
@@ -204,5 +211,96 @@ void TestConvolutionOpImpl::testOneFullyTransparent()
     }
 }
 
+template<typename channels_type, int channels_nb>
+void testOptimizedConvolutionOpImpl()
+{
+    using Trait = KoColorSpaceTrait<channels_type, channels_nb, channels_nb - 1>;
+
+    QScopedPointer<KoConvolutionOp> op(
+        KoOptimizedConvolutionOpFactory::create(colorDepthIdForChannelType<channels_type>(),
+                                                channels_nb, channels_nb - 1));
+    if (!op) {
+        QSKIP("No optimized convolution op for the current CPU");
+    }
+
+    KoConvolutionOpImpl<Trait> refOp;
+
+    const qreal unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+
+    for (int kernelSize = 1; kernelSize <= 7; kernelSize += 2) {
+        const int numPixels = kernelSize * kernelSize;
+
+        QVector<channels_type> pixels(numPixels * channels_nb);
+        QVector<const quint8*> colors(numPixels);
+        QVector<qreal> kernelValues(numPixels);
+
+        for (int iteration = 0; iteration < 50; iteration++) {
+            for (int i = 0; i < numPixels; i++) {
+                channels_type *pixel = pixels.data() + i * channels_nb;
+
+                for (int ch = 0; ch < channels_nb; ch++) {
+                    pixel[ch] = channels_type(unitValue * (qrand() % 1001) / 1000.0);
+                }
+
+                // make some of the pixels fully transparent
+                if (iteration % 3 > 0 && qrand() % 4 == 0) {
+                    pixel[channels_nb - 1] = channels_type(0);
+                }
+
+                colors[i] = reinterpret_cast<const quint8*>(pixel);
+
+                /**
+                 * The weights are multiples of 1/16, so that the products
+                 * are exact and don't depend on the usage of FMA
+                 */
+                kernelValues[i] = qrand() % 4 == 0 ? 0.0 : (qrand() % 65 - 32) / 16.0;
+            }
+
+            qreal totalWeight = 0;
+            Q_FOREACH (qreal weight, kernelValues) {
+                totalWeight += weight;
+            }
+
+            const qreal factor = iteration % 2 && totalWeight != 0 ? totalWeight : 1.0 + qrand() % 8;
+            const qreal offset = iteration % 5 == 0 ? 0.5 : 0.0;
+
+            QBitArray channelFlags;
+            if (iteration % 7 == 0) {
+                channelFlags = QBitArray(channels_nb, true);
+                channelFlags.clearBit(0);
+            }
+
+            QByteArray result(Trait::pixelSize, 0);
+            QByteArray expected(Trait::pixelSize, 0);
+
+            op->convolveColors(colors.constData(), kernelValues.constData(),
+                               reinterpret_cast<quint8*>(result.data()),
+                               factor, offset, numPixels, channelFlags);
+
+            refOp.convolveColors(colors.constData(), kernelValues.constData(),
+                                 reinterpret_cast<quint8*>(expected.data()),
+                                 factor, offset, numPixels, channelFlags);
+
+            QVERIFY2(result == expected,
+                     QString("kernelSize: %1, iteration: %2").arg(kernelSize).arg(iteration).toLatin1());
+        }
+    }
+}
+
+void TestConvolutionOpImpl::testOptimizedConvolutionOp()
+{
+    testOptimizedConvolutionOpImpl<quint8, 4>();
+    testOptimizedConvolutionOpImpl<quint16, 4>();
+    testOptimizedConvolutionOpImpl<float, 4>();
+
+    testOptimizedConvolutionOpImpl<quint8, 2>();
+    testOptimizedConvolutionOpImpl<quint16, 2>();
+    testOptimizedConvolutionOpImpl<float, 2>();
+
+#ifdef HAVE_OPENEXR
+    testOptimizedConvolutionOpImpl<half, 4>();
+    testOptimizedConvolutionOpImpl<half, 2>();
+#endif
+}
 
 QTEST_GUILESS_MAIN(TestConvolutionOpImpl)
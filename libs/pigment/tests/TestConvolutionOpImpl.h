@@ -16,6 +16,7 @@ private Q_SLOTS:
     void testConvolutionOpImpl();
     void testOneSemiTransparent();
     void testOneFullyTransparent();
+    void testOptimizedConvolutionOp();
 };
 
 #endif
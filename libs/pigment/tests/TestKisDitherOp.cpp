@@ -0,0 +1,131 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKisDitherOp.h"
+
+#include <simpletest.h>
+
+#include <KoConfig.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
+#include <KisDitherOp.h>
+#include <kis_debug.h>
+
+#include "sdk/tests/testpigment.h"
+
+void TestKisDitherOp::testRowsMatchPixels_data()
+{
+    QTest::addColumn<QString>("modelId");
+    QTest::addColumn<QString>("srcDepthId");
+    QTest::addColumn<QString>("dstDepthId");
+    QTest::addColumn<int>("ditherType");
+
+    const QList<KoID> models = {RGBAColorModelID, GrayAColorModelID, CMYKAColorModelID};
+    const QList<KoID> srcDepths = {
+        Integer8BitsColorDepthID,
+        Integer16BitsColorDepthID,
+#ifdef HAVE_OPENEXR
+        Float16BitsColorDepthID,
+#endif
+        Float32BitsColorDepthID
+    };
+    const QList<KoID> dstDepths = {Integer8BitsColorDepthID, Integer16BitsColorDepthID};
+
+    Q_FOREACH (const KoID &model, models) {
+        Q_FOREACH (const KoID &srcDepth, srcDepths) {
+            Q_FOREACH (const KoID &dstDepth, dstDepths) {
+                for (int type : {DITHER_BAYER, DITHER_BLUE_NOISE}) {
+                    const QString name =
+                        QString("%1 %2->%3 %4")
+                            .arg(model.id())
+                            .arg(srcDepth.id())
+                            .arg(dstDepth.id())
+                            .arg(type == DITHER_BAYER ? "bayer" : "blue-noise");
+
+                    QTest::newRow(name.toLatin1().data())
+                        << model.id() << srcDepth.id() << dstDepth.id() << type;
+                }
+            }
+        }
+    }
+}
+
+void TestKisDitherOp::testRowsMatchPixels()
+{
+    /**
+     * Rows of pixels may be dithered by a vectorized kernel, while
+     * single pixels are always dithered by the scalar code. Both should
+     * give the same result, with a one step tolerance for the fused
+     * multiply-add the vectorized code may be compiled with.
+     */
+
+    QFETCH(QString, modelId);
+    QFETCH(QString, srcDepthId);
+    QFETCH(QString, dstDepthId);
+    QFETCH(int, ditherType);
+
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->colorSpace(modelId, srcDepthId, 0);
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->colorSpace(modelId, dstDepthId, 0);
+    QVERIFY(srcCs);
+    QVERIFY(dstCs);
+
+    const KisDitherOp *op = srcCs->ditherOp(dstDepthId, DitherType(ditherType));
+    QVERIFY(op);
+
+    const int columns = 131;
+    const int rows = 3;
+    const int x = 13;
+    const int y = 7;
+
+    const int srcPixelSize = srcCs->pixelSize();
+    const int dstPixelSize = dstCs->pixelSize();
+
+    QVector<quint8> src(columns * rows * srcPixelSize);
+    QVector<float> channels(srcCs->channelCount());
+
+    for (int i = 0; i < columns * rows; i++) {
+        for (int c = 0; c < channels.size(); c++) {
+            channels[c] = (qrand() % 1001) / 1000.0f;
+        }
+        srcCs->fromNormalisedChannelsValue(src.data() + i * srcPixelSize, channels);
+    }
+
+    QVector<quint8> rowResult(columns * rows * dstPixelSize);
+    QVector<quint8> pixelResult(columns * rows * dstPixelSize);
+
+    op->dither(src.constData(), columns * srcPixelSize,
+               rowResult.data(), columns * dstPixelSize,
+               x, y, columns, rows);
+
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < columns; col++) {
+            const int index = row * columns + col;
+            op->dither(src.constData() + index * srcPixelSize,
+                       pixelResult.data() + index * dstPixelSize,
+                       x + col, y + row);
+        }
+    }
+
+    const bool isU16 = dstDepthId == Integer16BitsColorDepthID.id();
+    const int numChannels = columns * rows * dstCs->channelCount();
+
+    for (int i = 0; i < numChannels; i++) {
+        const int rowValue = isU16 ?
+            reinterpret_cast<const quint16*>(rowResult.constData())[i] :
+            rowResult[i];
+        const int pixelValue = isU16 ?
+            reinterpret_cast<const quint16*>(pixelResult.constData())[i] :
+            pixelResult[i];
+
+        if (qAbs(rowValue - pixelValue) > 1) {
+            qDebug() << "Channel" << i << "differs:" << ppVar(rowValue) << ppVar(pixelValue);
+            QFAIL("Row and pixel dithering give different results");
+        }
+    }
+}
+
+KISTEST_MAIN(TestKisDitherOp)
@@ -0,0 +1,173 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "TestKoColorConversionCache.h"
+
+#include <simpletest.h>
+
+#include <QHash>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+#include "KoColorConversionCache.h"
+#include "KoColorSpaceRegistry.h"
+#include "KoColorSpace.h"
+
+void TestKoColorConversionCache::testDestroyedColorSpaceIsDropped()
+{
+    const KoColorSpace *src = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *dst = KoColorSpaceRegistry::instance()->lab16();
+
+    KoColorConversionCache cache;
+
+    KoCachedColorConversionTransformation c1 =
+        cache.cachedConverter(src, dst,
+                              KoColorConversionTransformation::internalRenderingIntent(),
+                              KoColorConversionTransformation::internalConversionFlags());
+
+    KoCachedColorConversionTransformation c2 =
+        cache.cachedConverter(src, dst,
+                              KoColorConversionTransformation::internalRenderingIntent(),
+                              KoColorConversionTransformation::internalConversionFlags());
+
+    // the second request is served from the thread-local cache
+    QCOMPARE(c2.transformation(), c1.transformation());
+
+    cache.colorSpaceIsDestroyed(src);
+
+    /**
+     * c1 keeps the old transformation alive, so the new one cannot
+     * get the same address
+     */
+    KoCachedColorConversionTransformation c3 =
+        cache.cachedConverter(src, dst,
+                              KoColorConversionTransformation::internalRenderingIntent(),
+                              KoColorConversionTransformation::internalConversionFlags());
+
+    QVERIFY(c3.transformation() != c1.transformation());
+}
+
+namespace {
+
+/**
+ * Requests the conversions from the cache in a loop while another
+ * thread destroys their source color space. Every transformation the
+ * job has ever got is kept alive, so their addresses are unique. The
+ * job remembers how many destructions had been started when it saw a
+ * transformation for the first time. As soon as one more destruction
+ * is finished, the transformation must never be returned again.
+ */
+class ConversionJob : public QRunnable
+{
+public:
+    ConversionJob(KoColorConversionCache *cache,
+                  const KoColorSpace *src,
+                  const QVector<const KoColorSpace*> &dstColorSpaces,
+                  QAtomicInt *destructionsStarted,
+                  QAtomicInt *destructionsFinished,
+                  QAtomicInt *stopFlag,
+                  QAtomicInt *numStaleTransformations)
+        : m_cache(cache),
+          m_src(src),
+          m_dstColorSpaces(dstColorSpaces),
+          m_destructionsStarted(destructionsStarted),
+          m_destructionsFinished(destructionsFinished),
+          m_stopFlag(stopFlag),
+          m_numStaleTransformations(numStaleTransformations)
+    {
+    }
+
+    void run() override {
+        QHash<const KoColorConversionTransformation*, int> firstSeen;
+        QVector<KoCachedColorConversionTransformation> seenTransformations;
+
+        for (int i = 0; !m_stopFlag->loadAcquire(); i++) {
+            const KoColorSpace *dst = m_dstColorSpaces[i % m_dstColorSpaces.size()];
+
+            const int finished = m_destructionsFinished->loadAcquire();
+
+            KoCachedColorConversionTransformation c =
+                m_cache->cachedConverter(m_src, dst,
+                                         KoColorConversionTransformation::internalRenderingIntent(),
+                                         KoColorConversionTransformation::internalConversionFlags());
+
+            const int started = m_destructionsStarted->loadAcquire();
+
+            const KoColorConversionTransformation *transformation = c.transformation();
+
+            if (transformation->dstColorSpace() != dst) {
+                m_numStaleTransformations->ref();
+            }
+
+            auto it = firstSeen.constFind(transformation);
+            if (it == firstSeen.constEnd()) {
+                firstSeen.insert(transformation, started);
+                seenTransformations.append(c);
+            } else if (finished > it.value()) {
+                m_numStaleTransformations->ref();
+            }
+        }
+    }
+
+private:
+    KoColorConversionCache *m_cache;
+    const KoColorSpace *m_src;
+    QVector<const KoColorSpace*> m_dstColorSpaces;
+    QAtomicInt *m_destructionsStarted;
+    QAtomicInt *m_destructionsFinished;
+    QAtomicInt *m_stopFlag;
+    QAtomicInt *m_numStaleTransformations;
+};
+
+}
+
+void TestKoColorConversionCache::testConcurrentDestruction()
+{
+    const int numThreads = 8;
+    const int numDestructions = 200;
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    const KoColorSpace *src = registry->rgb8();
+    const QVector<const KoColorSpace*> dstColorSpaces =
+        {registry->lab16(), registry->rgb16(), registry->alpha8()};
+
+    KoColorConversionCache cache;
+
+    QAtomicInt destructionsStarted;
+    QAtomicInt destructionsFinished;
+    QAtomicInt stopFlag;
+    QAtomicInt numStaleTransformations;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(numThreads);
+
+    for (int i = 0; i < numThreads; i++) {
+        pool.start(new ConversionJob(&cache, src, dstColorSpaces,
+                                     &destructionsStarted, &destructionsFinished,
+                                     &stopFlag, &numStaleTransformations));
+    }
+
+    /**
+     * The color space is not actually deleted, the cache only compares
+     * the pointers, so the jobs may safely go on using it
+     */
+    for (int i = 0; i < numDestructions; i++) {
+        destructionsStarted.ref();
+        cache.colorSpaceIsDestroyed(src);
+        destructionsFinished.ref();
+
+        QThread::usleep(100);
+    }
+
+    stopFlag.storeRelease(1);
+    pool.waitForDone();
+
+    QCOMPARE(numStaleTransformations.loadAcquire(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestKoColorConversionCache)
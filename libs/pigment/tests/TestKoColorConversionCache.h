@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef _TEST_KO_COLOR_CONVERSION_CACHE_H_
+#define _TEST_KO_COLOR_CONVERSION_CACHE_H_
+
+#include <QObject>
+
+class TestKoColorConversionCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void testDestroyedColorSpaceIsDropped();
+    void testConcurrentDestruction();
+};
+
+#endif
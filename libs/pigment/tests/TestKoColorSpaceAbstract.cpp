@@ -6,8 +6,16 @@
 
 #include "KoColorSpaceAbstract.h"
 #include "KoColorSpaceTraits.h"
+#include "KoAlphaMaskApplicatorFactory.h"
+#include "KoColorModelStandardIdsUtils.h"
 
 #include <cfloat>
+#include <type_traits>
+
+#include <QScopedPointer>
+#include <QVector>
+
+#include <KoConfig.h>
 
 #include <simpletest.h>
 
@@ -398,5 +406,204 @@ void TestKoColorSpaceAbstract::testMixColorsOpU8NoAlphaLinear()
     QCOMPARE(outputPixel[COLOR_CHANNEL_2], mixOpNoAlphaExpectedColor(pixel1[COLOR_CHANNEL_2], pixel2[COLOR_CHANNEL_2], weights));
 }
 
+template <typename channels_type, int channels_nb>
+void testMixerMatchesMixColorsImpl()
+{
+    typedef KoColorSpaceTrait<channels_type, channels_nb, channels_nb - 1> Trait;
+    QScopedPointer<KoMixColorsOp> op(new KoMixColorsOpImpl<Trait>);
+
+    const int numPixels = 257;
+    const qreal unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+
+    QVector<channels_type> pixels(numPixels * channels_nb);
+    QVector<qint16> weights(numPixels);
+    int weightSum = 0;
+
+    for (int i = 0; i < pixels.size(); i++) {
+        pixels[i] = channels_type(unitValue * (qrand() % 1001) / 1000.0);
+    }
+
+    // the last pixels are transparent to check the zero alpha case
+    for (int i = numPixels - 5; i < numPixels; i++) {
+        pixels[i * channels_nb + channels_nb - 1] = 0;
+    }
+
+    for (int i = 0; i < numPixels; i++) {
+        weights[i] = qrand() % 256;
+        weightSum += weights[i];
+    }
+
+    const quint8 *data = reinterpret_cast<const quint8*>(pixels.constData());
+    const int pixelSize = Trait::pixelSize;
+
+    auto compareResults = [] (const channels_type *expected, const channels_type *result) {
+        for (int i = 0; i < channels_nb; i++) {
+            if (std::is_integral<channels_type>::value) {
+                QCOMPARE(result[i], expected[i]);
+            } else {
+                QVERIFY(qAbs(qreal(result[i]) - qreal(expected[i])) < 1e-6);
+            }
+        }
+    };
+
+    channels_type expected[channels_nb];
+    channels_type result[channels_nb];
+
+    for (int numMixedPixels : {1, 2, 7, numPixels - 5, numPixels}) {
+        const int halfSize = numMixedPixels / 2;
+
+        // weighted mixing, fed in two chunks as KisColorSmudgeOp does
+        {
+            op->mixColors(data, weights.constData(), numMixedPixels,
+                          reinterpret_cast<quint8*>(expected), weightSum);
+
+            QScopedPointer<KoMixColorsOp::Mixer> mixer(op->createMixer());
+
+            int firstWeightSum = 0;
+            for (int i = 0; i < halfSize; i++) {
+                firstWeightSum += weights[i];
+            }
+
+            mixer->accumulate(data, weights.constData(), firstWeightSum, halfSize);
+            mixer->accumulate(data + halfSize * pixelSize, weights.constData() + halfSize,
+                              weightSum - firstWeightSum, numMixedPixels - halfSize);
+            mixer->computeMixedColor(reinterpret_cast<quint8*>(result));
+
+            QCOMPARE(mixer->currentWeightsSum(), qint64(weightSum));
+            compareResults(expected, result);
+        }
+
+        // average mixing
+        {
+            op->mixColors(data, numMixedPixels, reinterpret_cast<quint8*>(expected));
+
+            QScopedPointer<KoMixColorsOp::Mixer> mixer(op->createMixer());
+            mixer->accumulateAverage(data, halfSize);
+            mixer->accumulateAverage(data + halfSize * pixelSize, numMixedPixels - halfSize);
+            mixer->computeMixedColor(reinterpret_cast<quint8*>(result));
+
+            QCOMPARE(mixer->currentWeightsSum(), qint64(numMixedPixels));
+            compareResults(expected, result);
+        }
+    }
+}
+
+void TestKoColorSpaceAbstract::testMixerMatchesMixColors()
+{
+    /**
+     * RGBA- and GrayA-like layouts get a vectorized mixer, which
+     * must give exactly the same result as KoMixColorsOpImpl::mixColors()
+     */
+
+    testMixerMatchesMixColorsImpl<quint8, 4>();
+    testMixerMatchesMixColorsImpl<quint16, 4>();
+    testMixerMatchesMixColorsImpl<float, 4>();
+
+    testMixerMatchesMixColorsImpl<quint8, 2>();
+    testMixerMatchesMixColorsImpl<quint16, 2>();
+    testMixerMatchesMixColorsImpl<float, 2>();
+
+#ifdef HAVE_OPENEXR
+    testMixerMatchesMixColorsImpl<half, 4>();
+    testMixerMatchesMixColorsImpl<half, 2>();
+#endif
+}
+
+template <typename channels_type, int channels_nb, int alpha_pos>
+void testAlphaMaskApplicatorImpl()
+{
+    typedef KoColorSpaceTrait<channels_type, channels_nb, alpha_pos> Trait;
+
+    QScopedPointer<KoAlphaMaskApplicatorBase> applicator(
+        KoAlphaMaskApplicatorFactory::create(colorDepthIdForChannelType<channels_type>(),
+                                             channels_nb, alpha_pos));
+    QVERIFY(applicator);
+
+    // an odd number of pixels to check the tail processing as well
+    const int numPixels = 1023;
+    const int numBytes = numPixels * Trait::pixelSize;
+    const qreal unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+
+    QVector<float> mask(numPixels);
+    for (int i = 0; i < numPixels; i++) {
+        mask[i] = (qrand() % 1001) / 1000.0f;
+    }
+    mask[0] = 0.0f;
+    mask[1] = 1.0f;
+
+    QVector<channels_type> pixels(numPixels * channels_nb);
+    for (int i = 0; i < pixels.size(); i++) {
+        pixels[i] = channels_type(unitValue * (qrand() % 1001) / 1000.0);
+    }
+
+    QVector<channels_type> brushColor(channels_nb);
+    for (int i = 0; i < channels_nb; i++) {
+        brushColor[i] = channels_type(unitValue * (qrand() % 1001) / 1000.0);
+    }
+
+    const quint8 *brushColorPtr = reinterpret_cast<const quint8*>(brushColor.constData());
+
+    for (int offset : {0, 1, 3}) {
+        const int nPixels = numPixels - offset;
+        const int startByte = offset * Trait::pixelSize;
+
+        {
+            QByteArray expected(reinterpret_cast<const char*>(pixels.constData()), numBytes);
+            QByteArray result = expected;
+
+            Trait::applyInverseAlphaNormedFloatMask(reinterpret_cast<quint8*>(expected.data()) + startByte,
+                                                    mask.constData() + offset, nPixels);
+            applicator->applyInverseNormedFloatMask(reinterpret_cast<quint8*>(result.data()) + startByte,
+                                                    mask.constData() + offset, nPixels);
+
+            QCOMPARE(result, expected);
+        }
+
+        {
+            QByteArray expected(numBytes, 0);
+            QByteArray result(numBytes, 0);
+
+            Trait::fillInverseAlphaNormedFloatMaskWithColor(reinterpret_cast<quint8*>(expected.data()) + startByte,
+                                                            mask.constData() + offset, brushColorPtr, nPixels);
+            applicator->fillInverseAlphaNormedFloatMaskWithColor(reinterpret_cast<quint8*>(result.data()) + startByte,
+                                                                 mask.constData() + offset, brushColorPtr, nPixels);
+
+            QCOMPARE(result, expected);
+        }
+    }
+}
+
+void TestKoColorSpaceAbstract::testAlphaMaskApplicatorMatchesTrait()
+{
+    /**
+     * The vectorized applicators must give bit-exact results with
+     * the scalar code in KoColorSpaceTrait for all the depths and
+     * RGBA, GrayA, CMYKA and Alpha layouts
+     */
+
+    testAlphaMaskApplicatorImpl<quint8, 4, 3>();
+    testAlphaMaskApplicatorImpl<quint16, 4, 3>();
+    testAlphaMaskApplicatorImpl<float, 4, 3>();
+
+    testAlphaMaskApplicatorImpl<quint8, 2, 1>();
+    testAlphaMaskApplicatorImpl<quint16, 2, 1>();
+    testAlphaMaskApplicatorImpl<float, 2, 1>();
+
+    testAlphaMaskApplicatorImpl<quint8, 5, 4>();
+    testAlphaMaskApplicatorImpl<quint16, 5, 4>();
+    testAlphaMaskApplicatorImpl<float, 5, 4>();
+
+    testAlphaMaskApplicatorImpl<quint8, 1, 0>();
+    testAlphaMaskApplicatorImpl<quint16, 1, 0>();
+    testAlphaMaskApplicatorImpl<float, 1, 0>();
+
+#ifdef HAVE_OPENEXR
+    testAlphaMaskApplicatorImpl<half, 4, 3>();
+    testAlphaMaskApplicatorImpl<half, 2, 1>();
+    testAlphaMaskApplicatorImpl<half, 5, 4>();
+    testAlphaMaskApplicatorImpl<half, 1, 0>();
+#endif
+}
+
 
 QTEST_GUILESS_MAIN(TestKoColorSpaceAbstract)
@@ -0,0 +1,683 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoOptimizedCompositeOps.h"
+
+#include <simpletest.h>
+
+#include <KoConfig.h>
+#include <config-vc.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpaceTraits.h>
+#include <KoColorSpaceMaths.h>
+#include <KoCompositeOpRegistry.h>
+#include <KoCompositeOps.h>
+#include <KoOptimizedCompositeOpFactory.h>
+#include <kis_debug.h>
+
+#if defined HAVE_OPENEXR && defined HAVE_VC
+#include <KoOptimizedCompositeOpOver128.h>
+#include <KoOptimizedCompositeOpCopy128.h>
+#include <KoOptimizedCompositeOpAlphaDarken128.h>
+#include <KoOptimizedCompositeOpGeneric.h>
+#include <KoOptimizedCompositeOpGenericHSL.h>
+#endif
+
+#include "sdk/tests/testpigment.h"
+
+namespace {
+
+/**
+ * The maximum difference between the results of the scalar and the
+ * optimized ops measured in the raw channel values. The colors are
+ * compared premultiplied by alpha, the values of the floating point
+ * channels relatively to their magnitude.
+ *
+ * The integer scalar ops round three products and a division per
+ * channel, the vectorized blending functions may add one more unit
+ * (two units for Vivid Light in 16 bits).
+ */
+template<typename channels_type>
+struct CompositionTolerance;
+
+template<>
+struct CompositionTolerance<quint8>
+{
+    static float color() { return 4.0f; }
+    static float alpha() { return 1.0f; }
+};
+
+template<>
+struct CompositionTolerance<quint16>
+{
+    static float color() { return 5.0f; }
+    static float alpha() { return 1.0f; }
+};
+
+template<>
+struct CompositionTolerance<float>
+{
+    static float color() { return 1e-5f; }
+    static float alpha() { return 1e-5f; }
+};
+
+#ifdef HAVE_OPENEXR
+/**
+ * The scalar half ops round every intermediate result to half, the
+ * optimized ones compute in floats and round only the final result
+ * (one half ulp is about 1e-3 near the unit value)
+ */
+template<>
+struct CompositionTolerance<half>
+{
+    static float color() { return 4e-3f; }
+    static float alpha() { return 2e-3f; }
+};
+#endif
+
+template<typename channels_type>
+channels_type randomChannelValue()
+{
+    // the grid is exact for the floating point channels, so the scalar
+    // and the vectorized sums of the channels are equal. The largest
+    // value is still rounded to the unit value in the integer channels,
+    // but the floating point ones never hit the infinite results of
+    // the division by (1 - src)
+    const float value = float(qrand() % 4096) / 4096.0f;
+    return KoColorSpaceMaths<float, channels_type>::scaleToA(value);
+}
+
+#ifdef HAVE_OPENEXR
+template<>
+half randomChannelValue<half>()
+{
+    // half has only 11 significant bits, so the largest value of the
+    // 4096 grid would be rounded to the unit value
+    return half(float(qrand() % 2048) / 2048.0f);
+}
+#endif
+
+template<typename channels_type>
+void fillRandomPixels(quint8 *buffer, int numPixels)
+{
+    channels_type *pixel = reinterpret_cast<channels_type*>(buffer);
+
+    for (int i = 0; i < numPixels; i++) {
+        for (int c = 0; c < 3; c++) {
+            pixel[c] = randomChannelValue<channels_type>();
+        }
+
+        // the ops have special cases for transparent and opaque pixels
+        switch (qrand() % 8) {
+        case 0:
+            pixel[3] = KoColorSpaceMathsTraits<channels_type>::zeroValue;
+            break;
+        case 1:
+            pixel[3] = KoColorSpaceMathsTraits<channels_type>::unitValue;
+            break;
+        default:
+            pixel[3] = randomChannelValue<channels_type>();
+        }
+
+        pixel += 4;
+    }
+}
+
+bool valuesFuzzyEqual(float reference, float optimized, float tolerance, float unitValue)
+{
+    // infinite values of the floating point channels are equal too
+    if (reference == optimized) return true;
+
+    const float scale = qMax(1.0f, qMax(qAbs(reference), qAbs(optimized)) / unitValue);
+    return qAbs(reference - optimized) <= tolerance * scale;
+}
+
+template<typename channels_type>
+bool comparePixels(const quint8 *referenceBuffer, const quint8 *optimizedBuffer, int numPixels)
+{
+    const float unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+
+    const channels_type *reference = reinterpret_cast<const channels_type*>(referenceBuffer);
+    const channels_type *optimized = reinterpret_cast<const channels_type*>(optimizedBuffer);
+
+    for (int i = 0; i < numPixels; i++) {
+        const float referenceAlpha = reference[3];
+        const float optimizedAlpha = optimized[3];
+
+        bool equal = valuesFuzzyEqual(referenceAlpha, optimizedAlpha,
+                                      CompositionTolerance<channels_type>::alpha(), unitValue);
+
+        for (int c = 0; c < 3; c++) {
+            equal &= valuesFuzzyEqual(float(reference[c]) * referenceAlpha / unitValue,
+                                      float(optimized[c]) * optimizedAlpha / unitValue,
+                                      CompositionTolerance<channels_type>::color(), unitValue);
+        }
+
+        if (!equal) {
+            qDebug() << "Pixel differs:" << ppVar(i);
+            qDebug() << "Exp:" << float(reference[0]) << float(reference[1]) << float(reference[2]) << float(reference[3]);
+            qDebug() << "Act:" << float(optimized[0]) << float(optimized[1]) << float(optimized[2]) << float(optimized[3]);
+            return false;
+        }
+
+        reference += 4;
+        optimized += 4;
+    }
+
+    return true;
+}
+
+/**
+ * Composites the same random pixels with both ops with and without
+ * a mask, with different opacity, flow, average opacity and channel
+ * flags. Only Alpha Darken uses flow and average opacity.
+ */
+template<typename channels_type>
+void compareCompositeOps(const KoCompositeOp *referenceOp, const KoCompositeOp *optimizedOp)
+{
+    // the number of columns is odd to go through the unaligned tails of the rows
+    const int rows = 3;
+    const int cols = 67;
+    const int numPixels = rows * cols;
+    const int pixelSize = 4 * sizeof(channels_type);
+
+    QBitArray colorChannelDisabled(4, true);
+    colorChannelDisabled.clearBit(0);
+
+    QBitArray alphaLocked(4, true);
+    alphaLocked.clearBit(3);
+
+    QBitArray colorChannelDisabledAlphaLocked(4, true);
+    colorChannelDisabledAlphaLocked.clearBit(0);
+    colorChannelDisabledAlphaLocked.clearBit(3);
+
+    const QVector<QBitArray> channelFlagsVariants =
+        {QBitArray(), colorChannelDisabled, alphaLocked, colorChannelDisabledAlphaLocked};
+
+    struct OpacityVariant {
+        float opacity;
+        float flow;
+        float averageOpacity;
+    };
+
+    // 128/255 is exactly representable in the integer channels
+    const float halfOpacity = 128.0f / 255.0f;
+
+    const QVector<OpacityVariant> opacityVariants = {
+        {1.0f, 1.0f, 1.0f},
+        {halfOpacity, 1.0f, halfOpacity},
+        {halfOpacity, 1.0f, 1.0f},
+        {halfOpacity, 0.5f, halfOpacity},
+        {halfOpacity, 0.5f, 1.0f}
+    };
+
+    for (bool haveMask : {false, true}) {
+        Q_FOREACH (const OpacityVariant &variant, opacityVariants) {
+            Q_FOREACH (const QBitArray &channelFlags, channelFlagsVariants) {
+                QVector<quint8> src(numPixels * pixelSize);
+                QVector<quint8> dst(numPixels * pixelSize);
+                QVector<quint8> mask(numPixels);
+
+                fillRandomPixels<channels_type>(src.data(), numPixels);
+                fillRandomPixels<channels_type>(dst.data(), numPixels);
+                for (int i = 0; i < numPixels; i++) {
+                    mask[i] = qrand() % 256;
+                }
+
+                QVector<quint8> referenceDst = dst;
+                QVector<quint8> optimizedDst = dst;
+
+                KoCompositeOp::ParameterInfo params;
+                params.srcRowStart = src.constData();
+                params.srcRowStride = cols * pixelSize;
+                params.dstRowStride = cols * pixelSize;
+                params.maskRowStart = haveMask ? mask.constData() : 0;
+                params.maskRowStride = cols;
+                params.rows = rows;
+                params.cols = cols;
+                params.setOpacityAndAverage(variant.opacity, variant.averageOpacity);
+                params.flow = variant.flow;
+                params.channelFlags = channelFlags;
+
+                params.dstRowStart = referenceDst.data();
+                referenceOp->composite(params);
+
+                params.dstRowStart = optimizedDst.data();
+                optimizedOp->composite(params);
+
+                if (!comparePixels<channels_type>(referenceDst.constData(), optimizedDst.constData(), numPixels)) {
+                    qDebug() << ppVar(haveMask) << ppVar(variant.opacity) << ppVar(variant.flow)
+                             << ppVar(variant.averageOpacity) << ppVar(channelFlags);
+                    QFAIL("The optimized op differs from the scalar one");
+                }
+            }
+        }
+    }
+}
+
+QStringList genericSCOpIds()
+{
+    return {
+        COMPOSITE_MULT, COMPOSITE_SCREEN, COMPOSITE_OVERLAY, COMPOSITE_HARD_LIGHT,
+        COMPOSITE_SOFT_LIGHT_PHOTOSHOP, COMPOSITE_SOFT_LIGHT_SVG, COMPOSITE_DODGE,
+        COMPOSITE_BURN, COMPOSITE_LINEAR_DODGE, COMPOSITE_ADD, COMPOSITE_LINEAR_BURN,
+        COMPOSITE_LINEAR_LIGHT, COMPOSITE_VIVID_LIGHT, COMPOSITE_PIN_LIGHT,
+        COMPOSITE_DARKEN, COMPOSITE_LIGHTEN, COMPOSITE_DIFF, COMPOSITE_EXCLUSION,
+        COMPOSITE_SUBTRACT, COMPOSITE_INVERSE_SUBTRACT, COMPOSITE_DIVIDE,
+        COMPOSITE_GRAIN_MERGE, COMPOSITE_GRAIN_EXTRACT, COMPOSITE_ALLANON,
+        COMPOSITE_GEOMETRIC_MEAN, COMPOSITE_HARD_MIX_PHOTOSHOP,
+        COMPOSITE_HARD_MIX_SOFTER_PHOTOSHOP
+    };
+}
+
+/**
+ * Creates the scalar op that is registered in the color space
+ * when there is no optimized version of it, see AddGeneralOps
+ */
+template<class Traits>
+KoCompositeOp* createReferenceGenericSCOp(const KoColorSpace *cs, const QString &id)
+{
+    typedef typename Traits::channels_type Arg;
+
+#define REFERENCE_SC_OP(opId, compositeFunc)                                                             \
+    if (id == opId) {                                                                                    \
+        return new KoCompositeOpGenericSC<Traits, &compositeFunc<Arg>>(cs, id, KoCompositeOp::categoryMisc()); \
+    }
+
+    REFERENCE_SC_OP(COMPOSITE_MULT, cfMultiply)
+    REFERENCE_SC_OP(COMPOSITE_SCREEN, cfScreen)
+    REFERENCE_SC_OP(COMPOSITE_OVERLAY, cfOverlay)
+    REFERENCE_SC_OP(COMPOSITE_HARD_LIGHT, cfHardLight)
+    REFERENCE_SC_OP(COMPOSITE_SOFT_LIGHT_PHOTOSHOP, cfSoftLight)
+    REFERENCE_SC_OP(COMPOSITE_SOFT_LIGHT_SVG, cfSoftLightSvg)
+    REFERENCE_SC_OP(COMPOSITE_DODGE, cfColorDodge)
+    REFERENCE_SC_OP(COMPOSITE_BURN, cfColorBurn)
+    REFERENCE_SC_OP(COMPOSITE_LINEAR_DODGE, cfAddition)
+    REFERENCE_SC_OP(COMPOSITE_ADD, cfAddition)
+    REFERENCE_SC_OP(COMPOSITE_LINEAR_BURN, cfLinearBurn)
+    REFERENCE_SC_OP(COMPOSITE_LINEAR_LIGHT, cfLinearLight)
+    REFERENCE_SC_OP(COMPOSITE_VIVID_LIGHT, cfVividLight)
+    REFERENCE_SC_OP(COMPOSITE_PIN_LIGHT, cfPinLight)
+    REFERENCE_SC_OP(COMPOSITE_DARKEN, cfDarkenOnly)
+    REFERENCE_SC_OP(COMPOSITE_LIGHTEN, cfLightenOnly)
+    REFERENCE_SC_OP(COMPOSITE_DIFF, cfDifference)
+    REFERENCE_SC_OP(COMPOSITE_EXCLUSION, cfExclusion)
+    REFERENCE_SC_OP(COMPOSITE_SUBTRACT, cfSubtract)
+    REFERENCE_SC_OP(COMPOSITE_INVERSE_SUBTRACT, cfInverseSubtract)
+    REFERENCE_SC_OP(COMPOSITE_DIVIDE, cfDivide)
+    REFERENCE_SC_OP(COMPOSITE_GRAIN_MERGE, cfGrainMerge)
+    REFERENCE_SC_OP(COMPOSITE_GRAIN_EXTRACT, cfGrainExtract)
+    REFERENCE_SC_OP(COMPOSITE_ALLANON, cfAllanon)
+    REFERENCE_SC_OP(COMPOSITE_GEOMETRIC_MEAN, cfGeometricMean)
+    REFERENCE_SC_OP(COMPOSITE_HARD_MIX_PHOTOSHOP, cfHardMixPhotoshop)
+    REFERENCE_SC_OP(COMPOSITE_HARD_MIX_SOFTER_PHOTOSHOP, cfHardMixSofterPhotoshop)
+
+#undef REFERENCE_SC_OP
+
+    return nullptr;
+}
+
+template<class Traits, class Selector = _Private::OptimizedOpsSelector<Traits>>
+void checkGenericSCOp(const KoColorSpace *cs, const QString &id)
+{
+    QScopedPointer<KoCompositeOp> optimizedOp(
+        Selector::createGenericSCOp(cs, id, KoCompositeOp::categoryMisc()));
+
+    if (!optimizedOp) {
+        QSKIP("The op is not optimized for this CPU or build");
+    }
+
+    QScopedPointer<KoCompositeOp> referenceOp(createReferenceGenericSCOp<Traits>(cs, id));
+    QVERIFY(referenceOp);
+
+    compareCompositeOps<typename Traits::channels_type>(referenceOp.data(), optimizedOp.data());
+}
+
+QStringList genericHSLOpIds()
+{
+    return {
+        COMPOSITE_COLOR, COMPOSITE_HUE, COMPOSITE_SATURATION, COMPOSITE_INC_SATURATION,
+        COMPOSITE_DEC_SATURATION, COMPOSITE_LUMINIZE, COMPOSITE_INC_LUMINOSITY,
+        COMPOSITE_DEC_LUMINOSITY, COMPOSITE_DARKER_COLOR, COMPOSITE_LIGHTER_COLOR,
+
+        COMPOSITE_COLOR_HSI, COMPOSITE_HUE_HSI, COMPOSITE_SATURATION_HSI,
+        COMPOSITE_INC_SATURATION_HSI, COMPOSITE_DEC_SATURATION_HSI, COMPOSITE_INTENSITY,
+        COMPOSITE_INC_INTENSITY, COMPOSITE_DEC_INTENSITY,
+
+        COMPOSITE_COLOR_HSL, COMPOSITE_HUE_HSL, COMPOSITE_SATURATION_HSL,
+        COMPOSITE_INC_SATURATION_HSL, COMPOSITE_DEC_SATURATION_HSL, COMPOSITE_LIGHTNESS,
+        COMPOSITE_INC_LIGHTNESS, COMPOSITE_DEC_LIGHTNESS,
+
+        COMPOSITE_COLOR_HSV, COMPOSITE_HUE_HSV, COMPOSITE_SATURATION_HSV,
+        COMPOSITE_INC_SATURATION_HSV, COMPOSITE_DEC_SATURATION_HSV, COMPOSITE_VALUE,
+        COMPOSITE_INC_VALUE, COMPOSITE_DEC_VALUE
+    };
+}
+
+/**
+ * Creates the scalar op that is registered in the color space
+ * when there is no optimized version of it, see AddRGBOps
+ */
+template<class Traits>
+KoCompositeOp* createReferenceGenericHSLOp(const KoColorSpace *cs, const QString &id)
+{
+    typedef float Arg;
+
+#define REFERENCE_HSL_OP(opId, compositeFunc, HSXType)                                                    \
+    if (id == opId) {                                                                                     \
+        return new KoCompositeOpGenericHSL<Traits, &compositeFunc<HSXType, Arg>>(cs, id, KoCompositeOp::categoryMisc()); \
+    }
+
+    REFERENCE_HSL_OP(COMPOSITE_COLOR, cfColor, HSYType)
+    REFERENCE_HSL_OP(COMPOSITE_HUE, cfHue, HSYType)
+    REFERENCE_HSL_OP(COMPOSITE_SATURATION, cfSaturation, HSYType)
+    REFERENCE_HSL_OP(COMPOSITE_INC_SATURATION, cfIncreaseSaturation, HSYType)
+    REFERENCE_HSL_OP(COMPOSITE_DEC_SATURATION, cfDecreaseSaturation, HSYType)
+    REFERENCE_HSL_OP(COMPOSITE_LUMINIZE, cfLightness, HSYType)
+    REFERENCE_HSL_OP(COMPOSITE_INC_LUMINOSITY, cfIncreaseLightness, HSYType)
+    REFERENCE_HSL_OP(COMPOSITE_DEC_LUMINOSITY, cfDecreaseLightness, HSYType)
+    REFERENCE_HSL_OP(COMPOSITE_DARKER_COLOR, cfDarkerColor, HSYType)
+    REFERENCE_HSL_OP(COMPOSITE_LIGHTER_COLOR, cfLighterColor, HSYType)
+
+    REFERENCE_HSL_OP(COMPOSITE_COLOR_HSI, cfColor, HSIType)
+    REFERENCE_HSL_OP(COMPOSITE_HUE_HSI, cfHue, HSIType)
+    REFERENCE_HSL_OP(COMPOSITE_SATURATION_HSI, cfSaturation, HSIType)
+    REFERENCE_HSL_OP(COMPOSITE_INC_SATURATION_HSI, cfIncreaseSaturation, HSIType)
+    REFERENCE_HSL_OP(COMPOSITE_DEC_SATURATION_HSI, cfDecreaseSaturation, HSIType)
+    REFERENCE_HSL_OP(COMPOSITE_INTENSITY, cfLightness, HSIType)
+    REFERENCE_HSL_OP(COMPOSITE_INC_INTENSITY, cfIncreaseLightness, HSIType)
+    REFERENCE_HSL_OP(COMPOSITE_DEC_INTENSITY, cfDecreaseLightness, HSIType)
+
+    REFERENCE_HSL_OP(COMPOSITE_COLOR_HSL, cfColor, HSLType)
+    REFERENCE_HSL_OP(COMPOSITE_HUE_HSL, cfHue, HSLType)
+    REFERENCE_HSL_OP(COMPOSITE_SATURATION_HSL, cfSaturation, HSLType)
+    REFERENCE_HSL_OP(COMPOSITE_INC_SATURATION_HSL, cfIncreaseSaturation, HSLType)
+    REFERENCE_HSL_OP(COMPOSITE_DEC_SATURATION_HSL, cfDecreaseSaturation, HSLType)
+    REFERENCE_HSL_OP(COMPOSITE_LIGHTNESS, cfLightness, HSLType)
+    REFERENCE_HSL_OP(COMPOSITE_INC_LIGHTNESS, cfIncreaseLightness, HSLType)
+    REFERENCE_HSL_OP(COMPOSITE_DEC_LIGHTNESS, cfDecreaseLightness, HSLType)
+
+    REFERENCE_HSL_OP(COMPOSITE_COLOR_HSV, cfColor, HSVType)
+    REFERENCE_HSL_OP(COMPOSITE_HUE_HSV, cfHue, HSVType)
+    REFERENCE_HSL_OP(COMPOSITE_SATURATION_HSV, cfSaturation, HSVType)
+    REFERENCE_HSL_OP(COMPOSITE_INC_SATURATION_HSV, cfIncreaseSaturation, HSVType)
+    REFERENCE_HSL_OP(COMPOSITE_DEC_SATURATION_HSV, cfDecreaseSaturation, HSVType)
+    REFERENCE_HSL_OP(COMPOSITE_VALUE, cfLightness, HSVType)
+    REFERENCE_HSL_OP(COMPOSITE_INC_VALUE, cfIncreaseLightness, HSVType)
+    REFERENCE_HSL_OP(COMPOSITE_DEC_VALUE, cfDecreaseLightness, HSVType)
+
+#undef REFERENCE_HSL_OP
+
+    return nullptr;
+}
+
+template<class Traits, class Selector = _Private::OptimizedOpsSelector<Traits>>
+void checkGenericHSLOp(const KoColorSpace *cs, const QString &id)
+{
+    QScopedPointer<KoCompositeOp> optimizedOp(
+        Selector::createGenericHSLOp(cs, id, KoCompositeOp::categoryMisc()));
+
+    if (!optimizedOp) {
+        QSKIP("The op is not optimized for this CPU or build");
+    }
+
+    QScopedPointer<KoCompositeOp> referenceOp(createReferenceGenericHSLOp<Traits>(cs, id));
+    QVERIFY(referenceOp);
+
+    compareCompositeOps<typename Traits::channels_type>(referenceOp.data(), optimizedOp.data());
+}
+
+#ifdef HAVE_OPENEXR
+
+/**
+ * The ops created by the factory of the library, which use F16C
+ * instructions to convert the pixels on AVX2 CPUs
+ */
+struct FactoryRgbF16Ops
+{
+    static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
+        return _Private::OptimizedOpsSelector<KoRgbF16Traits>::createOverOp(cs);
+    }
+    static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
+        return _Private::OptimizedOpsSelector<KoRgbF16Traits>::createCopyOp(cs);
+    }
+    static KoCompositeOp* createAlphaDarkenOpHard(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardF16(cs);
+    }
+    static KoCompositeOp* createAlphaDarkenOpCreamy(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(cs);
+    }
+};
+
+/**
+ * The same ops instantiated in the test itself, which is compiled for
+ * the baseline architecture, so they convert the pixels with OpenEXR's
+ * half instead of F16C instructions. If the test is compiled with AVX2
+ * enabled, there is nothing to check here.
+ */
+struct BaselineRgbF16Ops
+{
+#if defined HAVE_VC && !defined __AVX2__
+    static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
+        return new KoOptimizedCompositeOpOverF16<Vc::CurrentImplementation::current()>(cs);
+    }
+    static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
+        return new KoOptimizedCompositeOpCopyF16<Vc::CurrentImplementation::current()>(cs);
+    }
+    static KoCompositeOp* createAlphaDarkenOpHard(const KoColorSpace *cs) {
+        return new KoOptimizedCompositeOpAlphaDarkenHardF16<Vc::CurrentImplementation::current()>(cs);
+    }
+    static KoCompositeOp* createAlphaDarkenOpCreamy(const KoColorSpace *cs) {
+        return new KoOptimizedCompositeOpAlphaDarkenCreamyF16<Vc::CurrentImplementation::current()>(cs);
+    }
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return createOptimizedCompositeOpGenericSC<Vc::CurrentImplementation::current(), half>(cs, id, category);
+    }
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, const QString &id, const QString &category) {
+        return createOptimizedCompositeOpGenericHSL<Vc::CurrentImplementation::current(), KoRgbF16Traits>(cs, id, category);
+    }
+#else
+    static KoCompositeOp* createOverOp(const KoColorSpace *) { return nullptr; }
+    static KoCompositeOp* createCopyOp(const KoColorSpace *) { return nullptr; }
+    static KoCompositeOp* createAlphaDarkenOpHard(const KoColorSpace *) { return nullptr; }
+    static KoCompositeOp* createAlphaDarkenOpCreamy(const KoColorSpace *) { return nullptr; }
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *, const QString &, const QString &) { return nullptr; }
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *, const QString &, const QString &) { return nullptr; }
+#endif
+};
+
+/**
+ * The scalar ops that are registered in RGBA F16 color spaces
+ * when there are no optimized versions of them
+ */
+struct ReferenceRgbF16Ops
+{
+    static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
+        return new KoCompositeOpOver<KoRgbF16Traits>(cs);
+    }
+    static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
+        return new KoCompositeOpCopy2<KoRgbF16Traits>(cs);
+    }
+    static KoCompositeOp* createAlphaDarkenOpHard(const KoColorSpace *cs) {
+        return new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperHard>(cs);
+    }
+    static KoCompositeOp* createAlphaDarkenOpCreamy(const KoColorSpace *cs) {
+        return new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperCreamy>(cs);
+    }
+};
+
+template<class Ops>
+KoCompositeOp* createRgbF16Op(const KoColorSpace *cs, const QString &opName)
+{
+    if (opName == "Over") {
+        return Ops::createOverOp(cs);
+    } else if (opName == "Copy") {
+        return Ops::createCopyOp(cs);
+    } else if (opName == "AlphaDarkenHard") {
+        return Ops::createAlphaDarkenOpHard(cs);
+    } else if (opName == "AlphaDarkenCreamy") {
+        return Ops::createAlphaDarkenOpCreamy(cs);
+    }
+
+    return nullptr;
+}
+
+template<class Ops>
+void checkRgbF16Op(const KoColorSpace *cs, const QString &opName)
+{
+    QScopedPointer<KoCompositeOp> optimizedOp(createRgbF16Op<Ops>(cs, opName));
+
+    if (!optimizedOp) {
+        QSKIP("The op is not optimized for this CPU or build");
+    }
+
+    QScopedPointer<KoCompositeOp> referenceOp(createRgbF16Op<ReferenceRgbF16Ops>(cs, opName));
+    QVERIFY(referenceOp);
+
+    compareCompositeOps<half>(referenceOp.data(), optimizedOp.data());
+}
+
+const KoColorSpace* rgbF16ColorSpace()
+{
+    return KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Float16BitsColorDepthID.id(), 0);
+}
+
+#endif /* HAVE_OPENEXR */
+
+}
+
+void TestKoOptimizedCompositeOps::testGenericSCOps_data()
+{
+    QTest::addColumn<QString>("traitsId");
+    QTest::addColumn<QString>("compositeOpId");
+
+    QStringList traitsIds = {"BgrU8", "LabU8", "RgbF32", "BgrU16"};
+#ifdef HAVE_OPENEXR
+    traitsIds << "RgbF16" << "RgbF16Baseline";
+#endif
+
+    Q_FOREACH (const QString &traitsId, traitsIds) {
+        Q_FOREACH (const QString &id, genericSCOpIds()) {
+            const QString name = QString("%1 %2").arg(traitsId).arg(id);
+            QTest::newRow(name.toLatin1().data()) << traitsId << id;
+        }
+    }
+}
+
+void TestKoOptimizedCompositeOps::testGenericSCOps()
+{
+    /**
+     * The optimized separable ops should give the same result as
+     * KoCompositeOpGenericSC with the same blending function
+     */
+
+    QFETCH(QString, traitsId);
+    QFETCH(QString, compositeOpId);
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    if (traitsId == "BgrU8") {
+        checkGenericSCOp<KoBgrU8Traits>(registry->rgb8(), compositeOpId);
+    } else if (traitsId == "LabU8") {
+        checkGenericSCOp<KoLabU8Traits>(
+            registry->colorSpace(LABAColorModelID.id(), Integer8BitsColorDepthID.id(), 0), compositeOpId);
+    } else if (traitsId == "RgbF32") {
+        checkGenericSCOp<KoRgbF32Traits>(
+            registry->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), 0), compositeOpId);
+    } else if (traitsId == "BgrU16") {
+        checkGenericSCOp<KoBgrU16Traits>(registry->rgb16(), compositeOpId);
+#ifdef HAVE_OPENEXR
+    } else if (traitsId == "RgbF16") {
+        checkGenericSCOp<KoRgbF16Traits>(rgbF16ColorSpace(), compositeOpId);
+    } else if (traitsId == "RgbF16Baseline") {
+        checkGenericSCOp<KoRgbF16Traits, BaselineRgbF16Ops>(rgbF16ColorSpace(), compositeOpId);
+#endif
+    }
+}
+
+void TestKoOptimizedCompositeOps::testGenericHSLOps_data()
+{
+    QTest::addColumn<QString>("traitsId");
+    QTest::addColumn<QString>("compositeOpId");
+
+    QStringList traitsIds = {"BgrU8", "RgbF32", "BgrU16"};
+#ifdef HAVE_OPENEXR
+    traitsIds << "RgbF16" << "RgbF16Baseline";
+#endif
+
+    Q_FOREACH (const QString &traitsId, traitsIds) {
+        Q_FOREACH (const QString &id, genericHSLOpIds()) {
+            const QString name = QString("%1 %2").arg(traitsId).arg(id);
+            QTest::newRow(name.toLatin1().data()) << traitsId << id;
+        }
+    }
+}
+
+void TestKoOptimizedCompositeOps::testGenericHSLOps()
+{
+    /**
+     * The optimized non-separable ops should give the same result as
+     * KoCompositeOpGenericHSL with the same blending function, both
+     * for RGB and BGR layouts of the color channels
+     */
+
+    QFETCH(QString, traitsId);
+    QFETCH(QString, compositeOpId);
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    if (traitsId == "BgrU8") {
+        checkGenericHSLOp<KoBgrU8Traits>(registry->rgb8(), compositeOpId);
+    } else if (traitsId == "RgbF32") {
+        checkGenericHSLOp<KoRgbF32Traits>(
+            registry->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), 0), compositeOpId);
+    } else if (traitsId == "BgrU16") {
+        checkGenericHSLOp<KoBgrU16Traits>(registry->rgb16(), compositeOpId);
+#ifdef HAVE_OPENEXR
+    } else if (traitsId == "RgbF16") {
+        checkGenericHSLOp<KoRgbF16Traits>(rgbF16ColorSpace(), compositeOpId);
+    } else if (traitsId == "RgbF16Baseline") {
+        checkGenericHSLOp<KoRgbF16Traits, BaselineRgbF16Ops>(rgbF16ColorSpace(), compositeOpId);
+#endif
+    }
+}
+
+void TestKoOptimizedCompositeOps::testRgbF16Ops_data()
+{
+    QTest::addColumn<QString>("opName");
+    QTest::addColumn<bool>("useBaselineOps");
+
+    Q_FOREACH (const QString &opName, QStringList({"Over", "Copy", "AlphaDarkenHard", "AlphaDarkenCreamy"})) {
+        QTest::newRow(opName.toLatin1().data()) << opName << false;
+        QTest::newRow(QString("%1 baseline").arg(opName).toLatin1().data()) << opName << true;
+    }
+}
+
+void TestKoOptimizedCompositeOps::testRgbF16Ops()
+{
+    /**
+     * The optimized RGBA F16 ops should give the same result as
+     * the scalar ones, both when the pixels are converted with F16C
+     * instructions and with OpenEXR's half
+     */
+
+#ifdef HAVE_OPENEXR
+    QFETCH(QString, opName);
+    QFETCH(bool, useBaselineOps);
+
+    if (useBaselineOps) {
+        checkRgbF16Op<BaselineRgbF16Ops>(rgbF16ColorSpace(), opName);
+    } else {
+        checkRgbF16Op<FactoryRgbF16Ops>(rgbF16ColorSpace(), opName);
+    }
+#else
+    QSKIP("Krita is built without OpenEXR, there are no F16 color spaces");
+#endif
+}
+
+KISTEST_MAIN(TestKoOptimizedCompositeOps)
@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOOPTIMIZEDCOMPOSITEOPS_H
+#define TESTKOOPTIMIZEDCOMPOSITEOPS_H
+
+#include <QObject>
+
+class TestKoOptimizedCompositeOps : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testGenericSCOps_data();
+    void testGenericSCOps();
+    void testGenericHSLOps_data();
+    void testGenericHSLOps();
+    void testRgbF16Ops_data();
+    void testRgbF16Ops();
+};
+
+#endif // TESTKOOPTIMIZEDCOMPOSITEOPS_H
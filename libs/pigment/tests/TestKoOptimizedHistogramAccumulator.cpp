@@ -0,0 +1,130 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoOptimizedHistogramAccumulator.h"
+
+#include <simpletest.h>
+
+#include <cstring>
+
+#include <KoConfig.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
+#include <KoOptimizedHistogramAccumulatorFactory.h>
+#include <kis_debug.h>
+
+#include "sdk/tests/testpigment.h"
+
+void TestKoOptimizedHistogramAccumulator::testMatchesScaleToU8_data()
+{
+    QTest::addColumn<QString>("modelId");
+    QTest::addColumn<QString>("depthId");
+
+    const QList<KoID> models = {RGBAColorModelID, GrayAColorModelID, CMYKAColorModelID, LABAColorModelID};
+    const QList<KoID> depths = {
+        Integer8BitsColorDepthID,
+        Integer16BitsColorDepthID,
+#ifdef HAVE_OPENEXR
+        Float16BitsColorDepthID,
+#endif
+        Float32BitsColorDepthID
+    };
+
+    Q_FOREACH (const KoID &model, models) {
+        Q_FOREACH (const KoID &depth, depths) {
+            // there is no F16 Lab color space
+            if (model == LABAColorModelID && depth == Float16BitsColorDepthID) continue;
+
+            const QString name = QString("%1 %2").arg(model.id()).arg(depth.id());
+            QTest::newRow(name.toLatin1().data()) << model.id() << depth.id();
+        }
+    }
+}
+
+void TestKoOptimizedHistogramAccumulator::testMatchesScaleToU8()
+{
+    /**
+     * The accumulator should count exactly the same values as
+     * KoColorSpace::scaleToU8() gives, both for contiguous pixels
+     * and for every n-th pixel sampled
+     */
+
+    QFETCH(QString, modelId);
+    QFETCH(QString, depthId);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace(modelId, depthId, 0);
+    QVERIFY(cs);
+
+    const int numPixels = 1031;
+    const int pixelSize = cs->pixelSize();
+    const int numChannels = cs->channelCount();
+
+    QVector<quint8> pixels(numPixels * pixelSize);
+    QVector<float> channels(numChannels);
+
+    for (int i = 0; i < numPixels; i++) {
+        for (int c = 0; c < numChannels; c++) {
+            // a few values slightly out of range to check clamping
+            channels[c] = (qrand() % 1201) / 1000.0f - 0.1f;
+        }
+
+        // runs of equal pixels go to different partial histograms
+        if (i > 0 && i % 7 == 0) {
+            memcpy(pixels.data() + i * pixelSize, pixels.data() + (i - 1) * pixelSize, pixelSize);
+            continue;
+        }
+
+        cs->fromNormalisedChannelsValue(pixels.data() + i * pixelSize, channels);
+    }
+
+    QScopedPointer<KoOptimizedHistogramAccumulatorBase> accumulator(
+        KoOptimizedHistogramAccumulatorFactory::create(cs));
+    QVERIFY(accumulator);
+    QCOMPARE(accumulator->channelCount(), numChannels);
+
+    const int numBins = KoOptimizedHistogramAccumulatorBase::numBins;
+
+    for (int step : {1, 3}) {
+        const int numSamples = (numPixels + step - 1) / step;
+
+        QVector<quint32> expected(numChannels * numBins, 0);
+        for (int i = 0; i < numSamples; i++) {
+            const quint8 *pixel = pixels.constData() + i * step * pixelSize;
+
+            for (int c = 0; c < numChannels; c++) {
+                expected[c * numBins + cs->scaleToU8(pixel, c)]++;
+            }
+        }
+
+        accumulator->clear();
+
+        // feed the pixels in two chunks of odd sizes
+        const int firstChunk = numSamples / 2 + 1;
+        accumulator->accumulate(pixels.constData(), step * pixelSize, firstChunk);
+        accumulator->accumulate(pixels.constData() + firstChunk * step * pixelSize,
+                                step * pixelSize, numSamples - firstChunk);
+
+        QVector<quint32> result(numChannels * numBins, 0);
+        for (int c = 0; c < numChannels; c++) {
+            accumulator->addToBins(c, result.data() + c * numBins);
+        }
+
+        for (int c = 0; c < numChannels; c++) {
+            for (int bin = 0; bin < numBins; bin++) {
+                const int index = c * numBins + bin;
+
+                if (result[index] != expected[index]) {
+                    qDebug() << "Bin differs:" << ppVar(step) << ppVar(c) << ppVar(bin)
+                             << ppVar(result[index]) << ppVar(expected[index]);
+                    QFAIL("The accumulator and scaleToU8() give different histograms");
+                }
+            }
+        }
+    }
+}
+
+KISTEST_MAIN(TestKoOptimizedHistogramAccumulator)
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOOPTIMIZEDHISTOGRAMACCUMULATOR_H
+#define TESTKOOPTIMIZEDHISTOGRAMACCUMULATOR_H
+
+#include <QObject>
+
+class TestKoOptimizedHistogramAccumulator : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testMatchesScaleToU8_data();
+    void testMatchesScaleToU8();
+};
+
+#endif // TESTKOOPTIMIZEDHISTOGRAMACCUMULATOR_H
@@ -78,6 +78,7 @@
 // Krita Image
 #include <kis_image_animation_interface.h>
 #include <kis_config.h>
+#include <kis_image_config.h>
 #include <flake/kis_shape_layer.h>
 #include <kis_group_layer.h>
 #include <kis_image.h>
@@ -352,6 +353,7 @@ public:
     bool isAutosaving = false;
     bool disregardAutosaveFailure = false;
     int autoSaveFailureCount = 0;
+    int backgroundMemoryBudget = -1; // in MiB, -1 for the default one
 
     KUndo2Stack *undoStack = 0;
 
@@ -513,6 +515,7 @@ void KisDocument::Private::copyFromImpl(const Private &rhs, KisDocument *q, KisD
         gridConfig = rhs.gridConfig;
     }
     imageModifiedWithoutUndo = rhs.imageModifiedWithoutUndo;
+    backgroundMemoryBudget = rhs.backgroundMemoryBudget;
     m_bAutoDetectedMime = rhs.m_bAutoDetectedMime;
     m_path = rhs.m_path;
     m_file = rhs.m_file;
@@ -2267,6 +2270,18 @@ void KisDocument::setMirrorAxisConfig(const KisMirrorAxisConfig &config)
     emit sigMirrorAxisConfigChanged();
 }
 
+int KisDocument::backgroundMemoryBudget() const
+{
+    return d->backgroundMemoryBudget >= 0 ?
+        d->backgroundMemoryBudget :
+        KisImageConfig(true).backgroundDocumentMemoryBudget();
+}
+
+void KisDocument::setBackgroundMemoryBudget(int value)
+{
+    d->backgroundMemoryBudget = value;
+}
+
 void KisDocument::resetPath() {
     setPath(QString());
     setLocalFilePath(QString());
@@ -404,6 +404,15 @@ public:
     const KisMirrorAxisConfig& mirrorAxisConfig() const;
     void setMirrorAxisConfig(const KisMirrorAxisConfig& config);
 
+    /**
+     * The amount of memory (in MiB) the pixel data of the document
+     * may keep in RAM while the document is not shown in any view.
+     * Zero means the budget is unlimited, -1 (default) means that
+     * KisImageConfig::backgroundDocumentMemoryBudget() is used.
+     */
+    int backgroundMemoryBudget() const;
+    void setBackgroundMemoryBudget(int value);
+
     void clearUndoHistory();
 
     /**
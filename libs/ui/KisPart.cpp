@@ -68,6 +68,7 @@
 #include "KisBusyWaitBroker.h"
 #include "dialogs/kis_delayed_save_dialog.h"
 #include "kis_memory_statistics_server.h"
+#include "KisSwapOutToBudgetJob.h"
 #include "KisRecentFilesManager.h"
 
 Q_GLOBAL_STATIC(KisPart, s_instance)
@@ -148,6 +149,8 @@ KisPart::KisPart()
             this, SLOT(updateShortcuts()));
     connect(&d->idleWatcher, SIGNAL(startedIdleMode()),
             &d->animationCachePopulator, SLOT(slotRequestRegeneration()));
+    connect(&d->idleWatcher, SIGNAL(startedIdleMode()),
+            this, SLOT(slotEnforceBackgroundDocumentBudgets()));
     connect(&d->idleWatcher, SIGNAL(startedIdleMode()),
             KisMemoryStatisticsServer::instance(), SLOT(tryForceUpdateMemoryStatisticsWhileIdle()));
 
@@ -191,6 +194,40 @@ void KisPart::updateIdleWatcherConnections()
     d->idleWatcher.startCountdown();
 }
 
+void KisPart::slotEnforceBackgroundDocumentBudgets()
+{
+    QSet<KisDocument*> activeDocuments;
+
+    // in subwindow mode or with several main windows more than one
+    // document may be visible at the same time
+    Q_FOREACH (QPointer<KisView> view, d->views) {
+        if (view && view->isVisible()) {
+            activeDocuments.insert(view->document());
+        }
+    }
+
+    Q_FOREACH (QPointer<KisDocument> document, d->documents) {
+        if (!document || activeDocuments.contains(document.data())) continue;
+
+        KisImageSP image = document->image();
+
+        // don't interfere with the image if it is still processing something
+        if (!image || !image->isIdle()) continue;
+
+        const qint64 budget = qint64(document->backgroundMemoryBudget()) * 1024 * 1024;
+        if (budget <= 0) continue;
+
+        /**
+         * The size reported by the statistics is the upper bound of
+         * the memory occupied by the image, it is cheap to calculate
+         * and lets us skip the images that surely fit into the budget
+         */
+        if (KisMemoryStatisticsServer::instance()->fetchMemoryStatistics(image).imageSize <= budget) continue;
+
+        image->addSpontaneousJob(new KisSwapOutToBudgetJob(image->root(), budget));
+    }
+}
+
 void KisPart::addDocument(KisDocument *document, bool notify)
 {
     //dbgUI << "Adding document to part list" << document;
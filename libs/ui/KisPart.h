@@ -199,6 +199,15 @@ private Q_SLOTS:
 
     void updateIdleWatcherConnections();
 
+    /**
+     * Requests swapping out the least recently used tiles of the
+     * documents that are not visible in any view until they fit into
+     * their memory budgets, \see KisDocument::backgroundMemoryBudget().
+     * The tiles are collected by the image workers and swapped out in
+     * the swapper thread.
+     */
+    void slotEnforceBackgroundDocumentBudgets();
+
     void updateShortcuts();
 
 Q_SIGNALS:
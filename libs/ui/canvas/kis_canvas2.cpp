@@ -90,6 +90,7 @@
 #include "kis_wrapped_rect.h"
 #include "kis_algebra_2d.h"
 #include "kis_image_signal_router.h"
+#include "kis_layer_utils.h"
 
 #include "KisSnapPixelStrategy.h"
 
@@ -1026,8 +1027,28 @@ void KisCanvas2::slotUpdateRegionOfInterest()
 
     m_d->regionOfInterest = proposedRoi & imageRect;
 
+    /**
+     * The updates of the visible area are processed before the
+     * offscreen ones, so that the user sees the result of a filter
+     * applied to a huge image as soon as possible
+     */
+    KisImageSP image = this->image();
+    if (image) {
+        const QRect visibleRect =
+            m_d->coordinatesConverter->widgetRectInImagePixels().toAlignedRect() & imageRect;
+        image->setUpdatesPriorityRect(visibleRect);
+    }
+
     if (m_d->regionOfInterest != oldRegionOfInterest) {
         emit sigRegionOfInterestChanged(m_d->regionOfInterest);
+
+        /**
+         * Start loading the newly visible area from the swap before
+         * the user starts painting on it
+         */
+        if (image) {
+            KisLayerUtils::recursivePrefetchRect(image->root(), m_d->regionOfInterest);
+        }
     }
 }
 
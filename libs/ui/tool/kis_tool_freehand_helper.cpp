@@ -35,6 +35,7 @@
 #include "strokes/KisFreehandStrokeInfo.h"
 #include "KisAsyncronousStrokeUpdateHelper.h"
 #include "kis_canvas_resource_provider.h"
+#include "kis_layer_utils.h"
 
 #include <math.h>
 
@@ -53,6 +54,10 @@ const qreal SPACING_UPDATE_INTERVAL = 50.0;
 // used when airbrushing.
 const qreal TIMING_UPDATE_INTERVAL = 50.0;
 
+// How far into the future, in milliseconds, the stroke position is predicted to load the
+// pixels it is going to touch from the swap before the brush reaches them.
+const qreal STROKE_PREDICTION_INTERVAL = 200.0;
+
 struct KisToolFreehandHelper::Private
 {
     KoCanvasResourceProvider *resourceManager;
@@ -77,6 +82,9 @@ struct KisToolFreehandHelper::Private
     KisPaintInformation previousPaintInformation;
     KisPaintInformation olderPaintInformation;
 
+    // The area that has already been requested from the swap
+    QRect prefetchedRect;
+
     KisSmoothingOptionsSP smoothingOptions;
 
     // fake random sources for hovering outline *only*
@@ -273,6 +281,7 @@ void KisToolFreehandHelper::initPaintImpl(qreal startAngle,
     m_d->hasPaintAtLeastOnce = false;
 
     m_d->previousPaintInformation = pi;
+    m_d->prefetchedRect = QRect();
 
     m_d->resources = new KisResourcesSnapshot(image,
                                               currentNode,
@@ -449,6 +458,8 @@ void KisToolFreehandHelper::paintEvent(KoPointerEvent *event)
 
 void KisToolFreehandHelper::paint(KisPaintInformation &info)
 {
+    prefetchStrokeArea(info);
+
     /**
      * Smooth the coordinates out using the history and the
      * distance. This is a heavily modified version of an algo used in
@@ -610,6 +621,36 @@ void KisToolFreehandHelper::paint(KisPaintInformation &info)
     }
 }
 
+void KisToolFreehandHelper::prefetchStrokeArea(const KisPaintInformation &info)
+{
+    /**
+     * Extrapolate the stroke linearly and ask the layers to load
+     * the area it is going to pass from the swap in the background
+     */
+    const KisPaintInformation &prevInfo = m_d->previousPaintInformation;
+    const qreal timeDelta = info.currentTime() - prevInfo.currentTime();
+    if (timeDelta <= 0) return;
+
+    const QPointF velocity = (info.pos() - prevInfo.pos()) / timeDelta;
+    const QPointF predictedPos = info.pos() + velocity * STROKE_PREDICTION_INTERVAL;
+
+    KisPaintOpPresetSP preset = m_d->resources->currentPaintOpPreset();
+    const qreal brushRadius = preset ? 0.5 * preset->settings()->paintOpSize() : 0.0;
+
+    const QRect predictedRect =
+        kisGrowRect(QRectF(info.pos(), predictedPos).normalized(), brushRadius).toAlignedRect();
+
+    if (m_d->prefetchedRect.contains(predictedRect)) return;
+
+    /**
+     * Request a bit more than needed, so that we wouldn't issue
+     * a new request on every single event
+     */
+    m_d->prefetchedRect = kisGrowRect(predictedRect, qMax(predictedRect.width(), predictedRect.height()) / 2);
+
+    KisLayerUtils::recursivePrefetchRect(m_d->resources->image()->root(), m_d->prefetchedRect);
+}
+
 void KisToolFreehandHelper::endPaint()
 {
     if (!m_d->hasPaintAtLeastOnce) {
@@ -138,6 +138,8 @@ private:
                                                const KisPaintInformation &lastPaintInfo);
     int computeAirbrushTimerInterval() const;
 
+    void prefetchStrokeArea(const KisPaintInformation &info);
+
     qreal currentZoom() const;
 
 private Q_SLOTS:
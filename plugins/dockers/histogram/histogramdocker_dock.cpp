@@ -57,7 +57,7 @@ void HistogramDockerDock::setCanvas(KoCanvasBase * canvas)
         m_imageIdleWatcher->setTrackedImage(m_canvas->image());
         connect(m_imageIdleWatcher, &KisIdleWatcher::startedIdleMode, this, &HistogramDockerDock::updateHistogram, Qt::UniqueConnection);
 
-        connect(m_canvas->image(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(startUpdateCanvasProjection()), Qt::UniqueConnection);
+        connect(m_canvas->image(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(startUpdateCanvasProjection(QRect)), Qt::UniqueConnection);
         connect(m_canvas->image(), SIGNAL(sigColorSpaceChanged(const KoColorSpace*)), this, SLOT(sigColorSpaceChanged(const KoColorSpace*)), Qt::UniqueConnection);
         m_imageIdleWatcher->startCountdown();
     }
@@ -70,8 +70,12 @@ void HistogramDockerDock::unsetCanvas()
     m_imageIdleWatcher->startCountdown();
 }
 
-void HistogramDockerDock::startUpdateCanvasProjection()
+void HistogramDockerDock::startUpdateCanvasProjection(const QRect &rect)
 {
+    // the changes are tracked even when the docker is hidden,
+    // so that we would know what to recalculate on showing it
+    m_histogramWidget->addDirtyRect(rect);
+
     if (isVisible()) {
         m_imageIdleWatcher->startCountdown();
     }
@@ -21,6 +21,7 @@
 #include "kis_iterator_ng.h"
 #include "krita_utils.h"
 #include "kis_canvas2.h"
+#include "KoOptimizedHistogramAccumulatorFactory.h"
 
 struct HistogramComputationStrokeStrategy::Private {
 
@@ -39,9 +40,11 @@ struct HistogramComputationStrokeStrategy::Private {
 };
 
 
-HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageWSP image)
+HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageWSP image, HistogramPatchCacheSP cache, const QVector<QRect> &dirtyRects)
     : KisSimpleStrokeStrategy(QLatin1String("ComputeHistogram")),
-      m_image(image)
+      m_image(image),
+      m_cache(cache),
+      m_dirtyRects(dirtyRects)
 {
     enableJob(KisSimpleStrokeStrategy::JOB_INIT, true, KisStrokeJobData::BARRIER, KisStrokeJobData::EXCLUSIVE);
     enableJob(KisSimpleStrokeStrategy::JOB_DOSTROKE);
@@ -60,13 +63,32 @@ HistogramComputationStrokeStrategy::~HistogramComputationStrokeStrategy()
 
 void HistogramComputationStrokeStrategy::initStrokeCallback()
 {
+    const QRect imageBounds = m_image->bounds();
+    const KoColorSpace *colorSpace = m_image->projection()->colorSpace();
+
+    if (m_cache->imageBounds != imageBounds || m_cache->colorSpace != colorSpace) {
+        m_cache->imageBounds = imageBounds;
+        m_cache->colorSpace = colorSpace;
+        m_cache->patchRects = KritaUtils::splitRectIntoPatches(imageBounds, KritaUtils::optimalPatchSize());
+        m_cache->patchBins.clear();
+        m_cache->patchBins.resize(m_cache->patchRects.size());
+        m_cache->patchIsValid.assign(m_cache->patchRects.size(), false);
+    } else {
+        for (int i = 0; i < m_cache->patchRects.size(); i++) {
+            Q_FOREACH (const QRect &rc, m_dirtyRects) {
+                if (rc.intersects(m_cache->patchRects[i])) {
+                    m_cache->patchIsValid[i] = false;
+                    break;
+                }
+            }
+        }
+    }
+
     QVector<KisStrokeJobData*> jobsData;
-    int i = 0;
-    QVector<QRect> tileRects = KritaUtils::splitRectIntoPatches(m_image->bounds(), KritaUtils::optimalPatchSize());
-    m_results.resize(tileRects.size());
-    Q_FOREACH (const QRect &tileRectangle, tileRects) {
-        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(tileRectangle, i);
-        i++;
+    for (int i = 0; i < m_cache->patchRects.size(); i++) {
+        if (!m_cache->patchIsValid[i]) {
+            jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(m_cache->patchRects[i], i);
+        }
     }
     addMutatedJobs(jobsData);
 }
@@ -82,17 +104,24 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
 
     const KoColorSpace *cs = m_dev->colorSpace();
     quint32 channelCount = m_dev->channelCount();
-    quint32 pixelSize = m_dev->pixelSize();
+    int pixelSize = m_dev->pixelSize();
 
     quint32 imageSize = imageBounds.width() * imageBounds.height();
-    quint32 nSkip = 1 + (imageSize >> 20); //for speed use about 1M pixels for computing histograms
+    int nSkip = 1 + (imageSize >> 20); //for speed use about 1M pixels for computing histograms
 
-    if (calculate.isEmpty())
+    HistVector &bins = m_cache->patchBins[d_pd->jobId];
+    initiateVector(bins, cs);
+
+    if (calculate.isEmpty()) {
+        m_cache->patchIsValid[d_pd->jobId] = true;
         return;
+    }
 
-    initiateVector(m_results[d_pd->jobId], cs);
+    QScopedPointer<KoOptimizedHistogramAccumulatorBase> accumulator(
+        KoOptimizedHistogramAccumulatorFactory::create(cs));
 
-    quint32 toSkip = nSkip;
+    // a pixel is sampled when the counter reaches zero
+    int toSkip = nSkip;
 
     KisSequentialConstIterator it(m_dev, calculate);
 
@@ -101,16 +130,24 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
 
         numConseqPixels = it.nConseqPixels();
         const quint8* pixel = it.rawDataConst();
-        for (int k = 0; k < numConseqPixels; ++k) {
-            if (--toSkip == 0) {
-                for (int chan = 0; chan < (int)channelCount; ++chan) {
-                    m_results[d_pd->jobId][chan][cs->scaleToU8(pixel, chan)]++;
-                }
-                toSkip = nSkip;
-            }
-            pixel += pixelSize;
+
+        if (toSkip <= numConseqPixels) {
+            const int firstSample = toSkip - 1;
+            const int numSamples = 1 + (numConseqPixels - toSkip) / nSkip;
+            const int lastSample = firstSample + (numSamples - 1) * nSkip;
+
+            accumulator->accumulate(pixel + firstSample * pixelSize, nSkip * pixelSize, numSamples);
+            toSkip = nSkip - (numConseqPixels - 1 - lastSample);
+        } else {
+            toSkip -= numConseqPixels;
         }
     }
+
+    for (int chan = 0; chan < (int)channelCount; ++chan) {
+        accumulator->addToBins(chan, bins[chan].data());
+    }
+
+    m_cache->patchIsValid[d_pd->jobId] = true;
 }
 
 void HistogramComputationStrokeStrategy::finishStrokeCallback()
@@ -120,31 +157,26 @@ void HistogramComputationStrokeStrategy::finishStrokeCallback()
     }
 
     HistogramData hisData;
-    hisData.colorSpace = m_image->projection()->colorSpace();
+    hisData.colorSpace = m_cache->colorSpace;
 
-    if (m_results.size() == 1) {
-        hisData.bins = m_results[0];
-        emit computationResultReady(hisData);
-    } else {
+    quint32 channelCount = hisData.colorSpace->channelCount();
 
-        quint32 channelCount = m_image->projection()->channelCount();
+    initiateVector(hisData.bins, hisData.colorSpace);
 
-        initiateVector(hisData.bins, hisData.colorSpace);
+    for (size_t i = 0; i < m_cache->patchBins.size(); i++) {
+        KIS_SAFE_ASSERT_RECOVER(m_cache->patchIsValid[i]) { continue; }
 
         for (int chan = 0; chan < (int)channelCount; chan++) {
-            int bsize = hisData.bins[chan].size();
+            const std::vector<quint32> &patchChannel = m_cache->patchBins[i][chan];
+            std::vector<quint32> &channel = hisData.bins[chan];
 
-            for (int bi = 0; bi < bsize; bi++) {
-                hisData.bins[chan][bi] = 0;
-                for (int i = 0; i < (int)m_results.size(); i++) {
-                    hisData.bins[chan][bi] += m_results[i][chan][bi];
-                }
+            for (size_t bi = 0; bi < channel.size(); bi++) {
+                channel[bi] += patchChannel[bi];
             }
         }
-
-        emit computationResultReady(hisData);
     }
 
+    emit computationResultReady(hisData);
 }
 
 void HistogramComputationStrokeStrategy::cancelStrokeCallback()
@@ -156,7 +188,7 @@ void HistogramComputationStrokeStrategy::initiateVector(HistVector &vec, const K
     int channelCount = colorSpace->channelCount();
     vec.resize((int)channelCount);
     for (auto &bin : vec) {
-        bin.resize(std::numeric_limits<quint8>::max() + 1);
+        bin.assign(std::numeric_limits<quint8>::max() + 1, 0);
     }
 }
 
@@ -178,31 +210,57 @@ HistogramDockerWidget::~HistogramDockerWidget()
 void HistogramDockerWidget::updateHistogram(KisCanvas2* canvas)
 {
     if (canvas) {
-        KisPaintDeviceSP paintDevice = canvas->image()->projection();
-        QRect bounds = canvas->image()->bounds();
+        KisImageSP image = canvas->image();
 
         // remember to save the color space to paint the histogram data!
-        m_colorSpace = paintDevice->colorSpace();
-
-        KisPaintDeviceSP m_devClone = new KisPaintDevice(paintDevice->colorSpace());
+        m_colorSpace = image->projection()->colorSpace();
 
-        m_devClone->makeCloneFrom(paintDevice, bounds);
+        if (!m_patchCache || !m_cachedImage.isValid() || m_cachedImage != image.data()) {
+            m_patchCache.reset(new HistogramPatchCache());
+            m_cachedImage = image;
+            m_dirtyRects.clear();
+        }
 
         HistogramComputationStrokeStrategy* stroke;
-        stroke = new HistogramComputationStrokeStrategy(canvas->image());
+        stroke = new HistogramComputationStrokeStrategy(image, m_patchCache, m_dirtyRects);
+        m_dirtyRects.clear();
 
         connect(stroke, SIGNAL(computationResultReady(HistogramData)), this, SLOT(receiveNewHistogram(HistogramData)));
 
-        KisStrokeId strokeId = canvas->image()->startStroke(stroke);
-        canvas->image()->endStroke(strokeId);
+        KisStrokeId strokeId = image->startStroke(stroke);
+        image->endStroke(strokeId);
 
 
     } else {
+        m_patchCache.clear();
+        m_cachedImage = KisImageWSP();
+        m_dirtyRects.clear();
+
         m_histogramData.clear();
         update();
     }
 }
 
+void HistogramDockerWidget::addDirtyRect(const QRect &rect)
+{
+    /**
+     * Every rect is checked against every patch of the image, so
+     * when there are too many of them, just merge them into one
+     */
+    const int maxDirtyRects = 64;
+
+    if (m_dirtyRects.size() >= maxDirtyRects) {
+        QRect boundingRect = rect;
+        Q_FOREACH (const QRect &rc, m_dirtyRects) {
+            boundingRect |= rc;
+        }
+        m_dirtyRects.clear();
+        m_dirtyRects.append(boundingRect);
+    } else {
+        m_dirtyRects.append(rect);
+    }
+}
+
 void HistogramDockerWidget::receiveNewHistogram(HistVector* data)
 {
     m_histogramData = *data;
@@ -12,6 +12,9 @@
 #include <QWidget>
 #include <QLabel>
 #include <QThread>
+#include <QRect>
+#include <QSharedPointer>
+#include <QVector>
 #include "kis_types.h"
 #include <vector>
 #include <kis_simple_stroke_strategy.h>
@@ -32,12 +35,28 @@ struct HistogramData
 };
 Q_DECLARE_METATYPE(HistogramData)
 
+/**
+ * Histograms of the image patches calculated by the previous
+ * HistogramComputationStrokeStrategy. The next stroke recalculates
+ * only the patches touched by the image updates, the rest are
+ * reused as they are.
+ */
+struct HistogramPatchCache
+{
+    QRect imageBounds;
+    const KoColorSpace* colorSpace {0};
+    QVector<QRect> patchRects;
+    std::vector<HistVector> patchBins;
+    std::vector<int> patchIsValid; // not vector<bool>, the patches are written from different threads
+};
+using HistogramPatchCacheSP = QSharedPointer<HistogramPatchCache>;
+
 
 class HistogramComputationStrokeStrategy : public QObject, public KisSimpleStrokeStrategy
 {
     Q_OBJECT
 public:
-    HistogramComputationStrokeStrategy(KisImageWSP image);
+    HistogramComputationStrokeStrategy(KisImageWSP image, HistogramPatchCacheSP cache, const QVector<QRect> &dirtyRects);
     ~HistogramComputationStrokeStrategy() override;
 
 
@@ -58,7 +77,8 @@ private:
     struct Private;
     const QScopedPointer<Private> m_d;
     KisImageSP m_image;
-    std::vector<HistVector> m_results;
+    HistogramPatchCacheSP m_cache;
+    QVector<QRect> m_dirtyRects;
 };
 
 
@@ -84,8 +104,18 @@ public Q_SLOTS:
     void receiveNewHistogram(HistVector*);
     void receiveNewHistogram(HistogramData data);
 
+    /**
+     * @brief addDirtyRect marks the area of the image as changed,
+     * so that the next updateHistogram() call would recalculate it
+     */
+    void addDirtyRect(const QRect &rect);
+
 
 private:
+    HistogramPatchCacheSP m_patchCache;
+    KisImageWSP m_cachedImage;
+    QVector<QRect> m_dirtyRects;
+
     HistVector m_histogramData;
     const KoColorSpace* m_colorSpace {0};
     bool m_smoothHistogram {false};
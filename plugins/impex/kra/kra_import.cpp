@@ -26,7 +26,7 @@ KraImport::~KraImport()
 
 KisImportExportErrorCode KraImport::convert(KisDocument *document, QIODevice *io,  KisPropertiesConfigurationSP /*configuration*/)
 {
-    KraConverter kraConverter(document);
+    KraConverter kraConverter(document, updater());
     KisImportExportErrorCode result = kraConverter.buildImage(io);
     if (result.isOk()) {
         document->setCurrentImage(kraConverter.image());
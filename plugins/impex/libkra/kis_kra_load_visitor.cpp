@@ -17,6 +17,8 @@
 #include <QByteArray>
 #include <QMessageBox>
 #include <QApplication>
+#include <QElapsedTimer>
+#include <QtConcurrent>
 
 #include <KoMD5Generator.h>
 #include <KoColorSpaceRegistry.h>
@@ -44,6 +46,7 @@
 #include <kis_filter_mask.h>
 #include <kis_group_layer.h>
 #include <kis_image.h>
+#include <kis_image_config.h>
 #include <kis_layer.h>
 #include <kis_meta_data_backend_registry.h>
 #include <kis_meta_data_store.h>
@@ -117,6 +120,13 @@ KisKraLoadVisitor::KisKraLoadVisitor(KisImageSP image,
         m_store->popDirectory();
     }
     m_syntaxVersion = syntaxVersion;
+
+    m_decodeThreadPool.setMaxThreadCount(KisImageConfig(true).maxNumberOfThreads());
+}
+
+KisKraLoadVisitor::~KisKraLoadVisitor()
+{
+    waitForPendingJobs();
 }
 
 void KisKraLoadVisitor::setExternalUri(const QString &uri)
@@ -187,10 +197,15 @@ bool KisKraLoadVisitor::visit(KisPaintLayer *layer)
 {
     loadNodeKeyframes(layer);
 
-    if (!loadPaintDevice(layer->paintDevice(), getLocation(layer))) {
+    /**
+     * The profile is assigned before the pixel data is loaded, because
+     * the pixel data is loaded asynchronously and we should not touch
+     * the device after that.
+     */
+    if (!loadProfile(layer->paintDevice(), getLocation(layer, DOT_ICC))) {
         return false;
     }
-    if (!loadProfile(layer->paintDevice(), getLocation(layer, DOT_ICC))) {
+    if (!loadPaintDevice(layer->paintDevice(), getLocation(layer))) {
         return false;
     }
     if (!loadMetaData(layer)) {
@@ -248,6 +263,12 @@ bool KisKraLoadVisitor::visit(KisAdjustmentLayer* layer)
         KisSelectionSP selection = new KisSelection();
         KisPixelSelectionSP pixelSelection = selection->pixelSelection();
         result = loadPaintDevice(pixelSelection, getLocation(layer, ".selection"));
+
+        /**
+         * setInternalSelection() copies the selection and starts an
+         * update of the layer, so the pixel data should be fully loaded
+         */
+        waitForPendingJobs();
         layer->setInternalSelection(selection);
     } else if (m_syntaxVersion == 2) {
         result = loadSelection(getLocation(layer), layer->internalSelection());
@@ -467,6 +488,12 @@ bool KisKraLoadVisitor::visit(KisColorizeMask *mask)
 
     loadPaintDevice(mask->coloringProjection(), COLORIZE_COLORING_DEVICE);
 
+    /**
+     * Assigning the profile and resetting the cache touch the
+     * devices of the mask, so they should be fully loaded.
+     */
+    waitForPendingJobs();
+
     const KoColorProfile *profile =
         loadProfile(getLocation(mask, DOT_ICC), mask->colorSpace()->colorModelId().id(), mask->colorSpace()->colorDepthId().id());
 
@@ -538,7 +565,8 @@ struct FramedDevicePolicy
     int m_frameId;
 };
 
-bool KisKraLoadVisitor::loadPaintDevice(KisPaintDeviceSP device, const QString& location)
+bool KisKraLoadVisitor::loadPaintDevice(KisPaintDeviceSP device, const QString& location,
+                                        std::function<void()> postDecodeStep)
 {
     // Layer data
     KisPaintDeviceFramesInterface *frameInterface = device->framesInterface();
@@ -548,8 +576,14 @@ bool KisKraLoadVisitor::loadPaintDevice(KisPaintDeviceSP device, const QString&
         frames = device->framesInterface()->frames();
     }
 
+    /**
+     * All the frames of the device are loaded by the same job, because
+     * the frames interface of the device is not thread-safe
+     */
+    DeviceDecodeSteps steps;
+
     if (!frameInterface || frames.count() <= 1) {
-        return loadPaintDeviceFrame(device, location, SimpleDevicePolicy());
+        loadPaintDeviceFrame(device, location, SimpleDevicePolicy(), &steps);
     } else {
         KisRasterKeyframeChannel *keyframeChannel = device->keyframeChannel();
 
@@ -563,50 +597,139 @@ bool KisKraLoadVisitor::loadPaintDevice(KisPaintDeviceSP device, const QString&
                 QString frameFilename = getLocation(keyframeChannel->frameFilename(id));
                 Q_ASSERT(!frameFilename.isEmpty());
 
-                if (!loadPaintDeviceFrame(device, frameFilename, FramedDevicePolicy(id))) {
+                if (!loadPaintDeviceFrame(device, frameFilename, FramedDevicePolicy(id), &steps)) {
                     m_warningMessages << i18n("Could not load keyframe pixel data for frame %1 in %2.", id, location);
                 }
             }
         }
     }
 
+    if (postDecodeStep) {
+        steps.append(
+            [postDecodeStep] () {
+                postDecodeStep();
+                return QString();
+            });
+    }
+
+    scheduleDecodeJob(steps);
+
     return true;
 }
 
 template<class DevicePolicy>
-bool KisKraLoadVisitor::loadPaintDeviceFrame(KisPaintDeviceSP device, const QString &location, DevicePolicy policy)
+bool KisKraLoadVisitor::loadPaintDeviceFrame(KisPaintDeviceSP device, const QString &location, DevicePolicy policy, DeviceDecodeSteps *steps)
 {
-    {
-        const int pixelSize = device->colorSpace()->pixelSize();
-        KoColor color(Qt::transparent, device->colorSpace());
+    QElapsedTimer timer;
+    timer.start();
 
-        if (m_store->open(location + ".defaultpixel")) {
-            if (m_store->size() == pixelSize) {
-                m_store->read((char*)color.data(), pixelSize);
-            }
+    const int pixelSize = device->colorSpace()->pixelSize();
+    KoColor color(Qt::transparent, device->colorSpace());
 
-            m_store->close();
+    if (m_store->open(location + ".defaultpixel")) {
+        if (m_store->size() == pixelSize) {
+            m_store->read((char*)color.data(), pixelSize);
         }
 
-        policy.setDefaultPixel(device, color);
+        m_store->close();
     }
 
+    QByteArray data;
+    bool hasData = false;
+
     if (m_store->open(location)) {
-        if (!policy.read(device, m_store->device())) {
-            m_warningMessages << i18n("Could not read pixel data: %1.", location);
-            device->disconnect();
-            m_store->close();
-            return true;
-        }
+        data = m_store->read(m_store->size());
         m_store->close();
+        hasData = true;
     } else {
         m_warningMessages << i18n("Could not load pixel data: %1.", location);
-        return true;
     }
 
+    m_readingTime += timer.nsecsElapsed();
+
+    steps->append(
+        [device, location, policy, color, data, hasData] () mutable {
+            policy.setDefaultPixel(device, color);
+
+            if (!hasData) return QString();
+
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::ReadOnly);
+
+            if (!policy.read(device, &buffer)) {
+                device->disconnect();
+                return i18n("Could not read pixel data: %1.", location);
+            }
+
+            return QString();
+        });
+
     return true;
 }
 
+void KisKraLoadVisitor::scheduleDecodeJob(const DeviceDecodeSteps &steps)
+{
+    if (steps.isEmpty()) return;
+
+    /**
+     * Don't let the compressed data of the whole document be
+     * accumulated in memory if the decoding is slower than reading
+     */
+    const int maxPendingJobs = 4 * m_decodeThreadPool.maxThreadCount();
+    while (m_pendingJobs.size() >= maxPendingJobs) {
+        takeFirstPendingJob();
+    }
+
+    QAtomicInteger<qint64> *decodingTime = &m_decodingTime;
+
+    m_pendingJobs.append(QtConcurrent::run(&m_decodeThreadPool,
+        [steps, decodingTime] () {
+            QElapsedTimer timer;
+            timer.start();
+
+            QStringList warnings;
+
+            Q_FOREACH (const std::function<QString()> &step, steps) {
+                const QString warning = step();
+                if (!warning.isEmpty()) {
+                    warnings << warning;
+                }
+            }
+
+            decodingTime->fetchAndAddRelaxed(timer.nsecsElapsed());
+            return warnings;
+        }));
+
+    m_numScheduledJobs++;
+}
+
+void KisKraLoadVisitor::takeFirstPendingJob()
+{
+    QFuture<QStringList> job = m_pendingJobs.takeFirst();
+    m_warningMessages << job.result();
+    m_numFinishedJobs++;
+}
+
+void KisKraLoadVisitor::waitForPendingJobs(std::function<void(int)> progressCallback)
+{
+    if (m_pendingJobs.isEmpty()) return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!m_pendingJobs.isEmpty()) {
+        takeFirstPendingJob();
+
+        if (progressCallback) {
+            progressCallback(100 * m_numFinishedJobs / m_numScheduledJobs);
+        }
+    }
+
+    dbgFile << "Loaded" << m_numScheduledJobs << "paint devices:"
+            << "reading" << m_readingTime / 1000000 << "ms,"
+            << "decoding (total CPU)" << m_decodingTime.load() / 1000000 << "ms,"
+            << "waiting for decoding" << timer.elapsed() << "ms";
+}
 
 bool KisKraLoadVisitor::loadProfile(KisPaintDeviceSP device, const QString& location)
 {
@@ -769,11 +892,13 @@ bool KisKraLoadVisitor::loadSelection(const QString& location, KisSelectionSP ds
         QString pixelSelectionLocation = location + DOT_PIXEL_SELECTION;
         if (m_store->hasFile(pixelSelectionLocation)) {
             KisPixelSelectionSP pixelSelection = dstSelection->pixelSelection();
-            result = loadPaintDevice(pixelSelection, pixelSelectionLocation);
+            result = loadPaintDevice(pixelSelection, pixelSelectionLocation,
+                                     [pixelSelection] () {
+                                         pixelSelection->invalidateOutlineCache();
+                                     });
             if (!result) {
                 m_warningMessages << i18n("Could not load raster selection %1.", location);
             }
-            pixelSelection->invalidateOutlineCache();
         }
     }
 
@@ -10,6 +10,11 @@
 
 #include <QRect>
 #include <QStringList>
+#include <QThreadPool>
+#include <QFuture>
+#include <QAtomicInteger>
+
+#include <functional>
 
 // kritaimage
 #include "kis_types.h"
@@ -36,6 +41,8 @@ public:
                       const QString & name,
                       int syntaxVersion);
 
+    ~KisKraLoadVisitor() override;
+
 public:
     void setExternalUri(const QString &uri);
 
@@ -57,12 +64,34 @@ public:
     QStringList errorMessages() const;
     QStringList warningMessages() const;
 
+    /**
+     * The pixel data of the layers, masks and keyframes is read from the
+     * store sequentially, but decompressed and loaded into the paint
+     * devices on a pool of worker threads. This method waits until all
+     * the scheduled data is loaded and collects the warnings of the
+     * decoding jobs. It must be called before the image is used and
+     * before warningMessages() is checked.
+     *
+     * \p progressCallback is called with the percentage of the already
+     * loaded paint devices.
+     */
+    void waitForPendingJobs(std::function<void(int)> progressCallback = std::function<void(int)>());
+
 private:
+    typedef QVector<std::function<QString()>> DeviceDecodeSteps;
 
-    bool loadPaintDevice(KisPaintDeviceSP device, const QString& location);
+    /**
+     * Schedules loading of the pixel data of \p device. \p postDecodeStep
+     * is executed on the worker thread right after the data is loaded.
+     */
+    bool loadPaintDevice(KisPaintDeviceSP device, const QString& location,
+                         std::function<void()> postDecodeStep = std::function<void()>());
 
     template<class DevicePolicy>
-    bool loadPaintDeviceFrame(KisPaintDeviceSP device, const QString &location, DevicePolicy policy);
+    bool loadPaintDeviceFrame(KisPaintDeviceSP device, const QString &location, DevicePolicy policy, DeviceDecodeSteps *steps);
+
+    void scheduleDecodeJob(const DeviceDecodeSteps &steps);
+    void takeFirstPendingJob();
 
     bool loadProfile(KisPaintDeviceSP device,  const QString& location);
     bool loadFilterConfiguration(KisFilterConfigurationSP kfc, const QString& location);
@@ -96,6 +125,15 @@ private:
     QStringList m_warningMessages;
     KoShapeControllerBase *m_shapeController;
     QMap<QString, const KoColorProfile *> m_profileCache;
+
+    int m_numScheduledJobs {0};
+    int m_numFinishedJobs {0};
+    qint64 m_readingTime {0};
+    QAtomicInteger<qint64> m_decodingTime {0};
+    QList<QFuture<QStringList>> m_pendingJobs;
+
+    // should be the last member, since it waits for the running jobs
+    QThreadPool m_decodeThreadPool;
 };
 
 #endif // KIS_KRA_LOAD_VISITOR_H_
@@ -411,7 +411,8 @@ KisImageSP KisKraLoader::loadXML(const QDomElement& imageElement)
     return image;
 }
 
-void KisKraLoader::loadBinaryData(KoStore * store, KisImageSP image, const QString & uri, bool external)
+void KisKraLoader::loadBinaryData(KoStore * store, KisImageSP image, const QString & uri, bool external,
+                                  std::function<void(int)> progressCallback)
 {
     // icc profile: if present, this overrides the profile product name loaded in loadXML.
     QString location = external ? QString() : uri;
@@ -470,6 +471,8 @@ void KisKraLoader::loadBinaryData(KoStore * store, KisImageSP image, const QStri
     }
 
     image->rootLayer()->accept(visitor);
+    visitor.waitForPendingJobs(progressCallback);
+
     if (!visitor.errorMessages().isEmpty()) {
         m_d->errorMessages.append(visitor.errorMessages());
     }
@@ -18,6 +18,8 @@ class KisPaintingAssistant;
 class StoryboardComment;
 
 #include <kis_types.h>
+
+#include <functional>
 #include "kritalibkra_export.h"
 /**
  * Load old-style 1.x .kra files. Updated for 2.0, let's try to stay
@@ -39,7 +41,12 @@ public:
      */
     KisImageSP loadXML(const QDomElement& imageElement);
 
-    void loadBinaryData(KoStore* store, KisImageSP image, const QString & uri, bool external);
+    /**
+     * Loads the pixel data of the layers. \p progressCallback is called
+     * with the percentage of the already loaded layers data.
+     */
+    void loadBinaryData(KoStore* store, KisImageSP image, const QString & uri, bool external,
+                        std::function<void(int)> progressCallback = std::function<void(int)>());
 
     void loadResources(KoStore *store, KisDocument *doc);
     void loadStoryboards(KoStore *store, KisDocument *doc);
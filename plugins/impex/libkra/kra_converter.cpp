@@ -11,6 +11,7 @@
 #include <QScopedPointer>
 #include <QUrl>
 #include <QVersionNumber>
+#include <QElapsedTimer>
 
 #include <KoStore.h>
 #include <KoStoreDevice.h>
@@ -103,6 +104,7 @@ KisImportExportErrorCode KraConverter::buildImage(QIODevice *io)
                 m_doc->documentInfo()->load(doc);
             }
         }
+        setProgress(20);
         success = completeLoading(m_store);
     }
 
@@ -427,10 +429,23 @@ bool KraConverter::completeLoading(KoStore* store)
         }
     }
 
+    QElapsedTimer timer;
+    timer.start();
+
     m_kraLoader->loadResources(store, m_doc);
-    m_kraLoader->loadBinaryData(store, m_image, m_doc->localFilePath(), true);
+    dbgFile << "Loading resources took" << timer.restart() << "ms";
+    setProgress(30);
+
+    m_kraLoader->loadBinaryData(store, m_image, m_doc->localFilePath(), true,
+                                [this] (int progress) {
+                                    setProgress(30 + progress * 60 / 100);
+                                });
+    dbgFile << "Loading layers data took" << timer.restart() << "ms";
+    setProgress(90);
+
     m_kraLoader->loadStoryboards(store, m_doc);
     m_kraLoader->loadAnimationMetadata(store, m_image);
+    dbgFile << "Loading storyboards and animation metadata took" << timer.restart() << "ms";
 
     if (!m_kraLoader->errorMessages().isEmpty()) {
         m_doc->setErrorMessage(m_kraLoader->errorMessages().join("\n"));
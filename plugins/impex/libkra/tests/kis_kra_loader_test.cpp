@@ -23,7 +23,12 @@
 
 #include "kis_image_animation_interface.h"
 #include "kis_keyframe_channel.h"
+#include "kis_raster_keyframe_channel.h"
+#include "kis_paint_device_frames_interface.h"
 #include "kis_time_span.h"
+#include "kis_image_config.h"
+#include "kis_layer_utils.h"
+#include "util.h"
 
 #include <filestest.h>
 
@@ -164,6 +169,142 @@ void KisKraLoaderTest::testLoadAnimated()
 
 
 
+bool compareDevicesExactly(KisPaintDeviceSP dev1, KisPaintDeviceSP dev2)
+{
+    if (dev1->exactBounds() != dev2->exactBounds() ||
+        dev1->defaultPixel() != dev2->defaultPixel() ||
+        dev1->x() != dev2->x() || dev1->y() != dev2->y()) {
+
+        return false;
+    }
+
+    const QRect rc = dev1->exactBounds();
+    const int dataSize = rc.width() * rc.height() * dev1->pixelSize();
+
+    QByteArray data1(dataSize, 0);
+    QByteArray data2(dataSize, 0);
+
+    dev1->readBytes(reinterpret_cast<quint8*>(data1.data()), rc);
+    dev2->readBytes(reinterpret_cast<quint8*>(data2.data()), rc);
+
+    return data1 == data2;
+}
+
+bool compareNodeFramesExactly(KisNodeSP node1, KisNodeSP node2)
+{
+    KisKeyframeChannel *channel1 = node1->getKeyframeChannel(KisKeyframeChannel::Raster.id());
+    KisKeyframeChannel *channel2 = node2->getKeyframeChannel(KisKeyframeChannel::Raster.id());
+
+    if (!channel1 || !channel2) {
+        return !channel1 && !channel2;
+    }
+
+    if (channel1->allKeyframeTimes() != channel2->allKeyframeTimes()) return false;
+
+    KisPaintDeviceSP dev1 = node1->paintDevice();
+    KisPaintDeviceSP dev2 = node2->paintDevice();
+
+    Q_FOREACH (int time, channel1->allKeyframeTimes()) {
+        KisPaintDeviceSP frame1 = new KisPaintDevice(dev1->colorSpace());
+        KisPaintDeviceSP frame2 = new KisPaintDevice(dev2->colorSpace());
+
+        dev1->framesInterface()->writeFrameToDevice(
+            channel1->keyframeAt<KisRasterKeyframe>(time)->frameID(), frame1);
+        dev2->framesInterface()->writeFrameToDevice(
+            channel2->keyframeAt<KisRasterKeyframe>(time)->frameID(), frame2);
+
+        if (!compareDevicesExactly(frame1, frame2)) return false;
+    }
+
+    return true;
+}
+
+void KisKraLoaderTest::testThreadedLoadingMatchesSerial()
+{
+    QScopedPointer<KisDocument> doc(createCompleteDocument());
+    KisImageSP image = doc->image();
+    const KoColorSpace *cs = image->colorSpace();
+
+    KisPaintLayerSP animatedLayer = new KisPaintLayer(image, "animatedLayer", OPACITY_OPAQUE_U8);
+    image->addNode(animatedLayer);
+
+    KUndo2Command parentCommand;
+    animatedLayer->enableAnimation();
+    KisKeyframeChannel *channel =
+        animatedLayer->getKeyframeChannel(KisKeyframeChannel::Raster.id(), true);
+    QVERIFY(channel);
+
+    for (int i = 0; i < 4; i++) {
+        const int time = 10 * i;
+
+        if (time > 0) {
+            channel->addKeyframe(time, &parentCommand);
+        }
+        image->animationInterface()->switchCurrentTimeAsync(time);
+        image->waitForDone();
+
+        animatedLayer->paintDevice()->fill(QRect(100 * i, 50 * i, 200, 150),
+                                           KoColor(QColor(60 * i, 255 - 60 * i, 20), cs));
+    }
+
+    doc->exportDocumentSync("threaded_loading_test.kra", doc->mimeType());
+
+    const int numThreads = KisImageConfig(true).maxNumberOfThreads();
+
+    auto setNumThreads = [] (int value) {
+        KisImageConfig cfg(false);
+        cfg.setMaxNumberOfThreads(value);
+    };
+
+    QScopedPointer<KisDocument> serialDoc(KisPart::instance()->createDocument());
+    QScopedPointer<KisDocument> threadedDoc(KisPart::instance()->createDocument());
+
+    setNumThreads(1);
+    const bool serialResult = serialDoc->loadNativeFormat("threaded_loading_test.kra");
+
+    setNumThreads(qMax(4, numThreads));
+    const bool threadedResult = threadedDoc->loadNativeFormat("threaded_loading_test.kra");
+
+    setNumThreads(numThreads);
+
+    QVERIFY(serialResult);
+    QVERIFY(threadedResult);
+
+    KisImageSP serialImage = serialDoc->image();
+    KisImageSP threadedImage = threadedDoc->image();
+
+    serialImage->waitForDone();
+    threadedImage->waitForDone();
+
+    QStringList checkedNodes;
+
+    KisLayerUtils::recursiveApplyNodes(serialImage->root(),
+        [&checkedNodes, threadedImage] (KisNodeSP serialNode) {
+            if (!serialNode->parent()) return;
+
+            KisNodeSP threadedNode = TestUtil::findNode(threadedImage->root(), serialNode->name());
+            QVERIFY2(threadedNode, qPrintable(serialNode->name()));
+
+            if (serialNode->paintDevice()) {
+                QVERIFY(threadedNode->paintDevice());
+                QVERIFY2(compareDevicesExactly(serialNode->paintDevice(), threadedNode->paintDevice()),
+                         qPrintable(serialNode->name()));
+            }
+
+            QVERIFY2(compareNodeFramesExactly(serialNode, threadedNode),
+                     qPrintable(serialNode->name()));
+
+            checkedNodes << serialNode->name();
+        });
+
+    QVERIFY(checkedNodes.contains("animatedLayer"));
+    QVERIFY(checkedNodes.contains("selectionMask1"));
+    QVERIFY(checkedNodes.contains("transparencyMask1"));
+    QVERIFY(checkedNodes.contains("adjustmentLayer1"));
+
+    QVERIFY(compareDevicesExactly(serialImage->projection(), threadedImage->projection()));
+}
+
 void KisKraLoaderTest::testImportFromWriteonly()
 {
     TestUtil::testImportFromWriteonly(QString(FILES_DATA_DIR), KraMimetype);
@@ -21,6 +21,8 @@ private Q_SLOTS:
 
     void testLoadAnimated();
 
+    void testThreadedLoadingMatchesSerial();
+
     void testImportFromWriteonly();
     void testImportIncorrectFormat();
 